@@ -1,4 +1,5 @@
 #include "StageManager.h"
+#include "CollisionManager.h"
 
 using namespace Engine;
 StageManager* StageManager::GetInstance()
@@ -12,6 +13,9 @@ void StageManager::Initialize()
     // デフォルト設定
     stageCenter_ = kDefaultStageCenter_;
     stageRadius_ = kDefaultStageRadius_;
+
+    // 当たり判定のブロードフェーズ範囲をステージに合わせる
+    CollisionManager::SetWorldBounds(stageCenter_, stageRadius_);
 }
 
 bool StageManager::IsWithinStageBounds(const Vector3& position) const
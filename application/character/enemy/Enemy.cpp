@@ -72,11 +72,11 @@ void Enemy::Init()
 	effect_ = std::make_unique<EnemyEffect>();
 
 	trailEffect_ = std::make_unique<ParticleEmitter>();
-	trailEffect_->Initialize("enemyTrail", "debug/ringPlane.obj");
+	trailEffect_->Initialize("enemyTrail", "debug/ringPlane.obj", Ring);
 	trailEffect_->SetActive(false);
 
 	powerUpEffect_ = std::make_unique<ParticleEmitter>();
-	powerUpEffect_->Initialize("EnemyPowerUp", "debug/ringPlane.obj");
+	powerUpEffect_->Initialize("EnemyPowerUp", "debug/ringPlane.obj", Ring);
 	powerUpEffect_->SetActive(false);
 
 	// --- コンポーネントへのエフェクト設定 ---
@@ -367,20 +367,18 @@ void EnemyAttackRanged::Draw(const ViewProjection& viewProjection)
 			redColor.SetColor(Vector4(1.0f, 0.0f, 0.0f, 0.6f));
 			redColor.TransferMatrix();
 
+			// 行列は UpdateViewProjection と TransformHierarchy::Update で求めてあるので、ここでは計算しない
 			if (attack.warningOutline) {
-				attack.warningTransform.UpdateMatrix();
 				attack.warningOutline->Draw(attack.warningTransform, viewProjection, &redColor);
 			}
 
 			if (attack.warningFill) {
-				attack.warningFillTransform.UpdateMatrix();
 				attack.warningFill->Draw(attack.warningFillTransform, viewProjection, &redColor);
 			}
 
 		}
 
 		if (attack.isSpikeActive && attack.spike) {
-			attack.spikeTransform.UpdateMatrix();
 			attack.spike->Draw(attack.spikeTransform, viewProjection);
 		}
 	}
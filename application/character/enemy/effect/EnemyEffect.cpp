@@ -1,26 +1,33 @@
 #include "EnemyEffect.h"
 #include "Enemy.h"
-#include <Easing.h>
 
 using namespace Engine;
+EnemyEffect::~EnemyEffect()
+{
+	// 書き込み先がなくなるので止める
+	TweenScheduler::Cancel(fallTween_);
+}
+
 void EnemyEffect::UpdateStartEffect(Enemy* enemy)
 {
 	enemy->UpdateBaseObject();
 
-	if (fallTimer_ < kFallDuration_) {
-		Vector3 currentPos = EaseOutBounce<Vector3>(
-			fallStartPos_,
-			fallEndPos_,
-			fallTimer_,
-			kFallDuration_
-		);
-		enemy->SetWorldPosition(currentPos);
-		fallTimer_++;
+	// 最初の更新で落下のトゥイーンを開始する（Bounce は焼き込んだ表から求める）
+	TweenScheduler* tweenScheduler = TweenScheduler::GetInstance();
+	if (fallTween_ == TweenScheduler::kInvalidHandle) {
+		fallTween_ = tweenScheduler->Start<Vector3>(&fallPos_, fallStartPos_, fallEndPos_,
+			kFallDuration_ * TweenScheduler::kFixedDeltaTime, EaseType::OutBounce, 0.0f, true);
+		fallStartRotationY_ = enemy->GetObjRotation().y;
+	}
+
+	if (tweenScheduler->IsActive(fallTween_)) {
+		enemy->SetWorldPosition(fallPos_);
 
-		// 落下中の回転演出
-		float rotationSpeed = kFallRotationSpeed_;
+		// 落下中の回転演出（1フレームごとに speed * (1 - t) 回していたものを経過時間の割合 t で積分した角度。
+		// フレームレートによらず同じ角度になる）
+		const float t = tweenScheduler->GetProgress(fallTween_);
 		Vector3 rot = enemy->GetObjRotation();
-		rot.y += rotationSpeed * (1.0f - (fallTimer_ / kFallDuration_));
+		rot.y = fallStartRotationY_ + kFallRotationSpeed_ * kFallDuration_ * (t - 0.5f * t * t);
 		enemy->SetObjRotation(rot);
 	}
 	else {
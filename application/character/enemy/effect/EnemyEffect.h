@@ -1,6 +1,7 @@
 #pragma once
 #include "Vector3.h"
 #include "ViewProjection.h"
+#include "TweenScheduler.h"
 
 using namespace Engine;
 class Enemy;
@@ -16,6 +17,7 @@ class EnemyEffect
 {
 public:
 	EnemyEffect() = default;
+	~EnemyEffect();
 
 	/// <summary>落下演出の更新（ゲーム開始前に毎フレーム呼ぶ）</summary>
 	void UpdateStartEffect(Enemy* enemy);
@@ -24,11 +26,15 @@ public:
 	bool IsFallComplete() const { return isFallComplete_; }
 
 private:
-	float   fallTimer_ = 0.0f;
 	bool    isFallComplete_ = false;
+	float   fallStartRotationY_ = 0.0f; // 落下開始時のY回転
 
-	const float kFallDuration_ = 60.0f;
-	const float kFallRotationSpeed_ = 0.1f;   // 落下中の回転速度
+	// 落下中の座標（TweenScheduler が書き込む）
+	Vector3 fallPos_ = { 0.0f, 0.0f, 0.0f };
+	TweenScheduler::Handle fallTween_ = TweenScheduler::kInvalidHandle;
+
+	const float kFallDuration_ = 60.0f;       // フレーム数（60fps 換算）
+	const float kFallRotationSpeed_ = 0.1f;   // 落下中の回転速度（60fps の1フレームあたり）
 	const Vector3 fallStartPos_ = { 0.0f, 10.0f, 15.0f };
 	const Vector3 fallEndPos_ = { 0.0f,  0.0f, 15.0f };
 };
\ No newline at end of file
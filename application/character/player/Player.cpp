@@ -29,6 +29,8 @@ void Player::Init()
 {
 	BaseObject::Init();
 	Collider::SetTypeID(static_cast<uint32_t>(CollisionTypeIdDef::kPlayer));
+	// 回避中は1フレームの移動量が大きいので連続判定する
+	Collider::SetContinuousEnabled(true);
 
 	// =============================================================
 	// GlobalVariables の初期化
@@ -81,13 +83,13 @@ void Player::Init()
 
 	// エフェクト
 	hitEffect_ = std::make_unique<ParticleEmitter>();
-	hitEffect_->Initialize("hitEffect", "debug/ringPlane.obj");
+	hitEffect_->Initialize("hitEffect", "debug/ringPlane.obj", Ring);
 
 	damageEffect_ = std::make_unique<ParticleEmitter>();
-	damageEffect_->Initialize("playerDamage", "debug/ringPlane.obj");
+	damageEffect_->Initialize("playerDamage", "debug/ringPlane.obj", Ring);
 
 	trailEffect_ = std::make_unique<ParticleEmitter>();
-	trailEffect_->Initialize("playerTrail", "debug/ringPlane.obj");
+	trailEffect_->Initialize("playerTrail", "debug/ringPlane.obj", Ring);
 	trailEffect_->SetActive(false);
 
 	// =============================================================
@@ -535,12 +537,17 @@ void Player::Draw(const ViewProjection& viewProjection)
 {
 	if (!isAlive_) { return; }
 
-	WorldTransform tempTransform = BaseObject::GetWorldTransform();
+	const WorldTransform& transform = BaseObject::GetWorldTransform();
 	if (hitReaction_->IsHitReacting()) {
-		tempTransform.translation_ += hitReaction_->GetShakeOffset();
-		tempTransform.UpdateMatrix();
+		// 揺れの分だけずらした行列で描く（WorldTransform を複製すると階層への登録・解除が毎フレーム走る）
+		Matrix4x4 worldMatrix = MakeAffineMatrix(transform.scale_, transform.rotation_, transform.translation_ + hitReaction_->GetShakeOffset());
+		if (transform.parent_) {
+			worldMatrix *= transform.parent_->matWorld_;
+		}
+		obj3d_->Draw(worldMatrix, viewProjection);
+		return;
 	}
-	obj3d_->Draw(tempTransform, viewProjection);
+	obj3d_->Draw(transform, viewProjection);
 }
 
 void Player::DrawAnimation(const ViewProjection& viewProjection)
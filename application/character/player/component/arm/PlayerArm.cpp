@@ -39,6 +39,8 @@ void PlayerArm::Init(const std::string& filePath)
 
     Collider::SetRadius(kColliderRadius_);
     Collider::SetCollisionEnabled(true);
+    // ラッシュの連打は1フレームの移動量が大きく、敵をすり抜けることがある
+    Collider::SetContinuousEnabled(true);
 }
 
 // =============================================================
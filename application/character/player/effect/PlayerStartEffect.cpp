@@ -1,6 +1,5 @@
 #include "PlayerStartEffect.h"
 #include "Player.h"
-#include "myMath.h"   // Lerp
 
 using namespace Engine;
 PlayerStartEffect::PlayerStartEffect(Player* player)
@@ -8,6 +7,12 @@ PlayerStartEffect::PlayerStartEffect(Player* player)
 {
 }
 
+PlayerStartEffect::~PlayerStartEffect()
+{
+	// 書き込み先がなくなるので止める
+	TweenScheduler::Cancel(scaleTween_);
+}
+
 void PlayerStartEffect::Update()
 {
 	if (isEnd_) {
@@ -16,14 +21,13 @@ void PlayerStartEffect::Update()
 
 	player_->UpdateArms();
 
-	if (easeT_ < 1.0f) {
-		easeT_ += kFrameDeltaTime_ / kDuration_;
-		if (easeT_ > 1.0f) {
-			easeT_ = 1.0f;
-		}
-		player_->SetScale(Lerp(kScaleStart_, kScaleEnd_, easeT_));
+	// 最初の更新でスケールのトゥイーンを開始し、以降はスケジューラーが求めた値を反映する
+	TweenScheduler* tweenScheduler = TweenScheduler::GetInstance();
+	if (scaleTween_ == TweenScheduler::kInvalidHandle) {
+		scaleTween_ = tweenScheduler->Start<Vector3>(&scale_, kScaleStart_, kScaleEnd_, kDuration_, EaseType::Linear);
 	}
-	else {
+	player_->SetScale(scale_);
+	if (!tweenScheduler->IsActive(scaleTween_)) {
 		isEnd_ = true;
 	}
 }
\ No newline at end of file
@@ -1,17 +1,19 @@
 #pragma once
 #include "Vector3.h"
+#include "TweenScheduler.h"
 
 using namespace Engine;
 class Player;
 
 /// <summary>
 /// プレイヤーの開始時演出を管理するクラス
-/// スケールを 0→1 に補間し、完了時に isEnd を立てる
+/// スケールを 0→1 に補間し、完了時に isEnd を立てる（補間は TweenScheduler がまとめて行う）
 /// </summary>
 class PlayerStartEffect
 {
 public:
 	explicit PlayerStartEffect(Player* player);
+	~PlayerStartEffect();
 
 	/// <summary>
 	/// 毎フレーム更新。演出完了後も呼び続けて問題ない。
@@ -26,8 +28,9 @@ public:
 private:
 	Player* player_ = nullptr;
 
-	/// 補間パラメータ（0.0〜1.0）
-	float easeT_ = 0.0f;
+	/// 補間中のスケール（TweenScheduler が書き込む）
+	Vector3 scale_ = { 0.0f, 0.0f, 0.0f };
+	TweenScheduler::Handle scaleTween_ = TweenScheduler::kInvalidHandle;
 
 	/// 演出完了フラグ
 	bool isEnd_ = false;
@@ -36,9 +39,6 @@ private:
 	/// ゼロ→一へのLerp所要時間（秒）
 	static inline const float   kDuration_ = 1.5f;
 
-	/// 1フレームの経過時間（秒）。60fps 固定前提
-	static inline const float   kFrameDeltaTime_ = 1.0f / 60.0f;
-
 	/// スケール補間の開始値（ゼロスケール）
 	static inline const Vector3 kScaleStart_ = { 0.0f, 0.0f, 0.0f };
 
@@ -47,7 +47,7 @@ void DebugScene::Initialize() {
 
     // パーティクル
     emitter_ = std::make_unique<ParticleEmitter>();
-    emitter_->Initialize(particleName_, modelPath_);
+    emitter_->Initialize(particleName_, modelPath_, static_cast<PrimitiveType>(currentPrimitive_));
 
     // モーション プレビューリグ
     InitRig();
@@ -580,7 +580,7 @@ void DebugScene::DrawParticleUI() {
 
         if (ImGui::Button("Reset Emitter")) {
             emitter_ = std::make_unique<ParticleEmitter>();
-            emitter_->Initialize(particleName_, modelPath_);
+            emitter_->Initialize(particleName_, modelPath_, static_cast<PrimitiveType>(currentPrimitive_));
         }
 
         if (emitter_) {
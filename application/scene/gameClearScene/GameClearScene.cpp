@@ -52,7 +52,7 @@ void GameClearScene::Initialize()
 
 	// ===== 各エフェクト・演出の初期化 =====
 	stageWall_ = std::make_unique<ParticleEmitter>();
-	stageWall_->Initialize("stage", "debug/ringPlane.obj");
+	stageWall_->Initialize("stage", "debug/ringPlane.obj", Cylinder);
 
 	// ===== スプライト =====
 	gameClearTitle_ = std::make_unique<Sprite>();
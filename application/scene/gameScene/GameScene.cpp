@@ -58,7 +58,7 @@ void GameScene::Initialize()
 
 	// ===== 各エフェクト・演出の初期化 =====
 	stageWall_ = std::make_unique<ParticleEmitter>();
-	stageWall_->Initialize("stage", "debug/ringPlane.obj");
+	stageWall_->Initialize("stage", "debug/ringPlane.obj", Cylinder);
 
 	// ===== スプライト =====
 	UI_ = std::make_unique<Sprite>();
@@ -11,7 +11,7 @@ Camera::Camera()
 	, nearClip(0.1f)
 	, farClip(100.0f)
 	, worldMatrix(MakeAffineMatrix(transform.scale,transform.rotate,transform.translate))
-	, viewMatrix(Inverse(worldMatrix))
+	, viewMatrix(InverseAffine(worldMatrix))
 	, projectionMatrix(MakePerspectiveFovMatrix(fovY,aspectRatio,nearClip,farClip))
 	, viewProjectionMatrix(viewMatrix *projectionMatrix)
 {}
@@ -20,7 +20,7 @@ void Camera::Update()
 {
 	// --- world座標変換 ---
 	worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
-	viewMatrix = Inverse(worldMatrix);
+	viewMatrix = InverseAffine(worldMatrix);
 	projectionMatrix = MakePerspectiveFovMatrix(fovY, aspectRatio, nearClip, farClip);
 	viewProjectionMatrix = viewMatrix * projectionMatrix;
 }
@@ -41,7 +41,7 @@ void DebugCamera::Update()
 		Matrix4x4 translateMatrix = MakeTranslateMatrix(offset);
 		Matrix4x4 cameraMatrix = (scaleMatrix * rotateXYZMatrix) * translateMatrix;
 		viewProjection_->matWorld_ = cameraMatrix;
-		viewProjection_->matView_ = Inverse(cameraMatrix);
+		viewProjection_->matView_ = InverseAffine(cameraMatrix);
 		viewProjection_->matProjection_ = MakePerspectiveFovMatrix(0.45f,
 			float(WinApp::GetInstance()->kClientWidth) / float(WinApp::GetInstance()->kClientHeight),
 			0.1f, 100.0f);;
@@ -50,7 +50,7 @@ void ViewProjection::TransferMatrix()
 
 void ViewProjection::UpdateViewMatrix()
 {
-	matView_ = Inverse(MakeAffineMatrix({ 1.0f,1.0f,1.0f }, rotation_, translation_));
+	matView_ = InverseRigid(MakeAffineMatrix({ 1.0f,1.0f,1.0f }, rotation_, translation_));
 }
 
 void ViewProjection::UpdateProjectionMatrix()
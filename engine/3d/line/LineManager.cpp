@@ -10,7 +10,6 @@ void LineManager::Initialize(SrvManager* srvManager)
 {
 	particleCommon = ParticleCommon::GetInstance();
 	srvManager_ = srvManager;
-	randomEngine.seed(seedGenerator());
 }
 
 void LineManager::Update(const ViewProjection& viewProjection, const std::vector<Vector3>& startPoints, const std::vector<Vector3>& endPoints)
@@ -125,13 +125,9 @@ private:
 
 	std::unordered_map<std::string, LineGroup>lineGroups;
 
-	// Δtを定義
-	const float kDeltaTime = 1.0f / 60.0f;
+	// ラインは毎フレーム始点・終点から組み直すだけで時間では動かさないので、Δt・乱数は持たない
 	static const uint32_t kNumMaxInstance = 10000; // 最大インスタンス数の制限
 
-	std::random_device seedGenerator;
-	std::mt19937 randomEngine;
-
 private:
 	/// <summary>
 	/// .mtlファイルの読み取り
@@ -55,22 +55,15 @@ void Model::Draw() {
         const auto& meshResource = meshResources_[meshIndex];
         const auto& meshData = modelData.meshes[meshIndex];
 
-        if (!animator_ || !animator_->HaveAnimation()) {
-            // アニメーションなし - 通常の頂点バッファのみ使用
-            modelCommon_->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &meshResource.vertexBufferView);
-            modelCommon_->GetDxCommon()->GetCommandList()->IASetIndexBuffer(&meshResource.indexBufferView);
-            srvManager_->SetGraphicsRootDescriptorTable(2, meshData.material.textureIndex);
-            srvManager_->SetGraphicsRootDescriptorTable(6, environmentSrvIndex);
-        }
-        else if (!CheckBone()) {
-            // アニメーションあり - 通常の頂点バッファのみ使用
+        if (!skin_ || !CheckBone()) {
+            // スケルトンなし（ノードアニメーションを含む） - 通常の頂点バッファのみ使用
             modelCommon_->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &meshResource.vertexBufferView);
             modelCommon_->GetDxCommon()->GetCommandList()->IASetIndexBuffer(&meshResource.indexBufferView);
             srvManager_->SetGraphicsRootDescriptorTable(2, meshData.material.textureIndex);
             srvManager_->SetGraphicsRootDescriptorTable(6, environmentSrvIndex);
         }
         else {
-            // アニメーションあり - 頂点バッファ + スキニング用バッファ
+            // スケルトンあり（クリップがなくてもグラフで再生できる） - 頂点バッファ + スキニング用バッファ
             D3D12_VERTEX_BUFFER_VIEW vbvs[2] = {
                 meshResource.vertexBufferView,
                 skin_->GetSkinCluster().influenceBufferView };
@@ -244,7 +237,7 @@ ModelData Model::LoadModelFile(const std::string& directoryPath, const std::stri
                 { -translate.x, translate.y, translate.z });
 
             JointWeightData& jointWeightData = currentMesh.skinClusterData[jointName];
-            jointWeightData.inverseBindPoseMatrix = Inverse(bindPoseMatrix);
+            jointWeightData.inverseBindPoseMatrix = InverseAffine(bindPoseMatrix);
 
             for (uint32_t weightIndex = 0; weightIndex < bone->mNumWeights; ++weightIndex) {
                 jointWeightData.vertexWeights.push_back({ bone->mWeights[weightIndex].mWeight,
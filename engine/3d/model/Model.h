@@ -47,7 +47,7 @@ class Model {
 
     /// 各ステータス取得関数
     /// <returns></returns>
-    ModelData GetModelData() { return modelData; }
+    const ModelData& GetModelData() const { return modelData; }
     bool CheckBone() const { return hasBone_; }
 
     /// 各ステータス設定関数
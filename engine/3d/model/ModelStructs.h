@@ -1,5 +1,6 @@
 #pragma once
 #include <d3d12.h>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <span>
@@ -172,6 +173,13 @@ struct KeyframeQuaternion {
 	float time;
 };
 
+/// <summary>
+/// キーフレームの探索位置（チャンネルごとに持ち、次の探索を前回の区間から始める）
+/// </summary>
+struct KeyframeCursor {
+	uint32_t index = 0; // 前回の区間の先頭のキー
+};
+
 /// <summary>
 /// ノードアニメーション
 /// </summary>
@@ -182,10 +190,45 @@ struct NodeAnimation {
 };
 
 /// <summary>
-/// アニメーション
+/// 48bit に詰めたクォータニオン（smallest-three）。
+/// 絶対値が最大の成分を省き、残り3成分を15bitずつ、省いた成分の番号を2bitで持つ
+/// </summary>
+struct QuantizedQuaternion {
+	std::array<uint16_t, 3> data;
+};
+
+/// <summary>
+/// 1チャンネル分のキーの範囲（Animation の各配列への添字）
+/// </summary>
+struct KeyRange {
+	uint32_t timeOffset = 0;  // times の先頭（同じジョイントで時刻が同じチャンネルは共有する）
+	uint32_t valueOffset = 0; // 値の配列の先頭
+	uint32_t count = 0;       // キー数（0ならアニメーションしない）
+};
+
+/// <summary>
+/// 1ジョイント分のチャンネル
+/// </summary>
+struct AnimationTrack {
+	KeyRange translate;
+	KeyRange rotate;
+	KeyRange scale;
+};
+
+/// <summary>
+/// アニメーション。
+/// 読み込み時に焼き込み、トラックはファイルのノードを深さ優先でたどった順（= Bone のジョイント番号）に並べる。
+/// 時刻と値は全チャンネル分を1本ずつの配列にまとめて持つ
 /// </summary>
 struct Animation {
-	float duration;
-	std::map<std::string, NodeAnimation>nodeAnimations;
+	std::string name;                          // クリップ名
+	float duration = 0.0f;
+	std::vector<std::string> trackNames;       // トラックごとのノード名
+	std::vector<AnimationTrack> tracks;
+	std::vector<float> times;
+	std::vector<Vector3> vectors;              // translate / scale の値
+	std::vector<Quaternion> rotates;           // rotate の値（量子化しないとき）
+	std::vector<QuantizedQuaternion> quantizedRotates; // rotate の値（量子化したとき）
+	bool isQuantized = false;
 };
 } // namespace Engine
@@ -38,33 +38,34 @@ void Object3d::Initialize(const std::string &filePath) {
 }
 
 void Object3d::Update(const WorldTransform &worldTransform, const ViewProjection &viewProjection) {
+    // ワールド行列は TransformHierarchy（または UpdateMatrix）で変わったときだけ求めてあるので、ここでは計算しない
+    Update(worldTransform.matWorld_, viewProjection);
+}
+
+void Object3d::Update(const Matrix4x4 &worldMatrix, const ViewProjection &viewProjection) {
     if (lightGroup) {
         lightGroup->Update(viewProjection);
     }
-    Matrix4x4 worldMatrix = MakeAffineMatrix(worldTransform.scale_, worldTransform.rotation_, worldTransform.translation_);
-
-    if (worldTransform.parent_) {
-        worldMatrix *= worldTransform.parent_->matWorld_;
-    }
     const Matrix4x4 &viewProjectionMatrix = viewProjection.matView_ * viewProjection.matProjection_;
     worldViewProjectionMatrix_ = worldMatrix * viewProjectionMatrix;
 
-    Matrix4x4 worldInverseMatrix = Inverse(worldMatrix);
+    // ワールド行列は親も含めてアフィン変換なので、3x3 と平行移動だけで求める
+    const Matrix4x4 worldInverseTransposeMatrix = InverseTransposeAffine(worldMatrix);
 
     if (modelAnimation_) {
         if (hasBone_) {
             transformationMatrixData->WVP = worldViewProjectionMatrix_;
-            transformationMatrixData->World = worldTransform.matWorld_;
-            transformationMatrixData->WorldInverseTranspose = Transpose(worldInverseMatrix);
+            transformationMatrixData->World = worldMatrix;
+            transformationMatrixData->WorldInverseTranspose = worldInverseTransposeMatrix;
         } else {
             transformationMatrixData->WVP = modelAnimation_->GetLocalMatrix() * worldViewProjectionMatrix_;
-            transformationMatrixData->World = modelAnimation_->GetLocalMatrix() * worldTransform.matWorld_;
-            transformationMatrixData->WorldInverseTranspose = Transpose(worldInverseMatrix);
+            transformationMatrixData->World = modelAnimation_->GetLocalMatrix() * worldMatrix;
+            transformationMatrixData->WorldInverseTranspose = worldInverseTransposeMatrix;
         }
     } else {
         transformationMatrixData->WVP = worldViewProjectionMatrix_;
-        transformationMatrixData->World = worldTransform.matWorld_;
-        transformationMatrixData->WorldInverseTranspose = Transpose(worldInverseMatrix);
+        transformationMatrixData->World = worldMatrix;
+        transformationMatrixData->WorldInverseTranspose = worldInverseTransposeMatrix;
     }
 }
 
@@ -92,14 +93,23 @@ void Object3d::SetAnimation(const std::string &fileName) {
 }
 
 void Object3d::Draw(const WorldTransform &worldTransform, const ViewProjection &viewProjection, ObjColor *color, bool Lighting) {
+    Update(worldTransform, viewProjection);
+    DrawModel(color, Lighting);
+}
+
+void Object3d::Draw(const Matrix4x4 &worldMatrix, const ViewProjection &viewProjection, ObjColor *color, bool Lighting) {
+    Update(worldMatrix, viewProjection);
+    DrawModel(color, Lighting);
+}
+
+void Object3d::DrawModel(ObjColor *color, bool Lighting) {
     if (color) {
         materialData->color = color->GetColor();
     }
     materialData->enableLighting = Lighting;
-    Update(worldTransform, viewProjection);
 
     // パイプライン切り替え
-    if (hasBone_ && modelAnimation_ && modelAnimation_->GetAnimator()->HaveAnimation()) {
+    if (hasBone_ && modelAnimation_) {
         // スキニング用パイプライン設定
         obj3dCommon->skinningDrawCommonSetting();
     } else {
@@ -62,6 +62,11 @@ public: // メンバ関数
 	/// </summary>
 	void Update(const WorldTransform& worldTransform, const ViewProjection& viewProjection);
 
+	/// <summary>
+	/// 更新処理（ワールド行列を直接渡す。一時的にずらして描くとき用）
+	/// </summary>
+	void Update(const Matrix4x4& worldMatrix, const ViewProjection& viewProjection);
+
 	/// <summary>
 	/// アニメーションの更新処理
 	/// </summary>
@@ -84,6 +89,11 @@ public: // メンバ関数
 	/// </summary>
 	void Draw(const WorldTransform& worldTransform, const ViewProjection& viewProjection, ObjColor* color = nullptr, bool Lighting = true);
 
+	/// <summary>
+	/// 描画処理（ワールド行列を直接渡す。一時的な WorldTransform を作らずにずらして描ける）
+	/// </summary>
+	void Draw(const Matrix4x4& worldMatrix, const ViewProjection& viewProjection, ObjColor* color = nullptr, bool Lighting = true);
+
 	/// <summary>
 	/// スケルトン描画処理
 	/// </summary>
@@ -96,6 +106,7 @@ public:
 	const Vector3& GetRotation() const { return rotation; }
 	const Vector3& GetSize() const { return size; }
 	Model* GetModel() { return model; }
+	ModelAnimation* GetModelAnimation() { return modelAnimation_.get(); }
 
 	/// 各ステータス設定関数
 	/// <returns></returns>
@@ -123,6 +134,11 @@ private: // メンバ関数
 	/// </summary>
 	void CreateMaterial();
 
+	/// <summary>
+	/// 描画コマンドの積み込み（Update の後に呼ぶ）
+	/// </summary>
+	void DrawModel(ObjColor* color, bool Lighting);
+
 	Vector3 ExtractTranslation(const Matrix4x4& matrix) { return Vector3(matrix.m[3][0], matrix.m[3][1], matrix.m[3][2]); }
 
 private:
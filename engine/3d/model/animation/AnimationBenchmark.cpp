@@ -0,0 +1,566 @@
+#include "AnimationBenchmark.h"
+#ifdef _DEBUG
+#include "AnimationGraph.h"
+#include "Animator.h"
+#include "Benchmark.h"
+#include "Bone.h"
+#include "myMath.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <assimp/Importer.hpp>
+
+#include "imgui.h"
+#include "EditorUI.h"
+
+namespace Engine {
+namespace {
+using Benchmark::Clock;
+using Benchmark::ElapsedMs;
+
+constexpr float kCheckQuantizeTolerance = 1.0e-3f; // RunChecks での量子化した回転の誤差の許容値（ラジアン）
+
+// 旧 Animator::CalculateValue と同じ処理（毎回先頭から線形に探す）
+template<class Keyframe, class Function>
+auto LinearValue(const std::vector<Keyframe>& keyframes, float time, Function interpolate) {
+	if (keyframes.size() == 1 || time <= keyframes[0].time) {
+		return keyframes[0].value;
+	}
+	for (size_t index = 0; index < keyframes.size() - 1; ++index) {
+		size_t nextIndex = index + 1;
+		if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
+			float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
+			return interpolate(keyframes[index].value, keyframes[nextIndex].value, t);
+		}
+	}
+	return (*keyframes.rbegin()).value;
+}
+
+Vector3 LerpValue(const Vector3& a, const Vector3& b, float t) { return Lerp(a, b, t); }
+Quaternion SlerpValue(const Quaternion& a, const Quaternion& b, float t) { return Slerp(a, b, t); }
+
+// 30fps で焼いたクリップ（ジョイントごとに translate / rotate / scale を持つ）
+std::vector<NodeAnimation> MakeClip(uint32_t jointCount, uint32_t keyCount, std::mt19937& engine) {
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::vector<NodeAnimation> clip(jointCount);
+	for (NodeAnimation& nodeAnimation : clip) {
+		nodeAnimation.translate.resize(keyCount);
+		nodeAnimation.rotate.resize(keyCount);
+		nodeAnimation.scale.resize(keyCount);
+		for (uint32_t key = 0; key < keyCount; ++key) {
+			const float time = static_cast<float>(key) / 30.0f;
+			nodeAnimation.translate[key] = { { unit(engine), unit(engine), unit(engine) }, time };
+			nodeAnimation.rotate[key] = { Quaternion(unit(engine), unit(engine), unit(engine), unit(engine)).Normalize(), time };
+			nodeAnimation.scale[key] = { { 1.0f + unit(engine) * 0.1f, 1.0f + unit(engine) * 0.1f, 1.0f + unit(engine) * 0.1f }, time };
+		}
+	}
+	return clip;
+}
+
+// ループ再生（Animator::Update と同じく fmod で戻す）
+void AdvanceTimes(std::vector<float>& times, const std::vector<float>& speeds, float duration, float deltaTime) {
+	for (size_t character = 0; character < times.size(); ++character) {
+		times[character] = duration > 0.0f ? std::fmod(times[character] + deltaTime * speeds[character], duration) : 0.0f;
+	}
+}
+
+std::string JointName(uint32_t joint) {
+	return "joint_" + std::to_string(joint);
+}
+
+// 文字列がヒープに置く分（短い文字列はオブジェクト内に収まる）
+size_t StringHeapBytes(const std::string& string) {
+	return string.capacity() > std::string().capacity() ? string.capacity() + 1 : 0;
+}
+
+template<class T>
+size_t VectorBytes(const std::vector<T>& vector) {
+	return vector.capacity() * sizeof(T);
+}
+
+// 焼き込んだクリップ（ジョイント名は JointName）
+Animation MakeBakedClip(uint32_t jointCount, uint32_t keyCount, std::mt19937& engine) {
+	const std::vector<NodeAnimation> clip = MakeClip(jointCount, std::max(keyCount, 1u), engine);
+	std::map<std::string, NodeAnimation> nodeAnimations;
+	std::vector<std::string> jointNames(jointCount);
+	for (uint32_t joint = 0; joint < jointCount; ++joint) {
+		jointNames[joint] = JointName(joint);
+		nodeAnimations[jointNames[joint]] = clip[joint];
+	}
+	return Animator::BakeAnimation(static_cast<float>(std::max(keyCount, 1u) - 1) / 30.0f, nodeAnimations, jointNames, false);
+}
+
+// ジョイントを一本の鎖にしたモデル
+ModelData MakeChainModel(uint32_t jointCount) {
+	ModelData modelData;
+	Node* node = &modelData.rootNode;
+	for (uint32_t joint = 0; joint < jointCount; ++joint) {
+		if (joint > 0) {
+			node->children.emplace_back();
+			node = &node->children.back();
+		}
+		node->name = JointName(joint);
+		node->transform = { { 1.0f, 1.0f, 1.0f }, Quaternion::IdentityQuaternion(), { 0.0f, 1.0f, 0.0f } };
+		node->localMatrix = MakeAffineMatrix(node->transform.scale, node->transform.rotate, node->transform.translate);
+	}
+	return modelData;
+}
+
+// CPU 側だけのスキンクラスター（パレットは配列に書き込む）
+SkinCluster MakeSkinCluster(uint32_t jointCount, std::vector<WellForGPU>& palette) {
+	SkinCluster skinCluster;
+	palette.resize(jointCount);
+	skinCluster.mappedPalette = { palette.data(), palette.size() };
+	skinCluster.inverseBindPoseMatrices.assign(jointCount, MakeIdentity4x4());
+	return skinCluster;
+}
+
+// 焼き込んだクリップのメモリ
+size_t AnimationBytes(const Animation& animation) {
+	size_t bytes = sizeof(Animation) + StringHeapBytes(animation.name) + VectorBytes(animation.trackNames) + VectorBytes(animation.tracks) +
+		VectorBytes(animation.times) + VectorBytes(animation.vectors) + VectorBytes(animation.rotates) + VectorBytes(animation.quantizedRotates);
+	for (const std::string& name : animation.trackNames) {
+		bytes += StringHeapBytes(name);
+	}
+	return bytes;
+}
+
+// map の1要素分（要素 + 赤黒木のポインタ3つと色）
+template<class Map>
+constexpr size_t kMapNodeBytes = sizeof(typename Map::value_type) + sizeof(void*) * 4;
+} // namespace
+
+AnimationBenchmark::SamplingResult AnimationBenchmark::RunSampling(uint32_t characterCount, uint32_t jointCount, uint32_t keyCount,
+	uint32_t frameCount, uint32_t seed) {
+	SamplingResult result;
+	result.characterCount = characterCount;
+	result.jointCount = jointCount;
+	result.keyCount = keyCount;
+	result.frameCount = frameCount;
+	result.sampleCount = characterCount * jointCount * 3;
+
+	std::mt19937 engine(seed);
+	const std::vector<NodeAnimation> clip = MakeClip(jointCount, std::max(keyCount, 1u), engine);
+	const float duration = static_cast<float>(std::max(keyCount, 1u) - 1) / 30.0f;
+
+	// キャラクターごとに再生位置と速さをずらす
+	std::uniform_real_distribution<float> phase(0.0f, 1.0f);
+	std::uniform_real_distribution<float> speed(0.8f, 1.2f);
+	std::vector<float> times(characterCount);
+	std::vector<float> speeds(characterCount);
+	for (uint32_t character = 0; character < characterCount; ++character) {
+		times[character] = phase(engine) * duration;
+		speeds[character] = speed(engine);
+	}
+
+	const size_t poseCount = static_cast<size_t>(characterCount) * jointCount;
+	std::vector<QuaternionTransform> linearPoses(poseCount);
+	std::vector<QuaternionTransform> binaryPoses(poseCount);
+	std::vector<QuaternionTransform> cursorPoses(poseCount);
+	std::vector<std::array<KeyframeCursor, 3>> cursors(poseCount);
+
+	double linearMs = 0.0;
+	double binaryMs = 0.0;
+	double cursorMs = 0.0;
+	result.isIdentical = true;
+	const float deltaTime = 1.0f / 60.0f;
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		AdvanceTimes(times, speeds, duration, deltaTime);
+
+		// --- 旧実装 ---
+		Clock::time_point start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			for (uint32_t joint = 0; joint < jointCount; ++joint) {
+				QuaternionTransform& pose = linearPoses[character * jointCount + joint];
+				pose.translate = LinearValue(clip[joint].translate, times[character], LerpValue);
+				pose.rotate = LinearValue(clip[joint].rotate, times[character], SlerpValue);
+				pose.scale = LinearValue(clip[joint].scale, times[character], LerpValue);
+			}
+		}
+		linearMs += ElapsedMs(start);
+
+		// --- 二分探索 ---
+		start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			for (uint32_t joint = 0; joint < jointCount; ++joint) {
+				QuaternionTransform& pose = binaryPoses[character * jointCount + joint];
+				pose.translate = Animator::CalculateValue(clip[joint].translate, times[character]);
+				pose.rotate = Animator::CalculateValue(clip[joint].rotate, times[character]);
+				pose.scale = Animator::CalculateValue(clip[joint].scale, times[character]);
+			}
+		}
+		binaryMs += ElapsedMs(start);
+
+		// --- 前回の区間から ---
+		start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			for (uint32_t joint = 0; joint < jointCount; ++joint) {
+				const size_t poseIndex = character * jointCount + joint;
+				QuaternionTransform& pose = cursorPoses[poseIndex];
+				pose.translate = Animator::CalculateValue(clip[joint].translate, times[character], cursors[poseIndex][0]);
+				pose.rotate = Animator::CalculateValue(clip[joint].rotate, times[character], cursors[poseIndex][1]);
+				pose.scale = Animator::CalculateValue(clip[joint].scale, times[character], cursors[poseIndex][2]);
+			}
+		}
+		cursorMs += ElapsedMs(start);
+
+		const size_t bytes = sizeof(QuaternionTransform) * poseCount;
+		if (std::memcmp(linearPoses.data(), binaryPoses.data(), bytes) != 0 || std::memcmp(linearPoses.data(), cursorPoses.data(), bytes) != 0) {
+			result.isIdentical = false;
+		}
+	}
+
+	const double frames = static_cast<double>(std::max(frameCount, 1u));
+	result.linearMs = linearMs / frames;
+	result.binarySearchMs = binaryMs / frames;
+	result.cursorMs = cursorMs / frames;
+	return result;
+}
+
+AnimationBenchmark::ClipResult AnimationBenchmark::RunClipFormat(uint32_t characterCount, uint32_t jointCount, uint32_t keyCount,
+	uint32_t frameCount, uint32_t seed) {
+	ClipResult result;
+	result.characterCount = characterCount;
+	result.jointCount = jointCount;
+	result.keyCount = keyCount;
+	result.frameCount = frameCount;
+
+	std::mt19937 engine(seed);
+	const std::vector<NodeAnimation> clip = MakeClip(jointCount, std::max(keyCount, 1u), engine);
+	const float duration = static_cast<float>(std::max(keyCount, 1u) - 1) / 30.0f;
+
+	// 元の形式（Animator::LoadAnimationFile が焼き込む前の形）
+	std::map<std::string, NodeAnimation> nodeAnimations;
+	std::vector<std::string> jointNames(jointCount);
+	for (uint32_t joint = 0; joint < jointCount; ++joint) {
+		jointNames[joint] = JointName(joint);
+		nodeAnimations[jointNames[joint]] = clip[joint];
+	}
+	const Animation baked = Animator::BakeAnimation(duration, nodeAnimations, jointNames, false);
+	const Animation quantized = Animator::BakeAnimation(duration, nodeAnimations, jointNames, true);
+
+	// --- メモリ ---
+	for (const auto& [name, nodeAnimation] : nodeAnimations) {
+		result.sourceBytes += kMapNodeBytes<std::map<std::string, NodeAnimation>> + StringHeapBytes(name);
+		result.sourceBytes += VectorBytes(nodeAnimation.translate) + VectorBytes(nodeAnimation.rotate) + VectorBytes(nodeAnimation.scale);
+	}
+	result.bakedBytes = AnimationBytes(baked);
+	result.quantizedBytes = AnimationBytes(quantized);
+
+	// --- 再生 ---
+	std::uniform_real_distribution<float> phase(0.0f, 1.0f);
+	std::uniform_real_distribution<float> speed(0.8f, 1.2f);
+	std::vector<float> times(characterCount);
+	std::vector<float> speeds(characterCount);
+	for (uint32_t character = 0; character < characterCount; ++character) {
+		times[character] = phase(engine) * duration;
+		speeds[character] = speed(engine);
+	}
+
+	const size_t poseCount = static_cast<size_t>(characterCount) * jointCount;
+	std::vector<QuaternionTransform> sourcePoses(poseCount);
+	std::vector<QuaternionTransform> bakedPoses(poseCount);
+	std::vector<QuaternionTransform> quantizedPoses(poseCount);
+	std::vector<std::array<KeyframeCursor, 3>> sourceCursors(poseCount);
+	std::vector<std::array<KeyframeCursor, 3>> bakedCursors(poseCount);
+	std::vector<std::array<KeyframeCursor, 3>> quantizedCursors(poseCount);
+
+	double sourceMs = 0.0;
+	double bakedMs = 0.0;
+	double quantizedMs = 0.0;
+	result.isIdentical = true;
+	const float deltaTime = 1.0f / 60.0f;
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		AdvanceTimes(times, speeds, duration, deltaTime);
+
+		// --- 元の形式 ---
+		Clock::time_point start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			for (uint32_t joint = 0; joint < jointCount; ++joint) {
+				const size_t poseIndex = character * jointCount + joint;
+				auto it = nodeAnimations.find(jointNames[joint]);
+				if (it == nodeAnimations.end()) { continue; }
+				QuaternionTransform& pose = sourcePoses[poseIndex];
+				pose.translate = Animator::CalculateValue((*it).second.translate, times[character], sourceCursors[poseIndex][0]);
+				pose.rotate = Animator::CalculateValue((*it).second.rotate, times[character], sourceCursors[poseIndex][1]);
+				pose.scale = Animator::CalculateValue((*it).second.scale, times[character], sourceCursors[poseIndex][2]);
+			}
+		}
+		sourceMs += ElapsedMs(start);
+
+		// --- 焼き込み ---
+		start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			for (uint32_t joint = 0; joint < jointCount; ++joint) {
+				const size_t poseIndex = character * jointCount + joint;
+				Animator::CalculateTransform(baked, joint, times[character], bakedCursors[poseIndex], bakedPoses[poseIndex]);
+			}
+		}
+		bakedMs += ElapsedMs(start);
+
+		// --- 焼き込み + 量子化 ---
+		start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			for (uint32_t joint = 0; joint < jointCount; ++joint) {
+				const size_t poseIndex = character * jointCount + joint;
+				Animator::CalculateTransform(quantized, joint, times[character], quantizedCursors[poseIndex], quantizedPoses[poseIndex]);
+			}
+		}
+		quantizedMs += ElapsedMs(start);
+
+		if (std::memcmp(sourcePoses.data(), bakedPoses.data(), sizeof(QuaternionTransform) * poseCount) != 0) {
+			result.isIdentical = false;
+		}
+		for (size_t poseIndex = 0; poseIndex < poseCount; ++poseIndex) {
+			const float dot = std::min(std::fabs(sourcePoses[poseIndex].rotate.Dot(quantizedPoses[poseIndex].rotate)), 1.0f);
+			result.maxQuantizeError = std::max(result.maxQuantizeError, 2.0f * std::acos(dot));
+		}
+	}
+
+	const double frames = static_cast<double>(std::max(frameCount, 1u));
+	result.sourceMs = sourceMs / frames;
+	result.bakedMs = bakedMs / frames;
+	result.quantizedMs = quantizedMs / frames;
+	return result;
+}
+
+AnimationBenchmark::BlendResult AnimationBenchmark::RunBlend(uint32_t characterCount, uint32_t jointCount, uint32_t keyCount,
+	uint32_t frameCount, uint32_t seed) {
+	BlendResult result;
+	result.characterCount = characterCount;
+	result.jointCount = jointCount;
+	result.frameCount = frameCount;
+
+	std::mt19937 engine(seed);
+	// グラフはクリップの参照を持つので共有で作る
+	const std::shared_ptr<const Animation> walk = std::make_shared<const Animation>(MakeBakedClip(jointCount, keyCount, engine));
+	const std::shared_ptr<const Animation> run = std::make_shared<const Animation>(MakeBakedClip(jointCount, keyCount, engine));
+	const std::shared_ptr<const Animation> breath = std::make_shared<const Animation>(MakeBakedClip(jointCount, keyCount, engine));
+	const ModelData modelData = MakeChainModel(jointCount);
+
+	// --- グラフで1クリップだけ再生したときに直接再生と一致するか ---
+	{
+		Bone direct;
+		Bone graphed;
+		direct.Initialize(modelData);
+		graphed.Initialize(modelData);
+		std::vector<WellForGPU> directPalette;
+		std::vector<WellForGPU> graphPalette;
+		SkinCluster directCluster = MakeSkinCluster(jointCount, directPalette);
+		SkinCluster graphCluster = MakeSkinCluster(jointCount, graphPalette);
+		AnimationGraph graph;
+		graph.Initialize(graphed.GetSkeleton());
+		graph.Play(0, walk);
+
+		result.isSingleIdentical = true;
+		const float deltaTime = 1.0f / 60.0f;
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			graph.Update(deltaTime);
+			graph.Evaluate();
+			graphed.Update(graph.GetPose(), graphCluster);
+			direct.Update(*walk, graph.GetClipTime(0, 0), directCluster);
+			if (std::memcmp(directPalette.data(), graphPalette.data(), sizeof(WellForGPU) * jointCount) != 0) {
+				result.isSingleIdentical = false;
+			}
+		}
+	}
+
+	// --- キャラクターごとのボーンとグラフ ---
+	std::vector<Bone> bones(characterCount);
+	std::vector<AnimationGraph> graphs(characterCount);
+	std::vector<std::vector<WellForGPU>> palettes(characterCount);
+	std::vector<SkinCluster> skinClusters(characterCount);
+	std::uniform_real_distribution<float> phase(0.0f, walk->duration);
+	std::vector<float> times(characterCount);
+	for (uint32_t character = 0; character < characterCount; ++character) {
+		bones[character].Initialize(modelData);
+		skinClusters[character] = MakeSkinCluster(jointCount, palettes[character]);
+		graphs[character].Initialize(bones[character].GetSkeleton());
+		graphs[character].SetLayer(1, AnimationGraph::BlendMode::kAdditive, 0.5f);
+		graphs[character].Play(1, breath);
+		times[character] = phase(engine);
+	}
+
+	double singleMs = 0.0;
+	double blendMs = 0.0;
+	const float deltaTime = 1.0f / 60.0f;
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		// --- 直接再生 ---
+		Clock::time_point start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			times[character] = walk->duration > 0.0f ? std::fmod(times[character] + deltaTime, walk->duration) : 0.0f;
+			bones[character].Update(*walk, times[character], skinClusters[character]);
+		}
+		singleMs += ElapsedMs(start);
+
+		// --- 歩き ⇔ 走りを0.25秒かけて切り替え続ける + 加算レイヤー ---
+		if (frame % 30 == 0) {
+			const std::shared_ptr<const Animation>& next = (frame / 30) % 2 == 0 ? run : walk;
+			for (AnimationGraph& graph : graphs) {
+				graph.Play(0, next, 0.25f);
+			}
+		}
+		start = Clock::now();
+		for (uint32_t character = 0; character < characterCount; ++character) {
+			graphs[character].Update(deltaTime);
+			graphs[character].Evaluate();
+			bones[character].Update(graphs[character].GetPose(), skinClusters[character]);
+		}
+		blendMs += ElapsedMs(start);
+	}
+
+	const double frames = static_cast<double>(std::max(frameCount, 1u));
+	result.singleMs = singleMs / frames;
+	result.blendMs = blendMs / frames;
+	return result;
+}
+
+AnimationBenchmark::LoadResult AnimationBenchmark::RunLoad(const std::string& directoryPath, const std::string& filename, uint32_t instanceCount) {
+	LoadResult result;
+	result.instanceCount = instanceCount;
+
+	// 最初の1回はどちらも同じなので先に済ませておく
+	const std::vector<std::shared_ptr<const Animation>>& animations = Animator::LoadAnimations(directoryPath, filename);
+	result.clipCount = static_cast<uint32_t>(animations.size());
+	if (animations.empty()) {
+		return result;
+	}
+
+	// --- 旧実装：インスタンスごとにファイルを読み直してからキャッシュを見て、最初のクリップをコピーする ---
+	const std::string filePath = directoryPath + "/" + filename;
+	std::vector<Animation> legacyAnimations;
+	legacyAnimations.reserve(instanceCount);
+	Clock::time_point start = Clock::now();
+	for (uint32_t instance = 0; instance < instanceCount; ++instance) {
+		Assimp::Importer importer;
+		importer.ReadFile(filePath.c_str(), 0);
+		legacyAnimations.push_back(*animations.front());
+	}
+	result.legacyMs = ElapsedMs(start);
+	result.legacyBytes = AnimationBytes(*animations.front()) * (static_cast<size_t>(instanceCount) + 1);
+
+	// --- 共有：キャッシュを先に見て参照だけ持つ ---
+	std::vector<Animator> animators(instanceCount);
+	start = Clock::now();
+	for (Animator& animator : animators) {
+		animator.Initialize(directoryPath, filename);
+	}
+	result.sharedMs = ElapsedMs(start);
+	for (const std::shared_ptr<const Animation>& animation : animations) {
+		result.sharedBytes += AnimationBytes(*animation);
+	}
+	result.sharedBytes += sizeof(std::shared_ptr<const Animation>) * instanceCount;
+	return result;
+}
+
+void AnimationBenchmark::RunChecks(const Benchmark::Check& check) {
+	const SamplingResult sampling = RunSampling(4, 16, 30, 120);
+	check("Animation: keyframe search matches linear search", sampling.isIdentical);
+
+	const ClipResult clip = RunClipFormat(4, 16, 30, 120);
+	check("Animation: baked clip matches source", clip.isIdentical);
+	check(std::format("Animation: quantized rotate error {:.2e}", clip.maxQuantizeError), clip.maxQuantizeError <= kCheckQuantizeTolerance);
+
+	const BlendResult blend = RunBlend(4, 16, 30, 120);
+	check("Animation: single-clip graph matches direct playback", blend.isSingleIdentical);
+}
+
+void AnimationBenchmark::DrawPanel() {
+	if (!EditorUI::GetInstance()->PanelVisible("アニメーション計測", "デバッグ")) { return; }
+	ImGui::Begin("アニメーション計測");
+
+	// 100体 × 60ジョイント × 3チャンネルを、クリップの長さを変えて比べる
+	static std::vector<SamplingResult> samplingResults;
+	if (ImGui::Button("Run Sampling Benchmark")) {
+		samplingResults.clear();
+		for (uint32_t keyCount : { 30u, 120u, 480u }) {
+			samplingResults.push_back(RunSampling(100, 60, keyCount, 120));
+		}
+	}
+
+	if (!samplingResults.empty() && ImGui::BeginTable("SamplingResults", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Keys");
+		ImGui::TableSetupColumn("Linear(ms)");
+		ImGui::TableSetupColumn("Binary(ms)");
+		ImGui::TableSetupColumn("Cursor(ms)");
+		ImGui::TableSetupColumn("Identical");
+		ImGui::TableHeadersRow();
+		for (const SamplingResult& result : samplingResults) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0); ImGui::Text("%u", result.keyCount);
+			ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f", result.linearMs);
+			ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f", result.binarySearchMs);
+			ImGui::TableSetColumnIndex(3); ImGui::Text("%.3f", result.cursorMs);
+			ImGui::TableSetColumnIndex(4); ImGui::TextUnformatted(result.isIdentical ? "Yes" : "No");
+		}
+		ImGui::EndTable();
+	}
+
+	// 元の形式・焼き込み・量子化をメモリと時間で比べる
+	static std::vector<ClipResult> clipResults;
+	if (ImGui::Button("Run Clip Format Benchmark")) {
+		clipResults.clear();
+		for (uint32_t keyCount : { 30u, 120u, 480u }) {
+			clipResults.push_back(RunClipFormat(100, 60, keyCount, 120));
+		}
+	}
+
+	if (!clipResults.empty() && ImGui::BeginTable("ClipResults", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Keys");
+		ImGui::TableSetupColumn("Source(KB)");
+		ImGui::TableSetupColumn("Baked(KB)");
+		ImGui::TableSetupColumn("Quantized(KB)");
+		ImGui::TableSetupColumn("Source(ms)");
+		ImGui::TableSetupColumn("Baked(ms)");
+		ImGui::TableSetupColumn("Quantized(ms)");
+		ImGui::TableSetupColumn("Max Error(rad)");
+		ImGui::TableSetupColumn("Identical");
+		ImGui::TableHeadersRow();
+		for (const ClipResult& result : clipResults) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0); ImGui::Text("%u", result.keyCount);
+			ImGui::TableSetColumnIndex(1); ImGui::Text("%.1f", result.sourceBytes / 1024.0);
+			ImGui::TableSetColumnIndex(2); ImGui::Text("%.1f", result.bakedBytes / 1024.0);
+			ImGui::TableSetColumnIndex(3); ImGui::Text("%.1f", result.quantizedBytes / 1024.0);
+			ImGui::TableSetColumnIndex(4); ImGui::Text("%.3f", result.sourceMs);
+			ImGui::TableSetColumnIndex(5); ImGui::Text("%.3f", result.bakedMs);
+			ImGui::TableSetColumnIndex(6); ImGui::Text("%.3f", result.quantizedMs);
+			ImGui::TableSetColumnIndex(7); ImGui::Text("%.6f", result.maxQuantizeError);
+			ImGui::TableSetColumnIndex(8); ImGui::TextUnformatted(result.isIdentical ? "Yes" : "No");
+		}
+		ImGui::EndTable();
+	}
+
+	// 直接再生とグラフでのブレンドを比べる
+	static std::optional<BlendResult> blendResult;
+	if (ImGui::Button("Run Blend Benchmark")) {
+		blendResult = RunBlend(100, 60, 120, 120);
+	}
+	if (blendResult) {
+		ImGui::Text("Single: %.3f ms  Blend: %.3f ms  Identical: %s",
+			blendResult->singleMs, blendResult->blendMs, blendResult->isSingleIdentical ? "Yes" : "No");
+	}
+
+	// 同じファイルのモデルを100個作るときの読み込み
+	static std::optional<LoadResult> loadResult;
+	if (ImGui::Button("Run Load Benchmark")) {
+		loadResult = RunLoad("resources/models", "walk.gltf", 100);
+	}
+	if (loadResult) {
+		ImGui::Text("Clips: %u  Legacy: %.3f ms / %.1f KB  Shared: %.3f ms / %.1f KB", loadResult->clipCount,
+			loadResult->legacyMs, loadResult->legacyBytes / 1024.0, loadResult->sharedMs, loadResult->sharedBytes / 1024.0);
+	}
+
+	ImGui::End();
+}
+} // namespace Engine
+#endif // _DEBUG
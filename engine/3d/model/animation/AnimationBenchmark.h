@@ -0,0 +1,121 @@
+#pragma once
+#include "Benchmark.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+/// <summary>
+/// アニメーションの計測（デバッグビルドのみ。描画・GPUに依存せず単体で実行できる）
+/// </summary>
+class AnimationBenchmark {
+public:
+	/// <summary>
+	/// キーフレーム探索の計測結果
+	/// </summary>
+	struct SamplingResult {
+		uint32_t characterCount = 0;
+		uint32_t jointCount = 0;
+		uint32_t keyCount = 0;        // チャンネルごとのキー数
+		uint32_t frameCount = 0;
+		uint32_t sampleCount = 0;     // 1フレームあたりのサンプル数（キャラクター × ジョイント × 3チャンネル）
+		double linearMs = 0.0;        // 旧実装（毎回先頭から線形に探す）の1フレームあたりの時間
+		double binarySearchMs = 0.0;  // 毎回二分探索
+		double cursorMs = 0.0;        // 前回の区間から探す（戻ったときは二分探索）
+		bool isIdentical = false;     // 3方式の結果が全フレームでビット単位で一致したか
+	};
+
+	/// <summary>
+	/// 速さと開始位置の違うキャラクターをループ再生し、全ジョイントの translate / rotate / scale を求める
+	/// </summary>
+	/// <param name="characterCount">キャラクター数</param>
+	/// <param name="jointCount">ジョイント数</param>
+	/// <param name="keyCount">チャンネルごとのキー数（30fps で焼いたものとして並べる）</param>
+	/// <param name="frameCount">進めるフレーム数</param>
+	/// <param name="seed">乱数シード</param>
+	static SamplingResult RunSampling(uint32_t characterCount, uint32_t jointCount, uint32_t keyCount, uint32_t frameCount, uint32_t seed = 0u);
+
+	/// <summary>
+	/// クリップ形式の計測結果
+	/// </summary>
+	struct ClipResult {
+		uint32_t characterCount = 0;
+		uint32_t jointCount = 0;
+		uint32_t keyCount = 0;
+		uint32_t frameCount = 0;
+		size_t sourceBytes = 0;        // ノード名の map + チャンネルごとの std::vector（ヒープ上の概算）
+		size_t bakedBytes = 0;         // 焼き込んだ形式
+		size_t quantizedBytes = 0;     // 焼き込み + rotate を48bitに量子化
+		double sourceMs = 0.0;         // ジョイントごとに名前で探して std::vector から求める（1フレームあたり）
+		double bakedMs = 0.0;
+		double quantizedMs = 0.0;
+		float maxQuantizeError = 0.0f; // 量子化した rotate の最大誤差（ラジアン）
+		bool isIdentical = false;      // 焼き込んだ形式（量子化なし）が全フレームでビット単位で一致したか
+	};
+
+	/// <summary>
+	/// 同じクリップを元の形式・焼き込んだ形式・量子化した形式で再生し、メモリと時間を比べる
+	/// </summary>
+	/// <param name="characterCount">キャラクター数</param>
+	/// <param name="jointCount">ジョイント数</param>
+	/// <param name="keyCount">チャンネルごとのキー数</param>
+	/// <param name="frameCount">進めるフレーム数</param>
+	/// <param name="seed">乱数シード</param>
+	static ClipResult RunClipFormat(uint32_t characterCount, uint32_t jointCount, uint32_t keyCount, uint32_t frameCount, uint32_t seed = 0u);
+
+	/// <summary>
+	/// ブレンドの計測結果
+	/// </summary>
+	struct BlendResult {
+		uint32_t characterCount = 0;
+		uint32_t jointCount = 0;
+		uint32_t frameCount = 0;
+		double singleMs = 0.0;           // 1クリップを Bone で直接再生（1フレームあたり、パレット書き込みまで）
+		double blendMs = 0.0;            // AnimationGraph で2クリップのクロスフェード + 加算レイヤー
+		bool isSingleIdentical = false;  // グラフで1クリップだけ再生したときのパレットが直接再生とビット単位で一致したか
+	};
+
+	/// <summary>
+	/// キャラクターごとに AnimationGraph でクロスフェードし続けながら加算レイヤーを重ね、パレットまで求める
+	/// </summary>
+	/// <param name="characterCount">キャラクター数</param>
+	/// <param name="jointCount">ジョイント数（一本の鎖として並べる）</param>
+	/// <param name="keyCount">チャンネルごとのキー数</param>
+	/// <param name="frameCount">進めるフレーム数</param>
+	/// <param name="seed">乱数シード</param>
+	static BlendResult RunBlend(uint32_t characterCount, uint32_t jointCount, uint32_t keyCount, uint32_t frameCount, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 読み込みの計測結果
+	/// </summary>
+	struct LoadResult {
+		uint32_t instanceCount = 0;
+		uint32_t clipCount = 0;        // ファイル内のクリップ数
+		double legacyMs = 0.0;         // 旧実装（インスタンスごとにファイルを読み直し、クリップをコピー）の合計
+		double sharedMs = 0.0;         // キャッシュを先に見て共有のクリップを参照する
+		size_t legacyBytes = 0;        // 旧実装のクリップのメモリ（キャッシュ + インスタンスごとのコピー）
+		size_t sharedBytes = 0;        // 全クリップ1つずつ + インスタンスごとの参照
+	};
+
+	/// <summary>
+	/// 同じファイルのモデルを instanceCount 個作るときのアニメーションの読み込み時間とメモリを比べる（最初の1回の読み込みは含めない）
+	/// </summary>
+	/// <param name="directoryPath">ディレクトリ</param>
+	/// <param name="filename">ファイル名</param>
+	/// <param name="instanceCount">インスタンス数</param>
+	static LoadResult RunLoad(const std::string& directoryPath, const std::string& filename, uint32_t instanceCount);
+
+	/// <summary>
+	/// 結果の一致・性質の確認を小さい規模で実行する（SelfCheck から呼ぶ）
+	/// </summary>
+	/// <param name="check">確認1件ごとに呼ぶ関数</param>
+	static void RunChecks(const Benchmark::Check& check);
+
+#ifdef _DEBUG
+	/// <summary>
+	/// 計測パネル
+	/// </summary>
+	static void DrawPanel();
+#endif // _DEBUG
+};
+} // namespace Engine
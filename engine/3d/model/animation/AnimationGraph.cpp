@@ -0,0 +1,324 @@
+#define NOMINMAX
+#include "AnimationGraph.h"
+#include "Animator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include <myMath.h>
+
+namespace Engine {
+namespace {
+// ハミルトン積 a * b（b を先に回してから a で回す）
+Quaternion Multiply(const Quaternion& a, const Quaternion& b) {
+	return Quaternion(
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+// 重みを target へ近づける速さ（fadeTime かけて届くようにする）
+float FadeSpeed(float weight, float targetWeight, float fadeTime) {
+	return std::fabs(targetWeight - weight) / fadeTime;
+}
+} // namespace
+
+void AnimationGraph::Initialize(const Skeleton& skeleton)
+{
+	// --- バッファ確保 ---
+	// 評価中に確保しないよう、全スロット分をここでまとめて確保する
+	skeleton_ = &skeleton;
+	jointCount_ = static_cast<uint32_t>(skeleton.joints.size());
+	bindPose_.resize(jointCount_);
+	for (const Joint& joint : skeleton.joints) {
+		bindPose_[joint.index] = joint.transform;
+	}
+	pose_ = bindPose_;
+	tracks_.assign(static_cast<size_t>(kMaxLayers) * kMaxClipsPerLayer * jointCount_, kNoTrack);
+	cursors_.assign(tracks_.size(), {});
+	layers_ = {};
+}
+
+void AnimationGraph::Update(float deltaTime)
+{
+	// --- 時間とフェードを進める ---
+	for (Layer& layer : layers_) {
+		for (ClipSlot& slot : layer.slots) {
+			if (!slot.animation) { continue; }
+
+			const float duration = slot.animation->duration;
+			slot.time += deltaTime * slot.speed;
+			if (slot.loop && duration > 0.0f) {
+				// ループ時は最初に戻る（逆再生なら最後へ）
+				slot.time = std::fmod(slot.time, duration);
+				if (slot.time < 0.0f) { slot.time += duration; }
+			} else {
+				slot.time = std::clamp(slot.time, 0.0f, std::max(duration, 0.0f));
+			}
+
+			if (slot.fadeSpeed > 0.0f) {
+				const float step = slot.fadeSpeed * deltaTime;
+				if (std::fabs(slot.targetWeight - slot.weight) <= step) {
+					slot.weight = slot.targetWeight;
+					slot.fadeSpeed = 0.0f;
+				} else {
+					slot.weight += slot.targetWeight > slot.weight ? step : -step;
+				}
+			}
+
+			// フェードアウトし終えたら空ける
+			if (slot.weight <= 0.0f && slot.targetWeight <= 0.0f) {
+				slot.animation = nullptr;
+			}
+		}
+	}
+}
+
+void AnimationGraph::Evaluate()
+{
+	// --- 基準姿勢から下のレイヤーを順に重ねる ---
+	std::copy(bindPose_.begin(), bindPose_.end(), pose_.begin());
+	for (uint32_t layer = 0; layer < kMaxLayers; ++layer) {
+		if (layers_[layer].weight <= 0.0f) { continue; }
+		if (layers_[layer].mode == BlendMode::kOverride) {
+			EvaluateOverride(layer);
+		} else {
+			EvaluateAdditive(layer);
+		}
+	}
+}
+
+void AnimationGraph::SetLayer(uint32_t layer, BlendMode mode, float weight)
+{
+	assert(layer < kMaxLayers);
+	layers_[layer].mode = mode;
+	layers_[layer].weight = weight;
+}
+
+uint32_t AnimationGraph::Play(uint32_t layer, std::shared_ptr<const Animation> animation, float fadeTime, bool loop, float speed)
+{
+	assert(layer < kMaxLayers && animation);
+	Layer& target = layers_[layer];
+
+	// 同じクリップが残っていれば、続きからフェードインし直す
+	uint32_t slotIndex = kMaxClipsPerLayer;
+	for (uint32_t index = 0; index < kMaxClipsPerLayer; ++index) {
+		if (target.slots[index].animation == animation) {
+			slotIndex = index;
+			target.slots[index].loop = loop;
+			target.slots[index].speed = speed;
+			break;
+		}
+	}
+	if (slotIndex == kMaxClipsPerLayer) {
+		slotIndex = AcquireSlot(layer, std::move(animation), loop, speed);
+	}
+
+	// --- クロスフェード ---
+	for (uint32_t index = 0; index < kMaxClipsPerLayer; ++index) {
+		ClipSlot& slot = target.slots[index];
+		if (!slot.animation) { continue; }
+		slot.targetWeight = index == slotIndex ? 1.0f : 0.0f;
+		if (fadeTime > 0.0f) {
+			slot.fadeSpeed = FadeSpeed(slot.weight, slot.targetWeight, fadeTime);
+		} else {
+			slot.weight = slot.targetWeight;
+			slot.fadeSpeed = 0.0f;
+			if (index != slotIndex) { slot.animation = nullptr; }
+		}
+	}
+	return slotIndex;
+}
+
+uint32_t AnimationGraph::AddClip(uint32_t layer, std::shared_ptr<const Animation> animation, float weight, bool loop, float speed)
+{
+	assert(layer < kMaxLayers && animation);
+	const uint32_t slotIndex = AcquireSlot(layer, std::move(animation), loop, speed);
+	ClipSlot& slot = layers_[layer].slots[slotIndex];
+	slot.weight = weight;
+	slot.targetWeight = weight;
+	slot.fadeSpeed = 0.0f;
+	return slotIndex;
+}
+
+void AnimationGraph::SetClipWeight(uint32_t layer, uint32_t slot, float weight, float fadeTime)
+{
+	assert(layer < kMaxLayers && slot < kMaxClipsPerLayer);
+	ClipSlot& target = layers_[layer].slots[slot];
+	target.targetWeight = weight;
+	if (fadeTime > 0.0f) {
+		target.fadeSpeed = FadeSpeed(target.weight, weight, fadeTime);
+	} else {
+		target.weight = weight;
+		target.fadeSpeed = 0.0f;
+	}
+}
+
+void AnimationGraph::Stop(uint32_t layer, float fadeTime)
+{
+	assert(layer < kMaxLayers);
+	for (ClipSlot& slot : layers_[layer].slots) {
+		if (!slot.animation) { continue; }
+		slot.targetWeight = 0.0f;
+		if (fadeTime > 0.0f) {
+			slot.fadeSpeed = FadeSpeed(slot.weight, 0.0f, fadeTime);
+		} else {
+			slot.weight = 0.0f;
+			slot.animation = nullptr;
+		}
+	}
+}
+
+bool AnimationGraph::IsActive() const
+{
+	for (const Layer& layer : layers_) {
+		for (const ClipSlot& slot : layer.slots) {
+			if (slot.animation) { return true; }
+		}
+	}
+	return false;
+}
+
+uint32_t AnimationGraph::AcquireSlot(uint32_t layer, std::shared_ptr<const Animation> clip, bool loop, float speed)
+{
+	assert(skeleton_);
+	Layer& target = layers_[layer];
+
+	// 空きがなければ一番重みの小さいスロットを使う
+	uint32_t slotIndex = 0;
+	for (uint32_t index = 0; index < kMaxClipsPerLayer; ++index) {
+		if (!target.slots[index].animation) {
+			slotIndex = index;
+			break;
+		}
+		if (target.slots[index].weight < target.slots[slotIndex].weight) {
+			slotIndex = index;
+		}
+	}
+
+	ClipSlot& slot = target.slots[slotIndex];
+	slot = {};
+	slot.animation = std::move(clip);
+	const Animation& animation = *slot.animation;
+	slot.loop = loop;
+	slot.speed = speed;
+	slot.time = speed < 0.0f ? animation.duration : 0.0f;
+
+	// --- トラックの結びつけ（名前で探すのはここだけ） ---
+	const size_t offset = SlotOffset(layer, slotIndex);
+	for (const Joint& joint : skeleton_->joints) {
+		const size_t index = static_cast<size_t>(joint.index);
+		uint32_t track = kNoTrack;
+		if (index < animation.trackNames.size() && animation.trackNames[index] == joint.name) {
+			track = joint.index;
+		} else if (std::optional<uint32_t> found = Animator::FindTrack(animation, joint.name)) {
+			track = *found;
+		}
+		tracks_[offset + index] = track;
+		cursors_[offset + index] = {};
+	}
+	return slotIndex;
+}
+
+void AnimationGraph::EvaluateOverride(uint32_t layer)
+{
+	const Layer& target = layers_[layer];
+	std::array<uint32_t, kMaxClipsPerLayer> activeSlots;
+	uint32_t activeCount = 0;
+	for (uint32_t index = 0; index < kMaxClipsPerLayer; ++index) {
+		if (target.slots[index].animation && target.slots[index].weight > 0.0f) {
+			activeSlots[activeCount++] = index;
+		}
+	}
+	if (activeCount == 0) { return; }
+
+	for (uint32_t joint = 0; joint < jointCount_; ++joint) {
+		// --- レイヤー内のクリップを重みで混ぜる ---
+		QuaternionTransform first;
+		Vector3 scale = { 0.0f, 0.0f, 0.0f };
+		Quaternion rotate = { 0.0f, 0.0f, 0.0f, 0.0f };
+		Vector3 translate = { 0.0f, 0.0f, 0.0f };
+		float totalWeight = 0.0f;
+		uint32_t count = 0;
+		for (uint32_t active = 0; active < activeCount; ++active) {
+			const uint32_t slotIndex = activeSlots[active];
+			const size_t index = SlotOffset(layer, slotIndex) + joint;
+			if (tracks_[index] == kNoTrack) { continue; }
+
+			// キーのないチャンネルは下の姿勢のまま
+			const ClipSlot& slot = target.slots[slotIndex];
+			QuaternionTransform sample = pose_[joint];
+			Animator::CalculateTransform(*slot.animation, tracks_[index], slot.time, cursors_[index], sample);
+
+			if (count == 0) {
+				first = sample;
+			} else if (first.rotate.Dot(sample.rotate) < 0.0f) {
+				// 最初のクリップと同じ向きの半球にそろえる
+				sample.rotate = sample.rotate * -1.0f;
+			}
+			scale += sample.scale * slot.weight;
+			rotate = rotate + sample.rotate * slot.weight;
+			translate += sample.translate * slot.weight;
+			totalWeight += slot.weight;
+			++count;
+		}
+		if (count == 0) { continue; }
+
+		// 1本だけならサンプルした値をそのまま使う
+		QuaternionTransform blended = first;
+		if (count > 1) {
+			blended.scale = scale / totalWeight;
+			blended.rotate = rotate.Normalize();
+			blended.translate = translate / totalWeight;
+		}
+
+		// --- 下の姿勢に重ねる（フェードイン中は重みの合計が1に満たない） ---
+		const float alpha = target.weight * std::min(totalWeight, 1.0f);
+		QuaternionTransform& pose = pose_[joint];
+		if (alpha >= 1.0f) {
+			pose = blended;
+		} else {
+			pose.scale = Lerp(pose.scale, blended.scale, alpha);
+			pose.rotate = Slerp(pose.rotate, blended.rotate, alpha);
+			pose.translate = Lerp(pose.translate, blended.translate, alpha);
+		}
+	}
+}
+
+void AnimationGraph::EvaluateAdditive(uint32_t layer)
+{
+	const Layer& target = layers_[layer];
+	const QuaternionTransform identity = { { 1.0f, 1.0f, 1.0f }, Quaternion::IdentityQuaternion(), { 0.0f, 0.0f, 0.0f } };
+	for (uint32_t slotIndex = 0; slotIndex < kMaxClipsPerLayer; ++slotIndex) {
+		const ClipSlot& slot = target.slots[slotIndex];
+		const float weight = slot.weight * target.weight;
+		if (!slot.animation || weight <= 0.0f) { continue; }
+
+		const size_t offset = SlotOffset(layer, slotIndex);
+		for (uint32_t joint = 0; joint < jointCount_; ++joint) {
+			const uint32_t track = tracks_[offset + joint];
+			if (track == kNoTrack) { continue; }
+
+			// 先頭キーを基準にした差分（先頭より前の時刻なら探索せずに先頭キーが返る）
+			std::array<KeyframeCursor, 3> referenceCursors = {};
+			QuaternionTransform reference = identity;
+			Animator::CalculateTransform(*slot.animation, track, std::numeric_limits<float>::lowest(), referenceCursors, reference);
+			QuaternionTransform sample = identity;
+			Animator::CalculateTransform(*slot.animation, track, slot.time, cursors_[offset + joint], sample);
+
+			QuaternionTransform& pose = pose_[joint];
+			const Quaternion delta = Multiply(reference.rotate.Conjugate(), sample.rotate);
+			pose.rotate = Multiply(pose.rotate, Slerp(Quaternion::IdentityQuaternion(), delta, weight)).Normalize();
+			pose.translate += (sample.translate - reference.translate) * weight;
+			const Vector3 scaleDelta = {
+				reference.scale.x != 0.0f ? sample.scale.x / reference.scale.x : 1.0f,
+				reference.scale.y != 0.0f ? sample.scale.y / reference.scale.y : 1.0f,
+				reference.scale.z != 0.0f ? sample.scale.z / reference.scale.z : 1.0f };
+			pose.scale *= Lerp(Vector3{ 1.0f, 1.0f, 1.0f }, scaleDelta, weight);
+		}
+	}
+}
+} // namespace Engine
@@ -0,0 +1,173 @@
+#pragma once
+#include "ModelStructs.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// アニメーショングラフクラス。
+/// レイヤーごとに複数のクリップを重み付きで混ぜ（クロスフェードもここで行う）、
+/// 上書きレイヤーと加算レイヤーを下から順に重ねて1つの姿勢バッファへ書き込む。
+/// 必要なバッファは Initialize でまとめて確保し、Update / Evaluate では確保しない
+/// </summary>
+namespace Engine {
+class AnimationGraph
+{
+public:
+
+	// レイヤー数とレイヤーごとに同時に再生できるクリップ数の上限
+	static constexpr uint32_t kMaxLayers = 4;
+	static constexpr uint32_t kMaxClipsPerLayer = 4;
+
+	/// <summary>
+	/// レイヤーの重ね方
+	/// </summary>
+	enum class BlendMode {
+		kOverride, // 下の姿勢をレイヤーの重みで置き換える
+		kAdditive, // クリップの先頭キーからの差分を下の姿勢に足す
+	};
+
+	/// <summary>
+	/// 初期化（ジョイント数分のバッファを確保し、ジョイントの今の姿勢を基準姿勢にする）
+	/// </summary>
+	/// <param name="skeleton"></param>
+	void Initialize(const Skeleton& skeleton);
+
+	/// <summary>
+	/// 時間とフェードを進める
+	/// </summary>
+	/// <param name="deltaTime"></param>
+	void Update(float deltaTime);
+
+	/// <summary>
+	/// 全レイヤーを重ねて姿勢を求める
+	/// </summary>
+	void Evaluate();
+
+public:
+
+	/// <summary>
+	/// レイヤーの設定
+	/// </summary>
+	/// <param name="layer">レイヤー番号（0が一番下）</param>
+	/// <param name="mode">重ね方</param>
+	/// <param name="weight">重み</param>
+	void SetLayer(uint32_t layer, BlendMode mode, float weight = 1.0f);
+
+	/// <summary>
+	/// クロスフェードで再生する（同じレイヤーの他のクリップは fadeTime かけて消える）
+	/// </summary>
+	/// <param name="layer">レイヤー番号</param>
+	/// <param name="animation">クリップ（再生中はグラフが参照を持つ）</param>
+	/// <param name="fadeTime">フェード時間（0なら即座に切り替える）</param>
+	/// <param name="loop">ループするか</param>
+	/// <param name="speed">再生速度</param>
+	/// <returns>スロット番号</returns>
+	uint32_t Play(uint32_t layer, std::shared_ptr<const Animation> animation, float fadeTime = 0.0f, bool loop = true, float speed = 1.0f);
+
+	/// <summary>
+	/// 他のクリップはそのままに、重みを指定してクリップを足す（N方向のブレンド用）
+	/// </summary>
+	/// <param name="layer">レイヤー番号</param>
+	/// <param name="animation">クリップ（再生中はグラフが参照を持つ）</param>
+	/// <param name="weight">重み（レイヤー内で正規化する）</param>
+	/// <param name="loop">ループするか</param>
+	/// <param name="speed">再生速度</param>
+	/// <returns>スロット番号</returns>
+	uint32_t AddClip(uint32_t layer, std::shared_ptr<const Animation> animation, float weight, bool loop = true, float speed = 1.0f);
+
+	/// <summary>
+	/// クリップの重みの設定
+	/// </summary>
+	/// <param name="layer">レイヤー番号</param>
+	/// <param name="slot">スロット番号</param>
+	/// <param name="weight">重み</param>
+	/// <param name="fadeTime">変化にかける時間（0なら即座に変える）</param>
+	void SetClipWeight(uint32_t layer, uint32_t slot, float weight, float fadeTime = 0.0f);
+
+	/// <summary>
+	/// レイヤーの全クリップを止める
+	/// </summary>
+	/// <param name="layer">レイヤー番号</param>
+	/// <param name="fadeTime">フェード時間（0なら即座に止める）</param>
+	void Stop(uint32_t layer, float fadeTime = 0.0f);
+
+	/// <summary>
+	/// 再生中のクリップがあるか
+	/// </summary>
+	bool IsActive() const;
+
+	/// 各ステータス取得関数
+	/// <returns></returns>
+	std::span<const QuaternionTransform> GetPose() const { return pose_; }
+	float GetClipTime(uint32_t layer, uint32_t slot) const { return layers_[layer].slots[slot].time; }
+
+	/// 各ステータス設定関数
+	/// <returns></returns>
+	void SetLayerWeight(uint32_t layer, float weight) { layers_[layer].weight = weight; }
+	void SetClipTime(uint32_t layer, uint32_t slot, float time) { layers_[layer].slots[slot].time = time; }
+	void SetClipSpeed(uint32_t layer, uint32_t slot, float speed) { layers_[layer].slots[slot].speed = speed; }
+
+private:
+
+	/// <summary>
+	/// 再生中のクリップ
+	/// </summary>
+	struct ClipSlot {
+		std::shared_ptr<const Animation> animation; // nullptr なら空き（再生中はクリップを手放さない）
+		float time = 0.0f;
+		float speed = 1.0f;
+		float weight = 0.0f;
+		float targetWeight = 0.0f;
+		float fadeSpeed = 0.0f;               // 1秒あたりの重みの変化量（0なら変えない）
+		bool loop = true;
+	};
+
+	/// <summary>
+	/// レイヤー
+	/// </summary>
+	struct Layer {
+		BlendMode mode = BlendMode::kOverride;
+		float weight = 1.0f;
+		std::array<ClipSlot, kMaxClipsPerLayer> slots;
+	};
+
+	/// <summary>
+	/// スロットを確保してクリップを結びつける（空きがなければ一番重みの小さいスロットを使う）
+	/// </summary>
+	uint32_t AcquireSlot(uint32_t layer, std::shared_ptr<const Animation> clip, bool loop, float speed);
+
+	/// <summary>
+	/// スロットのバッファ（トラック番号・探索位置）の先頭
+	/// </summary>
+	size_t SlotOffset(uint32_t layer, uint32_t slot) const { return (static_cast<size_t>(layer) * kMaxClipsPerLayer + slot) * jointCount_; }
+
+	/// <summary>
+	/// 上書きレイヤーを重ねる
+	/// </summary>
+	void EvaluateOverride(uint32_t layer);
+
+	/// <summary>
+	/// 加算レイヤーを重ねる
+	/// </summary>
+	void EvaluateAdditive(uint32_t layer);
+
+private:
+
+	static constexpr uint32_t kNoTrack = UINT32_MAX;
+
+	const Skeleton* skeleton_ = nullptr;
+	uint32_t jointCount_ = 0;
+	std::array<Layer, kMaxLayers> layers_;
+
+	std::vector<QuaternionTransform> bindPose_;
+	std::vector<QuaternionTransform> pose_;
+	// [レイヤー][スロット][ジョイント] のトラック番号と探索位置
+	std::vector<uint32_t> tracks_;
+	std::vector<std::array<KeyframeCursor, 3>> cursors_;
+};
+
+} // namespace Engine
@@ -1,5 +1,8 @@
 #include "Animator.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 
 #include <myMath.h>
 #include <Frame.h>
@@ -8,7 +11,147 @@
 #include <assimp/Importer.hpp>
 
 namespace Engine {
-std::unordered_map<std::string, Animation> Animator::animationCache;
+namespace {
+// 前回の区間から線形に進める数の上限（超えたら二分探索に切り替える）
+constexpr uint32_t kMaxCursorSteps = 4;
+// 量子化した成分の範囲（絶対値が最大でない成分は ±1/√2 に収まる）
+constexpr float kQuantizeRange = 0.70710678f;
+constexpr float kQuantizeScale = 32767.0f;
+
+// time <= timeAt(index + 1) となる最初の区間 index を二分探索で求める（全キーより後なら末尾のキー）。
+// timeAt(0) < time で、キーが2つ以上あること
+template<class TimeAt>
+size_t FindSegment(size_t count, float time, TimeAt timeAt) {
+	size_t first = 1;
+	size_t length = count - 1;
+	while (length > 0) {
+		const size_t half = length / 2;
+		if (timeAt(first + half) < time) {
+			first += half + 1;
+			length -= half + 1;
+		} else {
+			length = half;
+		}
+	}
+	return first - 1;
+}
+
+// 前回の区間から探す（再生が進むだけなら区間は変わらないか数個先にある）
+template<class TimeAt>
+size_t FindSegment(size_t count, float time, KeyframeCursor& cursor, TimeAt timeAt) {
+	const size_t last = count - 1;
+	size_t index = cursor.index;
+	if (index > last || (index > 0 && time <= timeAt(index))) {
+		// 戻った（ループ・シーク）か、別のクリップに替わった
+		index = FindSegment(count, time, timeAt);
+	}
+	else {
+		uint32_t steps = 0;
+		while (index < last && timeAt(index + 1) < time) {
+			if (++steps > kMaxCursorSteps) {
+				index = FindSegment(count, time, timeAt);
+				break;
+			}
+			++index;
+		}
+	}
+	cursor.index = static_cast<uint32_t>(index);
+	return index;
+}
+
+// 区間 [index, index + 1] で補間する（index が末尾なら末尾の値）
+template<class TimeAt, class ValueAt, class Function>
+auto InterpolateSegment(size_t count, float time, size_t index, TimeAt timeAt, ValueAt valueAt, Function interpolate) {
+	if (index + 1 >= count) {
+		return valueAt(count - 1);
+	}
+	float t = (time - timeAt(index)) / (timeAt(index + 1) - timeAt(index));
+	return interpolate(valueAt(index), valueAt(index + 1), t);
+}
+
+// std::vector<Keyframe> 用
+template<class Keyframe, class Function>
+auto SampleKeyframes(const std::vector<Keyframe>& keyframes, float time, KeyframeCursor* cursor, Function interpolate) {
+	assert(!keyframes.empty());
+	if (keyframes.size() == 1 || time <= keyframes[0].time) {
+		if (cursor) { cursor->index = 0; }
+		return keyframes[0].value;
+	}
+	auto timeAt = [&keyframes](size_t index) { return keyframes[index].time; };
+	auto valueAt = [&keyframes](size_t index) { return keyframes[index].value; };
+	const size_t index = cursor ? FindSegment(keyframes.size(), time, *cursor, timeAt) : FindSegment(keyframes.size(), time, timeAt);
+	return InterpolateSegment(keyframes.size(), time, index, timeAt, valueAt, interpolate);
+}
+
+// 焼き込んだチャンネル用
+template<class ValueAt, class Function>
+auto SampleRange(const Animation& animation, const KeyRange& range, float time, KeyframeCursor& cursor, ValueAt valueAt, Function interpolate) {
+	const float* times = animation.times.data() + range.timeOffset;
+	auto timeAt = [times](size_t index) { return times[index]; };
+	if (range.count == 1 || time <= times[0]) {
+		cursor.index = 0;
+		return valueAt(0);
+	}
+	const size_t index = FindSegment(range.count, time, cursor, timeAt);
+	return InterpolateSegment(range.count, time, index, timeAt, valueAt, interpolate);
+}
+
+Vector3 LerpValue(const Vector3& a, const Vector3& b, float t) { return Lerp(a, b, t); }
+Quaternion SlerpValue(const Quaternion& a, const Quaternion& b, float t) { return Slerp(a, b, t); }
+
+// アニメーションのないモデル用の空のクリップ
+const std::shared_ptr<const Animation>& EmptyAnimation() {
+	static const std::shared_ptr<const Animation> empty = std::make_shared<const Animation>();
+	return empty;
+}
+
+// ノードを深さ優先でたどった順に名前を並べる（Model::ReadNode → Bone::CreateJoint と同じ順）
+void CollectNodeNames(const aiNode* node, std::vector<std::string>& names) {
+	names.push_back(node->mName.C_Str());
+	for (uint32_t childIndex = 0; childIndex < node->mNumChildren; ++childIndex) {
+		CollectNodeNames(node->mChildren[childIndex], names);
+	}
+}
+
+// 1チャンネル分を焼き込む。全キーが同じ値なら1キーにまとめ、時刻が同じトラックの前のチャンネルと同じなら共有する
+template<class Keyframe, class Store>
+KeyRange BakeChannel(const std::vector<Keyframe>& keyframes, const std::vector<KeyRange>& sharedRanges, std::vector<float>& times, Store store) {
+	KeyRange range;
+	if (keyframes.empty()) {
+		return range;
+	}
+
+	const bool isConstant = std::all_of(keyframes.begin(), keyframes.end(),
+		[&keyframes](const Keyframe& keyframe) { return std::memcmp(&keyframe.value, &keyframes[0].value, sizeof(keyframe.value)) == 0; });
+	range.count = isConstant ? 1u : static_cast<uint32_t>(keyframes.size());
+
+	// 時刻
+	range.timeOffset = static_cast<uint32_t>(times.size());
+	for (const KeyRange& shared : sharedRanges) {
+		if (shared.count != range.count) { continue; }
+		bool isSame = true;
+		for (uint32_t key = 0; key < range.count; ++key) {
+			if (times[shared.timeOffset + key] != keyframes[key].time) { isSame = false; break; }
+		}
+		if (isSame) {
+			range.timeOffset = shared.timeOffset;
+			break;
+		}
+	}
+	if (range.timeOffset == times.size()) {
+		for (uint32_t key = 0; key < range.count; ++key) {
+			times.push_back(keyframes[key].time);
+		}
+	}
+
+	// 値
+	range.valueOffset = store(keyframes, range.count);
+	return range;
+}
+} // namespace
+
+std::unordered_map<std::string, std::vector<std::shared_ptr<const Animation>>> Animator::animationCache;
+bool Animator::isQuantizeRotation_ = false;
 
 void Animator::Initialize(const std::string& directorypath, const std::string& filename)
 {
@@ -20,6 +163,21 @@ void Animator::Initialize(const std::string& directorypath, const std::string& f
 
 	// --- ファイル読み込み ---
 	animation_ = LoadAnimationFile(directorypath_, filename_);
+	ResolveRootTrack();
+}
+
+void Animator::SetModelData(const ModelData& modelData)
+{
+	rootNodeName_ = modelData.rootNode.name;
+	rootNodeTransform_ = modelData.rootNode.transform;
+	ResolveRootTrack();
+}
+
+void Animator::ResolveRootTrack()
+{
+	// 名前の比較は毎フレームせず、ここで1回だけ行う
+	rootTrack_ = animation_ ? FindTrack(*animation_, rootNodeName_) : std::nullopt;
+	rootCursors_ = {};
 }
 
 void Animator::Update(bool loop)
@@ -29,15 +187,15 @@ void Animator::Update(bool loop)
 			// --- ループ時の処理 ---
 			// アニメーション時間を進め、超えたら最初に戻る
 			animationTime += Frame::DeltaTime();
-			animationTime = std::fmod(animationTime, animation_.duration);
+			animationTime = std::fmod(animationTime, animation_->duration);
 		} else {
 			// --- 非ループ時の処理 ---
 			// アニメーションが終了するまで進行
-			if (animationTime < animation_.duration) {
+			if (animationTime < animation_->duration) {
 				animationTime += Frame::DeltaTime();
 				// durationを超えたら停止
-				if (animationTime > animation_.duration) {
-					animationTime = animation_.duration;
+				if (animationTime > animation_->duration) {
+					animationTime = animation_->duration;
 					isAnimation_ = false;
 				}
 			}
@@ -52,122 +210,290 @@ void Animator::UpdateNodeAnimation(bool loop)
 			// --- ループ時の処理 ---
 			// アニメーション時間を進め、超えたら最初に戻る
 			animationTime += Frame::DeltaTime();
-			animationTime = std::fmod(animationTime, animation_.duration);
+			animationTime = std::fmod(animationTime, animation_->duration);
 		}
 		else {
 			// --- 非ループ時の処理 ---
 			// アニメーションが終了するまで進行
-			if (animationTime < animation_.duration) {
+			if (animationTime < animation_->duration) {
 				animationTime += Frame::DeltaTime();
 				// durationを超えたら停止
-				if (animationTime > animation_.duration) {
-					animationTime = animation_.duration;
+				if (animationTime > animation_->duration) {
+					animationTime = animation_->duration;
 					isAnimation_ = false;
 				}
 			}
 		}
 	}
-	NodeAnimation& rootNodeAnimation = animation_.nodeAnimations[model_.rootNode.name];
-	Vector3 translate = CalculateValue(rootNodeAnimation.translate, animationTime); // 指定時刻の値を取得。関数の詳細は次ページ
-	Quaternion rotate = CalculateValue(rootNodeAnimation.rotate, animationTime);
-	Vector3 scale = CalculateValue(rootNodeAnimation.scale, animationTime);
-	localMatrix_ = MakeAffineMatrix(scale, rotate, translate);
+	// ルートノードのトラックがなければノードの姿勢のまま
+	QuaternionTransform transform = rootNodeTransform_;
+	if (rootTrack_) {
+		CalculateTransform(*animation_, *rootTrack_, animationTime, rootCursors_, transform); // 指定時刻の値を取得
+	}
+	localMatrix_ = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
 }
 
-Animation Animator::LoadAnimationFile(const std::string& directoryPath, const std::string& filename)
+std::shared_ptr<const Animation> Animator::LoadAnimationFile(const std::string& directoryPath, const std::string& filename)
 {
-	// --- パスの生成・チェック ---
-	std::string filePath = directoryPath + "/" + filename;
-	Animation animation;
-	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(filePath.c_str(), 0);
-	if (!scene || scene->mNumAnimations == 0) {
+	// --- 読み込み（キャッシュ済みなら読み込まない） ---
+	const std::vector<std::shared_ptr<const Animation>>& animations = LoadAnimations(directoryPath, filename);
+	if (animations.empty()) {
 		// アニメーションなし
 		haveAnimation = false;
-		return animation;
+		return EmptyAnimation();
 	}
 
 	haveAnimation = true;
+	return animations.front();
+}
 
-	auto it = animationCache.find(filePath);
+const std::vector<std::shared_ptr<const Animation>>& Animator::LoadAnimations(const std::string& directoryPath, const std::string& filename)
+{
+	// --- パスの生成・キャッシュの確認 ---
+	std::string filePath = directoryPath + "/" + filename;
+	// 量子化するかどうかで焼き込み結果が変わるので、キーを分ける
+	const std::string cacheKey = isQuantizeRotation_ ? filePath + "#quantized" : filePath;
+	auto it = animationCache.find(cacheKey);
 	if (it != animationCache.end()) {
 		return it->second;  // すでに読み込み済みの場合パスから返す
 	}
 
-	aiAnimation* animationAssimp = scene->mAnimations[0];
-	animation.duration = float(animationAssimp->mDuration / animationAssimp->mTicksPerSecond);
+	// --- ファイル読み込み ---
+	std::vector<std::shared_ptr<const Animation>>& animations = animationCache[cacheKey];
+	Assimp::Importer importer;
+	const aiScene* scene = importer.ReadFile(filePath.c_str(), 0);
+	if (!scene || scene->mNumAnimations == 0) {
+		// アニメーションなし（空のまま覚えておき、次からは読み込まない）
+		return animations;
+	}
 
-	// --- ノードアニメーション読み込み ---
-	for (uint32_t channelIndex = 0; channelIndex < animationAssimp->mNumChannels; ++channelIndex) {
-		aiNodeAnim* nodeAnimationAssimp = animationAssimp->mChannels[channelIndex];
-		NodeAnimation& nodeAnimation = animation.nodeAnimations[nodeAnimationAssimp->mNodeName.C_Str()];
+	// トラックはジョイントと同じ順に並べ、再生中に名前で探さずに済むようにする（ファイル内の全クリップで共通）
+	std::vector<std::string> trackNames;
+	if (scene->mRootNode) {
+		CollectNodeNames(scene->mRootNode, trackNames);
+	}
 
-		// transrate
-		for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumPositionKeys; ++keyIndex) {
-			aiVectorKey& keyAssimp = nodeAnimationAssimp->mPositionKeys[keyIndex];
-			KeyframeVector3 keyframe;
-			keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
-			keyframe.value = { -keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
-			nodeAnimation.translate.push_back(keyframe);
+	animations.reserve(scene->mNumAnimations);
+	for (uint32_t animationIndex = 0; animationIndex < scene->mNumAnimations; ++animationIndex) {
+		aiAnimation* animationAssimp = scene->mAnimations[animationIndex];
+		float duration = float(animationAssimp->mDuration / animationAssimp->mTicksPerSecond);
+
+		// --- ノードアニメーション読み込み ---
+		std::map<std::string, NodeAnimation> nodeAnimations;
+		for (uint32_t channelIndex = 0; channelIndex < animationAssimp->mNumChannels; ++channelIndex) {
+			aiNodeAnim* nodeAnimationAssimp = animationAssimp->mChannels[channelIndex];
+			NodeAnimation& nodeAnimation = nodeAnimations[nodeAnimationAssimp->mNodeName.C_Str()];
+
+			// transrate
+			nodeAnimation.translate.reserve(nodeAnimationAssimp->mNumPositionKeys);
+			for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumPositionKeys; ++keyIndex) {
+				aiVectorKey& keyAssimp = nodeAnimationAssimp->mPositionKeys[keyIndex];
+				KeyframeVector3 keyframe;
+				keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
+				keyframe.value = { -keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
+				nodeAnimation.translate.push_back(keyframe);
+			}
+
+			// Rotate
+			nodeAnimation.rotate.reserve(nodeAnimationAssimp->mNumRotationKeys);
+			for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumRotationKeys; ++keyIndex) {
+				aiQuatKey& keyAssimp = nodeAnimationAssimp->mRotationKeys[keyIndex];
+				KeyframeQuaternion keyframe;
+				keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
+				keyframe.value = { keyAssimp.mValue.x, -keyAssimp.mValue.y, -keyAssimp.mValue.z, keyAssimp.mValue.w };
+				nodeAnimation.rotate.push_back(keyframe);
+			}
+
+			// Scale
+			nodeAnimation.scale.reserve(nodeAnimationAssimp->mNumScalingKeys);
+			for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumScalingKeys; ++keyIndex) {
+				aiVectorKey& keyAssimp = nodeAnimationAssimp->mScalingKeys[keyIndex];
+				KeyframeVector3 keyframe;
+				keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
+				keyframe.value = { keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
+				nodeAnimation.scale.push_back(keyframe);
+			}
 		}
 
-		// Rotate
-		for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumRotationKeys; ++keyIndex) {
-			aiQuatKey& keyAssimp = nodeAnimationAssimp->mRotationKeys[keyIndex];
-			KeyframeQuaternion keyframe;
-			keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
-			keyframe.value = { keyAssimp.mValue.x, -keyAssimp.mValue.y, -keyAssimp.mValue.z, keyAssimp.mValue.w };
-			nodeAnimation.rotate.push_back(keyframe);
+		// --- 焼き込み ---
+		Animation animation = BakeAnimation(duration, nodeAnimations, trackNames, isQuantizeRotation_);
+		animation.name = animationAssimp->mName.C_Str();
+		animations.push_back(std::make_shared<const Animation>(std::move(animation)));
+	}
+	return animations;
+}
+
+std::shared_ptr<const Animation> Animator::FindAnimation(const std::string& directoryPath, const std::string& filename, const std::string& clipName)
+{
+	const std::vector<std::shared_ptr<const Animation>>& animations = LoadAnimations(directoryPath, filename);
+	for (const std::shared_ptr<const Animation>& animation : animations) {
+		if (clipName.empty() || animation->name == clipName) {
+			return animation;
 		}
+	}
+	return nullptr;
+}
 
-		// Scale
-		for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumScalingKeys; ++keyIndex) {
-			aiVectorKey& keyAssimp = nodeAnimationAssimp->mScalingKeys[keyIndex];
-			KeyframeVector3 keyframe;
-			keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
-			keyframe.value = { keyAssimp.mValue.x, keyAssimp.mValue.y, keyAssimp.mValue.z };
-			nodeAnimation.scale.push_back(keyframe);
+Animation Animator::BakeAnimation(float duration, const std::map<std::string, NodeAnimation>& nodeAnimations,
+	const std::vector<std::string>& trackNames, bool isQuantize)
+{
+	Animation animation;
+	animation.duration = duration;
+	animation.isQuantized = isQuantize;
+	animation.trackNames = trackNames;
+	for (const auto& [name, nodeAnimation] : nodeAnimations) {
+		if (std::find(trackNames.begin(), trackNames.end(), name) == trackNames.end()) {
+			animation.trackNames.push_back(name);
 		}
 	}
 
-	// キャッシュに登録
-	animationCache[filePath] = animation;
+	auto storeVector3 = [&animation](const std::vector<KeyframeVector3>& keyframes, uint32_t count) {
+		const uint32_t offset = static_cast<uint32_t>(animation.vectors.size());
+		for (uint32_t key = 0; key < count; ++key) {
+			animation.vectors.push_back(keyframes[key].value);
+		}
+		return offset;
+	};
+	auto storeQuaternion = [&animation](const std::vector<KeyframeQuaternion>& keyframes, uint32_t count) {
+		const uint32_t offset = static_cast<uint32_t>(animation.isQuantized ? animation.quantizedRotates.size() : animation.rotates.size());
+		for (uint32_t key = 0; key < count; ++key) {
+			if (animation.isQuantized) {
+				animation.quantizedRotates.push_back(QuantizeQuaternion(keyframes[key].value));
+			} else {
+				animation.rotates.push_back(keyframes[key].value);
+			}
+		}
+		return offset;
+	};
+
+	animation.tracks.resize(animation.trackNames.size());
+	for (size_t trackIndex = 0; trackIndex < animation.trackNames.size(); ++trackIndex) {
+		auto it = nodeAnimations.find(animation.trackNames[trackIndex]);
+		if (it == nodeAnimations.end()) {
+			continue;
+		}
+		const NodeAnimation& nodeAnimation = (*it).second;
+		AnimationTrack& track = animation.tracks[trackIndex];
+		std::vector<KeyRange> sharedRanges;
+		track.translate = BakeChannel(nodeAnimation.translate, sharedRanges, animation.times, storeVector3);
+		sharedRanges.push_back(track.translate);
+		track.rotate = BakeChannel(nodeAnimation.rotate, sharedRanges, animation.times, storeQuaternion);
+		sharedRanges.push_back(track.rotate);
+		track.scale = BakeChannel(nodeAnimation.scale, sharedRanges, animation.times, storeVector3);
+	}
+
+	animation.times.shrink_to_fit();
+	animation.vectors.shrink_to_fit();
+	animation.rotates.shrink_to_fit();
+	animation.quantizedRotates.shrink_to_fit();
 	return animation;
 }
 
-Vector3 Animator::CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time)
+std::optional<uint32_t> Animator::FindTrack(const Animation& animation, const std::string& name)
 {
-	// --- Vector3 ---
-	assert(!keyframes.empty()); 
-	if (keyframes.size() == 1 || time <= keyframes[0].time) {
-		return keyframes[0].value;
+	// ルートは先頭にあることが多いので先に見る
+	if (!animation.trackNames.empty() && animation.trackNames[0] == name) {
+		return 0u;
 	}
+	auto it = std::find(animation.trackNames.begin(), animation.trackNames.end(), name);
+	if (it == animation.trackNames.end()) {
+		return std::nullopt;
+	}
+	return static_cast<uint32_t>(it - animation.trackNames.begin());
+}
 
-	for (size_t index = 0; index < keyframes.size() - 1; ++index) {
-		size_t nextIndex = index + 1;
-		if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-			float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-			return Lerp(keyframes[index].value, keyframes[nextIndex].value, t);
+void Animator::CalculateTransform(const Animation& animation, uint32_t track, float time,
+	std::array<KeyframeCursor, 3>& cursors, QuaternionTransform& transform)
+{
+	// --- 焼き込んだトラックから求める ---
+	assert(track < animation.tracks.size());
+	const AnimationTrack& animationTrack = animation.tracks[track];
+	if (animationTrack.translate.count > 0) {
+		const Vector3* values = animation.vectors.data() + animationTrack.translate.valueOffset;
+		transform.translate = SampleRange(animation, animationTrack.translate, time, cursors[0],
+			[values](size_t index) { return values[index]; }, LerpValue);
+	}
+	if (animationTrack.rotate.count > 0) {
+		if (animation.isQuantized) {
+			const QuantizedQuaternion* values = animation.quantizedRotates.data() + animationTrack.rotate.valueOffset;
+			transform.rotate = SampleRange(animation, animationTrack.rotate, time, cursors[1],
+				[values](size_t index) { return DequantizeQuaternion(values[index]); }, SlerpValue);
+		} else {
+			const Quaternion* values = animation.rotates.data() + animationTrack.rotate.valueOffset;
+			transform.rotate = SampleRange(animation, animationTrack.rotate, time, cursors[1],
+				[values](size_t index) { return values[index]; }, SlerpValue);
 		}
 	}
-	return (*keyframes.rbegin()).value;
+	if (animationTrack.scale.count > 0) {
+		const Vector3* values = animation.vectors.data() + animationTrack.scale.valueOffset;
+		transform.scale = SampleRange(animation, animationTrack.scale, time, cursors[2],
+			[values](size_t index) { return values[index]; }, LerpValue);
+	}
 }
 
-Quaternion Animator::CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time)
+QuantizedQuaternion Animator::QuantizeQuaternion(const Quaternion& quaternion)
 {
-	// --- Quaternion ---
-	assert(!keyframes.empty());
-	if (keyframes.size() == 1 || time <= keyframes[0].time) {
-		return keyframes[0].value;
+	// --- smallest-three ---
+	const float components[4] = { quaternion.x, quaternion.y, quaternion.z, quaternion.w };
+	uint32_t largest = 0;
+	for (uint32_t index = 1; index < 4; ++index) {
+		if (std::fabs(components[index]) > std::fabs(components[largest])) {
+			largest = index;
+		}
 	}
 
-	for (size_t index = 0; index < keyframes.size() - 1; ++index) {
-		size_t nextIndex = index + 1;
-		if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-			float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-			return Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
-		}
+	// q と -q は同じ回転なので、省く成分が正になる向きにそろえる
+	const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+	QuantizedQuaternion quantized;
+	uint32_t slot = 0;
+	for (uint32_t index = 0; index < 4; ++index) {
+		if (index == largest) { continue; }
+		const float normalized = std::clamp(components[index] * sign / kQuantizeRange, -1.0f, 1.0f);
+		const uint16_t value = static_cast<uint16_t>(std::lround((normalized * 0.5f + 0.5f) * kQuantizeScale));
+		// 上位1bitずつに省いた成分の番号を入れる
+		const uint16_t largestBit = static_cast<uint16_t>(slot < 2 ? ((largest >> slot) & 1u) << 15 : 0u);
+		quantized.data[slot++] = static_cast<uint16_t>(value | largestBit);
 	}
-	return (*keyframes.rbegin()).value;
+	return quantized;
+}
+
+Quaternion Animator::DequantizeQuaternion(const QuantizedQuaternion& quantized)
+{
+	const uint32_t largest = (quantized.data[0] >> 15) | ((quantized.data[1] >> 15) << 1);
+	float components[4];
+	float sumSquares = 0.0f;
+	uint32_t slot = 0;
+	for (uint32_t index = 0; index < 4; ++index) {
+		if (index == largest) { continue; }
+		const float value = static_cast<float>(quantized.data[slot++] & 0x7fff) / kQuantizeScale;
+		components[index] = (value * 2.0f - 1.0f) * kQuantizeRange;
+		sumSquares += components[index] * components[index];
+	}
+	components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+	return Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+Vector3 Animator::CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time)
+{
+	// --- Vector3 ---
+	return SampleKeyframes(keyframes, time, nullptr, LerpValue);
+}
+
+Quaternion Animator::CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time)
+{
+	// --- Quaternion ---
+	return SampleKeyframes(keyframes, time, nullptr, SlerpValue);
+}
+
+Vector3 Animator::CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time, KeyframeCursor& cursor)
+{
+	// --- Vector3 ---
+	return SampleKeyframes(keyframes, time, &cursor, LerpValue);
+}
+
+Quaternion Animator::CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time, KeyframeCursor& cursor)
+{
+	// --- Quaternion ---
+	return SampleKeyframes(keyframes, time, &cursor, SlerpValue);
 }
 } // namespace Engine
@@ -1,6 +1,9 @@
 #pragma once
 #include "ModelStructs.h"
 
+#include <array>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <map>
@@ -41,7 +44,8 @@ public:
 
 	/// 各ステータス取得関数
 	/// <returns></returns>
-	Animation GetAnimation() { return animation_; }
+	const Animation& GetAnimation() const { return *animation_; }
+	const std::shared_ptr<const Animation>& GetSharedAnimation() const { return animation_; }
 	float GetAnimationTime() { return animationTime; }
 	Matrix4x4 GetLocalMatrix() { return localMatrix_; }
 
@@ -49,20 +53,88 @@ public:
 	/// <returns></returns>
 	void SetAnimationTime(float time) { animationTime = time; }
 	void SetIsAnimation(bool isAnimation) { isAnimation_ = isAnimation; }
-	void SetModelData(ModelData modelData) { model_ = modelData; }
+	void SetModelData(const ModelData& modelData);
 	
 public:
 
 	/// <summary>
-	/// アニメーションファイル読み込み
+	/// アニメーションファイル読み込み（ファイルの最初のクリップを返す）
 	/// </summary>
 	/// <param name="directoryPath"></param>
 	/// <param name="filename"></param>
 	/// <returns></returns>
-	Animation LoadAnimationFile(const std::string& directoryPath, const std::string& filename);
+	std::shared_ptr<const Animation> LoadAnimationFile(const std::string& directoryPath, const std::string& filename);
 
 	/// <summary>
-	/// 値の計算(Vector3)
+	/// ファイル内の全クリップの読み込み。
+	/// 先にキャッシュを見て、なければ1回の読み込みで全クリップを焼き込む（クリップのないファイルも空として覚える）
+	/// </summary>
+	/// <param name="directoryPath"></param>
+	/// <param name="filename"></param>
+	/// <returns>ファイル内の順に並んだクリップ（全インスタンスで共有し、書き換えない）</returns>
+	static const std::vector<std::shared_ptr<const Animation>>& LoadAnimations(const std::string& directoryPath, const std::string& filename);
+
+	/// <summary>
+	/// ファイル内のクリップを名前で探す
+	/// </summary>
+	/// <param name="directoryPath"></param>
+	/// <param name="filename"></param>
+	/// <param name="clipName">クリップ名（空ならファイルの最初のクリップ）</param>
+	/// <returns>見つからなければ nullptr</returns>
+	static std::shared_ptr<const Animation> FindAnimation(const std::string& directoryPath, const std::string& filename, const std::string& clipName);
+
+	/// <summary>
+	/// 読み込んだチャンネルを焼き込む
+	/// </summary>
+	/// <param name="duration">長さ（秒）</param>
+	/// <param name="nodeAnimations">ノード名ごとのチャンネル</param>
+	/// <param name="trackNames">トラックの並び（ノードを深さ優先でたどった順）。含まれないチャンネルは末尾に足す</param>
+	/// <param name="isQuantize">rotate を48bitに量子化するか</param>
+	/// <returns></returns>
+	static Animation BakeAnimation(float duration, const std::map<std::string, NodeAnimation>& nodeAnimations,
+		const std::vector<std::string>& trackNames, bool isQuantize);
+
+	/// <summary>
+	/// ノード名からトラックを探す
+	/// </summary>
+	/// <param name="animation"></param>
+	/// <param name="name"></param>
+	/// <returns></returns>
+	static std::optional<uint32_t> FindTrack(const Animation& animation, const std::string& name);
+
+	/// <summary>
+	/// トラックの translate / rotate / scale を求める（キーのないチャンネルは transform のまま）
+	/// </summary>
+	/// <param name="animation"></param>
+	/// <param name="track">トラック番号</param>
+	/// <param name="time"></param>
+	/// <param name="cursors">translate / rotate / scale の探索位置（更新する）</param>
+	/// <param name="transform">書き込み先</param>
+	static void CalculateTransform(const Animation& animation, uint32_t track, float time,
+		std::array<KeyframeCursor, 3>& cursors, QuaternionTransform& transform);
+
+	/// <summary>
+	/// クォータニオンの量子化（smallest-three、48bit）
+	/// </summary>
+	/// <param name="quaternion">正規化済みのクォータニオン</param>
+	/// <returns></returns>
+	static QuantizedQuaternion QuantizeQuaternion(const Quaternion& quaternion);
+
+	/// <summary>
+	/// 量子化したクォータニオンを戻す
+	/// </summary>
+	/// <param name="quantized"></param>
+	/// <returns></returns>
+	static Quaternion DequantizeQuaternion(const QuantizedQuaternion& quantized);
+
+	/// <summary>
+	/// これから読み込むアニメーションの rotate を量子化するか（既定は量子化しない）
+	/// </summary>
+	/// <param name="isQuantize"></param>
+	static void SetQuantizeRotation(bool isQuantize) { isQuantizeRotation_ = isQuantize; }
+
+	/// <summary>
+	/// 値の計算(Vector3)。区間は二分探索で探す
 	/// </summary>
 	/// <param name="keyframes"></param>
 	/// <param name="time"></param>
@@ -70,29 +142,60 @@ public:
 	static Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time);
 
 	/// <summary>
-	/// 値の計算(Quaternion)
+	/// 値の計算(Quaternion)。区間は二分探索で探す
 	/// </summary>
 	/// <param name="keyframes"></param>
 	/// <param name="time"></param>
 	/// <returns></returns>
 	static Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time);
 
+	/// <summary>
+	/// 値の計算(Vector3)。前回の区間から先へ数個だけ線形に探し、戻った・飛んだときは二分探索する
+	/// </summary>
+	/// <param name="keyframes"></param>
+	/// <param name="time"></param>
+	/// <param name="cursor">このチャンネルの探索位置（更新する）</param>
+	/// <returns></returns>
+	static Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time, KeyframeCursor& cursor);
+
+	/// <summary>
+	/// 値の計算(Quaternion)。前回の区間から先へ数個だけ線形に探し、戻った・飛んだときは二分探索する
+	/// </summary>
+	/// <param name="keyframes"></param>
+	/// <param name="time"></param>
+	/// <param name="cursor">このチャンネルの探索位置（更新する）</param>
+	/// <returns></returns>
+	static Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time, KeyframeCursor& cursor);
+
+private:
+
+	/// <summary>
+	/// ルートノードのトラックを引き直す（アニメーション・ルートノードが変わったときだけ）
+	/// </summary>
+	void ResolveRootTrack();
+
 private:
 
 	std::string filename_;
 	std::string directorypath_;
 
-	ModelData model_;
+	// UpdateNodeAnimation で使うルートノード
+	std::string rootNodeName_;
+	QuaternionTransform rootNodeTransform_;
+	std::optional<uint32_t> rootTrack_; // animation_ の中のルートノードのトラック（なければノードの姿勢のまま）
 	bool haveAnimation = false;
 
-	Animation animation_;
+	std::shared_ptr<const Animation> animation_;
 	float animationTime = 0.0f;
 	bool isRoop_;
 	bool isAnimation_ = true;
 
-	static std::unordered_map<std::string, Animation> animationCache;
+	static std::unordered_map<std::string, std::vector<std::shared_ptr<const Animation>>> animationCache;
+	static bool isQuantizeRotation_;
 
 	Matrix4x4 localMatrix_;
+	// ルートノードの探索位置（translate / rotate / scale）
+	std::array<KeyframeCursor, 3> rootCursors_;
 };
 
 } // namespace Engine
@@ -4,29 +4,26 @@
 
 #include <myMath.h>
 
+#include <cassert>
+
 namespace Engine {
-void Bone::Initialize(ModelData modelData)
+void Bone::Initialize(const ModelData& modelData)
 {
 	// --- ボーン生成 ---
 	skeleton_ = CreateSkeleton(modelData.rootNode);
 }
 
-void Bone::Update(const Animation& animation, float animationTime)
+void Bone::Update(const Animation& animation, float animationTime, SkinCluster& skinCluster)
 {
-	// --- ジョイント更新 ---
-	for (Joint& joint : skeleton_.joints) {
-		joint.localMatrix = MakeAffineMatrix(joint.transform.scale, joint.transform.rotate, joint.transform.translate);
-		
-		if (joint.parent) {
-			// 親がいるとき
-			joint.skeletonSpaceMatrix = joint.localMatrix * skeleton_.joints[*joint.parent].skeletonSpaceMatrix;
-		} else {
-			// 親がいないとき
-			joint.skeletonSpaceMatrix = joint.localMatrix;
-		}
-	}
+	// --- アニメーションの適応とジョイント更新 ---
+	ApplyAnimation(animation, animationTime, skinCluster);
+}
 
-	ApplyAnimation(animation, animationTime);
+void Bone::Update(std::span<const QuaternionTransform> pose, SkinCluster& skinCluster)
+{
+	// --- 求めた姿勢の適応とジョイント更新 ---
+	assert(pose.size() >= skeleton_.joints.size());
+	ApplyPose(skinCluster, [pose](Joint& joint) { joint.transform = pose[joint.index]; });
 }
 
 int32_t Bone::CreateJoint(const Node& node, const std::optional<int32_t>& parent, std::vector<Joint>& joints)
@@ -60,16 +57,67 @@ Skeleton Bone::CreateSkeleton(const Node& rootNode)
 	return skeleton;
 }
 
-void Bone::ApplyAnimation(const Animation& animation, float animationTime)
+void Bone::BindAnimation(const Animation& animation)
+{
+	// --- トラックの結びつけ ---
+	// 毎フレーム名前で探さないよう、ジョイントの並びでトラック番号を持っておく
+	if (boundAnimation_ == &animation && tracks_.size() == skeleton_.joints.size()) {
+		return;
+	}
+	boundAnimation_ = &animation;
+	tracks_.assign(skeleton_.joints.size(), kNoTrack);
+	cursors_.assign(skeleton_.joints.size(), {});
+	for (const Joint& joint : skeleton_.joints) {
+		const size_t index = static_cast<size_t>(joint.index);
+		if (index < animation.trackNames.size() && animation.trackNames[index] == joint.name) {
+			// 焼き込み時にジョイントと同じ順に並べているので、ほとんどはここで見つかる
+			tracks_[index] = joint.index;
+		} else if (std::optional<uint32_t> track = Animator::FindTrack(animation, joint.name)) {
+			tracks_[index] = *track;
+		}
+	}
+}
+
+void Bone::ApplyAnimation(const Animation& animation, float animationTime, SkinCluster& skinCluster)
 {
 	// --- アニメーションの適応 ---
+	BindAnimation(animation);
+	ApplyPose(skinCluster, [&](Joint& joint) {
+		// T / R / S を求める（再生が進むだけなら前回の区間から探す）
+		if (const uint32_t track = tracks_[joint.index]; track != kNoTrack) {
+			Animator::CalculateTransform(animation, track, animationTime, cursors_[joint.index], joint.transform);
+		}
+	});
+}
+
+template<class Sample>
+void Bone::ApplyPose(SkinCluster& skinCluster, Sample sample)
+{
+	assert(skinCluster.mappedPalette.size() >= skeleton_.joints.size());
+	assert(skinCluster.inverseBindPoseMatrices.size() >= skeleton_.joints.size());
+
+	// CreateJoint は親を子より先に積むので、先頭から1回なめるだけで親の行列は求まっている
 	for (Joint& joint : skeleton_.joints) {
-		if (auto it = animation.nodeAnimations.find(joint.name); it != animation.nodeAnimations.end()) {
-			const NodeAnimation& rootNodeAnimation = (*it).second;
-			joint.transform.translate = Animator::CalculateValue(rootNodeAnimation.translate, animationTime);
-			joint.transform.rotate = Animator::CalculateValue(rootNodeAnimation.rotate, animationTime);
-			joint.transform.scale = Animator::CalculateValue(rootNodeAnimation.scale, animationTime);
+		assert(!joint.parent || *joint.parent < joint.index);
+
+		// 姿勢を求める
+		sample(joint);
+
+		// 親から子へ伝える
+		joint.localMatrix = MakeAffineMatrix(joint.transform.scale, joint.transform.rotate, joint.transform.translate);
+		if (joint.parent) {
+			// 親がいるとき
+			joint.skeletonSpaceMatrix = joint.localMatrix * skeleton_.joints[*joint.parent].skeletonSpaceMatrix;
+		} else {
+			// 親がいないとき
+			joint.skeletonSpaceMatrix = joint.localMatrix;
 		}
+
+		// パレットへ書き込む（Map したアップロード用のメモリは読み戻すと遅いので、書き込むだけにする）
+		const Matrix4x4 skinningMatrix = skinCluster.inverseBindPoseMatrices[joint.index] * joint.skeletonSpaceMatrix;
+		WellForGPU& well = skinCluster.mappedPalette[joint.index];
+		well.skeletonSpaceMatrix = skinningMatrix;
+		well.skeletonSpaceInverseTransposeMatrix = InverseTransposeAffine(skinningMatrix);
 	}
 }
 } // namespace Engine
@@ -12,18 +12,28 @@ public:
 	/// <summary>
 	/// 初期化
 	/// </summary>
-	void Initialize(ModelData modelData);
+	void Initialize(const ModelData& modelData);
 
 	/// <summary>
-	/// 更新処理
+	/// 更新処理。全ジョイントの姿勢を求め、スキンクラスターのパレットへ直接書き込む
 	/// </summary>
-	void Update(const Animation& animation, float animtaionTime);
+	/// <param name="animation">再生中のアニメーション</param>
+	/// <param name="animationTime">再生時間</param>
+	/// <param name="skinCluster">書き込み先のスキンクラスター</param>
+	void Update(const Animation& animation, float animationTime, SkinCluster& skinCluster);
+
+	/// <summary>
+	/// 更新処理。AnimationGraph などで求めたジョイントごとの姿勢から、パレットへ直接書き込む
+	/// </summary>
+	/// <param name="pose">ジョイント番号順の姿勢</param>
+	/// <param name="skinCluster">書き込み先のスキンクラスター</param>
+	void Update(std::span<const QuaternionTransform> pose, SkinCluster& skinCluster);
 
 public:
 
 	/// 各ステータス取得関数
 	/// <returns></returns>
-	Skeleton GetSkeleton() { return skeleton_; }
+	const Skeleton& GetSkeleton() const { return skeleton_; }
 	
 	/// 各ステータス設定関数
 	/// <returns></returns>
@@ -49,16 +59,36 @@ private:
 
 
 	/// <summary>
-	/// アニメーションの適応
+	/// ジョイントとアニメーションのトラックを名前で結びつける（アニメーションが変わったときだけ行う）
+	/// </summary>
+	/// <param name="animation"></param>
+	void BindAnimation(const Animation& animation);
+
+	/// <summary>
+	/// アニメーションの適応（T / R / S を求め、親から子へ行列を伝えてパレットへ書き込む）
 	/// </summary>
-	/// <param name="skeleton"></param>
 	/// <param name="animation"></param>
-	/// <param name="animtionTime"></param>
-	void ApplyAnimation(const Animation& animation, float animationTime);
+	/// <param name="animationTime"></param>
+	/// <param name="skinCluster"></param>
+	void ApplyAnimation(const Animation& animation, float animationTime, SkinCluster& skinCluster);
+
+	/// <summary>
+	/// 先頭から1回なめて、各ジョイントの姿勢を sample で求め、親から子へ行列を伝えてパレットへ書き込む
+	/// </summary>
+	/// <param name="skinCluster"></param>
+	/// <param name="sample">ジョイントの transform を書き換える関数</param>
+	template<class Sample>
+	void ApplyPose(SkinCluster& skinCluster, Sample sample);
 
 private:
 
 	Skeleton skeleton_;
+	// ジョイントごとのトラック番号（同じファイルのモデルならジョイント番号と同じ。トラックがなければ kNoTrack）
+	static constexpr uint32_t kNoTrack = UINT32_MAX;
+	std::vector<uint32_t> tracks_;
+	const Animation* boundAnimation_ = nullptr;
+	// ジョイントごとの探索位置（translate / rotate / scale）
+	std::vector<std::array<KeyframeCursor, 3>> cursors_;
 };
 
 } // namespace Engine
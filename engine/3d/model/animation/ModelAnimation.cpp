@@ -1,6 +1,19 @@
 #include "ModelAnimation.h"
 
+#include <Frame.h>
+
+#include <algorithm>
+#include <cassert>
+
 namespace Engine {
+namespace {
+// スキンのあるメッシュを持つか（Model::CheckBone と同じ判定）
+bool HasSkeleton(const ModelData& modelData) {
+	return std::any_of(modelData.meshes.begin(), modelData.meshes.end(),
+		[](const MeshData& mesh) { return !mesh.skinClusterData.empty(); });
+}
+} // namespace
+
 void ModelAnimation::Initialize(const std::string& directorypath, const std::string& filename)
 {
 	// --- その他引数の適応 ---
@@ -12,21 +25,33 @@ void ModelAnimation::Initialize(const std::string& directorypath, const std::str
 	bone_ = std::make_unique<Bone>();
 	skin_ = std::make_unique<Skin>();
 	animator_->Initialize(directorypath_, filename_);
-	animator_->SetModelData(modelData_);
-	if (animator_->HaveAnimation()) {	
-		// アニメーションがある時
-		bone_->Initialize(modelData_);
-		skin_->Initialize(bone_->GetSkeleton(), modelData_);
+	assert(modelData_);
+	animator_->SetModelData(*modelData_);
+	if (animator_->HaveAnimation() || HasSkeleton(*modelData_)) {
+		// アニメーションかスケルトンがある時（クリップのないモデルでも LoadClip したクリップをグラフで再生できる）
+		bone_->Initialize(*modelData_);
+		skin_->Initialize(bone_->GetSkeleton(), *modelData_);
+		graph_ = std::make_unique<AnimationGraph>();
+		graph_->Initialize(bone_->GetSkeleton());
+		// 再生するまでは基準姿勢で描画する
+		bone_->Update(graph_->GetPose(), skin_->GetSkinCluster());
 	}
 }
 
 void ModelAnimation::Update(bool loop)
 {
 	// --- アニメーションの更新処理　---
+	if (graph_ && graph_->IsActive()) {
+		// グラフで混ぜた姿勢を使う
+		graph_->Update(Frame::DeltaTime());
+		graph_->Evaluate();
+		bone_->Update(graph_->GetPose(), skin_->GetSkinCluster());
+		return;
+	}
 	if (animator_->HaveAnimation()) {
 		animator_->Update(loop);
-		bone_->Update(animator_->GetAnimation(), animator_->GetAnimationTime());
-		skin_->Update(bone_->GetSkeleton());
+		// 姿勢はボーンがパレットへ直接書き込む
+		bone_->Update(animator_->GetAnimation(), animator_->GetAnimationTime(), skin_->GetSkinCluster());
 	}
 }
 
@@ -38,4 +63,10 @@ void ModelAnimation::UpdateNodeAnimation(bool loop)
 		localMatrix_ = animator_->GetLocalMatrix();
 	}
 }
+
+std::shared_ptr<const Animation> ModelAnimation::LoadClip(const std::string& filename, const std::string& clipName)
+{
+	// --- 共有のキャッシュから取り出す（読み込み済みならファイルは読まない） ---
+	return Animator::FindAnimation(directorypath_, filename, clipName);
+}
 } // namespace Engine
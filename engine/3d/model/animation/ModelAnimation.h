@@ -1,10 +1,14 @@
 #pragma once
 #include <memory>
 
+#include "AnimationGraph.h"
 #include "Animator.h"
 #include "Bone.h"
 #include "Skin.h"
 
+#include <string>
+#include <vector>
+
 /// <summary>
 /// アニメーションモデルクラス
 /// </summary>
@@ -24,19 +28,30 @@ public:
 	void Update(bool loop);
 	void UpdateNodeAnimation(bool loop);
 
+	/// <summary>
+	/// 追加のクリップの読み込み（AnimationGraph で再生する。全インスタンスで共有する）
+	/// </summary>
+	/// <param name="filename">ファイル名（Initialize のディレクトリから）</param>
+	/// <param name="clipName">クリップ名（空ならファイルの最初のクリップ）</param>
+	/// <returns>見つからなければ nullptr</returns>
+	std::shared_ptr<const Animation> LoadClip(const std::string& filename, const std::string& clipName = "");
+
 public:
 
 	/// 各ステータス取得関数
 	/// <returns></returns>
-	Skeleton GetSkeletonData() { return bone_->GetSkeleton(); }
+	const Skeleton& GetSkeletonData() const { return bone_->GetSkeleton(); }
 	Animator* GetAnimator() { return animator_.get(); }
 	Bone* GetBone() { return bone_.get(); }
 	Skin* GetSkin() { return skin_.get(); }
+	// クリップを再生すると、Update ではモデルのアニメーションの代わりにグラフの姿勢を使う（スケルトンがなければ nullptr）
+	AnimationGraph* GetGraph() { return graph_.get(); }
 	Matrix4x4 GetLocalMatrix() { return localMatrix_; }
 
 	/// 各ステータス設定関数
 	/// <returns></returns>
-	void SetModelData(ModelData modelData) { modelData_ = modelData; }
+	// Initialize の間だけ参照する（コピーは持たない）
+	void SetModelData(const ModelData& modelData) { modelData_ = &modelData; }
 	void SetIsAnimation(bool anime) { animator_->SetIsAnimation(anime); }
 	void SetHaveBone(bool bone) { HaveBone_ = bone; }
 
@@ -45,11 +60,12 @@ private:
 	std::unique_ptr<Animator> animator_;
 	std::unique_ptr<Bone> bone_;
 	std::unique_ptr<Skin> skin_;
+	std::unique_ptr<AnimationGraph> graph_;
 
 	std::string directorypath_;
 	std::string filename_;
 
-	ModelData modelData_;
+	const ModelData* modelData_ = nullptr;
 	Matrix4x4 localMatrix_;
 
 	bool HaveBone_;
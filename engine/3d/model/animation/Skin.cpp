@@ -1,5 +1,4 @@
 #include "Skin.h"
-#include <cassert>
 #include <algorithm>
 
 #include "SrvManager.h"
@@ -14,18 +13,6 @@ void Skin::Initialize(const Skeleton& skeleton, const ModelData& modelData)
 	skinCluster_ = CreateSkinCluster(skeleton,modelData);
 }
 
-void Skin::Update(const Skeleton& skeleton)
-{
-	// --- 更新 ---
-	for (size_t jointIndex = 0; jointIndex < skeleton.joints.size(); ++jointIndex) {
-		assert(jointIndex < skinCluster_.inverseBindPoseMatrices.size());
-		skinCluster_.mappedPalette[jointIndex].skeletonSpaceMatrix =
-			skinCluster_.inverseBindPoseMatrices[jointIndex] * skeleton.joints[jointIndex].skeletonSpaceMatrix;
-		skinCluster_.mappedPalette[jointIndex].skeletonSpaceInverseTransposeMatrix =
-			Transpose(Inverse(skinCluster_.mappedPalette[jointIndex].skeletonSpaceMatrix));
-	}
-}
-
 SkinCluster Skin::CreateSkinCluster(const Skeleton& skeleton, const ModelData& modelData)
 {
 	SkinCluster skinCluster;
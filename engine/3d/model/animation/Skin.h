@@ -16,17 +16,12 @@ public:
 	/// </summary>
 	void Initialize(const Skeleton& skeleton, const ModelData& modelData);
 	
-	/// <summary>
-	/// 更新処理
-	/// </summary>
-	void Update(const Skeleton& skeleton);
-
 public:
 
 	/// 各ステータス取得関数
 	/// <returns></returns>
 	uint32_t GetSrvIndex() { return skinClusterSrvIndex_; }
-	SkinCluster GetSkinCluster() { return skinCluster_; }
+	SkinCluster& GetSkinCluster() { return skinCluster_; }
 
 private:
 
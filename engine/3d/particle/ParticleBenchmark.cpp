@@ -0,0 +1,643 @@
+#define NOMINMAX
+#include "ParticleBenchmark.h"
+#ifdef _DEBUG
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "ParticleCompaction.h"
+#include "ParticleStorage.h"
+#include "WorldTransform.h"
+#include "myMath.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <list>
+#include <numbers>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace Engine {
+namespace {
+using Benchmark::Clock;
+using Benchmark::ElapsedMs;
+
+constexpr float kCheckTolerance = 1.0e-3f; // RunChecks での旧実装との誤差の許容値（sin の近似分）
+
+// 旧実装のパーティクル（WorldTransform を丸ごと持つ）
+struct LegacyParticle {
+	WorldTransform transform;
+	Vector3 velocity;
+	Vector3 Acce;
+	Vector4 color;
+	float lifeTime;
+	float currentTime;
+	Vector3 startScale;
+	Vector3 endScale;
+	Vector3 startAcce;
+	Vector3 endAcce;
+	Vector3 startRote;
+	Vector3 endRote;
+	Vector3 rotateVelocity;
+	float initialAlpha;
+};
+
+// 旧 ParticleManager::Update と同じ処理
+uint32_t UpdateLegacy(std::list<LegacyParticle>& particles, uint32_t flags, float deltaTime,
+	const Matrix4x4& viewProjection, const Matrix4x4& billboard, ParticleForGPU* outInstances, uint32_t capacity) {
+	uint32_t numInstance = 0;
+	for (auto it = particles.begin(); it != particles.end();) {
+		if (it->lifeTime <= it->currentTime) {
+			it = particles.erase(it);
+			continue;
+		}
+		float t = std::clamp(it->currentTime / it->lifeTime, 0.0f, 1.0f);
+
+		if (flags & ParticleStorage::kSinMove) {
+			float waveScale = 0.5f * (std::sin(t * std::numbers::pi_v<float> * 18.0f) + 1.0f);
+			float maxScale = (1.0f - t);
+			it->transform.scale_ = it->startScale * waveScale * maxScale;
+		}
+		else {
+			it->transform.scale_ = (1.0f - t) * it->startScale + t * it->endScale;
+			it->color.w = it->initialAlpha - (it->currentTime / it->lifeTime);
+		}
+
+		it->Acce = (1.0f - t) * it->startAcce + t * it->endAcce;
+
+		if (flags & ParticleStorage::kRandomRotate) {
+			it->transform.rotation_ += it->rotateVelocity;
+		}
+		else {
+			it->transform.rotation_ = (1.0f - t) * it->startRote + t * it->endRote;
+		}
+
+		if (flags & ParticleStorage::kAcceMultiply) {
+			it->velocity *= it->Acce;
+		}
+		else {
+			it->velocity += it->Acce;
+		}
+
+		it->transform.translation_ += it->velocity * deltaTime;
+		it->currentTime += deltaTime;
+
+		Matrix4x4 worldMatrix{};
+		if (flags & ParticleStorage::kBillboard) {
+			worldMatrix = MakeScaleMatrix(it->transform.scale_) * billboard * MakeTranslateMatrix(it->transform.translation_);
+		}
+		else {
+			worldMatrix = MakeAffineMatrix(it->transform.scale_, it->transform.rotation_, it->transform.translation_);
+		}
+
+		if (numInstance < capacity) {
+			outInstances[numInstance].WVP = worldMatrix * viewProjection;
+			outInstances[numInstance].World = worldMatrix;
+			outInstances[numInstance].color = it->color;
+			++numInstance;
+		}
+		++it;
+	}
+	return numInstance;
+}
+
+// 旧 ParticleManager::MakeNewParticle と同じ処理（分布を毎回作り、回転行列も1個ごとに作る）
+LegacyParticle MakeLegacyParticle(std::mt19937& randomEngine, const EmitterParams& params) {
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> distVelocityX(params.velocityMin.x, params.velocityMax.x);
+	std::uniform_real_distribution<float> distVelocityY(params.velocityMin.y, params.velocityMax.y);
+	std::uniform_real_distribution<float> distVelocityZ(params.velocityMin.z, params.velocityMax.z);
+	std::uniform_real_distribution<float> distLifeTime(params.lifeTimeMin, params.lifeTimeMax);
+	std::uniform_real_distribution<float> distAlpha(params.alphaMin, params.alphaMax);
+
+	LegacyParticle particle{};
+	particle.transform.scale_ = params.startScale;
+	Vector3 randomTranslate = { distribution(randomEngine) * params.scale.x, distribution(randomEngine) * params.scale.y, distribution(randomEngine) * params.scale.z };
+	Matrix4x4 rotationMatrix = MakeRotateXYZMatrix(params.rotation);
+	particle.transform.translation_ = params.position + Vector3{
+		randomTranslate.x * rotationMatrix.m[0][0] + randomTranslate.y * rotationMatrix.m[1][0] + randomTranslate.z * rotationMatrix.m[2][0],
+		randomTranslate.x * rotationMatrix.m[0][1] + randomTranslate.y * rotationMatrix.m[1][1] + randomTranslate.z * rotationMatrix.m[2][1],
+		randomTranslate.x * rotationMatrix.m[0][2] + randomTranslate.y * rotationMatrix.m[1][2] + randomTranslate.z * rotationMatrix.m[2][2] };
+
+	if (params.flags & ParticleStorage::kAllRandomSize) {
+		std::uniform_real_distribution<float> distScaleX(params.allScaleMin.x, params.allScaleMax.x);
+		std::uniform_real_distribution<float> distScaleY(params.allScaleMin.y, params.allScaleMax.y);
+		std::uniform_real_distribution<float> distScaleZ(params.allScaleMin.z, params.allScaleMax.z);
+		particle.startScale = { distScaleX(randomEngine), distScaleY(randomEngine), distScaleZ(randomEngine) };
+	}
+	else if (params.flags & ParticleStorage::kRandomSize) {
+		std::uniform_real_distribution<float> distScale(params.scaleMin, params.scaleMax);
+		particle.startScale.x = distScale(randomEngine);
+		particle.startScale.y = particle.startScale.x;
+		particle.startScale.z = particle.startScale.x;
+	}
+	else {
+		particle.startScale = params.startScale;
+	}
+	particle.endScale = params.endScale;
+	particle.startAcce = params.startAcce;
+	particle.endAcce = params.endAcce;
+
+	Vector3 randomVelocity = { distVelocityX(randomEngine), distVelocityY(randomEngine), distVelocityZ(randomEngine) };
+	particle.velocity = {
+		randomVelocity.x * rotationMatrix.m[0][0] + randomVelocity.y * rotationMatrix.m[1][0] + randomVelocity.z * rotationMatrix.m[2][0],
+		randomVelocity.x * rotationMatrix.m[0][1] + randomVelocity.y * rotationMatrix.m[1][1] + randomVelocity.z * rotationMatrix.m[2][1],
+		randomVelocity.x * rotationMatrix.m[0][2] + randomVelocity.y * rotationMatrix.m[1][2] + randomVelocity.z * rotationMatrix.m[2][2] };
+
+	if (params.flags & ParticleStorage::kRandomRotate) {
+		std::uniform_real_distribution<float> distRotateXVelocity(params.rotateVelocityMin.x, params.rotateVelocityMax.x);
+		std::uniform_real_distribution<float> distRotateYVelocity(params.rotateVelocityMin.y, params.rotateVelocityMax.y);
+		std::uniform_real_distribution<float> distRotateZVelocity(params.rotateVelocityMin.z, params.rotateVelocityMax.z);
+		std::uniform_real_distribution<float> distRotate(0.0f, 2.0f);
+		particle.rotateVelocity = { distRotateXVelocity(randomEngine), distRotateYVelocity(randomEngine), distRotateZVelocity(randomEngine) };
+		particle.transform.rotation_ = { distRotate(randomEngine), distRotate(randomEngine), distRotate(randomEngine) };
+	}
+	else {
+		particle.startRote = params.startRote;
+		particle.endRote = params.endRote;
+	}
+
+	if (params.isRandomColor) {
+		std::uniform_real_distribution<float> distColor(0.0f, 1.0f);
+		particle.color = { distColor(randomEngine), distColor(randomEngine), distColor(randomEngine), distAlpha(randomEngine) };
+	}
+	else {
+		particle.color = { 1.0f, 1.0f, 1.0f, distAlpha(randomEngine) };
+	}
+	particle.initialAlpha = distAlpha(randomEngine);
+	particle.lifeTime = distLifeTime(randomEngine);
+	particle.currentTime = 0.0f;
+	return particle;
+}
+
+// 旧 ParticleManager::Emit と同じ処理（一時リストを作って繋ぎ、空になったリストを値で返す）
+std::list<LegacyParticle> EmitLegacy(std::list<LegacyParticle>& particles, std::mt19937& randomEngine, const EmitterParams& params, uint32_t count) {
+	std::list<LegacyParticle> newParticles;
+	for (uint32_t nowCount = 0; nowCount < count; ++nowCount) {
+		newParticles.push_back(MakeLegacyParticle(randomEngine, params));
+	}
+	particles.splice(particles.end(), newParticles);
+	return newParticles;
+}
+
+// 発生させる値（エミッタの既定値に近いもの）
+std::vector<ParticleStorage::Particle> MakeTemplates(uint32_t count, uint32_t seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> velocity(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::uniform_real_distribution<float> lifeTime(0.5f, 2.0f);
+
+	std::vector<ParticleStorage::Particle> templates(count);
+	for (ParticleStorage::Particle& particle : templates) {
+		particle.position = { position(engine), position(engine) * 0.1f, position(engine) };
+		particle.velocity = { velocity(engine), velocity(engine), velocity(engine) };
+		particle.rotation = { unit(engine) * 2.0f, unit(engine) * 2.0f, unit(engine) * 2.0f };
+		particle.rotateVelocity = { velocity(engine) * 0.07f, velocity(engine) * 0.07f, velocity(engine) * 0.07f };
+		particle.startScale = { 1.0f, 1.0f, 1.0f };
+		particle.endScale = { 0.0f, 0.0f, 0.0f };
+		particle.startRote = {};
+		particle.endRote = { 0.0f, 3.0f, 0.0f };
+		particle.startAcce = { 1.0f, 1.0f, 1.0f };
+		particle.endAcce = { 0.98f, 0.98f, 0.98f };
+		particle.color = { unit(engine), unit(engine), unit(engine), 1.0f };
+		particle.initialAlpha = 1.0f;
+		particle.lifeTime = lifeTime(engine);
+	}
+
+	return templates;
+}
+
+// 視点はステージを斜め上から見下ろす位置に置く
+Matrix4x4 MakeBenchmarkViewProjection(Matrix4x4& outBillboard) {
+	Matrix4x4 camera = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.5f, 0.3f, 0.0f }, { 0.0f, 20.0f, -40.0f });
+	outBillboard = camera;
+	outBillboard.m[3][0] = 0.0f;
+	outBillboard.m[3][1] = 0.0f;
+	outBillboard.m[3][2] = 0.0f;
+	return Inverse(camera) * MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 1000.0f);
+}
+
+// 固定ステップで発生・更新を繰り返す（ParticleEmitter → ParticleManager::FlushUpdates と同じ流れ）。
+// 消える順でフレームごとの並びが変わるので、stepCount ステップ進めた状態をパーティクルごとに並べ替えて返す
+std::vector<std::array<float, ParticleStorage::kFieldCount>> SimulateFixedStep(const std::vector<float>& frameTimes, uint32_t stepCount,
+	uint32_t flags, uint32_t seed) {
+	EmitterParams params;
+	params.position = { 0.0f, 5.0f, 0.0f };
+	params.scale = { 3.0f, 1.0f, 3.0f };
+	params.rotation = { 0.3f, 0.6f, 0.0f };
+	params.lifeTimeMin = 0.5f;
+	params.lifeTimeMax = 1.5f;
+	params.endScale = { 0.0f, 0.0f, 0.0f };
+	params.endAcce = { 0.98f, 0.98f, 0.98f };
+	params.flags = flags;
+	const float emitFrequency = 0.1f;
+	const uint32_t emitCount = 32;
+
+	Matrix4x4 billboard;
+	const Matrix4x4 viewProjection = MakeBenchmarkViewProjection(billboard);
+	FixedTimestep timestep;
+	ParticleStorage storage(flags);
+	Pcg32 random(seed);
+	std::vector<ParticleForGPU> instances;
+	float elapsedTime = 0.0f;
+
+	uint32_t steps = 0;
+	for (size_t frame = 0; steps < stepCount; ++frame) {
+		FixedTimestep::Step step = timestep.Advance(frameTimes[frame % frameTimes.size()]);
+		step.count = std::min(step.count, stepCount - steps);
+
+		// 発生はステップごとに判定し、途中のステップの分はそのステップから動かす
+		for (uint32_t i = 0; i < step.count; ++i) {
+			elapsedTime += step.deltaTime;
+			while (elapsedTime >= emitFrequency) {
+				params.delay = step.deltaTime * static_cast<float>(i);
+				storage.Emit(params, emitCount, random);
+				elapsedTime -= emitFrequency;
+			}
+		}
+
+		storage.RemoveDead();
+		instances.resize(storage.GetSize());
+		storage.UpdateRange(0, storage.GetSize(), step, viewProjection, billboard, instances.data(), storage.GetSize());
+		steps += step.count;
+	}
+	storage.RemoveDead();
+
+	std::vector<std::array<float, ParticleStorage::kFieldCount>> state(storage.GetSize());
+	for (uint32_t index = 0; index < storage.GetSize(); ++index) {
+		for (uint32_t field = 0; field < ParticleStorage::kFieldCount; ++field) {
+			state[index][field] = storage.GetField(static_cast<ParticleStorage::Field>(field))[index];
+		}
+	}
+	std::sort(state.begin(), state.end());
+	return state;
+}
+} // namespace
+
+ParticleBenchmark::UpdateResult ParticleBenchmark::RunUpdate(uint32_t particleCount, uint32_t frameCount, uint32_t flags, uint32_t seed) {
+	UpdateResult result;
+	result.particleCount = particleCount;
+	result.frameCount = frameCount;
+	result.flags = flags;
+
+	const float deltaTime = 1.0f / 60.0f;
+
+	// 発生させる値は先に作っておく（乱数の時間は計らない）
+	const std::vector<ParticleStorage::Particle> templates = MakeTemplates(particleCount * 2, seed);
+
+	Matrix4x4 billboard;
+	const Matrix4x4 viewProjection = MakeBenchmarkViewProjection(billboard);
+
+	std::vector<ParticleForGPU> legacyInstances(particleCount);
+	std::vector<ParticleForGPU> storageInstances(particleCount);
+	uint32_t legacyInstanceCount = 0;
+	uint32_t storageInstanceCount = 0;
+
+	// 毎フレーム消えた分を発生させて数を保つ（発生と消滅を含めた時間を計る）
+	{
+		std::list<LegacyParticle> legacy;
+		size_t next = 0;
+		Clock::time_point start = Clock::now();
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			while (legacy.size() < particleCount) {
+				const ParticleStorage::Particle& particle = templates[next];
+				next = (next + 1) % templates.size();
+
+				LegacyParticle old;
+				old.transform.translation_ = particle.position;
+				old.transform.rotation_ = particle.rotation;
+				old.velocity = particle.velocity;
+				old.Acce = {};
+				old.color = particle.color;
+				old.lifeTime = particle.lifeTime;
+				old.currentTime = 0.0f;
+				old.startScale = particle.startScale;
+				old.endScale = particle.endScale;
+				old.startAcce = particle.startAcce;
+				old.endAcce = particle.endAcce;
+				old.startRote = particle.startRote;
+				old.endRote = particle.endRote;
+				old.rotateVelocity = particle.rotateVelocity;
+				old.initialAlpha = particle.initialAlpha;
+				legacy.push_back(old);
+			}
+			legacyInstanceCount = UpdateLegacy(legacy, flags, deltaTime, viewProjection, billboard, legacyInstances.data(), particleCount);
+		}
+		result.legacyMs = ElapsedMs(start) / std::max(frameCount, 1u);
+	}
+
+	// SoA はスカラーとSIMDの両方を同じ条件で計る
+	auto runStorage = [&](ParticleStorage::SimdLevel level, std::vector<ParticleForGPU>& outInstances, uint32_t& outCount) {
+		ParticleStorage storage(flags);
+		size_t next = 0;
+		Clock::time_point start = Clock::now();
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			while (storage.GetSize() < particleCount) {
+				storage.Push(templates[next]);
+				next = (next + 1) % templates.size();
+			}
+			outCount = storage.Update(FixedTimestep::Step{ deltaTime }, viewProjection, billboard, outInstances.data(), particleCount, level);
+		}
+		return ElapsedMs(start) / std::max(frameCount, 1u);
+		};
+	std::vector<ParticleForGPU> scalarInstances(particleCount);
+	uint32_t scalarInstanceCount = 0;
+	result.scalarMs = runStorage(ParticleStorage::SimdLevel::kScalar, scalarInstances, scalarInstanceCount);
+	result.storageMs = runStorage(ParticleStorage::GetSupportedLevel(), storageInstances, storageInstanceCount);
+
+	if (particleCount > 0) {
+		result.legacyPer100kMs = result.legacyMs * 100000.0 / particleCount;
+		result.scalarPer100kMs = result.scalarMs * 100000.0 / particleCount;
+		result.storagePer100kMs = result.storageMs * 100000.0 / particleCount;
+	}
+
+	// スカラーとSIMDは同じ順に消して同じ順に書くので、並べ替えずにそのまま比べる
+	auto instanceError = [](const ParticleForGPU& a, const ParticleForGPU& b) {
+		float error = 0.0f;
+		for (uint32_t row = 0; row < 4; ++row) {
+			for (uint32_t column = 0; column < 4; ++column) {
+				error = std::max(error, std::abs(a.World.m[row][column] - b.World.m[row][column]));
+				error = std::max(error, std::abs(a.WVP.m[row][column] - b.WVP.m[row][column]));
+			}
+		}
+		return std::max(error, std::abs(a.color.w - b.color.w));
+		};
+	if (scalarInstanceCount != storageInstanceCount) {
+		result.simdMaxError = std::numeric_limits<float>::infinity();
+	}
+	else {
+		for (uint32_t i = 0; i < storageInstanceCount; ++i) {
+			result.simdMaxError = std::max(result.simdMaxError, instanceError(scalarInstances[i], storageInstances[i]));
+		}
+	}
+
+	// 消し方が違うので並びは違う。位置で並べ替えてから最後のフレームの書き込み結果を比べる
+	if (legacyInstanceCount != storageInstanceCount) {
+		result.maxError = std::numeric_limits<float>::infinity();
+		return result;
+	}
+	auto sortByPosition = [](std::vector<ParticleForGPU>& instances, uint32_t count) {
+		std::sort(instances.begin(), instances.begin() + count, [](const ParticleForGPU& a, const ParticleForGPU& b) {
+			return std::tie(a.World.m[3][0], a.World.m[3][1], a.World.m[3][2]) < std::tie(b.World.m[3][0], b.World.m[3][1], b.World.m[3][2]);
+		});
+	};
+	sortByPosition(legacyInstances, legacyInstanceCount);
+	sortByPosition(storageInstances, storageInstanceCount);
+
+	for (uint32_t i = 0; i < legacyInstanceCount; ++i) {
+		result.maxError = std::max(result.maxError, instanceError(legacyInstances[i], storageInstances[i]));
+	}
+
+	return result;
+}
+
+ParticleBenchmark::ParallelResult ParticleBenchmark::RunParallelUpdate(uint32_t groupCount, uint32_t particlesPerGroup, uint32_t frameCount,
+	uint32_t maxThreads, uint32_t seed) {
+	ParallelResult result;
+	result.groupCount = groupCount;
+	result.particleCount = groupCount * particlesPerGroup;
+	result.frameCount = frameCount;
+	const uint32_t threadCount = JobSystem::GetInstance()->GetMaxThreadCount();
+	result.threadCount = maxThreads == 0 ? threadCount : std::min(maxThreads, threadCount);
+
+	const float deltaTime = 1.0f / 60.0f;
+	const std::vector<ParticleStorage::Particle> templates = MakeTemplates(particlesPerGroup * 2, seed);
+	Matrix4x4 billboard;
+	const Matrix4x4 viewProjection = MakeBenchmarkViewProjection(billboard);
+
+	// グループごとに挙動フラグを変えて、大きさの違うカーネルが混ざるようにする
+	auto makeGroups = [&]() {
+		std::vector<ParticleStorage> storages;
+		for (uint32_t group = 0; group < groupCount; ++group) {
+			storages.emplace_back((group & 7u) | ((group & 8u) ? uint32_t(ParticleStorage::kSinMove) : 0u));
+		}
+		return storages;
+		};
+	// 毎フレーム、グループごとに決まった順で消えた分を発生させる
+	auto refill = [&](std::vector<ParticleStorage>& storages, std::vector<size_t>& next) {
+		for (uint32_t group = 0; group < groupCount; ++group) {
+			while (storages[group].GetSize() < particlesPerGroup) {
+				storages[group].Push(templates[next[group]]);
+				next[group] = (next[group] + 1) % templates.size();
+			}
+		}
+		};
+
+	// --- 直列（グループを1つずつ Update） ---
+	std::vector<std::vector<ParticleForGPU>> serialInstances(groupCount, std::vector<ParticleForGPU>(particlesPerGroup));
+	{
+		std::vector<ParticleStorage> storages = makeGroups();
+		std::vector<size_t> next(groupCount, 0);
+		double totalMs = 0.0;
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			refill(storages, next);
+			Clock::time_point start = Clock::now();
+			for (uint32_t group = 0; group < groupCount; ++group) {
+				storages[group].Update(FixedTimestep::Step{ deltaTime }, viewProjection, billboard, serialInstances[group].data(), particlesPerGroup);
+			}
+			totalMs += ElapsedMs(start);
+		}
+		result.serialMs = totalMs / std::max(frameCount, 1u);
+	}
+
+	// --- 並列（詰める処理は配列ごと、更新は区切りごと） ---
+	std::vector<std::vector<ParticleForGPU>> parallelInstances(groupCount, std::vector<ParticleForGPU>(particlesPerGroup));
+	{
+		std::vector<ParticleStorage> storages = makeGroups();
+		std::vector<size_t> next(groupCount, 0);
+		std::vector<ParticleStorage*> pointers;
+		for (ParticleStorage& storage : storages) {
+			pointers.push_back(&storage);
+		}
+		std::vector<ParticleStorage::Target> targets(groupCount);
+		ParticleStorage::Workspace workspace;
+		double totalMs = 0.0;
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			refill(storages, next);
+			Clock::time_point start = Clock::now();
+			ParticleStorage::RemoveDeadParallel(pointers, maxThreads);
+			for (uint32_t group = 0; group < groupCount; ++group) {
+				targets[group].storage = &storages[group];
+				targets[group].outInstances = parallelInstances[group].data();
+				targets[group].capacity = storages[group].GetSize();
+				targets[group].viewProjection = &viewProjection;
+				targets[group].billboard = &billboard;
+			}
+			ParticleStorage::UpdateParallel(targets, FixedTimestep::Step{ deltaTime }, ParticleStorage::SimdLevel::kAVX2, maxThreads, workspace);
+			totalMs += ElapsedMs(start);
+		}
+		result.parallelMs = totalMs / std::max(frameCount, 1u);
+	}
+
+	// 同じ発生順なので、書き込み結果はビット単位で一致するはず
+	result.isDeterministic = true;
+	for (uint32_t group = 0; group < groupCount; ++group) {
+		if (std::memcmp(serialInstances[group].data(), parallelInstances[group].data(), sizeof(ParticleForGPU) * particlesPerGroup) != 0) {
+			result.isDeterministic = false;
+		}
+	}
+
+	return result;
+}
+
+ParticleBenchmark::EmitResult ParticleBenchmark::RunEmit(uint32_t burstSize, uint32_t burstCount, uint32_t flags) {
+	EmitResult result;
+	result.burstSize = burstSize;
+	result.burstCount = burstCount;
+
+	// エミッタの既定値で、発生範囲を回転させたもの
+	EmitterParams params;
+	params.position = { 0.0f, 5.0f, 0.0f };
+	params.scale = { 3.0f, 1.0f, 3.0f };
+	params.rotation = { 0.3f, 0.6f, 0.0f };
+	params.flags = flags;
+
+	{
+		std::list<LegacyParticle> particles;
+		std::mt19937 randomEngine(0);
+		double totalMs = 0.0;
+		for (uint32_t burst = 0; burst < burstCount; ++burst) {
+			Clock::time_point start = Clock::now();
+			EmitLegacy(particles, randomEngine, params, burstSize);
+			const double ms = ElapsedMs(start);
+			totalMs += ms;
+			result.legacyMaxMs = std::max(result.legacyMaxMs, ms);
+			particles.clear();
+		}
+		result.legacyMs = totalMs / std::max(burstCount, 1u);
+	}
+
+	{
+		ParticleStorage storage(flags);
+		Pcg32 random(0);
+		double totalMs = 0.0;
+		for (uint32_t burst = 0; burst < burstCount; ++burst) {
+			Clock::time_point start = Clock::now();
+			storage.Emit(params, burstSize, random);
+			const double ms = ElapsedMs(start);
+			totalMs += ms;
+			result.storageMaxMs = std::max(result.storageMaxMs, ms);
+			storage.Clear();
+		}
+		result.storageMs = totalMs / std::max(burstCount, 1u);
+	}
+
+	return result;
+}
+
+ParticleBenchmark::CompactionResult ParticleBenchmark::RunCompaction(uint32_t particleCount, uint32_t frameCount, uint32_t seed) {
+	CompactionResult result;
+	result.particleCount = particleCount;
+
+	// 視錐台の外にも出るよう、発生範囲を広げて1回更新したものを使う
+	std::vector<ParticleStorage::Particle> templates = MakeTemplates(particleCount, seed);
+	for (ParticleStorage::Particle& particle : templates) {
+		particle.position = particle.position * 2.0f;
+	}
+	ParticleStorage storage(ParticleStorage::kBillboard);
+	for (const ParticleStorage::Particle& particle : templates) {
+		storage.Push(particle);
+	}
+	Matrix4x4 billboard;
+	const Matrix4x4 viewProjection = MakeBenchmarkViewProjection(billboard);
+	std::vector<ParticleForGPU> instances(particleCount);
+	storage.Update(FixedTimestep::Step{}, viewProjection, billboard, instances.data(), particleCount);
+
+	const ParticleCompaction::Frustum frustum = ParticleCompaction::Frustum::FromViewProjection(viewProjection);
+	ParticleCompaction::Workspace workspace;
+	std::vector<ParticleForGPU> culled(particleCount);
+	std::vector<ParticleForGPU> sorted(particleCount);
+	std::vector<ParticleForGPU> reference(particleCount);
+
+	// --- 除くだけ ---
+	Clock::time_point start = Clock::now();
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		result.visibleCount = ParticleCompaction::Compact(instances.data(), particleCount, frustum, 1.0f, false, culled.data(), particleCount, workspace).writtenCount;
+	}
+	result.cullMs = ElapsedMs(start) / std::max(frameCount, 1u);
+
+	// --- 除いて基数ソート ---
+	start = Clock::now();
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		ParticleCompaction::Compact(instances.data(), particleCount, frustum, 1.0f, true, sorted.data(), particleCount, workspace);
+	}
+	result.radixSortMs = ElapsedMs(start) / std::max(frameCount, 1u);
+
+	// --- 除いて std::stable_sort（深度の降順） ---
+	std::vector<uint32_t> order(particleCount);
+	start = Clock::now();
+	for (uint32_t frame = 0; frame < frameCount; ++frame) {
+		order.clear();
+		ParticleCompaction::Compact(instances.data(), particleCount, frustum, 1.0f, false, culled.data(), particleCount, workspace);
+		order.assign(workspace.indices.begin(), workspace.indices.end());
+		std::stable_sort(order.begin(), order.end(), [&instances](uint32_t a, uint32_t b) { return instances[a].WVP.m[3][3] > instances[b].WVP.m[3][3]; });
+		for (uint32_t i = 0; i < order.size(); ++i) {
+			reference[i] = instances[order[i]];
+		}
+	}
+	result.stdSortMs = ElapsedMs(start) / std::max(frameCount, 1u);
+
+	result.isBackToFront = true;
+	for (uint32_t i = 1; i < result.visibleCount; ++i) {
+		if (sorted[i - 1].WVP.m[3][3] < sorted[i].WVP.m[3][3]) {
+			result.isBackToFront = false;
+		}
+	}
+	result.matchesStdSort = std::memcmp(sorted.data(), reference.data(), sizeof(ParticleForGPU) * result.visibleCount) == 0;
+
+	return result;
+}
+
+ParticleBenchmark::FixedStepResult ParticleBenchmark::RunFixedStep(uint32_t stepCount, uint32_t flags, uint32_t seed) {
+	FixedStepResult result;
+	result.stepCount = stepCount;
+
+	// 60Hz・144Hz・引っかかりのある可変フレーム（Frame::Update と同じく 0.05 秒で頭打ち）
+	const std::vector<float> frameTimes60 = { 1.0f / 60.0f };
+	const std::vector<float> frameTimes144 = { 1.0f / 144.0f };
+	std::vector<float> frameTimesHitch(97);
+	Pcg32 frameRandom(seed, 1);
+	for (float& frameTime : frameTimesHitch) {
+		frameTime = frameRandom.NextFloat() < 0.1f ? 0.05f : frameRandom.Range(1.0f / 240.0f, 1.0f / 30.0f);
+	}
+
+	const auto state60 = SimulateFixedStep(frameTimes60, stepCount, flags, seed);
+	const auto state144 = SimulateFixedStep(frameTimes144, stepCount, flags, seed);
+	const auto stateHitch = SimulateFixedStep(frameTimesHitch, stepCount, flags, seed);
+	const auto stateReplay = SimulateFixedStep(frameTimesHitch, stepCount, flags, seed);
+
+	// 比較はビット単位（-0 と 0 の違いも見る）
+	auto isSame = [](const auto& a, const auto& b) {
+		return a.size() == b.size() && std::memcmp(a.data(), b.data(), sizeof(a[0]) * a.size()) == 0;
+		};
+	result.particleCount = static_cast<uint32_t>(state60.size());
+	result.isReplayIdentical = isSame(stateHitch, stateReplay);
+	result.isFrameRateIndependent = isSame(state60, state144) && isSame(state60, stateHitch);
+
+	return result;
+}
+
+void ParticleBenchmark::RunChecks(const Benchmark::Check& check) {
+	for (uint32_t flags : { 0u, uint32_t(ParticleStorage::kBillboard), uint32_t(ParticleStorage::kRandomRotate | ParticleStorage::kSinMove),
+		uint32_t(ParticleStorage::kAcceMultiply) }) {
+		const UpdateResult update = RunUpdate(1000, 30, flags);
+		check(std::format("Particle: flags {:#x} SIMD matches scalar", flags), update.simdMaxError == 0.0f);
+		check(std::format("Particle: flags {:#x} legacy error {:.2e}", flags, update.maxError), update.maxError <= kCheckTolerance);
+	}
+
+	const ParallelResult parallel = RunParallelUpdate(4, 1000, 30);
+	check("Particle: parallel update matches serial", parallel.isDeterministic);
+
+	const CompactionResult compaction = RunCompaction(2000, 1);
+	check("Particle: sorted back to front", compaction.isBackToFront);
+	check("Particle: radix sort matches std::stable_sort", compaction.matchesStdSort);
+
+	const FixedStepResult fixedStep = RunFixedStep(120, ParticleStorage::kRandomRotate | ParticleStorage::kAcceMultiply);
+	check("Particle: fixed step replay", fixedStep.isReplayIdentical);
+	check("Particle: fixed step frame rate independence", fixedStep.isFrameRateIndependent);
+}
+} // namespace Engine
+#endif // _DEBUG
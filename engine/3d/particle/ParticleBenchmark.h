@@ -0,0 +1,126 @@
+#pragma once
+#include "Benchmark.h"
+#include <cstdint>
+
+namespace Engine {
+/// <summary>
+/// パーティクル更新の計測（デバッグビルドのみ。描画・GPUに依存せず単体で実行できる）
+/// </summary>
+class ParticleBenchmark {
+public:
+	/// <summary>
+	/// 更新の計測結果
+	/// </summary>
+	struct UpdateResult {
+		uint32_t particleCount = 0;
+		uint32_t frameCount = 0;
+		uint32_t flags = 0;
+		double legacyMs = 0.0;         // 旧実装（構造体の std::list）の1フレームあたりの時間（発生・消滅を含む）
+		double scalarMs = 0.0;         // SoA・スカラーカーネルの1フレームあたりの時間
+		double storageMs = 0.0;        // SoA・使える最上位のSIMDカーネルの1フレームあたりの時間
+		double legacyPer100kMs = 0.0;  // 10万個あたりに換算した時間
+		double scalarPer100kMs = 0.0;
+		double storagePer100kMs = 0.0;
+		float maxError = 0.0f;         // 旧実装との書き込んだインスタンスデータの差の最大（sin の近似分だけずれる）
+		float simdMaxError = 0.0f;     // スカラーとSIMDの差の最大（同じ計算順序なので0のはず）
+	};
+
+	/// <summary>
+	/// 並列更新の計測結果
+	/// </summary>
+	struct ParallelResult {
+		uint32_t groupCount = 0;
+		uint32_t particleCount = 0;  // 全グループの合計
+		uint32_t frameCount = 0;
+		uint32_t threadCount = 0;    // JobSystem のスレッド数で頭打ちになる
+		double serialMs = 0.0;       // グループを1つずつ更新した1フレームあたりの時間（発生は含まない）
+		double parallelMs = 0.0;     // 配列・区切りごとに並列で更新した時間
+		bool isDeterministic = false; // 直列と並列の書き込み結果がビット単位で一致したか
+	};
+
+	/// <summary>
+	/// 発生の計測結果
+	/// </summary>
+	struct EmitResult {
+		uint32_t burstSize = 0;
+		uint32_t burstCount = 0;
+		double legacyMs = 0.0;        // 旧実装（分布を毎回作り、std::list を作って繋ぐ）の1回あたりの時間
+		double storageMs = 0.0;       // EmitterParams でまとめて発生させた1回あたりの時間
+		double legacyMaxMs = 0.0;     // 1回の最大（フレームの引っかかり）
+		double storageMaxMs = 0.0;
+	};
+
+	/// <summary>
+	/// カリング・並べ替えの計測結果
+	/// </summary>
+	struct CompactionResult {
+		uint32_t particleCount = 0;
+		uint32_t visibleCount = 0;     // 視錐台に入った数
+		double cullMs = 0.0;           // 除いて詰めるだけの時間
+		double radixSortMs = 0.0;      // 除いて基数ソートで並べて詰める時間
+		double stdSortMs = 0.0;        // 基数ソートの代わりに std::stable_sort を使った時間（比較用）
+		bool isBackToFront = false;    // 奥から手前の順になっているか
+		bool matchesStdSort = false;   // std::stable_sort と同じ並びか
+	};
+
+	/// <summary>
+	/// 固定ステップの確認結果
+	/// </summary>
+	struct FixedStepResult {
+		uint32_t stepCount = 0;               // 進めたステップ数
+		uint32_t particleCount = 0;           // 最後に残った数
+		bool isReplayIdentical = false;       // 同じシード・同じフレーム時間の列で、状態がビット単位で一致したか
+		bool isFrameRateIndependent = false;  // 60Hz・144Hz・引っかかりのあるフレーム時間で、状態がビット単位で一致したか
+	};
+
+	/// <summary>
+	/// 旧実装と SoA（スカラー・SIMD）で同じパーティクルを発生・更新し、時間と結果を比べる
+	/// </summary>
+	/// <param name="particleCount">パーティクル数（毎フレーム消えた分を発生させて保つ）</param>
+	/// <param name="frameCount">更新するフレーム数</param>
+	/// <param name="flags">挙動フラグ（ParticleStorage::Flag の組み合わせ）</param>
+	/// <param name="seed">乱数シード</param>
+	static UpdateResult RunUpdate(uint32_t particleCount, uint32_t frameCount, uint32_t flags = 0, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 挙動フラグの違う複数のグループを、1つずつ更新した場合と並列で更新した場合で比べる
+	/// </summary>
+	/// <param name="groupCount">グループ数</param>
+	/// <param name="particlesPerGroup">グループごとのパーティクル数（毎フレーム消えた分を発生させて保つ）</param>
+	/// <param name="frameCount">更新するフレーム数</param>
+	/// <param name="maxThreads">使うスレッド数の上限（0なら JobSystem の全スレッド）</param>
+	/// <param name="seed">乱数シード</param>
+	static ParallelResult RunParallelUpdate(uint32_t groupCount, uint32_t particlesPerGroup, uint32_t frameCount,
+		uint32_t maxThreads = 0, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 同じ設定で旧実装と EmitterParams の発生を比べる（発生させたものは計測の外で消す）
+	/// </summary>
+	/// <param name="burstSize">1回に発生させる数</param>
+	/// <param name="burstCount">発生させる回数</param>
+	/// <param name="flags">挙動フラグ（ParticleStorage::Flag の組み合わせ）</param>
+	static EmitResult RunEmit(uint32_t burstSize, uint32_t burstCount, uint32_t flags = 0);
+
+	/// <summary>
+	/// 画面の外にも散らばったパーティクルを、視錐台で除いて奥から手前の順に詰める
+	/// </summary>
+	/// <param name="particleCount">パーティクル数</param>
+	/// <param name="frameCount">繰り返す回数</param>
+	/// <param name="seed">乱数シード</param>
+	static CompactionResult RunCompaction(uint32_t particleCount, uint32_t frameCount, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 同じエミッタを違うフレーム時間の列で固定ステップ更新し、同じステップ数での状態を比べる（描画なしで再生できるかの確認）
+	/// </summary>
+	/// <param name="stepCount">進めるステップ数</param>
+	/// <param name="flags">挙動フラグ（ParticleStorage::Flag の組み合わせ）</param>
+	/// <param name="seed">乱数シード</param>
+	static FixedStepResult RunFixedStep(uint32_t stepCount, uint32_t flags = 0, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 結果の一致・性質の確認を小さい規模で実行する（SelfCheck から呼ぶ）
+	/// </summary>
+	/// <param name="check">確認1件ごとに呼ぶ関数</param>
+	static void RunChecks(const Benchmark::Check& check);
+};
+} // namespace Engine
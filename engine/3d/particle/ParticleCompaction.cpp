@@ -0,0 +1,153 @@
+#define NOMINMAX
+#include "ParticleCompaction.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Engine {
+namespace {
+// 基数ソートの1回で見る桁数
+constexpr uint32_t kRadixBits = 11;
+constexpr uint32_t kRadixSize = 1u << kRadixBits;
+constexpr uint32_t kRadixMask = kRadixSize - 1;
+constexpr uint32_t kRadixPasses = (32 + kRadixBits - 1) / kRadixBits;
+
+// 平面を法線の長さで割る
+Vector4 NormalizePlane(float a, float b, float c, float d) {
+	const float length = std::sqrt(a * a + b * b + c * c);
+	const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+	return { a * inverse, b * inverse, c * inverse, d * inverse };
+}
+
+// 境界球が視錐台の内側に掛かっているか
+bool IsVisible(const ParticleCompaction::Frustum& frustum, const ParticleForGPU& instance, float meshRadius) {
+	const Matrix4x4& world = instance.World;
+
+	// 行ごとの長さが各軸のスケール（回転・ビルボードは正規直交）
+	float scaleSquared = 0.0f;
+	for (uint32_t row = 0; row < 3; ++row) {
+		scaleSquared = std::max(scaleSquared, world.m[row][0] * world.m[row][0] + world.m[row][1] * world.m[row][1] + world.m[row][2] * world.m[row][2]);
+	}
+	const float radius = meshRadius * std::sqrt(scaleSquared);
+
+	// 外れる平面はパーティクルごとにばらばらなので、途中で抜けずに6平面とも調べる（分岐予測の失敗を避ける）
+	bool visible = true;
+	for (const Vector4& plane : frustum.planes) {
+		const float distance = plane.x * world.m[3][0] + plane.y * world.m[3][1] + plane.z * world.m[3][2] + plane.w;
+		visible &= distance >= -radius;
+	}
+	return visible;
+}
+} // namespace
+
+ParticleCompaction::Frustum ParticleCompaction::Frustum::FromViewProjection(const Matrix4x4& viewProjection) {
+	// 行ベクトル（p * VP）なので、クリップ座標の各成分は VP の列との内積
+	const Matrix4x4& m = viewProjection;
+	auto column = [&m](uint32_t index, uint32_t row) { return m.m[row][index]; };
+
+	Frustum frustum;
+	// 左・右・下・上（-w <= x, y <= w）
+	frustum.planes[0] = NormalizePlane(column(3, 0) + column(0, 0), column(3, 1) + column(0, 1), column(3, 2) + column(0, 2), column(3, 3) + column(0, 3));
+	frustum.planes[1] = NormalizePlane(column(3, 0) - column(0, 0), column(3, 1) - column(0, 1), column(3, 2) - column(0, 2), column(3, 3) - column(0, 3));
+	frustum.planes[2] = NormalizePlane(column(3, 0) + column(1, 0), column(3, 1) + column(1, 1), column(3, 2) + column(1, 2), column(3, 3) + column(1, 3));
+	frustum.planes[3] = NormalizePlane(column(3, 0) - column(1, 0), column(3, 1) - column(1, 1), column(3, 2) - column(1, 2), column(3, 3) - column(1, 3));
+	// 手前・奥（0 <= z <= w）
+	frustum.planes[4] = NormalizePlane(column(2, 0), column(2, 1), column(2, 2), column(2, 3));
+	frustum.planes[5] = NormalizePlane(column(3, 0) - column(2, 0), column(3, 1) - column(2, 1), column(3, 2) - column(2, 2), column(3, 3) - column(2, 3));
+	return frustum;
+}
+
+uint32_t ParticleCompaction::DepthKey(float depth) {
+	// float のビット列を符号なしの大小と一致させてから反転する（奥ほど小さいキー）
+	uint32_t bits;
+	std::memcpy(&bits, &depth, sizeof(bits));
+	const uint32_t ordered = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	return ~ordered;
+}
+
+void ParticleCompaction::RadixSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& indices, Workspace& workspace) {
+	const size_t count = keys.size();
+	workspace.tempKeys.resize(count);
+	workspace.tempIndices.resize(count);
+
+	// 全桁の頻度を1回で数える
+	uint32_t histogram[kRadixPasses][kRadixSize] = {};
+	for (uint32_t key : keys) {
+		for (uint32_t pass = 0; pass < kRadixPasses; ++pass) {
+			++histogram[pass][(key >> (pass * kRadixBits)) & kRadixMask];
+		}
+	}
+
+	std::vector<uint32_t>* sourceKeys = &keys;
+	std::vector<uint32_t>* sourceIndices = &indices;
+	std::vector<uint32_t>* destinationKeys = &workspace.tempKeys;
+	std::vector<uint32_t>* destinationIndices = &workspace.tempIndices;
+	for (uint32_t pass = 0; pass < kRadixPasses; ++pass) {
+		// 全要素が同じ桁なら並びは変わらないので飛ばす
+		uint32_t* counts = histogram[pass];
+		const uint32_t shift = pass * kRadixBits;
+		if (count == 0 || counts[((*sourceKeys)[0] >> shift) & kRadixMask] == count) {
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t digit = 0; digit < kRadixSize; ++digit) {
+			const uint32_t digitCount = counts[digit];
+			counts[digit] = offset;
+			offset += digitCount;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			const uint32_t key = (*sourceKeys)[i];
+			const uint32_t position = counts[(key >> shift) & kRadixMask]++;
+			(*destinationKeys)[position] = key;
+			(*destinationIndices)[position] = (*sourceIndices)[i];
+		}
+		std::swap(sourceKeys, destinationKeys);
+		std::swap(sourceIndices, destinationIndices);
+	}
+
+	// 奇数回入れ替えた場合は作業領域側に結果があるので戻す
+	if (sourceKeys != &keys) {
+		keys.swap(workspace.tempKeys);
+		indices.swap(workspace.tempIndices);
+	}
+}
+
+ParticleCompaction::Result ParticleCompaction::Compact(const ParticleForGPU* instances, uint32_t count, const Frustum& frustum,
+	float meshRadius, bool sort, ParticleForGPU* outInstances, uint32_t capacity, Workspace& workspace) {
+	Result result;
+
+	// --- 視錐台で除く（残ったものの番号と、並べ替えるならキーを控える。分岐せずに書いて数だけ進める） ---
+	workspace.indices.resize(count);
+	workspace.keys.resize(sort ? count : 0);
+	uint32_t visibleCount = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		workspace.indices[visibleCount] = i;
+		if (sort) {
+			// WVP の4行目は中心のクリップ座標で、w はビュー空間の深度
+			workspace.keys[visibleCount] = DepthKey(instances[i].WVP.m[3][3]);
+		}
+		visibleCount += IsVisible(frustum, instances[i], meshRadius) ? 1u : 0u;
+	}
+	workspace.indices.resize(visibleCount);
+	workspace.keys.resize(sort ? visibleCount : 0);
+	result.visibleCount = visibleCount;
+
+	// --- 奥から手前の順に並べる ---
+	uint32_t first = 0;
+	if (sort) {
+		RadixSort(workspace.keys, workspace.indices, workspace);
+		// 溢れた分は奥のものから捨てる
+		if (result.visibleCount > capacity) {
+			first = result.visibleCount - capacity;
+		}
+	}
+
+	// --- 書き込み ---
+	result.writtenCount = std::min(result.visibleCount, capacity);
+	for (uint32_t i = 0; i < result.writtenCount; ++i) {
+		outInstances[i] = instances[workspace.indices[first + i]];
+	}
+	return result;
+}
+} // namespace Engine
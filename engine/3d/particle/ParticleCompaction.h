@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Matrix4x4.h"
+#include "ParticleStorage.h"
+#include "Vector4.h"
+
+namespace Engine {
+/// <summary>
+/// インスタンスデータの詰め直し。視錐台から外れたものを除き、必要なら奥から手前の順に並べて書き込む
+/// </summary>
+class ParticleCompaction {
+public:
+	/// <summary>
+	/// 視錐台（ワールド空間の6平面。法線は内向きで、ax + by + cz + d >= 0 が内側）
+	/// </summary>
+	struct Frustum {
+		Vector4 planes[6];
+
+		/// <summary>
+		/// ビュープロジェクション行列から作る（深度は 0〜1）
+		/// </summary>
+		static Frustum FromViewProjection(const Matrix4x4& viewProjection);
+	};
+
+	/// <summary>
+	/// 作業領域（毎フレーム使い回す）
+	/// </summary>
+	struct Workspace {
+		std::vector<uint32_t> keys;
+		std::vector<uint32_t> indices;
+		std::vector<uint32_t> tempKeys;
+		std::vector<uint32_t> tempIndices;
+	};
+
+	/// <summary>
+	/// 詰め直しの結果
+	/// </summary>
+	struct Result {
+		uint32_t visibleCount = 0; // 視錐台に入った数
+		uint32_t writtenCount = 0; // 書き込んだ数（capacity で頭打ち）
+	};
+
+	/// <summary>
+	/// 視錐台で除き、残りを書き込む
+	/// </summary>
+	/// <param name="instances">更新済みのインスタンスデータ</param>
+	/// <param name="count">要素数</param>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="meshRadius">形状の半径（スケールを掛けて境界球にする）</param>
+	/// <param name="sort">奥から手前の順に並べるか（溢れた分は奥から捨てる）</param>
+	/// <param name="outInstances">書き込み先</param>
+	/// <param name="capacity">書き込める数</param>
+	/// <param name="workspace">作業領域</param>
+	static Result Compact(const ParticleForGPU* instances, uint32_t count, const Frustum& frustum, float meshRadius, bool sort,
+		ParticleForGPU* outInstances, uint32_t capacity, Workspace& workspace);
+
+	/// <summary>
+	/// 奥から手前の順になる並べ替えのキー（クリップ空間の w が大きいほど小さい値）
+	/// </summary>
+	static uint32_t DepthKey(float depth);
+
+	/// <summary>
+	/// キーの昇順に基数ソートする（11bit ずつ3回。同じキーは元の順を保つ）
+	/// </summary>
+	/// <param name="keys">キー（並べ替えた結果で上書きする）</param>
+	/// <param name="indices">キーと一緒に並べ替える番号</param>
+	/// <param name="workspace">作業領域（temp 側だけを使う）</param>
+	static void RadixSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& indices, Workspace& workspace);
+};
+} // namespace Engine
@@ -15,18 +15,20 @@ ParticleEmitter::ParticleEmitter() {
 
 ParticleEmitter::~ParticleEmitter() {
     s_registry_.erase(std::remove(s_registry_.begin(), s_registry_.end(), this), s_registry_.end());
+    ParticleManager::ReleaseGroup(groupHandle_);
 }
 
-void ParticleEmitter::Initialize(const std::string& name, const std::string& fileName)
+void ParticleEmitter::Initialize(const std::string& name, const std::string& fileName, PrimitiveType primitiveType)
 {
     // --- 引数で受け取りメンバ変数に記録 ---
     name_ = name;
+    fileName_ = fileName;
+    primitiveType_ = primitiveType;
 
     transform_.Initialize();
 
-    manager_ = std::make_unique<ParticleManager>();
-    manager_->Initialize(SrvManager::GetInstance());
-    manager_->CreateParticleGroup(name_, fileName);
+    RegisterGroup();
+    random_ = ParticleManager::GetInstance()->CreateRandom(name_);
 
     // --- 各ステータスにデフォルト値を設定 ---
     emitFrequency_ = 0.1f;
@@ -58,15 +60,19 @@ void ParticleEmitter::Initialize(const std::string& name, const std::string& fil
 
 void ParticleEmitter::Update(const ViewProjection& vp_) {
     if (isActive_) {
-        elapsedTime_ += deltaTime;
-
-        while (elapsedTime_ >= emitFrequency_) {
-            Emit();
-            elapsedTime_ -= emitFrequency_;
+        // 発生はパーティクルと同じ固定ステップで判定し、途中のステップの分はそのステップから動かす
+        const FixedTimestep::Step& step = ParticleManager::GetInstance()->GetStep();
+        for (uint32_t i = 0; i < step.count; ++i) {
+            elapsedTime_ += step.deltaTime;
+
+            while (elapsedTime_ >= emitFrequency_) {
+                Emit(step.deltaTime * static_cast<float>(i));
+                elapsedTime_ -= emitFrequency_;
+            }
         }
     }
 
-    manager_->Update(vp_);
+    ParticleManager::GetInstance()->Update(groupHandle_, vp_);
     transform_.UpdateMatrix();
 }
 
@@ -76,19 +82,35 @@ void ParticleEmitter::UpdateOnce(const ViewProjection& vp_)
         Emit();
         isActive_ = true;
     }
-    manager_->Update(vp_);
+    ParticleManager::GetInstance()->Update(groupHandle_, vp_);
     transform_.UpdateMatrix();
 }
 
 void ParticleEmitter::Draw(PrimitiveType primitiveType)
 {
-    manager_->SetRandomRotate(isRandomRotate);
-    manager_->SetAcceMultipy(isAcceMultiply);
-    manager_->SetBillBorad(isBillBoard);
-    manager_->SetRandomSize(isRandomScale);
-    manager_->SetAllRandomSize(isAllRamdomScale);
-    manager_->SetSinMove(isSinMove);
-    manager_->Draw(primitiveType);
+    if (primitiveType != primitiveType_) {
+        primitiveType_ = primitiveType;
+        RegisterGroup();
+    }
+    ParticleManager::GetInstance()->Draw(groupHandle_);
+}
+
+void ParticleEmitter::SetBlendMode(BlendMode blendMode)
+{
+    if (blendMode == blendMode_) {
+        return;
+    }
+    blendMode_ = blendMode;
+    RegisterGroup();
+}
+
+void ParticleEmitter::RegisterGroup()
+{
+    ParticleManager* particleManager = ParticleManager::GetInstance();
+    // 先に新しい方を取ってから手放す（同じグループなら残りのパーティクルを消さない）
+    ParticleManager::GroupHandle previous = groupHandle_;
+    groupHandle_ = particleManager->RegisterGroup(fileName_, primitiveType_, blendMode_);
+    ParticleManager::ReleaseGroup(previous);
 }
 
 void ParticleEmitter::DrawEmitter()
@@ -125,33 +147,40 @@ void ParticleEmitter::DrawEmitter()
     }
 }
 
-void ParticleEmitter::Emit() {
-    manager_->Emit(
-        name_,
-        transform_.translation_,
-        count_,
-        transform_.scale_,
-        velocityMin_,
-        velocityMax_,
-        lifeTimeMin_,
-        lifeTimeMax_,
-        startScale_,
-        endScale_,
-        startAcce_,
-        endAcce_,
-        startRote_,
-        endRote_,
-        isRandomColor,
-        alphaMin_,
-        alphaMax_,
-        rotateVelocityMin,
-        rotateVelocityMax,
-        allScaleMax,
-        allScaleMin,
-        scaleMin,
-        scaleMax,
-        transform_.rotation_
-    );
+void ParticleEmitter::Emit(float delay) {
+    // 挙動の設定は発生時にパーティクルへ持たせる（グループは他のエミッタと共有するため）
+    EmitterParams params;
+    params.position = transform_.translation_;
+    params.scale = transform_.scale_;
+    params.rotation = transform_.rotation_;
+    params.velocityMin = velocityMin_;
+    params.velocityMax = velocityMax_;
+    params.lifeTimeMin = lifeTimeMin_;
+    params.lifeTimeMax = lifeTimeMax_;
+    params.startScale = startScale_;
+    params.endScale = endScale_;
+    params.startAcce = startAcce_;
+    params.endAcce = endAcce_;
+    params.startRote = startRote_;
+    params.endRote = endRote_;
+    params.isRandomColor = isRandomColor;
+    params.alphaMin = alphaMin_;
+    params.alphaMax = alphaMax_;
+    params.rotateVelocityMin = rotateVelocityMin;
+    params.rotateVelocityMax = rotateVelocityMax;
+    params.allScaleMin = allScaleMin;
+    params.allScaleMax = allScaleMax;
+    params.scaleMin = scaleMin;
+    params.scaleMax = scaleMax;
+    if (isBillBoard) { params.flags |= ParticleStorage::kBillboard; }
+    if (isRandomRotate) { params.flags |= ParticleStorage::kRandomRotate; }
+    if (isAcceMultiply) { params.flags |= ParticleStorage::kAcceMultiply; }
+    if (isRandomScale) { params.flags |= ParticleStorage::kRandomSize; }
+    if (isAllRamdomScale) { params.flags |= ParticleStorage::kAllRandomSize; }
+    if (isSinMove) { params.flags |= ParticleStorage::kSinMove; }
+    params.delay = delay;
+
+    ParticleManager::GetInstance()->Emit(groupHandle_, params, count_, random_);
 }
 
 void ParticleEmitter::ApplyGlobalVariables()
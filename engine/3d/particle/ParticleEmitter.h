@@ -25,7 +25,8 @@ public:
     /// </summary>
     /// <param name="name">: パーティクル名</param>
     /// <param name="fileName">: オブジェクトのファイルパス</param>
-    void Initialize(const std::string& name, const std::string& fileName);
+    /// <param name="primitiveType">: 描画する形状</param>
+    void Initialize(const std::string& name, const std::string& fileName, PrimitiveType primitiveType = Normal);
 
     /// <summary>
     /// 更新処理
@@ -34,7 +35,7 @@ public:
     void UpdateOnce(const ViewProjection& vp_);
 
     /// <summary>
-    /// 描画処理
+    /// 描画処理（形状が Initialize と違えばグループを付け替える）
     /// </summary>
     void Draw(PrimitiveType primitiveType);
 
@@ -63,30 +64,41 @@ public:
     void SetScale(const Vector3& scale) { transform_.scale_ = scale; }
     void SetCount(const int& count) { count_ = count; }
     void SetActive(bool isActive) { isActive_ = isActive; }
+    void SetBlendMode(BlendMode blendMode);
     void SetValue();
+    // 乱数列を指定したシードで作り直す（記録した操作の再生用。系列は CreateRandom でエミッタごとに分けたものを残す）
+    void SetSeed(uint64_t seed) { random_.Seed(seed, random_.GetStream()); }
 
 private:
     /// <summary>
     /// パーティクル発生
     /// </summary>
-    void Emit();
+    /// <param name="delay">動き出すまでの時間（フレーム内の何ステップ目で発生したか）</param>
+    void Emit(float delay = 0.0f);
+
+    /// <summary>
+    /// 共有プールのグループを取り直す（形状・ブレンドの変更時）
+    /// </summary>
+    void RegisterGroup();
 
     void ApplyGlobalVariables();
     void AddItem();
 
     // --- パーティクルステータス ---
     std::string name_;          
+    std::string fileName_;
+    PrimitiveType primitiveType_ = Normal;
+    BlendMode blendMode_ = BlendMode::kAdd;
     WorldTransform transform_; 
     int count_; 
 
     float emitFrequency_;
-    float elapsedTime_; 
+    float elapsedTime_ = 0.0f;
 
     float lifeTimeMin_;         
     float lifeTimeMax_; 
     float alphaMin_;
     float alphaMax_;
-    float deltaTime = 1.0f / 60.0f;
     float scaleMin;
     float scaleMax;
 
@@ -113,7 +125,10 @@ private:
     bool isAcceMultiply = false;
     bool isSinMove = false;
 
-    std::unique_ptr<ParticleManager> manager_;
+    // 共有プール内のグループ（同じ形状・テクスチャ・ブレンドのエミッタと共有する）
+    ParticleManager::GroupHandle groupHandle_;
+    // このエミッタの乱数列（エミッタごとに分けて、他のエミッタの発生数に左右されないようにする）
+    Pcg32 random_;
 
     GlobalVariables* globalVariables = nullptr;
     const char* groupName = nullptr;
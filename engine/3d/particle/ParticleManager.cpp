@@ -1,236 +1,429 @@
+#define NOMINMAX
 #include "ParticleManager.h"
+#include "GlobalVariables.h"
+#include "JobSystem.h"
+#include "ParticleCompaction.h"
 #include "TextureManager.h"
 #include "fstream"
+#include <optional>
+
+#ifdef _DEBUG
+#include "ParticleBenchmark.h"
+#include "imgui.h"
+#include "EditorUI.h"
+#endif // _DEBUG
 
 namespace Engine {
 std::unordered_map<std::string, ParticleManager::ModelData> ParticleManager::modelCache;
 
-void ParticleManager::Initialize(SrvManager* srvManager)
+std::unique_ptr<ParticleManager> ParticleManager::instance = nullptr;
+
+ParticleManager* ParticleManager::GetInstance()
 {
-	particleCommon = ParticleCommon::GetInstance();
-	srvManager_ = srvManager;
-	randomEngine.seed(seedGenerator());
+	if (instance == nullptr) {
+		instance = std::unique_ptr<ParticleManager>(new ParticleManager());
+	}
+	return instance.get();
 }
 
-void ParticleManager::Update(const ViewProjection& viewProjection)
+void ParticleManager::Finalize()
 {
-	// --- 各行列の初期化・計算 ---
-	Matrix4x4 viewProjectionMatrix = viewProjection.matView_ * viewProjection.matProjection_;
-
-	Matrix4x4 billboardMatrix = viewProjection.matView_;
-	billboardMatrix.m[3][0] = 0.0f;
-	billboardMatrix.m[3][1] = 0.0f;
-	billboardMatrix.m[3][2] = 0.0f;
-	billboardMatrix.m[3][3] = 1.0f;
-
-	billboardMatrix = Inverse(billboardMatrix);
+	instance.reset();
+}
 
-	for (auto& [groupName, particleGroup] : particleGroups) {
+void ParticleManager::Initialize(SrvManager* srvManager)
+{
+	particleCommon = ParticleCommon::GetInstance();
+	srvManager_ = srvManager;
+	SetSeed((static_cast<uint64_t>(seedGenerator()) << 32) | seedGenerator());
 
-		uint32_t numInstance = 0;
+	// 円・円柱は全グループで共有するので最初に1回だけ作る
+	CreateRingVartexData();
+	CreateCylinderVartexData();
+	GetMesh("<ring>", ringModelData);
+	GetMesh("<cylinder>", cylinderModelData);
 
-		// --- パーティクルの更新 ---
-		for (auto particleIterator = particleGroup.particles.begin();
-			particleIterator != particleGroup.particles.end();) {
+	CreateMaterial();
 
-			if ((*particleIterator).lifeTime <= (*particleIterator).currentTime) {
-				particleIterator = particleGroup.particles.erase(particleIterator);
-				continue;
-			}
-			// パーティクルの生存時間 t の計算
-			float t = (*particleIterator).currentTime / (*particleIterator).lifeTime;
-			t = std::clamp(t, 0.0f, 1.0f);
+	const char* groupName = "ParticleManager";
+	GlobalVariables* globalVariables = GlobalVariables::GetInstance();
+	globalVariables->CreateGroup(groupName);
+	globalVariables->AddItem(groupName, "updateThreads", updateThreads_);
+	globalVariables->SetIntRange(groupName, "updateThreads", 0, 16);
+}
 
-			// --- 拡縮処理 ---
-			if (isSinMove_) {
-				// Sin波の周波数制御 (速度調整)
-				float waveScale = 0.5f * (sin(t * DirectX::XM_PI * 18.0f) + 1.0f);  // 0 ~ 1
+void ParticleManager::BeginFrame(float deltaTime)
+{
+	// 前のフレームの終わりでGPUの完了を待っているので、広げる前のバッファはもう参照されない
+	retiredInstancingResources_.clear();
+	for (ParticleGroup& particleGroup : particleGroups) {
+		particleGroup.isUpdated = false;
+		particleGroup.isDrawn = false;
+	}
 
-				// 最大スケールが寿命に応じて縮小し、最終的に0になる
-				float maxScale = (1.0f - t);
+	// 描画されなかったグループの更新も前のフレームの分として済ませる
+	FlushUpdates();
+	step_ = timestep_.Advance(deltaTime);
 
-				// Sin波スケールと最大スケールの積を適用
-				(*particleIterator).transform.scale_ =
-					(*particleIterator).startScale * waveScale * maxScale;
+	updateThreads_ = GlobalVariables::GetInstance()->GetIntValue("ParticleManager", "updateThreads");
+#ifdef _DEBUG
+	DrawBenchmark();
+#endif // _DEBUG
+}
 
-			}
-			else {
-				// 通常の線形補間
-				(*particleIterator).transform.scale_ =
-					(1.0f - t) * (*particleIterator).startScale + t * (*particleIterator).endScale;
+ParticleManager::GroupHandle ParticleManager::RegisterGroup(const std::string& filename, PrimitiveType primitiveType, BlendMode blendMode)
+{
+	// テクスチャは形状によらずモデルの .mtl から取る
+	const ModelData& modelData = LoadObjFile("resources/models/", filename);
+
+	GroupKey key;
+	key.textureFilePath = modelData.material.textureFilePath;
+	key.blendMode = blendMode;
+	if (primitiveType == Ring) {
+		key.meshName = "<ring>";
+	}
+	else if (primitiveType == Cylinder) {
+		key.meshName = "<cylinder>";
+	}
+	else {
+		key.meshName = "resources/models/" + filename;
+	}
 
-				// アルファ値の計算
-				(*particleIterator).color.w = (*particleIterator).initialAlpha - ((*particleIterator).currentTime / (*particleIterator).lifeTime);
-			}
+	GroupHandle handle;
+	auto it = groupIndices_.find(key);
+	if (it != groupIndices_.end()) {
+		handle.index = it->second;
+	}
+	else {
+		// --- パーティクルグループ生成（インスタンス用バッファは発生させたときに確保する） ---
+		handle.index = static_cast<uint32_t>(particleGroups.size());
+		groupIndices_[key] = handle.index;
 
-			(*particleIterator).Acce = (1.0f - t) * (*particleIterator).startAcce + t * (*particleIterator).endAcce;
+		ParticleGroup& particleGroup = particleGroups.emplace_back();
+		particleGroup.key = key;
+		particleGroup.mesh = GetMesh(key.meshName, modelData);
 
-			if (isRandomRotate_) {
-				(*particleIterator).transform.rotation_ += (*particleIterator).rotateVelocity;
-			}
-			else {
-				(*particleIterator).transform.rotation_ = (1.0f - t) * (*particleIterator).startRote + t * (*particleIterator).endRote;
-			}
-
-			if (isAcceMultipy_) {
-				(*particleIterator).velocity *= (*particleIterator).Acce;
-			}
-			else {
-				(*particleIterator).velocity += (*particleIterator).Acce;
-			}
+		TextureManager::GetInstance()->LoadModelTexture(key.textureFilePath);
+		particleGroup.instancingSRVIndex = srvManager_->Allocate() + 1;
+	}
 
-			// パーティクルの移動
-			(*particleIterator).transform.translation_ +=
-				(*particleIterator).velocity * kDeltaTime;
-			(*particleIterator).currentTime += kDeltaTime;
+	++particleGroups[handle.index].refCount;
+	return handle;
+}
 
-			// ワールド行列の計算
-			Matrix4x4 worldMatrix{};
+void ParticleManager::ReleaseGroup(GroupHandle handle)
+{
+	// 終了処理の後に破棄されたエミッタからも呼ばれるので、そのときと範囲外は無視する
+	if (!instance || !handle.IsValid() || handle.index >= instance->particleGroups.size()) {
+		return;
+	}
+	ParticleGroup& particleGroup = instance->particleGroups[handle.index];
+	assert(particleGroup.refCount > 0);
+	if (--particleGroup.refCount == 0) {
+		particleGroup.storages.clear();
+		particleGroup.instanceCount = 0;
+	}
+}
 
-			if (isBillboard) {
-				// ビルボード
-				worldMatrix = MakeScaleMatrix((*particleIterator).transform.scale_) * billboardMatrix *
-					MakeTranslateMatrix((*particleIterator).transform.translation_);
-			}
-			else {
-				// 通常
-				worldMatrix = MakeAffineMatrix((*particleIterator).transform.scale_,
-					(*particleIterator).transform.rotation_,
-					(*particleIterator).transform.translation_);
-			}
+void ParticleManager::Update(GroupHandle handle, const ViewProjection& viewProjection)
+{
+	assert(handle.IsValid() && "Error: パーティクルグループが存在しません。");
+	ParticleGroup& particleGroup = particleGroups[handle.index];
+	if (particleGroup.isUpdated) {
+		return;
+	}
+	particleGroup.isUpdated = true;
 
-			// ワールド・ビュー・プロジェクション行列計算
-			Matrix4x4 worldViewProjectionMatrix = worldMatrix * viewProjectionMatrix;
+	// --- 各行列の初期化・計算 ---
+	particleGroup.viewProjectionMatrix = viewProjection.matView_ * viewProjection.matProjection_;
 
-			// インスタンスデータ設定
-			if (numInstance < kNumMaxInstance) {
-				particleGroup.instancingData[numInstance].WVP = worldViewProjectionMatrix;
-				particleGroup.instancingData[numInstance].World = worldMatrix;
-				particleGroup.instancingData[numInstance].color = (*particleIterator).color;
-				particleGroup.instancingData[numInstance].color.w = (*particleIterator).color.w;
-				++numInstance;
-			}
+	Matrix4x4 billboardMatrix = viewProjection.matView_;
+	billboardMatrix.m[3][0] = 0.0f;
+	billboardMatrix.m[3][1] = 0.0f;
+	billboardMatrix.m[3][2] = 0.0f;
+	billboardMatrix.m[3][3] = 1.0f;
 
-			++particleIterator;
-		}
+	// ビュー行列はアフィン変換なので 3x3 の逆行列だけで求める（射影などが入っているときは一般の逆行列）
+	particleGroup.billboardMatrix = IsAffine(billboardMatrix) ? InverseAffine(billboardMatrix) : Inverse(billboardMatrix);
 
-		// インスタンス数更新
-		particleGroup.instanceCount = numInstance;
-	}
+	// 実際の更新は最初の描画でまとめて並列に行う
+	pendingGroups_.push_back(handle.index);
 }
 
-void ParticleManager::Draw(PrimitiveType primitiveType)
+void ParticleManager::FlushUpdates()
 {
-	if (primitiveType == Normal) {
-		particleCommon->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
+	if (pendingGroups_.empty()) {
+		return;
+	}
+	const uint32_t maxThreads = static_cast<uint32_t>(std::max(updateThreads_, 0));
 
-		for (auto& [groupName, particleGroup] : particleGroups) {
-			if (particleGroup.instanceCount > 0) {
-				particleCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
+	// --- 寿命の尽きたものを配列ごとに並列で詰める ---
+	pendingStorages_.clear();
+	for (uint32_t groupIndex : pendingGroups_) {
+		for (ParticleStorage& storage : particleGroups[groupIndex].storages) {
+			pendingStorages_.push_back(&storage);
+		}
+	}
+	ParticleStorage::RemoveDeadParallel(pendingStorages_, maxThreads);
+
+	// --- 残った数の累積和で、グループ内の配列ごとの書き込み位置を決める（バッファの確保はここで行う） ---
+	updateTargets_.clear();
+	for (uint32_t groupIndex : pendingGroups_) {
+		ParticleGroup& particleGroup = particleGroups[groupIndex];
+		uint32_t particleCount = 0;
+		for (const ParticleStorage& storage : particleGroup.storages) {
+			particleCount += storage.GetSize();
+		}
+		ReserveInstance(particleGroup, std::min(particleCount, kNumMaxInstance));
 
-				srvManager_->SetGraphicsRootDescriptorTable(1, particleGroup.instancingSRVIndex);
-				srvManager_->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetModelTextureIndexByFilePath(particleGroup.material.textureFilePath));
+		// 全部をいったん作業用の配列へ書き、視錐台で除いてからアップロード用のバッファへ詰める
+		if (particleGroup.stagingInstances.size() < particleCount) {
+			particleGroup.stagingInstances.resize(particleCount);
+		}
+		particleGroup.particleCount = particleCount;
 
-				particleCommon->GetDxCommon()->GetCommandList()->DrawInstanced(UINT(modelData.vertices.size()), particleGroup.instanceCount, 0, 0);
-			}
+		uint32_t numInstance = 0;
+		for (ParticleStorage& storage : particleGroup.storages) {
+			ParticleStorage::Target& target = updateTargets_.emplace_back();
+			target.storage = &storage;
+			target.outInstances = particleGroup.stagingInstances.data() + numInstance;
+			target.capacity = storage.GetSize();
+			target.viewProjection = &particleGroup.viewProjectionMatrix;
+			target.billboard = &particleGroup.billboardMatrix;
+			numInstance += target.capacity;
 		}
 	}
 
-	else if (primitiveType == Ring) {
-		particleCommon->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &ringVertexBufferView);
+	// --- 全グループの配列を区切って並列に更新し、それぞれの範囲へ直接書き込む ---
+	ParticleStorage::UpdateParallel(updateTargets_, step_, ParticleStorage::SimdLevel::kAVX2, maxThreads, updateWorkspace_);
+
+	// --- グループごとに視錐台で除き、通常ブレンドは奥から手前の順に並べて詰める ---
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	compactionWorkspaces_.resize(jobSystem->GetMaxThreadCount());
+	jobSystem->ParallelFor(static_cast<uint32_t>(pendingGroups_.size()), 1, [&](uint32_t begin, uint32_t end, uint32_t threadIndex) {
+		for (uint32_t i = begin; i < end; ++i) {
+			ParticleGroup& particleGroup = particleGroups[pendingGroups_[i]];
+			const ParticleCompaction::Frustum frustum = ParticleCompaction::Frustum::FromViewProjection(particleGroup.viewProjectionMatrix);
+			const bool sort = particleGroup.key.blendMode == BlendMode::kNormal;
+			const ParticleCompaction::Result result = ParticleCompaction::Compact(particleGroup.stagingInstances.data(), particleGroup.particleCount,
+				frustum, particleGroup.mesh->radius, sort, particleGroup.instancingData, particleGroup.instanceCapacity, compactionWorkspaces_[threadIndex]);
+
+			// インスタンス数更新
+			particleGroup.instanceCount = result.writtenCount;
+		}
+		}, maxThreads);
+	pendingGroups_.clear();
+}
 
-		for (auto& [groupName, particleGroup] : particleGroups) {
-			if (particleGroup.instanceCount > 0) {
-				particleCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
+void ParticleManager::Draw(GroupHandle handle)
+{
+	assert(handle.IsValid() && "Error: パーティクルグループが存在しません。");
+	FlushUpdates();
+	ParticleGroup& particleGroup = particleGroups[handle.index];
+	if (particleGroup.isDrawn || particleGroup.instanceCount == 0) {
+		return;
+	}
+	particleGroup.isDrawn = true;
 
-				srvManager_->SetGraphicsRootDescriptorTable(1, particleGroup.instancingSRVIndex);
-				srvManager_->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetModelTextureIndexByFilePath(particleGroup.material.textureFilePath));
+	ID3D12GraphicsCommandList* commandList = particleCommon->GetDxCommon()->GetCommandList();
 
-				particleCommon->GetDxCommon()->GetCommandList()->DrawInstanced(UINT(ringModelData.vertices.size()), particleGroup.instanceCount, 0, 0);
-			}
-		}
+	// DrawCommonSetting は加算なので、それ以外のグループだけ切り替えて戻す
+	const bool isOtherBlend = particleGroup.key.blendMode != BlendMode::kAdd;
+	if (isOtherBlend) {
+		particleCommon->SetBlendMode(particleGroup.key.blendMode);
 	}
 
-	else if (primitiveType == Cylinder) {
-		particleCommon->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &cylinderVertexBufferView);
+	commandList->IASetVertexBuffers(0, 1, &particleGroup.mesh->vertexBufferView);
+	commandList->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
 
-		for (auto& [groupName, particleGroup] : particleGroups) {
-			if (particleGroup.instanceCount > 0) {
-				particleCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
+	srvManager_->SetGraphicsRootDescriptorTable(1, particleGroup.instancingSRVIndex);
+	srvManager_->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetModelTextureIndexByFilePath(particleGroup.key.textureFilePath));
 
-				srvManager_->SetGraphicsRootDescriptorTable(1, particleGroup.instancingSRVIndex);
-				srvManager_->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetModelTextureIndexByFilePath(particleGroup.material.textureFilePath));
+	commandList->DrawInstanced(particleGroup.mesh->vertexCount, particleGroup.instanceCount, 0, 0);
 
-				particleCommon->GetDxCommon()->GetCommandList()->DrawInstanced(UINT(cylinderModelData.vertices.size()), particleGroup.instanceCount, 0, 0);
-			}
-		}
+	if (isOtherBlend) {
+		particleCommon->SetBlendMode(BlendMode::kAdd);
 	}
 }
 
-void ParticleManager::CreateParticleGroup(const std::string name, const std::string& filename)
+#ifdef _DEBUG
+void ParticleManager::DrawBenchmark()
 {
-	// --- パーティクルグループ生成 ---
-	if (particleGroups.contains(name)) {
-		return;
+	if (!EditorUI::GetInstance()->PanelVisible("パーティクル計測", "デバッグ")) { return; }
+	ImGui::Begin("パーティクル計測");
+
+	uint32_t liveCount = 0;
+	for (const ParticleGroup& particleGroup : particleGroups) {
+		for (const ParticleStorage& storage : particleGroup.storages) {
+			liveCount += storage.GetSize();
+		}
+	}
+	uint32_t drawnCount = 0;
+	for (const ParticleGroup& particleGroup : particleGroups) {
+		drawnCount += particleGroup.instanceCount;
+	}
+	ImGui::Text("Groups: %d  Meshes: %d  Particles: %u  Drawn: %u", static_cast<int>(particleGroups.size()), static_cast<int>(meshes_.size()), liveCount, drawnCount);
+	ImGui::Separator();
+
+	// 旧実装（構造体の std::list）と SoA（スカラー・SIMD）の比較（10万個を発生・消滅させながら2秒分）
+	static std::vector<ParticleBenchmark::UpdateResult> results;
+	if (ImGui::Button("Run Update Benchmark")) {
+		results.clear();
+		for (uint32_t flags : { 0u, uint32_t(ParticleStorage::kBillboard), uint32_t(ParticleStorage::kRandomRotate | ParticleStorage::kSinMove) }) {
+			results.push_back(ParticleBenchmark::RunUpdate(100000, 120, flags));
+		}
 	}
 
-	particleGroups[name] = ParticleGroup();
-	ParticleGroup& particleGroup = particleGroups[name];
-	CreateVartexData(filename);
+	ImGui::Text("SIMD: %s", ParticleStorage::GetSupportedLevel() == ParticleStorage::SimdLevel::kAVX2 ? "AVX2" : "Scalar");
+
+	if (!results.empty() && ImGui::BeginTable("ParticleUpdateResults", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Flags");
+		ImGui::TableSetupColumn("List(ms/100k)");
+		ImGui::TableSetupColumn("Scalar(ms/100k)");
+		ImGui::TableSetupColumn("SIMD(ms/100k)");
+		ImGui::TableSetupColumn("MaxError");
+		ImGui::TableSetupColumn("SimdError");
+		ImGui::TableHeadersRow();
+		for (const ParticleBenchmark::UpdateResult& result : results) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0); ImGui::Text("0x%02x", result.flags);
+			ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f", result.legacyPer100kMs);
+			ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f", result.scalarPer100kMs);
+			ImGui::TableSetColumnIndex(3); ImGui::Text("%.3f", result.storagePer100kMs);
+			ImGui::TableSetColumnIndex(4); ImGui::Text("%g", result.maxError);
+			ImGui::TableSetColumnIndex(5); ImGui::Text("%g", result.simdMaxError);
+		}
+		ImGui::EndTable();
+	}
+	ImGui::Separator();
+
+	// 5000個の発生を旧実装と比べる（平均と最大）
+	static std::vector<ParticleBenchmark::EmitResult> emitResults;
+	if (ImGui::Button("Run Emit Benchmark")) {
+		emitResults.clear();
+		for (uint32_t flags : { 0u, uint32_t(ParticleStorage::kRandomRotate | ParticleStorage::kRandomSize) }) {
+			emitResults.push_back(ParticleBenchmark::RunEmit(5000, 60, flags));
+		}
+	}
+	for (const ParticleBenchmark::EmitResult& result : emitResults) {
+		ImGui::Text("Burst %u: List %.3f ms (max %.3f)  Params %.3f ms (max %.3f)",
+			result.burstSize, result.legacyMs, result.legacyMaxMs, result.storageMs, result.storageMaxMs);
+	}
+	ImGui::Separator();
 
-	particleGroup.material.textureFilePath = modelData.material.textureFilePath;
-	TextureManager::GetInstance()->LoadModelTexture(modelData.material.textureFilePath);
-	particleGroup.instancingResource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(ParticleForGPU) * kNumMaxInstance);
+	// 固定ステップ：60Hz・144Hz・引っかかりのあるフレーム時間で10秒分進めた状態を比べる
+	ImGui::Text("Step: %u  Interpolation: %.2f", step_.count, step_.interpolation);
+	static std::optional<ParticleBenchmark::FixedStepResult> fixedStepResult;
+	if (ImGui::Button("Run Fixed Step Check")) {
+		fixedStepResult = ParticleBenchmark::RunFixedStep(600, ParticleStorage::kRandomRotate | ParticleStorage::kAcceMultiply);
+	}
+	if (fixedStepResult) {
+		ImGui::Text("Steps %u  Particles %u  Replay: %s  FrameRateIndependent: %s", fixedStepResult->stepCount, fixedStepResult->particleCount,
+			fixedStepResult->isReplayIdentical ? "Yes" : "No", fixedStepResult->isFrameRateIndependent ? "Yes" : "No");
+	}
+	ImGui::Separator();
 
-	particleGroup.instancingSRVIndex = srvManager_->Allocate() + 1;
-	particleGroup.instancingResource->Map(0, nullptr, reinterpret_cast<void**>(&particleGroup.instancingData));
+	// 5万個を視錐台で除いて奥から手前の順に並べる
+	static std::optional<ParticleBenchmark::CompactionResult> compactionResult;
+	if (ImGui::Button("Run Cull/Sort Benchmark")) {
+		compactionResult = ParticleBenchmark::RunCompaction(50000, 60);
+	}
+	if (compactionResult) {
+		ImGui::Text("Visible %u / %u", compactionResult->visibleCount, compactionResult->particleCount);
+		ImGui::Text("Cull %.3f ms  Cull+Radix %.3f ms  Cull+stable_sort %.3f ms",
+			compactionResult->cullMs, compactionResult->radixSortMs, compactionResult->stdSortMs);
+		ImGui::Text("BackToFront: %s  MatchesStdSort: %s",
+			compactionResult->isBackToFront ? "Yes" : "No", compactionResult->matchesStdSort ? "Yes" : "No");
+	}
+	ImGui::Separator();
+
+	// グループを1つずつ更新した場合と並列で更新した場合の比較（合計10万個）
+	static std::vector<ParticleBenchmark::ParallelResult> parallelResults;
+	if (ImGui::Button("Run Parallel Benchmark")) {
+		parallelResults.clear();
+		for (uint32_t groupCount : { 1u, 16u, 64u }) {
+			parallelResults.push_back(ParticleBenchmark::RunParallelUpdate(groupCount, 100000 / groupCount, 120, static_cast<uint32_t>(std::max(updateThreads_, 0))));
+		}
+	}
 
-	srvManager_->CreateSRVforStructuredBuffer(particleGroup.instancingSRVIndex, particleGroup.instancingResource.Get(), kNumMaxInstance, sizeof(ParticleForGPU));
+	if (!parallelResults.empty() && ImGui::BeginTable("ParticleParallelResults", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Groups");
+		ImGui::TableSetupColumn("Threads");
+		ImGui::TableSetupColumn("Serial(ms)");
+		ImGui::TableSetupColumn("Parallel(ms)");
+		ImGui::TableSetupColumn("Deterministic");
+		ImGui::TableHeadersRow();
+		for (const ParticleBenchmark::ParallelResult& result : parallelResults) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0); ImGui::Text("%u", result.groupCount);
+			ImGui::TableSetColumnIndex(1); ImGui::Text("%u", result.threadCount);
+			ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f", result.serialMs);
+			ImGui::TableSetColumnIndex(3); ImGui::Text("%.3f", result.parallelMs);
+			ImGui::TableSetColumnIndex(4); ImGui::Text("%s", result.isDeterministic ? "Yes" : "No");
+		}
+		ImGui::EndTable();
+	}
 
-	CreateMaterial();
-	particleGroup.instanceCount = 0;
+	ImGui::End();
 }
+#endif // _DEBUG
 
-void ParticleManager::CreateVartexData(const std::string& filename)
+const ParticleManager::Mesh* ParticleManager::GetMesh(const std::string& meshName, const ModelData& modelData)
 {
-	modelData = LoadObjFile("resources/models/", filename);
+	auto it = meshes_.find(meshName);
+	if (it != meshes_.end()) {
+		return &it->second;
+	}
 
-	ringModelData.material.textureFilePath = "resources/images/" + filename;
-	CreateRingVartexData();
+	Mesh& mesh = meshes_[meshName];
+	mesh.vertexCount = static_cast<uint32_t>(modelData.vertices.size());
 
-	cylinderModelData.material.textureFilePath = "resources/images/" + filename;
-	CreateCylinderVartexData();
+	// 視錐台カリング用に原点からの最大距離を取っておく
+	for (const VertexData& vertex : modelData.vertices) {
+		const Vector4& position = vertex.position;
+		mesh.radius = std::max(mesh.radius, std::sqrt(position.x * position.x + position.y * position.y + position.z * position.z));
+	}
 
 	// --- 頂点リソース生成 ---
-	vertexResource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(VertexData) * modelData.vertices.size());
-
-	ringVertexResource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(VertexData) * ringModelData.vertices.size());
-
-	cylinderVertexResource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(VertexData) * cylinderModelData.vertices.size());
+	mesh.vertexResource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(VertexData) * modelData.vertices.size());
 
 	// --- 頂点バッファビュー生成 ---
-	vertexBufferView.BufferLocation = vertexResource->GetGPUVirtualAddress();
-	vertexBufferView.SizeInBytes = UINT(sizeof(VertexData) * modelData.vertices.size());
-	vertexBufferView.StrideInBytes = sizeof(VertexData);
-
-	ringVertexBufferView.BufferLocation = ringVertexResource->GetGPUVirtualAddress();
-	ringVertexBufferView.SizeInBytes = UINT(sizeof(VertexData) * ringModelData.vertices.size());
-	ringVertexBufferView.StrideInBytes = sizeof(VertexData);
-
-	cylinderVertexBufferView.BufferLocation = cylinderVertexResource->GetGPUVirtualAddress();
-	cylinderVertexBufferView.SizeInBytes = UINT(sizeof(VertexData) * cylinderModelData.vertices.size());
-	cylinderVertexBufferView.StrideInBytes = sizeof(VertexData);
+	mesh.vertexBufferView.BufferLocation = mesh.vertexResource->GetGPUVirtualAddress();
+	mesh.vertexBufferView.SizeInBytes = UINT(sizeof(VertexData) * modelData.vertices.size());
+	mesh.vertexBufferView.StrideInBytes = sizeof(VertexData);
 
 	// --- 書き込み ---
-	vertexResource->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
+	VertexData* vertexData = nullptr;
+	mesh.vertexResource->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
 	std::memcpy(vertexData, modelData.vertices.data(), sizeof(VertexData) * modelData.vertices.size());
 
-	ringVertexResource->Map(0, nullptr, reinterpret_cast<void**>(&ringVertexData));
-	std::memcpy(ringVertexData, ringModelData.vertices.data(), sizeof(VertexData) * ringModelData.vertices.size());
+	return &mesh;
+}
 
-	cylinderVertexResource->Map(0, nullptr, reinterpret_cast<void**>(&cylinderVertexData));
-	std::memcpy(cylinderVertexData, cylinderModelData.vertices.data(), sizeof(VertexData) * cylinderModelData.vertices.size());
+void ParticleManager::ReserveInstance(ParticleGroup& particleGroup, uint32_t count)
+{
+	if (count <= particleGroup.instanceCapacity) {
+		return;
+	}
 
+	uint32_t capacity = std::max(particleGroup.instanceCapacity, kMinInstanceCapacity);
+	while (capacity < count) {
+		capacity *= 2;
+	}
+	capacity = std::min(capacity, kNumMaxInstance);
+
+	// 描画の途中（最初の Draw からの FlushUpdates）でも呼ばれ、前のバッファは同じフレームで記録したコマンドが参照しうるので、
+	// 次のフレームの開始まで残す。SRV はこのグループ専用で、書き換えるのはこのグループを描画する前だけ
+	assert(!particleGroup.isDrawn);
+	if (particleGroup.instancingResource) {
+		retiredInstancingResources_.push_back(std::move(particleGroup.instancingResource));
+	}
+	particleGroup.instancingResource = particleCommon->GetDxCommon()->CreateBufferResource(sizeof(ParticleForGPU) * capacity);
+	particleGroup.instancingResource->Map(0, nullptr, reinterpret_cast<void**>(&particleGroup.instancingData));
+
+	srvManager_->CreateSRVforStructuredBuffer(particleGroup.instancingSRVIndex, particleGroup.instancingResource.Get(), capacity, sizeof(ParticleForGPU));
+
+	particleGroup.instanceCapacity = capacity;
 }
 
 void ParticleManager::CreateRingVartexData()
@@ -278,124 +471,6 @@ void ParticleManager::CreateCylinderVartexData()
 	}
 }
 
-ParticleManager::Particle ParticleManager::MakeNewParticle(
-	std::mt19937& randomEngine,
-	const Vector3& translate,
-	const Vector3& rotation,
-	const Vector3& scale,
-	const Vector3& velocityMin, const Vector3& velocityMax,
-	float lifeTimeMin, float lifeTimeMax,
-	const Vector3& particleStartScale, const Vector3& particleEndScale,
-	const Vector3& startAcce, const Vector3& endAcce,
-	const Vector3& startRote, const Vector3& endRote,
-	bool isRamdomColor, float alphaMin, float alphaMax,
-	const Vector3& rotateVelocityMin, const Vector3& rotateVelocityMax,
-	const Vector3& allScaleMax, const Vector3& allScaleMin,
-	const float& scaleMin, const float& scaleMax
-)
-{
-	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
-	std::uniform_real_distribution<float> distVelocityX(velocityMin.x, velocityMax.x);
-	std::uniform_real_distribution<float> distVelocityY(velocityMin.y, velocityMax.y);
-	std::uniform_real_distribution<float> distVelocityZ(velocityMin.z, velocityMax.z);
-	std::uniform_real_distribution<float> distLifeTime(lifeTimeMin, lifeTimeMax);
-	std::uniform_real_distribution<float> distAlpha(alphaMin, alphaMax);
-
-	Particle particle;
-
-	// スケールを考慮して位置を生成
-	Vector3 randomTranslate = {
-		distribution(randomEngine) * scale.x,
-		distribution(randomEngine) * scale.y,
-		distribution(randomEngine) * scale.z
-	};
-
-	// 回転行列を適用しランダムに回転
-	Matrix4x4 rotationMatrix = MakeRotateXYZMatrix(rotation);
-
-	// ランダム位置を回転行列で変換
-	Vector3 rotatedPosition = {
-		randomTranslate.x * rotationMatrix.m[0][0] + randomTranslate.y * rotationMatrix.m[1][0] + randomTranslate.z * rotationMatrix.m[2][0],
-		randomTranslate.x * rotationMatrix.m[0][1] + randomTranslate.y * rotationMatrix.m[1][1] + randomTranslate.z * rotationMatrix.m[2][1],
-		randomTranslate.x * rotationMatrix.m[0][2] + randomTranslate.y * rotationMatrix.m[1][2] + randomTranslate.z * rotationMatrix.m[2][2]
-	};
-
-	// 回転されたランダムな位置をトランスレーションに加算
-	particle.transform.translation_ = translate + rotatedPosition;
-
-	if (isRandomAllSize_) {
-		std::uniform_real_distribution<float> distScaleX(allScaleMin.x, allScaleMax.x);
-		std::uniform_real_distribution<float> distScaleY(allScaleMin.y, allScaleMax.y);
-		std::uniform_real_distribution<float> distScaleZ(allScaleMin.z, allScaleMax.z);
-
-		particle.startScale = { distScaleX(randomEngine),distScaleY(randomEngine),distScaleZ(randomEngine) };
-	}
-	else if (isRandomSize_) {
-		std::uniform_real_distribution<float> distScale(scaleMin, scaleMax);
-		particle.startScale.x = distScale(randomEngine);
-		particle.startScale.y = particle.startScale.x;
-		particle.startScale.z = particle.startScale.x;
-
-	}
-	else {
-		particle.startScale = particleStartScale;
-	}
-
-	particle.endScale = particleEndScale;
-
-	particle.startAcce = startAcce;
-	particle.endAcce = endAcce;
-
-	// パーティクルの速度をランダムに設定
-	Vector3 randomVelocity = {
-		distVelocityX(randomEngine),
-		distVelocityY(randomEngine),
-		distVelocityZ(randomEngine)
-	};
-
-	// エミッターの回転を速度ベクトルに適用
-	particle.velocity = {
-		randomVelocity.x * rotationMatrix.m[0][0] + randomVelocity.y * rotationMatrix.m[1][0] + randomVelocity.z * rotationMatrix.m[2][0],
-		randomVelocity.x * rotationMatrix.m[0][1] + randomVelocity.y * rotationMatrix.m[1][1] + randomVelocity.z * rotationMatrix.m[2][1],
-		randomVelocity.x * rotationMatrix.m[0][2] + randomVelocity.y * rotationMatrix.m[1][2] + randomVelocity.z * rotationMatrix.m[2][2]
-	};
-
-
-	if (isRandomRotate_) {
-		// 回転速度をランダムに設定
-		std::uniform_real_distribution<float> distRotateXVelocity(rotateVelocityMin.x, rotateVelocityMax.x);
-		std::uniform_real_distribution<float> distRotateYVelocity(rotateVelocityMin.y, rotateVelocityMax.y);
-		std::uniform_real_distribution<float> distRotateZVelocity(rotateVelocityMin.z, rotateVelocityMax.z);
-		std::uniform_real_distribution<float> distRotateX(0.0f, 2.0f);
-		std::uniform_real_distribution<float> distRotateY(0.0f, 2.0f);
-		std::uniform_real_distribution<float> distRotateZ(0.0f, 2.0f);
-		particle.rotateVelocity.x = distRotateXVelocity(randomEngine);
-		particle.rotateVelocity.y = distRotateYVelocity(randomEngine);
-		particle.rotateVelocity.z = distRotateZVelocity(randomEngine);
-		particle.transform.rotation_.x = distRotateX(randomEngine);
-		particle.transform.rotation_.y = distRotateY(randomEngine);
-		particle.transform.rotation_.z = distRotateZ(randomEngine);
-	}
-	else {
-		particle.startRote = startRote;
-		particle.endRote = endRote;
-	}
-
-	if (isRamdomColor) {
-		std::uniform_real_distribution<float> distColor(0.0f, 1.0f);
-		particle.color = { distColor(randomEngine), distColor(randomEngine), distColor(randomEngine), distAlpha(randomEngine) };
-	}
-	else {
-		particle.color = { 1.0f,1.0f,1.0f, distAlpha(randomEngine) };
-	}
-
-	particle.initialAlpha = distAlpha(randomEngine);
-	particle.lifeTime = distLifeTime(randomEngine);
-	particle.currentTime = 0.0f;
-
-	return particle;
-}
-
 ParticleManager::MaterialData ParticleManager::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename)
 {
 	MaterialData materialData;
@@ -511,55 +586,34 @@ void ParticleManager::CreateMaterial()
 	materialData->uvTransform = MakeIdentity4x4();
 }
 
-std::list<ParticleManager::Particle> ParticleManager::Emit(
-	const std::string name,
-	const Vector3& position,
-	uint32_t count,
-	const Vector3& scale,
-	const Vector3& velocityMin, const Vector3& velocityMax,
-	float lifeTimeMin, float lifeTimeMax,
-	const Vector3& particleStartScale, const Vector3& particleEndScale,
-	const Vector3& startAcce, const Vector3& endAcce,
-	const Vector3& startRote, const Vector3& endRote,
-	bool isRandomColor, float alphaMin, float alphaMax,
-	const Vector3& rotateVelocityMin, const Vector3& rotateVelocityMax,
-	const Vector3& allScaleMax, const Vector3& allScaleMin,
-	const float& scaleMin, const float& scaleMax, const Vector3& rotation)
+uint32_t ParticleManager::Emit(GroupHandle handle, const EmitterParams& params, uint32_t count, Pcg32& random)
 {
-	assert(particleGroups.find(name) != particleGroups.end() && "Error: パーティクルグループが存在しません。");
-
-	ParticleGroup& particleGroup = particleGroups[name];
-
-	std::list<Particle> newParticles;
-	for (uint32_t nowCount = 0; nowCount < count; ++nowCount) {
-		Particle particle = MakeNewParticle(
-			randomEngine,
-			position,
-			rotation,
-			scale,
-			velocityMin,
-			velocityMax,
-			lifeTimeMin,
-			lifeTimeMax,
-			particleStartScale,
-			particleEndScale,
-			startAcce,
-			endAcce,
-			startRote,
-			endRote,
-			isRandomColor,
-			alphaMin,
-			alphaMax,
-			rotateVelocityMin,
-			rotateVelocityMax,
-			allScaleMax, allScaleMin,
-			scaleMin, scaleMax
-		);
-		newParticles.push_back(particle);
-	}
-
-	particleGroup.particles.splice(particleGroup.particles.end(), newParticles);
-
-	return newParticles;
+	assert(handle.IsValid() && "Error: パーティクルグループが存在しません。");
+
+	ParticleGroup& particleGroup = particleGroups[handle.index];
+
+	// 同じ挙動フラグの配列へ入れる（無ければ作る）
+	auto it = std::find_if(particleGroup.storages.begin(), particleGroup.storages.end(),
+		[&params](const ParticleStorage& storage) { return storage.GetFlags() == params.flags; });
+	ParticleStorage& storage = (it != particleGroup.storages.end()) ? *it : particleGroup.storages.emplace_back(params.flags);
+
+	return storage.Emit(params, count, random);
+}
+
+void ParticleManager::SetSeed(uint64_t seed)
+{
+	seed_ = seed;
+	randomCounts_.clear();
+}
+
+Pcg32 ParticleManager::CreateRandom(const std::string& name)
+{
+	// 名前の FNV-1a に作った順を混ぜて列の番号にする（同じ名前のエミッタが同じ列にならないようにする）
+	uint64_t stream = 0xcbf29ce484222325ULL;
+	for (char c : name) {
+		stream = (stream ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+	}
+	stream ^= static_cast<uint64_t>(randomCounts_[name]++) * 0x9e3779b97f4a7c15ULL;
+	return Pcg32(seed_, stream);
 }
 } // namespace Engine
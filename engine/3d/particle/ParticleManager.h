@@ -1,9 +1,13 @@
 #pragma once
+#include "FixedTimestep.h"
 #include "ParticleCommon.h"
+#include "ParticleCompaction.h"
+#include "ParticleStorage.h"
 #include "PrimitiveType.h"
 #include "SrvManager.h"
 #include "ViewProjection.h"
-#include "WorldTransform.h"
+#include "map"
+#include "memory"
 #include "random"
 
 #include "Matrix4x4.h"
@@ -12,121 +16,189 @@
 #include "Vector4.h"
 
 /// <summary>
-/// パーティクル管理クラス
+/// パーティクル管理クラス（全エミッタ共有のプール）。
+/// 形状・テクスチャ・ブレンドの組ごとにグループを持ち、同じ組のエミッタは1つのグループを共有する
 /// </summary>
 namespace Engine {
 class ParticleManager {
+#pragma region シングルトンインスタンス
+  private:
+    static std::unique_ptr<ParticleManager> instance;
+
+    ParticleManager() = default;
+    ParticleManager(ParticleManager &) = delete;
+    ParticleManager &operator=(ParticleManager &) = delete;
+
+  public:
+    ~ParticleManager() = default;
+    // シングルトンインスタンスの取得
+    static ParticleManager *GetInstance();
+    // 終了
+    void Finalize();
+#pragma endregion シングルトンインスタンス
+
   public:
+    /// <summary>
+    /// グループへのハンドル（エミッタはこれだけを持つ）
+    /// </summary>
+    struct GroupHandle {
+        uint32_t index = UINT32_MAX;
+
+        bool IsValid() const { return index != UINT32_MAX; }
+    };
+
     /// <summary>
     /// 初期化
     /// </summary>
     void Initialize(SrvManager *srvManager);
 
     /// <summary>
-    /// 更新処理
+    /// フレームの開始（グループごとの更新・描画済みの印を外し、経過時間を固定ステップに換算する）
     /// </summary>
-    void Update(const ViewProjection &viewProjeciton);
+    /// <param name="deltaTime">前のフレームからの経過時間（Frame::DeltaTime）</param>
+    void BeginFrame(float deltaTime);
 
     /// <summary>
-    /// 描画処理
+    /// このフレームで進める固定ステップ（エミッタの発生もこれに合わせる）
     /// </summary>
-    void Draw(PrimitiveType primitiveType);
+    const FixedTimestep::Step &GetStep() const { return step_; }
 
     /// <summary>
-    /// パーティクルグループ生成
+    /// 乱数のシードを決める（同じシード・同じ順で作ったエミッタは同じ乱数列になる。記録した操作の再生用）
     /// </summary>
-    /// <param name="name"></param>
-    /// <param name="textureFilePath"></param>
-    void CreateParticleGroup(const std::string name, const std::string &filename);
+    void SetSeed(uint64_t seed);
 
-  public:
-    /// 各ステータス設定関数
-    /// <returns></returns>
-    void SetBillBorad(bool isBillBoard) { isBillboard = isBillBoard; }
-    void SetRandomRotate(bool isRandomRotate) { isRandomRotate_ = isRandomRotate; }
-    void SetAcceMultipy(bool isAcceMultipy) { isAcceMultipy_ = isAcceMultipy; }
-    void SetRandomSize(bool isRandomSize) { isRandomSize_ = isRandomSize; }
-    void SetAllRandomSize(bool isAllRandomSize) { isRandomAllSize_ = isAllRandomSize; }
-    void SetSinMove(bool isSinMove) { isSinMove_ = isSinMove; }
+    /// <summary>
+    /// エミッタごとの乱数列を作る（名前と、同じ名前の中で作った順から決める）
+    /// </summary>
+    Pcg32 CreateRandom(const std::string &name);
 
-  private:
     /// <summary>
-    /// 頂点データ作成
+    /// グループの登録（同じ形状・テクスチャ・ブレンドの組なら既存のグループを共有する）
     /// </summary>
-    void CreateVartexData(const std::string &filename);
+    /// <param name="filename">モデルのファイルパス（テクスチャはこの .mtl から取る）</param>
+    /// <param name="primitiveType">描画する形状</param>
+    /// <param name="blendMode">ブレンドモード</param>
+    GroupHandle RegisterGroup(const std::string &filename, PrimitiveType primitiveType, BlendMode blendMode);
 
     /// <summary>
-    /// 円状頂点データ作成
+    /// グループの登録解除（使うエミッタが無くなったら残りのパーティクルを消す。バッファは再登録に備えて残す）。
+    /// 終了処理の後に破棄されたエミッタから呼ばれても何もしない
     /// </summary>
-    void CreateRingVartexData();
+    static void ReleaseGroup(GroupHandle handle);
 
     /// <summary>
-    /// 円柱状頂点データ作成
+    /// 更新処理（共有しているエミッタの分もまとめて、1フレームに1回だけ行う）。
+    /// ここでは行列を控えるだけで、実際の更新は FlushUpdates で全グループまとめて並列に行う。
+    /// 描画するのは視錐台に入ったものだけで、通常ブレンドのグループは奥から手前の順に並べる
     /// </summary>
-    void CreateCylinderVartexData();
+    void Update(GroupHandle handle, const ViewProjection &viewProjeciton);
+
+    /// <summary>
+    /// 控えておいた更新をまとめて行う（最初の描画・フレームの開始で自動的に呼ばれる）
+    /// </summary>
+    void FlushUpdates();
+
+    /// <summary>
+    /// 描画処理（共有しているエミッタの分もまとめて、1フレームに1回だけ行う）
+    /// </summary>
+    void Draw(GroupHandle handle);
+
+    /// <summary>
+    /// 指定したグループにパーティクルをまとめて発生させる
+    /// </summary>
+    /// <param name="params">発生のパラメータ（挙動フラグごとに別の配列へ入る）</param>
+    /// <param name="count">発生させる数</param>
+    /// <param name="random">発生させるエミッタの乱数列</param>
+    /// <returns>発生させた数</returns>
+    uint32_t Emit(GroupHandle handle, const EmitterParams &params, uint32_t count, Pcg32 &random);
 
   private:
-    struct ParticleForGPU {
-        Matrix4x4 WVP;
-        Matrix4x4 World;
-        Vector4 color;
+    struct MaterialData {
+        std::string textureFilePath;
     };
 
-    struct Particle {
-        WorldTransform transform;
-        Vector3 velocity;
-        Vector3 Acce;
-        Vector4 color;
-        float lifeTime;
-        float currentTime;
-        Vector3 startScale;
-        Vector3 endScale;
-        Vector3 startAcce;
-        Vector3 endAcce;
-        Vector3 startRote;
-        Vector3 endRote;
-        Vector3 rotateVelocity;
-        float initialAlpha;
+    // --- 頂点データ ---
+    struct VertexData {
+        Vector4 position;
+        Vector2 texcoord;
     };
 
-    struct MaterialData {
+    struct ModelData {
+        std::vector<VertexData> vertices;
+        MaterialData material;
+    };
+
+    // 共有の形状（モデルごと・円・円柱で1つずつ）
+    struct Mesh {
+        Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource = nullptr;
+        D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+        uint32_t vertexCount = 0;
+        float radius = 0.0f; // 原点からの最大距離（カリング用）
+    };
+
+    // グループの識別（形状・テクスチャ・ブレンド）
+    struct GroupKey {
+        std::string meshName;
         std::string textureFilePath;
+        BlendMode blendMode;
+
+        auto operator<=>(const GroupKey &other) const = default;
     };
 
     struct ParticleGroup {
-        MaterialData material;
-        std::list<Particle> particles;
+        GroupKey key;
+        const Mesh *mesh = nullptr;
+        std::vector<ParticleStorage> storages; // 挙動フラグの組ごとの配列
         uint32_t instancingSRVIndex = 0;
         Microsoft::WRL::ComPtr<ID3D12Resource> instancingResource = nullptr;
+        uint32_t instanceCapacity = 0; // 確保済みのインスタンス数（必要になった分だけ伸ばす）
         uint32_t instanceCount = 0;
         ParticleForGPU *instancingData = nullptr;
+        std::vector<ParticleForGPU> stagingInstances; // カリング前の全インスタンス
+        uint32_t particleCount = 0;                   // stagingInstances の有効な数
+        Matrix4x4 viewProjectionMatrix; // 更新を控えたときのカメラ
+        Matrix4x4 billboardMatrix;
+        uint32_t refCount = 0;         // 使っているエミッタの数
+        bool isUpdated = false;        // このフレームで更新済みか
+        bool isDrawn = false;          // このフレームで描画済みか
     };
 
-    ParticleCommon *particleCommon = nullptr;
-    SrvManager *srvManager_;
+    /// <summary>
+    /// 形状の取得（無ければ頂点バッファを作る）
+    /// </summary>
+    const Mesh *GetMesh(const std::string &meshName, const ModelData &modelData);
 
-    // --- 頂点データ ---
-    struct VertexData {
-        Vector4 position;
-        Vector2 texcoord;
-    };
-    Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource = nullptr;
-    VertexData *vertexData = nullptr;
-    D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
+    /// <summary>
+    /// インスタンス用バッファを必要な数まで広げる（前のバッファは次のフレームの開始まで残す）
+    /// </summary>
+    void ReserveInstance(ParticleGroup &particleGroup, uint32_t count);
+
+#ifdef _DEBUG
+    // パーティクル計測パネル
+    void DrawBenchmark();
+#endif // _DEBUG
+
+    /// <summary>
+    /// 円状頂点データ作成
+    /// </summary>
+    void CreateRingVartexData();
+
+    /// <summary>
+    /// 円柱状頂点データ作成
+    /// </summary>
+    void CreateCylinderVartexData();
+
+    ParticleCommon *particleCommon = nullptr;
+    SrvManager *srvManager_ = nullptr;
 
     // 円形データ
-    Microsoft::WRL::ComPtr<ID3D12Resource> ringVertexResource = nullptr;
-    VertexData *ringVertexData = nullptr;
-    D3D12_VERTEX_BUFFER_VIEW ringVertexBufferView;
     const uint32_t kRingDivide = 32;
     const float kOuterRadius = 1.0f;
     const float kInnerRadius = 0.2f;
     const float ringRadianPerDivide = 2.0f * std::numbers::pi_v<float> / float(kRingDivide);
 
     // 円柱データ
-    Microsoft::WRL::ComPtr<ID3D12Resource> cylinderVertexResource = nullptr;
-    VertexData *cylinderVertexData = nullptr;
-    D3D12_VERTEX_BUFFER_VIEW cylinderVertexBufferView;
     const uint32_t kCylinderDivide = 32;
     const float kTopRadius = 1.0f;
     const float kBottomRadius = 1.0f;
@@ -142,13 +214,7 @@ class ParticleManager {
     Microsoft::WRL::ComPtr<ID3D12Resource> materialResource = nullptr;
     Material *materialData = nullptr;
 
-    struct ModelData {
-        std::vector<VertexData> vertices;
-        MaterialData material;
-    };
-    ModelData modelData;
     static std::unordered_map<std::string, ModelData> modelCache;
-    std::unordered_map<std::string, ParticleGroup> particleGroups;
 
     // 円形データ
     ModelData ringModelData;
@@ -156,31 +222,34 @@ class ParticleManager {
     // 円柱データ
     ModelData cylinderModelData;
 
-    // --- デルタタイム ---
-    const float kDeltaTime = 1.0f / 60.0f;
-    static const uint32_t kNumMaxInstance = 10000;
+    // 形状（モデルのパス・円・円柱で引く）
+    std::unordered_map<std::string, Mesh> meshes_;
+    // グループ（ハンドルの番号で引く。登録解除しても詰めない）
+    std::vector<ParticleGroup> particleGroups;
+    std::map<GroupKey, uint32_t> groupIndices_;
+    // 広げる前のインスタンス用バッファ（記録済みのコマンドが参照しうるので、GPUの完了を待った次のフレームの開始で手放す）
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> retiredInstancingResources_;
 
-    std::random_device seedGenerator;
-    std::mt19937 randomEngine;
+    // 更新を控えているグループ（Update が呼ばれた順）と、並列更新の作業領域
+    std::vector<uint32_t> pendingGroups_;
+    std::vector<ParticleStorage *> pendingStorages_;
+    std::vector<ParticleStorage::Target> updateTargets_;
+    ParticleStorage::Workspace updateWorkspace_;
+    std::vector<ParticleCompaction::Workspace> compactionWorkspaces_; // スレッドごと
+    // 更新に使うスレッド数（0なら JobSystem の全スレッド）
+    int32_t updateThreads_ = 0;
 
-    bool isBillboard = false;
-    bool isRandomRotate_ = false;
-    bool isAcceMultipy_ = false;
-    bool isRandomSize_ = false;
-    bool isRandomAllSize_ = false;
-    bool isSinMove_ = false;
+    // --- 固定ステップ（フレームレートによらず同じ間隔で進め、描画はステップの間を補間する） ---
+    static constexpr float kFixedDeltaTime = 1.0f / 60.0f;
+    static constexpr uint32_t kMaxStepsPerFrame = 4;
+    FixedTimestep timestep_{kFixedDeltaTime, kMaxStepsPerFrame};
+    FixedTimestep::Step step_{kFixedDeltaTime};
+    static constexpr uint32_t kNumMaxInstance = 10000;
+    static constexpr uint32_t kMinInstanceCapacity = 64;
 
-  public:
-    /// <summary>
-    /// 指定した名前のパーティクルグループにパーティクルを発生させる
-    /// </summary>
-    std::list<Particle> Emit(const std::string name, const Vector3 &position, uint32_t count, const Vector3 &scale,
-                             const Vector3 &velocityMin, const Vector3 &velocityMax, float lifeTimeMin, float lifeTimeMax,
-                             const Vector3 &particleStartScale, const Vector3 &particleEndScale, const Vector3 &startAcce, const Vector3 &endAcce,
-                             const Vector3 &startRote, const Vector3 &endRote, bool isRandomColor, float alphaMin, float alphaMax,
-                             const Vector3 &rotateVelocityMin, const Vector3 &rotateVelocityMax,
-                             const Vector3 &allScaleMax, const Vector3 &allScaleMin,
-                             const float &scaleMin, const float &scaleMax, const Vector3 &rotation);
+    std::random_device seedGenerator;
+    uint64_t seed_ = 0;
+    std::unordered_map<std::string, uint32_t> randomCounts_; // 名前ごとに作った乱数列の数
 
   private:
     /// <summary>
@@ -203,15 +272,5 @@ class ParticleManager {
     /// マテリアルデータ作成
     /// </summary>
     void CreateMaterial();
-
-    Particle MakeNewParticle(std::mt19937 &randomEngine,
-                             const Vector3 &translate,
-                             const Vector3 &rotation,
-                             const Vector3 &scale,
-                             const Vector3 &velocityMin, const Vector3 &velocityMax,
-                             float lifeTimeMin, float lifeTimeMax, const Vector3 &particleStartScale, const Vector3 &particleEndScale,
-                             const Vector3 &startAcce, const Vector3 &endAcce, const Vector3 &startRote, const Vector3 &endRote, bool isRamdomColor, float alphaMin, float alphaMax, const Vector3 &rotateVelocityMin, const Vector3 &rotateVelocityMax,
-                             const Vector3 &allScaleMax, const Vector3 &allScaleMin,
-                             const float &scaleMin, const float &scaleMax);
 };
 } // namespace Engine
@@ -0,0 +1,662 @@
+#define NOMINMAX
+#include "ParticleStorage.h"
+#include "JobSystem.h"
+#include "myMath.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <utility>
+
+namespace Engine {
+namespace {
+using Field = ParticleStorage::Field;
+
+// ParticleForGPU を float の並びとして書き込む（WVP・World・色の順）
+constexpr uint32_t kInstanceFloats = 36;
+static_assert(sizeof(ParticleForGPU) == sizeof(float) * kInstanceFloats);
+
+///-------------------------------------------///
+/// 演算の差し替え（共通の演算にインスタンスデータの書き込みを足す）
+///-------------------------------------------///
+struct ScalarOps : Simd::ScalarOps {
+	// 1個分のインスタンスデータを書き込む
+	static void StoreInstances(const V (&values)[kInstanceFloats], ParticleForGPU* out, uint32_t /*count*/) {
+		std::memcpy(out, values, sizeof(ParticleForGPU));
+	}
+};
+
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+struct Avx2Ops : Simd::Avx2Ops {
+	// 8x8 の転置（8フィールド x 8個 → 8個 x 8フィールド）
+	static void Transpose8(const V* in, V* out) {
+		const V t0 = _mm256_unpacklo_ps(in[0], in[1]);
+		const V t1 = _mm256_unpackhi_ps(in[0], in[1]);
+		const V t2 = _mm256_unpacklo_ps(in[2], in[3]);
+		const V t3 = _mm256_unpackhi_ps(in[2], in[3]);
+		const V t4 = _mm256_unpacklo_ps(in[4], in[5]);
+		const V t5 = _mm256_unpackhi_ps(in[4], in[5]);
+		const V t6 = _mm256_unpacklo_ps(in[6], in[7]);
+		const V t7 = _mm256_unpackhi_ps(in[6], in[7]);
+		const V s0 = _mm256_shuffle_ps(t0, t2, 0x44);
+		const V s1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+		const V s2 = _mm256_shuffle_ps(t1, t3, 0x44);
+		const V s3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+		const V s4 = _mm256_shuffle_ps(t4, t6, 0x44);
+		const V s5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+		const V s6 = _mm256_shuffle_ps(t5, t7, 0x44);
+		const V s7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+		out[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+		out[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+		out[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+		out[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+		out[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+		out[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+		out[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+		out[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+	}
+
+	// 8個分のインスタンスデータを転置して書き込む（count が8未満なら先頭の count 個だけ）。
+	// 書き込み先はGPUのアップロード用（ライトコンバイン）なので、揃っていればキャッシュを通さずに流す
+	static void StoreInstances(const V (&values)[kInstanceFloats], ParticleForGPU* out, uint32_t count) {
+		alignas(32) float staging[kWidth * kInstanceFloats];
+
+		// 行列の32個は8個ずつ、色の4個は残りを0で埋めて転置する
+		V rows[kWidth];
+		for (uint32_t block = 0; block < 4; ++block) {
+			Transpose8(values + block * kWidth, rows);
+			for (uint32_t lane = 0; lane < kWidth; ++lane) {
+				_mm256_storeu_ps(staging + lane * kInstanceFloats + block * kWidth, rows[lane]);
+			}
+		}
+		const V color[kWidth] = {
+			values[32], values[33], values[34], values[35],
+			_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(),
+		};
+		Transpose8(color, rows);
+		for (uint32_t lane = 0; lane < kWidth; ++lane) {
+			_mm_storeu_ps(staging + lane * kInstanceFloats + 32, _mm256_castps256_ps128(rows[lane]));
+		}
+
+		float* destination = reinterpret_cast<float*>(out);
+		if (count == kWidth && (reinterpret_cast<uintptr_t>(destination) & 31) == 0) {
+			for (uint32_t i = 0; i < kInstanceFloats; ++i) {
+				_mm256_stream_ps(destination + i * kWidth, _mm256_load_ps(staging + i * kWidth));
+			}
+		}
+		else {
+			std::memcpy(destination, staging, sizeof(ParticleForGPU) * count);
+		}
+	}
+};
+#endif // ENGINE_SIMD_ENABLE_AVX2
+
+///-------------------------------------------///
+/// sin / cos の同時計算（スカラーとAVX2で同じ結果になるよう多項式で近似する）
+///-------------------------------------------///
+template<class Ops>
+void SinCos(typename Ops::V x, typename Ops::V& outSin, typename Ops::V& outCos) {
+	using V = typename Ops::V;
+	using M = typename Ops::M;
+
+	// π/2 の何倍かを求め、π/2 を3つに分けて引く（引き算の桁落ちを抑える）
+	const V quotient = Ops::Floor(Ops::Add(Ops::Mul(x, Ops::Set1(2.0f / std::numbers::pi_v<float>)), Ops::Set1(0.5f)));
+	V r = Ops::Sub(x, Ops::Mul(quotient, Ops::Set1(1.5703125f)));
+	r = Ops::Sub(r, Ops::Mul(quotient, Ops::Set1(4.837512969970703125e-4f)));
+	r = Ops::Sub(r, Ops::Mul(quotient, Ops::Set1(7.54978995489188216e-8f)));
+
+	// [-π/4, π/4] での多項式
+	const V z = Ops::Mul(r, r);
+	V s = Ops::Add(Ops::Mul(Ops::Set1(-1.9515295891e-4f), z), Ops::Set1(8.3321608736e-3f));
+	s = Ops::Add(Ops::Mul(s, z), Ops::Set1(-1.6666654611e-1f));
+	s = Ops::Add(Ops::Mul(Ops::Mul(s, z), r), r);
+	V c = Ops::Add(Ops::Mul(Ops::Set1(2.443315711809948e-5f), z), Ops::Set1(-1.388731625493765e-3f));
+	c = Ops::Add(Ops::Mul(c, z), Ops::Set1(4.166664568298827e-2f));
+	c = Ops::Add(Ops::Sub(Ops::Mul(Ops::Mul(c, z), z), Ops::Mul(Ops::Set1(0.5f), z)), Ops::Set1(1.0f));
+
+	// 象限（0〜3）で入れ替えと符号を決める
+	const V quadrant = Ops::Sub(quotient, Ops::Mul(Ops::Floor(Ops::Mul(quotient, Ops::Set1(0.25f))), Ops::Set1(4.0f)));
+	const M quadrant1 = Ops::Equal(quadrant, Ops::Set1(1.0f));
+	const M quadrant2 = Ops::Equal(quadrant, Ops::Set1(2.0f));
+	const M quadrant3 = Ops::Equal(quadrant, Ops::Set1(3.0f));
+	const M swap = Ops::Or(quadrant1, quadrant3);
+	const V sinBase = Ops::Select(swap, c, s);
+	const V cosBase = Ops::Select(swap, s, c);
+	outSin = Ops::Select(Ops::GreaterEq(quadrant, Ops::Set1(2.0f)), Ops::Neg(sinBase), sinBase);
+	outCos = Ops::Select(Ops::Or(quadrant1, quadrant2), Ops::Neg(cosBase), cosBase);
+}
+
+///-------------------------------------------///
+/// 更新カーネル（挙動フラグごとにコンパイル時に分岐を外す）
+///-------------------------------------------///
+struct KernelArgs {
+	float* field[ParticleStorage::kFieldCount];
+	uint32_t begin;                 // 処理する範囲 [begin, end)
+	uint32_t end;
+	FixedTimestep::Step step;
+	const Matrix4x4* viewProjection;
+	const Matrix4x4* billboard;
+	ParticleForGPU* outInstances;   // begin 番目の書き込み先
+	uint32_t capacity;              // begin から数えて書き込める数
+};
+
+template<uint32_t kFlags, class Ops>
+void UpdateLanes(const KernelArgs& args, uint32_t begin, uint32_t end) {
+	using V = typename Ops::V;
+	using M = typename Ops::M;
+	constexpr bool kBillboard = (kFlags & ParticleStorage::kBillboard) != 0;
+	constexpr bool kRandomRotate = (kFlags & ParticleStorage::kRandomRotate) != 0;
+	constexpr bool kAcceMultiply = (kFlags & ParticleStorage::kAcceMultiply) != 0;
+	constexpr bool kSinMove = (kFlags & ParticleStorage::kSinMove) != 0;
+
+	float* const* field = args.field;
+
+	// 行列はループの外で全レーンに配っておく（フィールドへの書き込みと別の値だとコンパイラに分かるようにする）
+	V viewProjection[4][4];
+	V billboard[3][3];
+	for (uint32_t row = 0; row < 4; ++row) {
+		for (uint32_t column = 0; column < 4; ++column) {
+			viewProjection[row][column] = Ops::Set1(args.viewProjection->m[row][column]);
+			if (row < 3 && column < 3) {
+				billboard[row][column] = Ops::Set1(args.billboard->m[row][column]);
+			}
+		}
+	}
+	const V zero = Ops::Set1(0.0f);
+	const V one = Ops::Set1(1.0f);
+	const V deltaTime = Ops::Set1(args.step.deltaTime);
+	// 発生待ちの経過時間が0をまたいだとみなす境目（丸め誤差で0にぴったり戻らない分を吸収する）
+	const V bornThreshold = Ops::Set1(-0.5f * args.step.deltaTime);
+	// 描画は最後のステップから補間の割合だけ1つ前のステップ側へ戻す（時間と、ステップ単位の回転で別に持つ）
+	const float lagSteps = 1.0f - args.step.interpolation;
+	const V lagTime = Ops::Set1(lagSteps * args.step.deltaTime);
+	const V lagRotation = Ops::Set1(lagSteps);
+
+	for (uint32_t index = begin; index + Ops::kWidth <= end; index += Ops::kWidth) {
+		auto load = [&](Field f) { return Ops::Load(field[f] + index); };
+		auto store = [&](Field f, V value) { Ops::Store(field[f] + index, value); };
+
+		const V lifeTime = load(ParticleStorage::kLifeTime);
+		auto lerpAt = [&](V t, Field start, Field end) {
+			return Ops::Add(Ops::Mul(Ops::Sub(one, t), load(start)), Ops::Mul(t, load(end)));
+			};
+		auto ratioAt = [&](V time, V& t) {
+			const V ratio = Ops::Div(time, lifeTime);
+			t = Ops::Min(Ops::Max(ratio, zero), one);
+			return ratio;
+			};
+
+		// --- 状態を固定ステップで進める（途中のステップで発生したものは、そのステップまで時間だけ進める） ---
+		V currentTime = load(ParticleStorage::kCurrentTime);
+		V velocity[3];
+		V position[3];
+		V rotation[3];
+		for (uint32_t axis = 0; axis < 3; ++axis) {
+			velocity[axis] = load(static_cast<Field>(ParticleStorage::kVelocityX + axis));
+			position[axis] = load(static_cast<Field>(ParticleStorage::kPositionX + axis));
+			if constexpr (!kBillboard && kRandomRotate) {
+				rotation[axis] = load(static_cast<Field>(ParticleStorage::kRotationX + axis));
+			}
+		}
+		// 最後のステップを始めたときの経過時間（進めないフレームは1つ前のステップ）
+		V stepTime = Ops::Sub(currentTime, deltaTime);
+
+		for (uint32_t step = 0; step < args.step.count; ++step) {
+			const M isBorn = Ops::GreaterEq(currentTime, zero);
+			V t;
+			ratioAt(currentTime, t);
+
+			// 回転（ビルボードでは行列に使わないので進めない。補間のものは寿命から決まるので持たない）
+			if constexpr (!kBillboard && kRandomRotate) {
+				for (uint32_t axis = 0; axis < 3; ++axis) {
+					const V rotated = Ops::Add(rotation[axis], load(static_cast<Field>(ParticleStorage::kRotateVelocityX + axis)));
+					rotation[axis] = Ops::Select(isBorn, rotated, rotation[axis]);
+				}
+			}
+
+			// 加速と移動
+			for (uint32_t axis = 0; axis < 3; ++axis) {
+				const V acce = lerpAt(t, static_cast<Field>(ParticleStorage::kStartAcceX + axis), static_cast<Field>(ParticleStorage::kEndAcceX + axis));
+				V accelerated;
+				if constexpr (kAcceMultiply) {
+					accelerated = Ops::Mul(velocity[axis], acce);
+				}
+				else {
+					accelerated = Ops::Add(velocity[axis], acce);
+				}
+				velocity[axis] = Ops::Select(isBorn, accelerated, velocity[axis]);
+				position[axis] = Ops::Select(isBorn, Ops::Add(position[axis], Ops::Mul(velocity[axis], deltaTime)), position[axis]);
+			}
+
+			stepTime = currentTime;
+			const V nextTime = Ops::Add(currentTime, deltaTime);
+			currentTime = Ops::Select(Ops::Or(isBorn, Ops::GreaterEq(bornThreshold, nextTime)), nextTime, zero);
+		}
+
+		if (args.step.count > 0) {
+			for (uint32_t axis = 0; axis < 3; ++axis) {
+				store(static_cast<Field>(ParticleStorage::kVelocityX + axis), velocity[axis]);
+				store(static_cast<Field>(ParticleStorage::kPositionX + axis), position[axis]);
+				if constexpr (!kBillboard && kRandomRotate) {
+					store(static_cast<Field>(ParticleStorage::kRotationX + axis), rotation[axis]);
+				}
+			}
+			store(ParticleStorage::kCurrentTime, currentTime);
+		}
+
+		const uint32_t instanceIndex = index - args.begin;
+		if (instanceIndex >= args.capacity) {
+			continue;
+		}
+
+		// --- 描画する時点の値（最後のステップと1つ前のステップの間を補間する） ---
+		V t;
+		const V ratio = ratioAt(Ops::Sub(stepTime, lagTime), t);
+		const V inverseT = Ops::Sub(one, t);
+		auto lerp = [&](Field start, Field end) {
+			return Ops::Add(Ops::Mul(inverseT, load(start)), Ops::Mul(t, load(end)));
+			};
+		for (uint32_t axis = 0; axis < 3; ++axis) {
+			position[axis] = Ops::Sub(position[axis], Ops::Mul(velocity[axis], lagTime));
+		}
+
+		// --- 拡縮処理 ---
+		V scale[3];
+		V alpha;
+		if constexpr (kSinMove) {
+			// Sin波スケールに寿命で縮む最大スケールを掛ける
+			V waveSin, waveCos;
+			SinCos<Ops>(Ops::Mul(Ops::Mul(t, Ops::Set1(std::numbers::pi_v<float>)), Ops::Set1(18.0f)), waveSin, waveCos);
+			const V waveScale = Ops::Mul(Ops::Set1(0.5f), Ops::Add(waveSin, one));
+			for (uint32_t axis = 0; axis < 3; ++axis) {
+				scale[axis] = Ops::Mul(Ops::Mul(load(static_cast<Field>(ParticleStorage::kStartScaleX + axis)), waveScale), inverseT);
+			}
+			alpha = load(ParticleStorage::kColorA);
+		}
+		else {
+			// 通常の線形補間
+			for (uint32_t axis = 0; axis < 3; ++axis) {
+				scale[axis] = lerp(static_cast<Field>(ParticleStorage::kStartScaleX + axis), static_cast<Field>(ParticleStorage::kEndScaleX + axis));
+			}
+			alpha = Ops::Sub(load(ParticleStorage::kInitialAlpha), ratio);
+		}
+
+		// --- 回転 ---
+		if constexpr (!kBillboard) {
+			for (uint32_t axis = 0; axis < 3; ++axis) {
+				if constexpr (kRandomRotate) {
+					rotation[axis] = Ops::Sub(rotation[axis], Ops::Mul(load(static_cast<Field>(ParticleStorage::kRotateVelocityX + axis)), lagRotation));
+				}
+				else {
+					rotation[axis] = lerp(static_cast<Field>(ParticleStorage::kStartRoteX + axis), static_cast<Field>(ParticleStorage::kEndRoteX + axis));
+				}
+			}
+		}
+
+		// --- ワールド行列（S * R * T を展開して直接組み立てる。4列目は (0,0,0,1)） ---
+		V world[4][3];
+		if constexpr (kBillboard) {
+			for (uint32_t row = 0; row < 3; ++row) {
+				for (uint32_t column = 0; column < 3; ++column) {
+					world[row][column] = Ops::Mul(scale[row], billboard[row][column]);
+				}
+			}
+		}
+		else {
+			// R = Rx * Ry * Rz
+			V sinX, cosX, sinY, cosY, sinZ, cosZ;
+			SinCos<Ops>(rotation[0], sinX, cosX);
+			SinCos<Ops>(rotation[1], sinY, cosY);
+			SinCos<Ops>(rotation[2], sinZ, cosZ);
+			const V sinXsinY = Ops::Mul(sinX, sinY);
+			const V cosXsinY = Ops::Mul(cosX, sinY);
+			const V rotate[3][3] = {
+				{ Ops::Mul(cosY, cosZ), Ops::Mul(cosY, sinZ), Ops::Neg(sinY) },
+				{ Ops::Sub(Ops::Mul(sinXsinY, cosZ), Ops::Mul(cosX, sinZ)), Ops::Add(Ops::Mul(sinXsinY, sinZ), Ops::Mul(cosX, cosZ)), Ops::Mul(sinX, cosY) },
+				{ Ops::Add(Ops::Mul(cosXsinY, cosZ), Ops::Mul(sinX, sinZ)), Ops::Sub(Ops::Mul(cosXsinY, sinZ), Ops::Mul(sinX, cosZ)), Ops::Mul(cosX, cosY) },
+			};
+			for (uint32_t row = 0; row < 3; ++row) {
+				for (uint32_t column = 0; column < 3; ++column) {
+					world[row][column] = Ops::Mul(scale[row], rotate[row][column]);
+				}
+			}
+		}
+		for (uint32_t column = 0; column < 3; ++column) {
+			world[3][column] = position[column];
+		}
+
+		// --- インスタンスデータ（WVP = World * VP。World の4列目が (0,0,0,1) なので掛け算を省く） ---
+		V instance[kInstanceFloats];
+		for (uint32_t row = 0; row < 4; ++row) {
+			for (uint32_t column = 0; column < 4; ++column) {
+				V value = Ops::Mul(world[row][0], viewProjection[0][column]);
+				value = Ops::Add(value, Ops::Mul(world[row][1], viewProjection[1][column]));
+				value = Ops::Add(value, Ops::Mul(world[row][2], viewProjection[2][column]));
+				if (row == 3) {
+					value = Ops::Add(value, viewProjection[3][column]);
+				}
+				instance[row * 4 + column] = value;
+			}
+			for (uint32_t column = 0; column < 3; ++column) {
+				instance[16 + row * 4 + column] = world[row][column];
+			}
+			instance[16 + row * 4 + 3] = row == 3 ? one : zero;
+		}
+		instance[32] = load(ParticleStorage::kColorR);
+		instance[33] = load(ParticleStorage::kColorG);
+		instance[34] = load(ParticleStorage::kColorB);
+		instance[35] = alpha;
+
+		Ops::StoreInstances(instance, args.outInstances + instanceIndex, std::min(Ops::kWidth, args.capacity - instanceIndex));
+	}
+}
+
+// 幅で割り切れる分を Ops で、残りをスカラーで処理する
+template<uint32_t kFlags, class Ops>
+void UpdateKernel(const KernelArgs& args) {
+	const uint32_t vectorEnd = args.end - (args.end - args.begin) % Ops::kWidth;
+	UpdateLanes<kFlags, Ops>(args, args.begin, vectorEnd);
+	UpdateLanes<kFlags, ScalarOps>(args, vectorEnd, args.end);
+}
+
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+template<uint32_t kFlags>
+void UpdateKernelAvx2(const KernelArgs& args) {
+	UpdateKernel<kFlags, Avx2Ops>(args);
+	// 流した書き込みを後続の読み書きより先に終わらせる
+	_mm_sfence();
+	// SSE命令との切り替えペナルティを避ける
+	_mm256_zeroupper();
+}
+#endif // ENGINE_SIMD_ENABLE_AVX2
+
+///-------------------------------------------///
+/// フラグの組ごとのカーネル表（更新に関わる4つのフラグで16通り）
+///-------------------------------------------///
+using KernelFunction = void (*)(const KernelArgs&);
+constexpr uint32_t kKernelCount = 16;
+
+constexpr uint32_t KernelIndex(uint32_t flags) {
+	return (flags & (ParticleStorage::kBillboard | ParticleStorage::kRandomRotate | ParticleStorage::kAcceMultiply)) |
+		((flags & ParticleStorage::kSinMove) ? 8u : 0u);
+}
+
+constexpr uint32_t KernelFlags(uint32_t index) {
+	return (index & 7u) | ((index & 8u) ? uint32_t(ParticleStorage::kSinMove) : 0u);
+}
+
+template<size_t... kIndices>
+constexpr std::array<KernelFunction, kKernelCount> MakeScalarKernels(std::index_sequence<kIndices...>) {
+	return { &UpdateKernel<KernelFlags(kIndices), ScalarOps>... };
+}
+constexpr std::array<KernelFunction, kKernelCount> kScalarKernels = MakeScalarKernels(std::make_index_sequence<kKernelCount>{});
+
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+template<size_t... kIndices>
+constexpr std::array<KernelFunction, kKernelCount> MakeAvx2Kernels(std::index_sequence<kIndices...>) {
+	return { &UpdateKernelAvx2<KernelFlags(kIndices)>... };
+}
+constexpr std::array<KernelFunction, kKernelCount> kAvx2Kernels = MakeAvx2Kernels(std::make_index_sequence<kKernelCount>{});
+#endif // ENGINE_SIMD_ENABLE_AVX2
+} // namespace
+
+void ParticleStorage::Clear() {
+	size_ = 0;
+}
+
+void ParticleStorage::Push(const Particle& particle) {
+	if (size_ == capacity_) {
+		Grow(size_ + 1);
+	}
+	const float values[kFieldCount] = {
+		particle.position.x, particle.position.y, particle.position.z,
+		particle.velocity.x, particle.velocity.y, particle.velocity.z,
+		particle.rotation.x, particle.rotation.y, particle.rotation.z,
+		particle.rotateVelocity.x, particle.rotateVelocity.y, particle.rotateVelocity.z,
+		particle.startScale.x, particle.startScale.y, particle.startScale.z,
+		particle.endScale.x, particle.endScale.y, particle.endScale.z,
+		particle.startRote.x, particle.startRote.y, particle.startRote.z,
+		particle.endRote.x, particle.endRote.y, particle.endRote.z,
+		particle.startAcce.x, particle.startAcce.y, particle.startAcce.z,
+		particle.endAcce.x, particle.endAcce.y, particle.endAcce.z,
+		particle.color.x, particle.color.y, particle.color.z, particle.color.w,
+		particle.initialAlpha,
+		particle.lifeTime,
+		0.0f,
+	};
+	for (uint32_t field = 0; field < kFieldCount; ++field) {
+		data_[field * stride_ + size_] = values[field];
+	}
+	++size_;
+}
+
+void ParticleStorage::SwapRemove(uint32_t index) {
+	const uint32_t last = size_ - 1;
+	for (uint32_t field = 0; field < kFieldCount; ++field) {
+		data_[field * stride_ + index] = data_[field * stride_ + last];
+	}
+	--size_;
+}
+
+void ParticleStorage::Reserve(uint32_t count) {
+	if (count > capacity_) {
+		Grow(count);
+	}
+}
+
+void ParticleStorage::Grow(uint32_t minCapacity) {
+	uint32_t capacity = std::max(capacity_ * 2, kMinCapacity);
+	while (capacity < minCapacity) {
+		capacity *= 2;
+	}
+	const uint32_t stride = capacity + kFieldPadding;
+
+	std::vector<float> data(static_cast<size_t>(stride) * kFieldCount);
+	for (uint32_t field = 0; field < kFieldCount; ++field) {
+		std::copy_n(data_.data() + field * stride_, size_, data.data() + field * stride);
+	}
+
+	data_ = std::move(data);
+	stride_ = stride;
+	capacity_ = capacity;
+}
+
+uint32_t ParticleStorage::Emit(const EmitterParams& params, uint32_t count, Pcg32& random) {
+	if (count == 0) {
+		return 0;
+	}
+	Reserve(size_ + count);
+
+	float* field[kFieldCount];
+	for (uint32_t i = 0; i < kFieldCount; ++i) {
+		field[i] = GetField(static_cast<Field>(i));
+	}
+
+	// 発生範囲・速度の回転は1回の発生で共通
+	const Matrix4x4 rotationMatrix = MakeRotateXYZMatrix(params.rotation);
+	auto rotate = [&rotationMatrix](float x, float y, float z, uint32_t column) {
+		return x * rotationMatrix.m[0][column] + y * rotationMatrix.m[1][column] + z * rotationMatrix.m[2][column];
+		};
+
+	const uint32_t begin = size_;
+	const uint32_t end = size_ + count;
+	for (uint32_t index = begin; index < end; ++index) {
+		// スケールを考慮した位置を回転させて中心に足す
+		const float offsetX = random.Range(-1.0f, 1.0f) * params.scale.x;
+		const float offsetY = random.Range(-1.0f, 1.0f) * params.scale.y;
+		const float offsetZ = random.Range(-1.0f, 1.0f) * params.scale.z;
+		field[kPositionX][index] = params.position.x + rotate(offsetX, offsetY, offsetZ, 0);
+		field[kPositionY][index] = params.position.y + rotate(offsetX, offsetY, offsetZ, 1);
+		field[kPositionZ][index] = params.position.z + rotate(offsetX, offsetY, offsetZ, 2);
+
+		// 開始スケール
+		if (flags_ & kAllRandomSize) {
+			field[kStartScaleX][index] = random.Range(params.allScaleMin.x, params.allScaleMax.x);
+			field[kStartScaleY][index] = random.Range(params.allScaleMin.y, params.allScaleMax.y);
+			field[kStartScaleZ][index] = random.Range(params.allScaleMin.z, params.allScaleMax.z);
+		}
+		else if (flags_ & kRandomSize) {
+			const float scale = random.Range(params.scaleMin, params.scaleMax);
+			field[kStartScaleX][index] = scale;
+			field[kStartScaleY][index] = scale;
+			field[kStartScaleZ][index] = scale;
+		}
+		else {
+			field[kStartScaleX][index] = params.startScale.x;
+			field[kStartScaleY][index] = params.startScale.y;
+			field[kStartScaleZ][index] = params.startScale.z;
+		}
+		field[kEndScaleX][index] = params.endScale.x;
+		field[kEndScaleY][index] = params.endScale.y;
+		field[kEndScaleZ][index] = params.endScale.z;
+
+		field[kStartAcceX][index] = params.startAcce.x;
+		field[kStartAcceY][index] = params.startAcce.y;
+		field[kStartAcceZ][index] = params.startAcce.z;
+		field[kEndAcceX][index] = params.endAcce.x;
+		field[kEndAcceY][index] = params.endAcce.y;
+		field[kEndAcceZ][index] = params.endAcce.z;
+
+		// 速度にもエミッタの回転を適用する
+		const float velocityX = random.Range(params.velocityMin.x, params.velocityMax.x);
+		const float velocityY = random.Range(params.velocityMin.y, params.velocityMax.y);
+		const float velocityZ = random.Range(params.velocityMin.z, params.velocityMax.z);
+		field[kVelocityX][index] = rotate(velocityX, velocityY, velocityZ, 0);
+		field[kVelocityY][index] = rotate(velocityX, velocityY, velocityZ, 1);
+		field[kVelocityZ][index] = rotate(velocityX, velocityY, velocityZ, 2);
+
+		// 回転
+		if (flags_ & kRandomRotate) {
+			field[kRotateVelocityX][index] = random.Range(params.rotateVelocityMin.x, params.rotateVelocityMax.x);
+			field[kRotateVelocityY][index] = random.Range(params.rotateVelocityMin.y, params.rotateVelocityMax.y);
+			field[kRotateVelocityZ][index] = random.Range(params.rotateVelocityMin.z, params.rotateVelocityMax.z);
+			field[kRotationX][index] = random.Range(0.0f, 2.0f);
+			field[kRotationY][index] = random.Range(0.0f, 2.0f);
+			field[kRotationZ][index] = random.Range(0.0f, 2.0f);
+			field[kStartRoteX][index] = 0.0f;
+			field[kStartRoteY][index] = 0.0f;
+			field[kStartRoteZ][index] = 0.0f;
+			field[kEndRoteX][index] = 0.0f;
+			field[kEndRoteY][index] = 0.0f;
+			field[kEndRoteZ][index] = 0.0f;
+		}
+		else {
+			field[kRotateVelocityX][index] = 0.0f;
+			field[kRotateVelocityY][index] = 0.0f;
+			field[kRotateVelocityZ][index] = 0.0f;
+			field[kRotationX][index] = 0.0f;
+			field[kRotationY][index] = 0.0f;
+			field[kRotationZ][index] = 0.0f;
+			field[kStartRoteX][index] = params.startRote.x;
+			field[kStartRoteY][index] = params.startRote.y;
+			field[kStartRoteZ][index] = params.startRote.z;
+			field[kEndRoteX][index] = params.endRote.x;
+			field[kEndRoteY][index] = params.endRote.y;
+			field[kEndRoteZ][index] = params.endRote.z;
+		}
+
+		// 色
+		if (params.isRandomColor) {
+			field[kColorR][index] = random.NextFloat();
+			field[kColorG][index] = random.NextFloat();
+			field[kColorB][index] = random.NextFloat();
+		}
+		else {
+			field[kColorR][index] = 1.0f;
+			field[kColorG][index] = 1.0f;
+			field[kColorB][index] = 1.0f;
+		}
+		field[kColorA][index] = random.Range(params.alphaMin, params.alphaMax);
+		field[kInitialAlpha][index] = random.Range(params.alphaMin, params.alphaMax);
+		field[kLifeTime][index] = random.Range(params.lifeTimeMin, params.lifeTimeMax);
+		field[kCurrentTime][index] = -params.delay;
+	}
+
+	size_ = end;
+	return count;
+}
+
+void ParticleStorage::RemoveDead() {
+	// 末尾を持ってきて同じ位置をもう一度見る
+	uint32_t index = 0;
+	while (index < size_) {
+		if (GetField(kLifeTime)[index] <= GetField(kCurrentTime)[index]) {
+			SwapRemove(index);
+			continue;
+		}
+		++index;
+	}
+}
+
+void ParticleStorage::UpdateRange(uint32_t begin, uint32_t end, const FixedTimestep::Step& step, const Matrix4x4& viewProjection,
+	const Matrix4x4& billboard, ParticleForGPU* outInstances, uint32_t capacity, SimdLevel level) {
+	KernelArgs args;
+	for (uint32_t i = 0; i < kFieldCount; ++i) {
+		args.field[i] = GetField(static_cast<Field>(i));
+	}
+	args.begin = begin;
+	args.end = std::min(end, size_);
+	args.step = step;
+	args.viewProjection = &viewProjection;
+	args.billboard = &billboard;
+	args.outInstances = outInstances;
+	args.capacity = capacity;
+	if (args.begin >= args.end) {
+		return;
+	}
+
+	const uint32_t kernel = KernelIndex(flags_);
+	level = std::min(level, GetSupportedLevel());
+	switch (level) {
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+	case SimdLevel::kAVX2:
+		kAvx2Kernels[kernel](args);
+		break;
+#endif // ENGINE_SIMD_ENABLE_AVX2
+	default:
+		kScalarKernels[kernel](args);
+		break;
+	}
+}
+
+uint32_t ParticleStorage::Update(const FixedTimestep::Step& step, const Matrix4x4& viewProjection, const Matrix4x4& billboard,
+	ParticleForGPU* outInstances, uint32_t capacity, SimdLevel level) {
+	// 寿命の尽きたものを先に詰める
+	RemoveDead();
+	UpdateRange(0, size_, step, viewProjection, billboard, outInstances, capacity, level);
+	return std::min(size_, capacity);
+}
+
+void ParticleStorage::RemoveDeadParallel(const std::vector<ParticleStorage*>& storages, uint32_t maxThreads) {
+	// 配列の中は順番に詰めるしかないので、配列ごとに分担する
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(storages.size()), 1, [&](uint32_t begin, uint32_t end, uint32_t /*threadIndex*/) {
+		for (uint32_t i = begin; i < end; ++i) {
+			storages[i]->RemoveDead();
+		}
+		}, maxThreads);
+}
+
+void ParticleStorage::UpdateParallel(const std::vector<Target>& targets, const FixedTimestep::Step& step, SimdLevel level, uint32_t maxThreads,
+	Workspace& workspace) {
+	// 大きい配列は固定数ごとに区切る。区切りは命令の幅の倍数なので、1つで流した場合と結果は変わらない
+	workspace.chunks.clear();
+	for (uint32_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex) {
+		const uint32_t size = targets[targetIndex].storage->GetSize();
+		for (uint32_t begin = 0; begin < size; begin += kParticlesPerChunk) {
+			workspace.chunks.push_back({ targetIndex, begin, std::min(begin + kParticlesPerChunk, size) });
+		}
+	}
+
+	// 区切りごとに書き込み先の範囲が決まっているので、スレッド間で共有する状態は無い
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(workspace.chunks.size()), 1, [&](uint32_t begin, uint32_t end, uint32_t /*threadIndex*/) {
+		for (uint32_t i = begin; i < end; ++i) {
+			const Chunk& chunk = workspace.chunks[i];
+			const Target& target = targets[chunk.target];
+			const uint32_t capacity = target.capacity > chunk.begin ? target.capacity - chunk.begin : 0u;
+			target.storage->UpdateRange(chunk.begin, chunk.end, step, *target.viewProjection, *target.billboard,
+				target.outInstances + std::min(chunk.begin, target.capacity), capacity, level);
+		}
+		}, maxThreads);
+}
+} // namespace Engine
@@ -0,0 +1,233 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "FixedTimestep.h"
+#include "Matrix4x4.h"
+#include "SimdOps.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "random.h"
+
+namespace Engine {
+/// <summary>
+/// GPUへ送るインスタンスデータ
+/// </summary>
+struct ParticleForGPU {
+	Matrix4x4 WVP;
+	Matrix4x4 World;
+	Vector4 color;
+};
+
+/// <summary>
+/// 発生のパラメータ（エミッタの設定をまとめたもの）
+/// </summary>
+struct EmitterParams {
+	Vector3 position;                    // 発生の中心
+	Vector3 scale = { 1.0f, 1.0f, 1.0f };  // 発生範囲（中心から各軸に ±scale）
+	Vector3 rotation;                    // 発生範囲・速度の回転
+	Vector3 velocityMin = { -1.0f, -1.0f, -1.0f };
+	Vector3 velocityMax = { 1.0f, 1.0f, 1.0f };
+	float lifeTimeMin = 1.0f;
+	float lifeTimeMax = 3.0f;
+	Vector3 startScale = { 1.0f, 1.0f, 1.0f };
+	Vector3 endScale = { 1.0f, 1.0f, 1.0f };
+	Vector3 startAcce = { 1.0f, 1.0f, 1.0f };
+	Vector3 endAcce = { 1.0f, 1.0f, 1.0f };
+	Vector3 startRote;
+	Vector3 endRote;
+	bool isRandomColor = true;
+	float alphaMin = 1.0f;
+	float alphaMax = 1.0f;
+	Vector3 rotateVelocityMin = { -0.07f, -0.07f, -0.07f };
+	Vector3 rotateVelocityMax = { 0.07f, 0.07f, 0.07f };
+	Vector3 allScaleMin = { 1.0f, 1.0f, 1.0f }; // kAllRandomSize のときの軸ごとの範囲
+	Vector3 allScaleMax = { 1.0f, 1.0f, 1.0f };
+	float scaleMin = 0.0f;               // kRandomSize のときの範囲
+	float scaleMax = 1.0f;
+	uint32_t flags = 0;                  // 挙動フラグ（ParticleStorage::Flag の組み合わせ）
+	float delay = 0.0f;                  // 動き出すまでの時間（固定ステップの途中で発生したものを、そのステップから動かす）
+};
+
+/// <summary>
+/// パーティクルをSoA(フィールドごとの配列)で保持する。
+/// 挙動フラグは配列ごとに1つで、消すときは末尾と入れ替えて詰める（並び順は保たない）
+/// </summary>
+class ParticleStorage {
+public:
+	/// <summary>
+	/// 更新に使う命令セット
+	/// </summary>
+	using SimdLevel = Simd::Level; // kSSE はスカラーで処理する
+
+	/// <summary>
+	/// 挙動フラグ（発生させたエミッタの設定）
+	/// </summary>
+	enum Flag : uint32_t {
+		kBillboard = 1 << 0,
+		kRandomRotate = 1 << 1,
+		kAcceMultiply = 1 << 2,
+		kRandomSize = 1 << 3,
+		kAllRandomSize = 1 << 4,
+		kSinMove = 1 << 5,
+	};
+
+	// フィールド
+	enum Field : uint32_t {
+		kPositionX, kPositionY, kPositionZ,
+		kVelocityX, kVelocityY, kVelocityZ,
+		kRotationX, kRotationY, kRotationZ,
+		kRotateVelocityX, kRotateVelocityY, kRotateVelocityZ,
+		kStartScaleX, kStartScaleY, kStartScaleZ,
+		kEndScaleX, kEndScaleY, kEndScaleZ,
+		kStartRoteX, kStartRoteY, kStartRoteZ,
+		kEndRoteX, kEndRoteY, kEndRoteZ,
+		kStartAcceX, kStartAcceY, kStartAcceZ,
+		kEndAcceX, kEndAcceY, kEndAcceZ,
+		kColorR, kColorG, kColorB, kColorA,
+		kInitialAlpha,
+		kLifeTime,
+		kCurrentTime,
+		kFieldCount,
+	};
+
+	/// <summary>
+	/// 発生時の値
+	/// </summary>
+	struct Particle {
+		Vector3 position;
+		Vector3 velocity;
+		Vector3 rotation;
+		Vector3 rotateVelocity;
+		Vector3 startScale;
+		Vector3 endScale;
+		Vector3 startRote;
+		Vector3 endRote;
+		Vector3 startAcce;
+		Vector3 endAcce;
+		Vector4 color;
+		float initialAlpha = 1.0f;
+		float lifeTime = 1.0f;
+	};
+
+	/// <summary>
+	/// 並列更新の対象（1つの配列と、その書き込み先）
+	/// </summary>
+	struct Target {
+		ParticleStorage* storage = nullptr;
+		ParticleForGPU* outInstances = nullptr; // 先頭の書き込み先（グループ内で前の配列の数だけずらす）
+		uint32_t capacity = 0;                  // 書き込める数
+		const Matrix4x4* viewProjection = nullptr;
+		const Matrix4x4* billboard = nullptr;
+	};
+
+	/// <summary>
+	/// 並列更新の区切り（対象の [begin, end)）
+	/// </summary>
+	struct Chunk {
+		uint32_t target;
+		uint32_t begin;
+		uint32_t end;
+	};
+
+	/// <summary>
+	/// 並列更新の作業領域（毎フレーム使い回す）
+	/// </summary>
+	struct Workspace {
+		std::vector<Chunk> chunks;
+	};
+
+	// 1ジョブで受け持つパーティクル数（命令の幅の倍数）
+	static constexpr uint32_t kParticlesPerChunk = 4096;
+
+	explicit ParticleStorage(uint32_t flags = 0) : flags_(flags) {}
+
+	/// <summary>全要素の削除（確保済みの領域は残す）</summary>
+	void Clear();
+
+	/// <summary>要素の追加</summary>
+	void Push(const Particle& particle);
+
+	/// <summary>
+	/// まとめて発生させる（必要なら1回だけ確保を広げ、各フィールドへ直接書き込む）
+	/// </summary>
+	/// <param name="params">発生のパラメータ（挙動フラグはこの配列のものを使う）</param>
+	/// <param name="count">発生させる数</param>
+	/// <param name="random">乱数生成器</param>
+	/// <returns>発生させた数</returns>
+	uint32_t Emit(const EmitterParams& params, uint32_t count, Pcg32& random);
+
+	/// <summary>確保数を count 以上にする</summary>
+	void Reserve(uint32_t count);
+
+	/// <summary>要素の削除（末尾の要素を index へ移す）</summary>
+	void SwapRemove(uint32_t index);
+
+	/// <summary>
+	/// 固定ステップで進めてインスタンスデータを書き込む（寿命の尽きたものは消す）
+	/// </summary>
+	/// <param name="step">進めるステップ（0ステップなら書き込みだけ。描画は補間の割合の時点）</param>
+	/// <param name="viewProjection">ビュープロジェクション行列</param>
+	/// <param name="billboard">ビルボード行列（カメラの回転のみ。平行移動は持たないこと）</param>
+	/// <param name="outInstances">書き込み先</param>
+	/// <param name="capacity">書き込める数（超えた分は動かすだけで書き込まない）</param>
+	/// <param name="level">使う命令セット（CPUが対応していなければ下げる）</param>
+	/// <returns>書き込んだ数</returns>
+	uint32_t Update(const FixedTimestep::Step& step, const Matrix4x4& viewProjection, const Matrix4x4& billboard,
+		ParticleForGPU* outInstances, uint32_t capacity, SimdLevel level = SimdLevel::kAVX2);
+
+	/// <summary>寿命の尽きたものを消す（末尾と入れ替えて詰める）</summary>
+	void RemoveDead();
+
+	/// <summary>
+	/// [begin, end) だけを固定ステップで進めて書き込む（消すのは RemoveDead で先に済ませておく）
+	/// </summary>
+	/// <param name="outInstances">begin 番目の書き込み先</param>
+	/// <param name="capacity">begin から数えて書き込める数</param>
+	void UpdateRange(uint32_t begin, uint32_t end, const FixedTimestep::Step& step, const Matrix4x4& viewProjection, const Matrix4x4& billboard,
+		ParticleForGPU* outInstances, uint32_t capacity, SimdLevel level = SimdLevel::kAVX2);
+
+	/// <summary>
+	/// 複数の配列の RemoveDead を配列ごとに並列で行う
+	/// </summary>
+	/// <param name="maxThreads">使うスレッド数の上限（0なら JobSystem の全スレッド）</param>
+	static void RemoveDeadParallel(const std::vector<ParticleStorage*>& storages, uint32_t maxThreads);
+
+	/// <summary>
+	/// 複数の配列を区切りごとに並列で更新する（各区切りは書き込み先の自分の範囲にだけ書く）。
+	/// 区切り方・スレッド数によらず、1つずつ Update した場合と同じ結果になる
+	/// </summary>
+	/// <param name="targets">対象（RemoveDead 済みで、書き込み先は重ならないこと）</param>
+	/// <param name="maxThreads">使うスレッド数の上限（0なら JobSystem の全スレッド）</param>
+	/// <param name="workspace">作業領域</param>
+	static void UpdateParallel(const std::vector<Target>& targets, const FixedTimestep::Step& step, SimdLevel level, uint32_t maxThreads,
+		Workspace& workspace);
+
+	/// <summary>
+	/// 実行中のCPUで使える最上位の命令セット（初回のみ判定）
+	/// </summary>
+	static SimdLevel GetSupportedLevel() { return Simd::GetSupportedLevel(); }
+
+	uint32_t GetSize() const { return size_; }
+	uint32_t GetFlags() const { return flags_; }
+	float* GetField(Field field) { return data_.data() + field * stride_; }
+	const float* GetField(Field field) const { return data_.data() + field * stride_; }
+
+private:
+	/// <summary>
+	/// 確保数を増やす（フィールドごとに詰め直す）
+	/// </summary>
+	void Grow(uint32_t minCapacity);
+
+	// 全フィールドを1つの領域に並べる。フィールドごとに別確保すると先頭がページ境界に揃い、
+	// 同じ番号の要素が同じキャッシュセットに集まって追い出し合うので、間隔を1キャッシュライン分ずらす
+	static constexpr uint32_t kFieldPadding = 16;
+	static constexpr uint32_t kMinCapacity = 256;
+
+	std::vector<float> data_;
+	uint32_t stride_ = 0; // フィールド間の間隔（確保数 + kFieldPadding）
+	uint32_t capacity_ = 0;
+	uint32_t size_ = 0;
+	uint32_t flags_ = 0;
+};
+} // namespace Engine
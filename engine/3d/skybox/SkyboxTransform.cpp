@@ -26,7 +26,7 @@ void SkyboxTransform::Update(const ViewProjection &viewProjection, float scale)
     // 変換行列データの更新
     transformationMatrixData_->WVP = worldViewProjectionMatrix;
     transformationMatrixData_->World = worldMatrix;
-    transformationMatrixData_->WorldInverseTranspose = Transpose(Inverse(worldMatrix));
+    transformationMatrixData_->WorldInverseTranspose = InverseTransposeAffine(worldMatrix);
 
     // マテリアルデータの更新
     materialData_->color = {1.0f, 1.0f, 1.0f, 1.0f};
@@ -0,0 +1,289 @@
+#define NOMINMAX
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace Engine {
+std::unique_ptr<TransformHierarchy> TransformHierarchy::instance = nullptr;
+
+TransformHierarchy* TransformHierarchy::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = std::unique_ptr<TransformHierarchy>(new TransformHierarchy());
+	}
+	return instance.get();
+}
+
+void TransformHierarchy::Finalize()
+{
+	// 終了後に破棄された WorldTransform は Release で何もしない
+	instance.reset();
+}
+
+void TransformHierarchy::Update()
+{
+	// 親の付け替えを反映し、必要なら並べ直す
+	const uint32_t count = GetNodeCount();
+	for (uint32_t position = 0; position < count; ++position) {
+		if (owners_[position]->parent_ != ownerParents_[position]) {
+			SyncParent(position);
+		}
+	}
+	if (isOrderDirty_) {
+		Reorder();
+	}
+
+	// 親が先に並んでいるので、1パスで変わったノードとその子孫だけを計算できる
+	computedCount_ = 0;
+	for (uint32_t position = 0; position < count; ++position) {
+		if (ComputeNode(position)) {
+			++computedCount_;
+		}
+	}
+}
+
+uint32_t TransformHierarchy::Register(WorldTransform* owner)
+{
+	uint32_t node = 0;
+	if (!freeNodes_.empty()) {
+		node = freeNodes_.back();
+		freeNodes_.pop_back();
+	} else {
+		node = static_cast<uint32_t>(positions_.size());
+		positions_.push_back(kInvalidNode);
+		childCounts_.push_back(0);
+	}
+
+	// 親のないノードとして末尾に置く（親は次の UpdateNode / Update で決める）
+	positions_[node] = GetNodeCount();
+	nodes_.push_back(node);
+	owners_.push_back(owner);
+	ownerParents_.push_back(nullptr);
+	parents_.push_back(kNoParent);
+	scales_.push_back(owner->scale_);
+	rotations_.push_back(owner->rotation_);
+	translations_.push_back(owner->translation_);
+	localMatrices_.push_back(MakeAffineMatrix(owner->scale_, owner->rotation_, owner->translation_));
+	worldMatrices_.push_back(localMatrices_.back());
+	versions_.push_back(0);
+	parentVersions_.push_back(0);
+	isDirty_.push_back(1);
+	return node;
+}
+
+void TransformHierarchy::Release(uint32_t node)
+{
+	if (instance) {
+		instance->Unregister(node);
+	}
+}
+
+void TransformHierarchy::Unregister(uint32_t node)
+{
+	if (node >= positions_.size() || positions_[node] == kInvalidNode) {
+		return;
+	}
+
+	// 末尾のノードを空いた位置へ移す（親子の順番が崩れるので次の Update で並べ直す）
+	const uint32_t position = positions_[node];
+	if (parents_[position] < kExternalParent) {
+		--childCounts_[parents_[position]];
+	}
+	const uint32_t last = GetNodeCount() - 1;
+	if (position != last) {
+		nodes_[position] = nodes_[last];
+		owners_[position] = owners_[last];
+		ownerParents_[position] = ownerParents_[last];
+		parents_[position] = parents_[last];
+		scales_[position] = scales_[last];
+		rotations_[position] = rotations_[last];
+		translations_[position] = translations_[last];
+		localMatrices_[position] = localMatrices_[last];
+		worldMatrices_[position] = worldMatrices_[last];
+		versions_[position] = versions_[last];
+		parentVersions_[position] = parentVersions_[last];
+		isDirty_[position] = isDirty_[last];
+		positions_[nodes_[position]] = position;
+		isOrderDirty_ = true;
+	}
+	nodes_.pop_back();
+	owners_.pop_back();
+	ownerParents_.pop_back();
+	parents_.pop_back();
+	scales_.pop_back();
+	rotations_.pop_back();
+	translations_.pop_back();
+	localMatrices_.pop_back();
+	worldMatrices_.pop_back();
+	versions_.pop_back();
+	parentVersions_.pop_back();
+	isDirty_.pop_back();
+
+	// 子は親のないノードとして残す（ノード番号が使い回されても別の親につながらないように）
+	// 子のないノード（ほとんどの場合）は全体を探さない
+	if (childCounts_[node] > 0) {
+		const uint32_t count = GetNodeCount();
+		for (uint32_t childPosition = 0; childPosition < count; ++childPosition) {
+			if (parents_[childPosition] == node) {
+				parents_[childPosition] = kNoParent;
+				isDirty_[childPosition] = 1;
+			}
+		}
+		childCounts_[node] = 0;
+	}
+
+	positions_[node] = kInvalidNode;
+	freeNodes_.push_back(node);
+}
+
+void TransformHierarchy::Rebind(uint32_t node, WorldTransform* owner)
+{
+	owners_[positions_[node]] = owner;
+}
+
+void TransformHierarchy::UpdateNode(uint32_t node)
+{
+	const uint32_t position = positions_[node];
+	if (owners_[position]->parent_ != ownerParents_[position]) {
+		SyncParent(position);
+	}
+	ComputeNode(position);
+}
+
+void TransformHierarchy::TransferNode(uint32_t node)
+{
+	// matWorld_ を直接書き換えたときも、子へ伝わるようにする
+	const uint32_t position = positions_[node];
+	const WorldTransform& owner = *owners_[position];
+	if (std::memcmp(&worldMatrices_[position], &owner.matWorld_, sizeof(Matrix4x4)) != 0) {
+		worldMatrices_[position] = owner.matWorld_;
+		++versions_[position];
+	}
+}
+
+void TransformHierarchy::SyncParent(uint32_t position)
+{
+	const WorldTransform* parent = owners_[position]->parent_;
+	ownerParents_[position] = parent;
+
+	uint32_t parentNode = kNoParent;
+	if (parent) {
+		parentNode = parent->node_ != kInvalidNode ? parent->node_ : kExternalParent;
+	}
+	if (parentNode == parents_[position]) {
+		return;
+	}
+	if (parents_[position] < kExternalParent) {
+		--childCounts_[parents_[position]];
+	}
+	if (parentNode < kExternalParent) {
+		++childCounts_[parentNode];
+	}
+	parents_[position] = parentNode;
+	isDirty_[position] = 1;
+	if (parentNode < kExternalParent && positions_[parentNode] > position) {
+		isOrderDirty_ = true;
+	}
+}
+
+void TransformHierarchy::Reorder()
+{
+	const uint32_t count = GetNodeCount();
+
+	// 根からの深さ
+	std::vector<uint32_t> depths(count, UINT32_MAX);
+	std::vector<uint32_t> chain;
+	for (uint32_t position = 0; position < count; ++position) {
+		// 深さの分かっているノードか根まで辿る
+		uint32_t current = position;
+		while (depths[current] == UINT32_MAX) {
+			chain.push_back(current);
+			const uint32_t parent = parents_[current];
+			if (parent >= kExternalParent) {
+				break;
+			}
+			current = positions_[parent];
+			assert(chain.size() <= count && "Error: トランスフォームの親子関係が循環しています。");
+		}
+		// 根まで辿ったときは current が根（深さ未定）
+		uint32_t depth = depths[current] == UINT32_MAX ? 0 : depths[current] + 1;
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+			depths[*it] = depth++;
+		}
+		chain.clear();
+	}
+
+	// 深さの浅い順に並べる（同じ深さの中では今の順番を保つ）
+	std::vector<uint32_t> order(count);
+	for (uint32_t position = 0; position < count; ++position) {
+		order[position] = position;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return depths[a] < depths[b]; });
+
+	auto permute = [&](auto& array) {
+		std::remove_reference_t<decltype(array)> sorted;
+		sorted.reserve(count);
+		for (uint32_t position : order) {
+			sorted.push_back(array[position]);
+		}
+		array.swap(sorted);
+		};
+	permute(nodes_);
+	permute(owners_);
+	permute(ownerParents_);
+	permute(parents_);
+	permute(scales_);
+	permute(rotations_);
+	permute(translations_);
+	permute(localMatrices_);
+	permute(worldMatrices_);
+	permute(versions_);
+	permute(parentVersions_);
+	permute(isDirty_);
+	for (uint32_t position = 0; position < count; ++position) {
+		positions_[nodes_[position]] = position;
+	}
+	isOrderDirty_ = false;
+}
+
+bool TransformHierarchy::ComputeNode(uint32_t position)
+{
+	WorldTransform& owner = *owners_[position];
+	bool isDirty = isDirty_[position] != 0;
+
+	// ローカルの値が変わったときだけ作り直す
+	if (owner.scale_ != scales_[position] || owner.rotation_ != rotations_[position] || owner.translation_ != translations_[position]) {
+		scales_[position] = owner.scale_;
+		rotations_[position] = owner.rotation_;
+		translations_[position] = owner.translation_;
+		localMatrices_[position] = MakeAffineMatrix(owner.scale_, owner.rotation_, owner.translation_);
+		isDirty = true;
+	}
+
+	// 親のワールド行列が前回から変わったか
+	const uint32_t parent = parents_[position];
+	const Matrix4x4* parentMatrix = nullptr;
+	if (parent == kExternalParent) {
+		parentMatrix = &owner.parent_->matWorld_;
+		isDirty = true;
+	} else if (parent != kNoParent) {
+		const uint32_t parentPosition = positions_[parent];
+		if (parentVersions_[position] != versions_[parentPosition]) {
+			parentVersions_[position] = versions_[parentPosition];
+			isDirty = true;
+		}
+		parentMatrix = &worldMatrices_[parentPosition];
+	}
+	if (!isDirty) {
+		return false;
+	}
+
+	isDirty_[position] = 0;
+	const Matrix4x4 worldMatrix = parentMatrix ? localMatrices_[position] * *parentMatrix : localMatrices_[position];
+	worldMatrices_[position] = worldMatrix;
+	owner.matWorld_ = worldMatrix;
+	++versions_[position];
+	return true;
+}
+} // namespace Engine
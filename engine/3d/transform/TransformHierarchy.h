@@ -0,0 +1,127 @@
+#pragma once
+#include "WorldTransform.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// トランスフォーム階層クラス。
+/// Initialize 済みの WorldTransform をノードとして持ち、親が子より前に来る順番で連続した配列に並べる。
+/// 変更のあったノードとその子孫だけを1パスで計算し、結果は各 WorldTransform の matWorld_ に書き込む
+/// </summary>
+namespace Engine {
+class TransformHierarchy
+{
+#pragma region シングルトンインスタンス
+private:
+	static std::unique_ptr<TransformHierarchy> instance;
+
+	TransformHierarchy() = default;
+	TransformHierarchy(TransformHierarchy&) = delete;
+	TransformHierarchy& operator=(TransformHierarchy&) = delete;
+
+public:
+	~TransformHierarchy() = default;
+	// シングルトンインスタンスの取得
+	static TransformHierarchy* GetInstance();
+	// 終了
+	void Finalize();
+#pragma endregion シングルトンインスタンス
+
+public:
+
+	static constexpr uint32_t kInvalidNode = UINT32_MAX;
+
+	/// <summary>
+	/// 全ノードを親から順に1パスで更新する（シーンの更新の後、描画の前に1回呼ぶ）
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// ノードの登録（WorldTransform::Initialize から呼ぶ）
+	/// </summary>
+	/// <param name="owner">トランスフォーム</param>
+	/// <returns>ノード番号（登録中は変わらない）</returns>
+	uint32_t Register(WorldTransform* owner);
+
+	/// <summary>
+	/// ノードの登録解除（終了後に呼ばれたときは何もしない）
+	/// </summary>
+	/// <param name="node">ノード番号</param>
+	static void Release(uint32_t node);
+
+	/// <summary>
+	/// ノードの持ち主の付け替え（WorldTransform のムーブ用）
+	/// </summary>
+	void Rebind(uint32_t node, WorldTransform* owner);
+
+	/// <summary>
+	/// ノードの行列を、変更があったときだけ計算する（WorldTransform::UpdateMatrix から呼ぶ）
+	/// </summary>
+	/// <param name="node">ノード番号</param>
+	void UpdateNode(uint32_t node);
+
+	/// <summary>
+	/// 持ち主の matWorld_ をそのまま子へ伝える（WorldTransform::TransferMatrix から呼ぶ）
+	/// </summary>
+	/// <param name="node">ノード番号</param>
+	void TransferNode(uint32_t node);
+
+	/// 各ステータス取得関数
+	/// <returns></returns>
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(owners_.size()); }
+	uint32_t GetComputedCount() const { return computedCount_; }
+
+private:
+
+	/// <summary>
+	/// ノードの登録解除
+	/// </summary>
+	void Unregister(uint32_t node);
+
+	/// <summary>
+	/// 持ち主の parent_ からノードの親を決める
+	/// </summary>
+	void SyncParent(uint32_t position);
+
+	/// <summary>
+	/// 親が子より前に来るように並べ直す
+	/// </summary>
+	void Reorder();
+
+	/// <summary>
+	/// ノードの行列の計算（ローカルの値か親の行列が変わったときだけ）
+	/// </summary>
+	/// <returns>計算したか</returns>
+	bool ComputeNode(uint32_t position);
+
+private:
+
+	static constexpr uint32_t kNoParent = UINT32_MAX;
+	static constexpr uint32_t kExternalParent = UINT32_MAX - 1; // 親が登録されていない（毎回親の matWorld_ を読む）
+
+	// ノード番号 → 並び順の位置（空きは kInvalidNode）
+	std::vector<uint32_t> positions_;
+	std::vector<uint32_t> freeNodes_;
+	std::vector<uint32_t> childCounts_; // ノード番号 → 子の数（0 なら登録解除で子を探さない）
+
+	// 並び順（親が子より前）の配列
+	std::vector<uint32_t> nodes_;                       // 位置 → ノード番号
+	std::vector<WorldTransform*> owners_;
+	std::vector<const WorldTransform*> ownerParents_;   // 最後に見た parent_（付け替えの検出用）
+	std::vector<uint32_t> parents_;                     // 親のノード番号（kNoParent / kExternalParent）
+	std::vector<Vector3> scales_;
+	std::vector<Vector3> rotations_;
+	std::vector<Vector3> translations_;
+	std::vector<Matrix4x4> localMatrices_;
+	std::vector<Matrix4x4> worldMatrices_;
+	std::vector<uint32_t> versions_;                    // ワールド行列が変わるたびに増える
+	std::vector<uint32_t> parentVersions_;              // 最後に計算したときの親の versions_
+	std::vector<uint8_t> isDirty_;                      // 次の計算を必ず行う
+	bool isOrderDirty_ = false;
+
+	// 前回の Update の統計
+	uint32_t computedCount_ = 0;
+};
+} // namespace Engine
@@ -1,4 +1,5 @@
 #include "WorldTransform.h"
+#include "TransformHierarchy.h"
 
 namespace Engine {
 void WorldTransform::Initialize()
@@ -6,41 +7,104 @@ void WorldTransform::Initialize()
 	scale_ = { 1.0f, 1.0f, 1.0f };
 	rotation_ = { 0.0f, 0.0f, 0.0f };
 	translation_ = { 0.0f, 0.0f, 0.0f };
-	dxCommon_ = DirectXCommon::GetInstance();
 	matWorld_ = MakeIdentity4x4();
 
-	CreateConstBuffer();
-	Map();
+	if (node_ == TransformHierarchy::kInvalidNode) {
+		node_ = TransformHierarchy::GetInstance()->Register(this);
+	}
 	UpdateMatrix();
 }
 
 void WorldTransform::TransferMatrix()
 {
-	if (constMap) {
-		constMap->matWorld = matWorld_;
+	if (node_ != TransformHierarchy::kInvalidNode) {
+		TransformHierarchy::GetInstance()->TransferNode(node_);
 	}
 }
 
-void WorldTransform::CreateConstBuffer()
+void WorldTransform::UpdateMatrix()
 {
-	const UINT bufferSize = sizeof(ConstBufferDataWorldTransform);
-	constBuffer_ = dxCommon_->CreateBufferResource(bufferSize);
+	if (node_ != TransformHierarchy::kInvalidNode) {
+		TransformHierarchy::GetInstance()->UpdateNode(node_);
+		return;
+	}
+
+	// 登録されていないときはその場で計算する
+	matWorld_ = MakeAffineMatrix(scale_, rotation_, translation_);
+
+	if (parent_) {
+		matWorld_ *= parent_->matWorld_;
+	}
 }
 
-void WorldTransform::Map()
+WorldTransform::~WorldTransform()
 {
-	HRESULT hr = constBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&constMap));
+	if (node_ != TransformHierarchy::kInvalidNode) {
+		TransformHierarchy::Release(node_);
+	}
 }
 
-void WorldTransform::UpdateMatrix()
+WorldTransform::WorldTransform(const WorldTransform& other)
+	: scale_(other.scale_)
+	, rotation_(other.rotation_)
+	, translation_(other.translation_)
+	, matWorld_(other.matWorld_)
+	, parent_(other.parent_)
 {
-	matWorld_ = MakeAffineMatrix(scale_, rotation_, translation_);
+	if (other.node_ != TransformHierarchy::kInvalidNode) {
+		node_ = TransformHierarchy::GetInstance()->Register(this);
+	}
+}
 
-	if (parent_) {
-		matWorld_ *= parent_->matWorld_;
+WorldTransform::WorldTransform(WorldTransform&& other) noexcept
+	: scale_(other.scale_)
+	, rotation_(other.rotation_)
+	, translation_(other.translation_)
+	, matWorld_(other.matWorld_)
+	, parent_(other.parent_)
+	, node_(other.node_)
+{
+	if (node_ != TransformHierarchy::kInvalidNode) {
+		TransformHierarchy::GetInstance()->Rebind(node_, this);
+		other.node_ = TransformHierarchy::kInvalidNode;
 	}
+}
 
-	TransferMatrix();
+WorldTransform& WorldTransform::operator=(const WorldTransform& other)
+{
+	if (this == &other) {
+		return *this;
+	}
+	scale_ = other.scale_;
+	rotation_ = other.rotation_;
+	translation_ = other.translation_;
+	matWorld_ = other.matWorld_;
+	parent_ = other.parent_;
+	if (node_ == TransformHierarchy::kInvalidNode && other.node_ != TransformHierarchy::kInvalidNode) {
+		node_ = TransformHierarchy::GetInstance()->Register(this);
+	}
+	return *this;
+}
+
+WorldTransform& WorldTransform::operator=(WorldTransform&& other) noexcept
+{
+	if (this == &other) {
+		return *this;
+	}
+	scale_ = other.scale_;
+	rotation_ = other.rotation_;
+	translation_ = other.translation_;
+	matWorld_ = other.matWorld_;
+	parent_ = other.parent_;
+	if (other.node_ != TransformHierarchy::kInvalidNode) {
+		if (node_ != TransformHierarchy::kInvalidNode) {
+			TransformHierarchy::Release(node_);
+		}
+		node_ = other.node_;
+		other.node_ = TransformHierarchy::kInvalidNode;
+		TransformHierarchy::GetInstance()->Rebind(node_, this);
+	}
+	return *this;
 }
 
 } // namespace Engine
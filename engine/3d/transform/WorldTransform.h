@@ -4,6 +4,7 @@
 #include "DirectXCommon.h"
 
 #include "myMath.h"
+#include <cstdint>
 
 /// <summary>
 /// ワールド変換用定数バッファデータ
@@ -15,6 +16,7 @@ struct ConstBufferDataWorldTransform {
 
 /// <summary>
 /// ワールド変換クラス
+/// Initialize すると TransformHierarchy に登録され、行列は変更があったときだけ計算される
 /// </summary>
 class WorldTransform
 {
@@ -26,31 +28,15 @@ public:
 	void Initialize();
 
 	/// <summary>
-	/// 行列の転送
+	/// 行列の反映（matWorld_ を直接書き換えたときに子へ伝える）
 	/// </summary>
 	void TransferMatrix();
 
 	/// <summary>
-	/// 定数バッファ生成
-	/// </summary>
-	void CreateConstBuffer();
-
-	/// <summary>
-	/// マッピング
-	/// </summary>
-	void Map();
-
-	/// <summary>
-	/// 行列の計算・転送
+	/// 行列の計算（ローカルの値と親の行列が前回から変わっていなければ何もしない）
 	/// </summary>
 	void UpdateMatrix();
 
-	/// <summary>
-	/// 定数バッファの取得
-	/// </summary>
-	/// <returns></returns>
-	const Microsoft::WRL::ComPtr<ID3D12Resource>& GetConstBuffer() const { return constBuffer_; }
-
 public:
 
 	// --- ローカル座標情報 ---
@@ -63,15 +49,19 @@ public:
 	const WorldTransform* parent_ = nullptr;
 
 	WorldTransform() = default;
-	~WorldTransform() = default;
+	~WorldTransform();
+
+	// コピーしたものは別のノードとして登録し、ムーブしたものはノードを引き継ぐ
+	WorldTransform(const WorldTransform& other);
+	WorldTransform(WorldTransform&& other) noexcept;
+	WorldTransform& operator=(const WorldTransform& other);
+	WorldTransform& operator=(WorldTransform&& other) noexcept;
 
 private:
 
-	DirectXCommon* dxCommon_ = nullptr;
+	friend class TransformHierarchy;
 
-	// 定数バッファ
-	Microsoft::WRL::ComPtr<ID3D12Resource>constBuffer_;
-	// マッピング済み
-	ConstBufferDataWorldTransform* constMap = nullptr;
+	// TransformHierarchy のノード番号（Initialize 前は未登録）
+	uint32_t node_ = UINT32_MAX;
 };
 } // namespace Engine
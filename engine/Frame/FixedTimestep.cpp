@@ -0,0 +1,32 @@
+#include "FixedTimestep.h"
+
+namespace Engine {
+FixedTimestep::FixedTimestep(float stepTime, uint32_t maxStepsPerFrame)
+    : stepTime_(stepTime), maxStepsPerFrame_(maxStepsPerFrame) {
+}
+
+/// <summary>
+/// フレーム時間を溜めて、このフレームのステップを求める
+/// </summary>
+FixedTimestep::Step FixedTimestep::Advance(float deltaTime) {
+    if (deltaTime > 0.0f) {
+        accumulator_ += deltaTime;
+    }
+
+    Step step;
+    step.deltaTime = stepTime_;
+    step.count = 0;
+    while (accumulator_ >= stepTime_ && step.count < maxStepsPerFrame_) {
+        accumulator_ -= stepTime_;
+        ++step.count;
+    }
+
+    // 上限を超えた分は追いつこうとせずに捨てる（重いフレームが続いたときに処理が雪だるま式に増えないようにする）
+    while (accumulator_ >= stepTime_) {
+        accumulator_ -= stepTime_;
+    }
+
+    step.interpolation = accumulator_ / stepTime_;
+    return step;
+}
+} // namespace Engine
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// 固定ステップの時間管理クラス。
+/// 可変のフレーム時間を溜めて一定間隔のステップ数に変換し、余りを描画の補間の割合として返す
+/// </summary>
+namespace Engine {
+class FixedTimestep {
+  public:
+    /// <summary>
+    /// 1フレーム分のステップ
+    /// </summary>
+    struct Step {
+        float deltaTime = 1.0f / 60.0f; ///< 1ステップの時間
+        uint32_t count = 1;             ///< このフレームで進めるステップ数（0もある）
+        float interpolation = 1.0f;     ///< 描画する位置（0で1つ前のステップ、1で最後のステップ）
+    };
+
+    /// <param name="stepTime">1ステップの時間</param>
+    /// <param name="maxStepsPerFrame">1フレームで進める最大ステップ数（超えた分は捨てる）</param>
+    explicit FixedTimestep(float stepTime = 1.0f / 60.0f, uint32_t maxStepsPerFrame = 4);
+
+    /// <summary>
+    /// フレーム時間を溜めて、このフレームのステップを求める
+    /// </summary>
+    /// <param name="deltaTime">前のフレームからの経過時間</param>
+    Step Advance(float deltaTime);
+
+    /// <summary>
+    /// 溜めた時間を捨てる
+    /// </summary>
+    void Reset() { accumulator_ = 0.0f; }
+
+    float GetStepTime() const { return stepTime_; }
+
+  private:
+    float stepTime_;
+    uint32_t maxStepsPerFrame_;
+    float accumulator_ = 0.0f; ///< まだステップにしていない時間
+};
+} // namespace Engine
@@ -1,9 +1,15 @@
 #include "Framework.h"
 #include "GlobalVariables.h"
 #include "ImGuiManager.h"
+#include "JobSystem.h"
+#include "ParticleManager.h"
+#include "TransformHierarchy.h"
+#include "TweenScheduler.h"
 #include "engine/Frame/Frame.h"
 #include <D3DResourceLeakChecker.h>
 #ifdef _DEBUG
+#include "animation/AnimationBenchmark.h"
+#include "MathBenchmark.h"
 #include "EditorUI.h"
 #endif // _DEBUG
 
@@ -98,6 +104,7 @@ void Framework::Initialize() {
     ///----------ParticleCommon------------
     particleCommon = ParticleCommon::GetInstance();
     particleCommon->Initialize(dxCommon);
+    ParticleManager::GetInstance()->Initialize(srvManager);
     ///------------------------------------
 
     ///----------SkyboxManager------------
@@ -110,6 +117,10 @@ void Framework::Initialize() {
     audio->Initialize();
     ///---------------------------
 
+    ///-------JobSystem--------------------
+    JobSystem::GetInstance()->Initialize();
+    ///-------------------------------------
+
     ///-------CollisionManager--------------
     collisionManager_ = std::make_unique<CollisionManager>();
     collisionManager_->Initialize();
@@ -140,6 +151,7 @@ void Framework::Initialize() {
 
 void Framework::Finalize() {
     sceneManager_->Finalize();
+    JobSystem::GetInstance()->Finalize();
 
     // WindowsAPIの終了処理
     winApp->Finalize();
@@ -166,6 +178,9 @@ void Framework::Finalize() {
     LightGroup::GetInstance()->Finalize();
     object3dCommon->Finalize();
     spriteCommon->Finalize();
+    ParticleManager::GetInstance()->Finalize();
+    TransformHierarchy::GetInstance()->Finalize();
+    TweenScheduler::GetInstance()->Finalize();
     particleCommon->Finalize();
     skyboxManager_->Finalize();
     dxCommon->Finalize();
@@ -178,10 +193,17 @@ void Framework::Update() {
     ImGuiManager::GetInstance()->Begin();
     EditorUI::GetInstance()->BeginDockSpace();
     GlobalVariables::GetInstance()->Update();
+    AnimationBenchmark::DrawPanel();
+    MathBenchmark::DrawPanel();
 #endif // _DEBUG
     offscreen_->DrawCommonSetting();
+    ParticleManager::GetInstance()->BeginFrame(Frame::DeltaTime());
+    // トゥイーンをまとめて進める（シーンの更新で今フレームの値を読めるように先に行う）
+    TweenScheduler::GetInstance()->Update(Frame::DeltaTime());
     sceneManager_->Update();
     collisionManager_->Update();
+    // 親から順に変わったトランスフォームだけを計算する（描画は matWorld_ をそのまま使う）
+    TransformHierarchy::GetInstance()->Update();
 #ifdef _DEBUG
     EditorUI::GetInstance()->EndDockSpace();
     ImGuiManager::GetInstance()->End();
@@ -3,6 +3,8 @@
 #include <ImGuiManager.h>
 #include "BaseScene.h"
 #include "ViewProjection.h"
+#include "CollisionManager.h"
+#include "CollisionTypeIdDef.h"
 #ifdef _DEBUG
 #include "EditorUI.h"
 #endif // _DEBUG
@@ -22,6 +24,9 @@ void MyGame::Initialize()
 	sceneManager_->SetSceneFactory(sceneFactory_.get());
 	sceneManager_->NextSceneReservation("GAME");
 
+	// 当たり判定レイヤー（識別ID）の登録
+	RegisterCollisionLayers();
+
 #ifdef _DEBUG
 	// エディタのシーンメニューに切り替え候補を登録
 	EditorUI* editor = EditorUI::GetInstance();
@@ -33,6 +38,37 @@ void MyGame::Initialize()
 #endif // _DEBUG
 }
 
+void MyGame::RegisterCollisionLayers()
+{
+	const uint32_t kNone = static_cast<uint32_t>(CollisionTypeIdDef::kNone);
+	const uint32_t kDefault = static_cast<uint32_t>(CollisionTypeIdDef::kDefault);
+	const uint32_t kPlayer = static_cast<uint32_t>(CollisionTypeIdDef::kPlayer);
+	const uint32_t kPRArm = static_cast<uint32_t>(CollisionTypeIdDef::kPRArm);
+	const uint32_t kPLArm = static_cast<uint32_t>(CollisionTypeIdDef::kPLArm);
+	const uint32_t kEnemy = static_cast<uint32_t>(CollisionTypeIdDef::kEnemy);
+
+	CollisionManager::RegisterLayer(kNone, "None");
+	CollisionManager::RegisterLayer(kDefault, "Default");
+	CollisionManager::RegisterLayer(kPlayer, "Player");
+	CollisionManager::RegisterLayer(kPRArm, "PRArm");
+	CollisionManager::RegisterLayer(kPLArm, "PLArm");
+	CollisionManager::RegisterLayer(kEnemy, "Enemy");
+
+	// None は何とも当たらない
+	for (uint32_t layer = 0; layer < CollisionManager::kMaxLayers; ++layer) {
+		CollisionManager::SetLayerCollision(kNone, layer, false);
+	}
+
+	// プレイヤーと自分の腕、同じ陣営同士は判定しない
+	const uint32_t playerSide[] = { kPlayer, kPRArm, kPLArm };
+	for (uint32_t a : playerSide) {
+		for (uint32_t b : playerSide) {
+			CollisionManager::SetLayerCollision(a, b, false);
+		}
+	}
+	CollisionManager::SetLayerCollision(kEnemy, kEnemy, false);
+}
+
 void MyGame::Finalize()
 {
 	Framework::Finalize();
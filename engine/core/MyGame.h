@@ -34,5 +34,11 @@ public: // メンバ関数
 	/// 描画
 	/// </summary>
 	void Draw()override;
+
+private:
+	/// <summary>
+	/// 当たり判定レイヤーの登録と、当たる組み合わせの初期値設定
+	/// </summary>
+	void RegisterCollisionLayers();
 };
 } // namespace Engine
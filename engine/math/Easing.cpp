@@ -122,334 +122,316 @@ template<typename T> T EaseAmplitudeScale(const T& initScale, const float& easeT
 	return newScale;
 }
 
+//バウンス補助関数
+float BounceEaseOut(float x) {
+
+	const float n1 = 7.5625f;
+	const float d1 = 2.75f;
+	float easeT = 0.0f;
+
+	if (x < 1.0f / d1) {
+		easeT = n1 * x * x;
+	}
+	else if (x < 2.0f / d1) {
+		x -= 1.5f / d1;
+		easeT = n1 * x * x + 0.75f;
+	}
+	else if (x < 2.5f / d1) {
+		x -= 2.25f / d1;
+		easeT = n1 * x * x + 0.9375f;
+	}
+	else {
+		x -= 2.625f / d1;
+		easeT = n1 * x * x + 0.984375f;
+	}
+	return easeT;
+}
+
+namespace {
+// イージングの式（進行度 [0, 1] → 補間の割合）。EaseXxx・EaseCurve・EaseCurves はすべてここから求める
+constexpr float kPi = std::numbers::pi_v<float>;
+
+inline float CurveLinear(float t) { return t; }
+
+inline float CurveInSine(float t) { return 1.0f - std::cosf((t * kPi) / 2.0f); }
+inline float CurveOutSine(float t) { return std::sinf((t * kPi) / 2.0f); }
+inline float CurveInOutSine(float x) {
+	float t = x / 0.5f;
+	return 0.5f * (1.0f - std::cosf(t * kPi));
+}
+
+inline float CurveInBack(float t) {
+	const float s = 1.70158f;
+	return t * t * ((s + 1) * t - s);
+}
+inline float CurveOutBack(float x) {
+	const float s = 1.70158f;
+	float t = x - 1;
+	return (t * t * ((s + 1) * t + s)) + 1;
+}
+inline float CurveInOutBack(float x) {
+	const float s = 1.70158f * 1.525f;
+	float t = x / 0.5f;
+	if (t < 1) {
+		return 0.5f * (t * t * ((s + 1) * t - s));
+	}
+	t -= 2;
+	return 0.5f * ((t * t * ((s + 1) * t + s)) + 2);
+}
+
+inline float CurveInQuint(float t) { return t * t * t * t * t; }
+inline float CurveOutQuint(float t) { return 1.0f - std::powf(1.0f - t, 5); }
+inline float CurveInOutQuint(float x) {
+	float t = x / 0.5f;
+	if (t < 1.0f) {
+		return 0.5f * t * t * t * t * t;
+	}
+	t -= 2.0f;
+	return 0.5f * (std::powf(t, 5) + 2.0f);
+}
+
+inline float CurveInCirc(float t) { return 1.0f - std::sqrtf(1.0f - std::powf(t, 2)); }
+inline float CurveOutCirc(float t) { return std::sqrtf(1.0f - std::powf(t - 1.0f, 2)); }
+inline float CurveInOutCirc(float x) {
+	float t = x / 0.5f;
+	if (t < 1.0f) {
+		return -0.5f * (std::sqrtf(1.0f - std::powf(t, 2)) - 1.0f);
+	}
+	t -= 2.0f;
+	return 0.5f * (std::sqrtf(1.0f - std::powf(t, 2)) + 1.0f);
+}
+
+inline float CurveInExpo(float t) { return (t == 0.0f) ? 0.0f : std::powf(2.0f, 10.0f * (t - 1.0f)); }
+inline float CurveOutExpo(float t) { return (t == 1.0f) ? 1.0f : 1.0f - std::powf(2.0f, -10.0f * t); }
+inline float CurveInOutExpo(float x) {
+	float t = x / 0.5f;
+	if (t < 1.0f) {
+		return 0.5f * std::powf(2.0f, 10.0f * (t - 1.0f));
+	}
+	t -= 1.0f;
+	return 0.5f * (2.0f - std::powf(2.0f, -10.0f * t));
+}
+
+inline float CurveInCubic(float t) { return t * t * t; }
+inline float CurveOutCubic(float t) { return 1.0f - std::powf(1.0f - t, 3); }
+inline float CurveInOutCubic(float x) {
+	float t = x / 0.5f;
+	if (t < 1.0f) {
+		return 0.5f * t * t * t;
+	}
+	t -= 2.0f;
+	return 0.5f * (std::powf(t, 3) + 2.0f);
+}
+
+inline float CurveInQuad(float t) { return t * t; }
+inline float CurveOutQuad(float t) { return 1.0f - (1.0f - t) * (1.0f - t); }
+inline float CurveInOutQuad(float x) {
+	float t = x / 0.5f;
+	if (t < 1.0f) {
+		return 0.5f * t * t;
+	}
+	t -= 1.0f;
+	return -0.5f * (t * (t - 2.0f) - 1.0f);
+}
+
+inline float CurveInQuart(float t) { return t * t * t * t; }
+inline float CurveOutQuart(float t) { return 1.0f - std::powf(1.0f - t, 4); }
+inline float CurveInOutQuart(float x) {
+	float t = x / 0.5f;
+	if (t < 1.0f) {
+		return 0.5f * t * t * t * t;
+	}
+	t -= 2.0f;
+	return -0.5f * (std::powf(t, 4) - 2.0f);
+}
+
+inline float CurveInBounce(float x) { return 1.0f - BounceEaseOut(1.0f - x); }
+inline float CurveOutBounce(float x) { return BounceEaseOut(x); }
+inline float CurveInOutBounce(float x) {
+	float t = x / 0.5f;
+	if (t < 1.0f) {
+		return 0.5f * (1.0f - BounceEaseOut(1.0f - t));
+	}
+	t -= 1.0f;
+	return 0.5f * BounceEaseOut(t) + 0.5f;
+}
+
+inline float CurveInElastic(float t) {
+	if (t == 0) return 0.0f;
+	if (t == 1.0f) return 1.0f;
+	float p = 0.3f;
+	float s = p / 4.0f;
+	return -std::pow(2.0f, 10.0f * (t - 1)) * std::sin((t - 1 - s) * (2 * kPi) / p);
+}
+inline float CurveOutElastic(float t) {
+	if (t == 0) return 0.0f;
+	if (t == 1.0f) return 1.0f;
+	float p = 0.3f;
+	float s = p / 4.0f;
+	return std::pow(2.0f, -10.0f * t) * std::sin((t - s) * (2 * kPi) / p) + 1.0f;
+}
+inline float CurveInOutElastic(float x) {
+	if (x == 0) return 0.0f;
+	if (x == 1.0f) return 1.0f;
+	float t = x / 0.5f;
+	float p = 0.45f;
+	float s = p / 4.0f;
+	if (t < 1) {
+		return -0.5f * std::pow(2.0f, 10.0f * (t - 1)) * std::sin((t - 1 - s) * (2 * kPi) / p);
+	}
+	t -= 1;
+	return std::pow(2.0f, -10.0f * t) * std::sin((t - s) * (2 * kPi) / p) * 0.5f + 1.0f;
+}
+} // namespace
+
 // EaseInSine 関数
 template<typename T> T EaseInSine(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = 1.0f - std::cosf((t * std::numbers::pi_v<float>) / 2.0f);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInSine(x / totalX));
 }
 
 // EaseOutSine 関数
 template<typename T> T EaseOutSine(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = std::sinf((t * std::numbers::pi_v<float>) / 2.0f);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutSine(x / totalX));
 }
 
 // EaseInOutSine 関数
 template<typename T> T EaseInOutSine(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT = 0.5f * (1.0f - std::cosf(t * std::numbers::pi_v<float>));
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInOutSine(x / totalX));
 }
 
-/// EaseInBack
-template<typename T>
-T EaseInBack(const T& start, const T& end, float x, float totalX) {
-	const float s = 1.70158f; // オーバーシュートの量 (調整可能)
-	float t = x / totalX;
-	float easeT = t * t * ((s + 1) * t - s);
-	return LerpE(start, end, easeT);
+// EaseInBack 関数
+template<typename T> T EaseInBack(const T& start, const T& end, float x, float totalX) {
+	return LerpE(start, end, CurveInBack(x / totalX));
 }
 
-/// EaseOutBack
-template<typename T>
-T EaseOutBack(const T& start, const T& end, float x, float totalX) {
-	const float s = 1.70158f; // オーバーシュートの量 (調整可能)
-	float t = x / totalX - 1;
-	float easeT = (t * t * ((s + 1) * t + s)) + 1;
-	return LerpE(start, end, easeT);
+// EaseOutBack 関数
+template<typename T> T EaseOutBack(const T& start, const T& end, float x, float totalX) {
+	return LerpE(start, end, CurveOutBack(x / totalX));
 }
 
-
-/// EaseInOutBack
-template<typename T>
-T EaseInOutBack(const T& start, const T& end, float x, float totalX) {
-	const float s = 1.70158f * 1.525f; // オーバーシュートの量 (調整可能)
-	float t = x / (totalX / 2.0f);
-	float easeT;
-
-	if (t < 1) {
-		easeT = 0.5f * (t * t * ((s + 1) * t - s));
-	}
-	else {
-		t -= 2;
-		easeT = 0.5f * ((t * t * ((s + 1) * t + s)) + 2);
-	}
-
-	return LerpE(start, end, easeT);
+// EaseInOutBack 関数
+template<typename T> T EaseInOutBack(const T& start, const T& end, float x, float totalX) {
+	return LerpE(start, end, CurveInOutBack(x / totalX));
 }
 
 // EaseInQuint 関数
 template<typename T> T EaseInQuint(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = t * t * t * t * t;
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInQuint(x / totalX));
 }
 
 // EaseOutQuint 関数
 template<typename T> T EaseOutQuint(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = 1.0f - std::powf(1.0f - t, 5);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutQuint(x / totalX));
 }
 
 // EaseInOutQuint 関数
 template<typename T> T EaseInOutQuint(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT;
-	if (t < 1.0f) {
-		easeT = 0.5f * t * t * t * t * t;
-	}
-	else {
-		t -= 2.0f;
-		easeT = 0.5f * (std::powf(t, 5) + 2.0f);
-	}
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInOutQuint(x / totalX));
 }
 
 // EaseInCirc 関数
 template<typename T> T EaseInCirc(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = 1.0f - std::sqrtf(1.0f - std::powf(t, 2));
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInCirc(x / totalX));
 }
 
 // EaseOutCirc 関数
 template<typename T> T EaseOutCirc(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = std::sqrtf(1.0f - std::powf(t - 1.0f, 2));
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutCirc(x / totalX));
 }
 
 // EaseInOutCirc 関数
 template<typename T> T EaseInOutCirc(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT;
-	if (t < 1.0f) {
-		easeT = -0.5f * (std::sqrtf(1.0f - std::powf(t, 2)) - 1.0f);
-	}
-	else {
-		t -= 2.0f;
-		easeT = 0.5f * (std::sqrtf(1.0f - std::powf(t, 2)) + 1.0f);
-	}
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInOutCirc(x / totalX));
 }
 
 // EaseInExpo 関数
 template<typename T> T EaseInExpo(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = (t == 0.0f) ? 0.0f : std::powf(2.0f, 10.0f * (t - 1.0f));
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInExpo(x / totalX));
 }
 
 // EaseOutExpo 関数
 template<typename T> T EaseOutExpo(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = (t == 1.0f) ? 1.0f : 1.0f - std::powf(2.0f, -10.0f * t);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutExpo(x / totalX));
 }
 
 // EaseInOutExpo 関数
 template<typename T> T EaseInOutExpo(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT;
-	if (t < 1.0f) {
-		easeT = 0.5f * std::powf(2.0f, 10.0f * (t - 1.0f));
-	}
-	else {
-		t -= 1.0f;
-		easeT = 0.5f * (2.0f - std::powf(2.0f, -10.0f * t));
-	}
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInOutExpo(x / totalX));
 }
 
 // EaseInCubic 関数
 template<typename T> T EaseInCubic(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = t * t * t;
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInCubic(x / totalX));
 }
 
 // EaseOutCubic 関数
 template<typename T> T EaseOutCubic(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = 1.0f - std::powf(1.0f - t, 3);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutCubic(x / totalX));
 }
 
 // EaseInOutCubic 関数
 template<typename T> T EaseInOutCubic(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT;
-	if (t < 1.0f) {
-		easeT = 0.5f * t * t * t;
-	}
-	else {
-		t -= 2.0f;
-		easeT = 0.5f * (std::powf(t, 3) + 2.0f);
-	}
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInOutCubic(x / totalX));
 }
 
 // EaseInQuad 関数
 template<typename T> T EaseInQuad(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = t * t;
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInQuad(x / totalX));
 }
 
 // EaseOutQuad 関数
 template<typename T> T EaseOutQuad(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = 1.0f - (1.0f - t) * (1.0f - t);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutQuad(x / totalX));
 }
 
 // EaseInOutQuad 関数
 template<typename T> T EaseInOutQuad(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT;
-	if (t < 1.0f) {
-		easeT = 0.5f * t * t;
-	}
-	else {
-		t -= 1.0f;
-		easeT = -0.5f * (t * (t - 2.0f) - 1.0f);
-	}
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInOutQuad(x / totalX));
 }
 
 // EaseInQuart 関数
 template<typename T> T EaseInQuart(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = t * t * t * t;
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInQuart(x / totalX));
 }
 
 // EaseOutQuart 関数
 template<typename T> T EaseOutQuart(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = 1.0f - std::powf(1.0f - t, 4);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutQuart(x / totalX));
 }
 
 // EaseInOutQuart 関数
 template<typename T> T EaseInOutQuart(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT;
-	if (t < 1.0f) {
-		easeT = 0.5f * t * t * t * t;
-	}
-	else {
-		t -= 2.0f;
-		easeT = -0.5f * (std::powf(t, 4) - 2.0f);
-	}
-	return LerpE(start, end, easeT);
-}
-
-//バウンス補助関数
-float BounceEaseOut(float x) {
-
-	const float n1 = 7.5625f;
-	const float d1 = 2.75f;
-	float easeT = 0.0f;
-
-	if (x < 1.0f / d1) {
-		easeT = n1 * x * x;
-	}
-	else if (x < 2.0f / d1) {
-		x -= 1.5f / d1;
-		easeT = n1 * x * x + 0.75f;
-	}
-	else if (x < 2.5f / d1) {
-		x -= 2.25f / d1;
-		easeT = n1 * x * x + 0.9375f;
-	}
-	else {
-		x -= 2.625f / d1;
-		easeT = n1 * x * x + 0.984375f;
-	}
-	return easeT;
+	return LerpE(start, end, CurveInOutQuart(x / totalX));
 }
 
 // EaseInBounce 関数
 template<typename T> T EaseInBounce(const T& start, const T& end, float x, float totalX) {
-	float t = 1.0f - (x / totalX);
-	float easeT = 1.0f - BounceEaseOut(t);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInBounce(x / totalX));
 }
 
 // EaseOutBounce 関数
 template<typename T> T EaseOutBounce(const T& start, const T& end, float x, float totalX) {
-	float t = x / totalX;
-	float easeT = BounceEaseOut(t);
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveOutBounce(x / totalX));
 }
 
 // EaseInOutBounce 関数
 template<typename T> T EaseInOutBounce(const T& start, const T& end, float x, float totalX) {
-	float t = x / (totalX / 2.0f);
-	float easeT;
-	if (t < 1.0f) {
-		easeT = 0.5f * (1.0f - BounceEaseOut(1.0f - t));
-	}
-	else {
-		t -= 1.0f;
-		easeT = 0.5f * BounceEaseOut(t) + 0.5f;
-	}
-	return LerpE(start, end, easeT);
+	return LerpE(start, end, CurveInOutBounce(x / totalX));
 }
 
-/// EaseInElastic
-template<typename T>
-T EaseInElastic(const T& start, const T& end, float x, float totalX) {
-	if (x == 0) return start;
-	if (x == totalX) return end;
-
-	float t = x / totalX;
-	float p = 0.3f; // period
-	float s = p / 4.0f; // calculated shift
-	float easeT = -std::pow(2.0f, 10.0f * (t - 1)) * std::sin((t - 1 - s) * (2 * std::numbers::pi_v<float>) / p);
-
-	return LerpE(start, end, easeT);
+// EaseInElastic 関数
+template<typename T> T EaseInElastic(const T& start, const T& end, float x, float totalX) {
+	return LerpE(start, end, CurveInElastic(x / totalX));
 }
 
-/// EaseOutElastic
-template<typename T>
-T EaseOutElastic(const T& start, const T& end, float x, float totalX) {
-	if (x == 0) return start;
-	if (x == totalX) return end;
-
-	float t = x / totalX;
-	float p = 0.3f; // period
-	float s = p / 4.0f; // calculated shift
-	float easeT = std::pow(2.0f, -10.0f * t) * std::sin((t - s) * (2 * std::numbers::pi_v<float>) / p) + 1.0f;
-
-	return LerpE(start, end, easeT);
+// EaseOutElastic 関数
+template<typename T> T EaseOutElastic(const T& start, const T& end, float x, float totalX) {
+	return LerpE(start, end, CurveOutElastic(x / totalX));
 }
 
-
-/// EaseInOutElastic
-template<typename T>
-T EaseInOutElastic(const T& start, const T& end, float x, float totalX) {
-	if (x == 0) return start;
-	if (x == totalX) return end;
-
-	float t = x / (totalX / 2.0f);
-	float p = 0.45f; // period
-	float s = p / 4.0f; // calculated shift
-	float easeT;
-
-	if (t < 1) {
-		easeT = -0.5f * std::pow(2.0f, 10.0f * (t - 1)) * std::sin((t - 1 - s) * (2 * std::numbers::pi_v<float>) / p);
-	}
-	else {
-		t -= 1;
-		easeT = std::pow(2.0f, -10.0f * t) * std::sin((t - s) * (2 * std::numbers::pi_v<float>) / p) * 0.5f + 1.0f;
-	}
-
-	return LerpE(start, end, easeT);
+// EaseInOutElastic 関数
+template<typename T> T EaseInOutElastic(const T& start, const T& end, float x, float totalX) {
+	return LerpE(start, end, CurveInOutElastic(x / totalX));
 }
 
 //// イージングタイムコントール
@@ -556,9 +538,6 @@ template Vector3 EaseOutQuart<Vector3>(const Vector3& start, const Vector3& end,
 template Vector2 EaseOutQuart<Vector2>(const Vector2& start, const Vector2& end, float x, float totalx);
 template float EaseOutQuart<float>(const float& start, const float& end, float x, float totalx);
 
-// バウンス補助関数
-float BounceEaseOut(float x);
-
 template Vector3 EaseInBounce<Vector3>(const Vector3& start, const Vector3& end, float x, float totalX);
 template Vector2 EaseInBounce<Vector2>(const Vector2& start, const Vector2& end, float x, float totalX);
 template float EaseInBounce<float>(const float& start, const float& end, float x, float totalX);
@@ -582,4 +561,61 @@ template float EaseOutElastic<float>(const float& start, const float& end, float
 template Vector3 EaseInOutElastic<Vector3>(const Vector3& start, const Vector3& end, float x, float totalX);
 template Vector2 EaseInOutElastic<Vector2>(const Vector2& start, const Vector2& end, float x, float totalX);
 template float EaseInOutElastic<float>(const float& start, const float& end, float x, float totalX);
+
+//*******************************************************************************************************************************************************************
+// Curve**************************************************************************************************************************************************************
+//*******************************************************************************************************************************************************************
+
+namespace {
+// 種類ごとに呼び出しをまとめる（curve はループ内で展開される）
+template<typename Curve>
+void EvaluateCurves(Curve curve, std::span<const float> t, std::span<float> result) {
+	const size_t count = t.size();
+	const float* source = t.data();
+	float* destination = result.data();
+	for (size_t index = 0; index < count; ++index) {
+		destination[index] = curve(source[index]);
+	}
+}
+
+// EaseType と同じ並び
+using CurveFunction = float (*)(float);
+constexpr CurveFunction kCurves[] = {
+	CurveLinear,
+	CurveInSine, CurveOutSine, CurveInOutSine,
+	CurveInBack, CurveOutBack, CurveInOutBack,
+	CurveInQuint, CurveOutQuint, CurveInOutQuint,
+	CurveInCirc, CurveOutCirc, CurveInOutCirc,
+	CurveInExpo, CurveOutExpo, CurveInOutExpo,
+	CurveInCubic, CurveOutCubic, CurveInOutCubic,
+	CurveInQuad, CurveOutQuad, CurveInOutQuad,
+	CurveInQuart, CurveOutQuart, CurveInOutQuart,
+	CurveInBounce, CurveOutBounce, CurveInOutBounce,
+	CurveInElastic, CurveOutElastic, CurveInOutElastic,
+};
+static_assert(std::size(kCurves) == static_cast<size_t>(EaseType::Count));
+} // namespace
+
+float EaseCurve(EaseType type, float t) {
+	return kCurves[static_cast<size_t>(type)](t);
+}
+
+void EaseCurves(EaseType type, std::span<const float> t, std::span<float> result) {
+	switch (type) {
+#define EASE_CURVE_CASE(name) case EaseType::name: EvaluateCurves(Curve##name, t, result); break;
+	EASE_CURVE_CASE(Linear)
+	EASE_CURVE_CASE(InSine) EASE_CURVE_CASE(OutSine) EASE_CURVE_CASE(InOutSine)
+	EASE_CURVE_CASE(InBack) EASE_CURVE_CASE(OutBack) EASE_CURVE_CASE(InOutBack)
+	EASE_CURVE_CASE(InQuint) EASE_CURVE_CASE(OutQuint) EASE_CURVE_CASE(InOutQuint)
+	EASE_CURVE_CASE(InCirc) EASE_CURVE_CASE(OutCirc) EASE_CURVE_CASE(InOutCirc)
+	EASE_CURVE_CASE(InExpo) EASE_CURVE_CASE(OutExpo) EASE_CURVE_CASE(InOutExpo)
+	EASE_CURVE_CASE(InCubic) EASE_CURVE_CASE(OutCubic) EASE_CURVE_CASE(InOutCubic)
+	EASE_CURVE_CASE(InQuad) EASE_CURVE_CASE(OutQuad) EASE_CURVE_CASE(InOutQuad)
+	EASE_CURVE_CASE(InQuart) EASE_CURVE_CASE(OutQuart) EASE_CURVE_CASE(InOutQuart)
+	EASE_CURVE_CASE(InBounce) EASE_CURVE_CASE(OutBounce) EASE_CURVE_CASE(InOutBounce)
+	EASE_CURVE_CASE(InElastic) EASE_CURVE_CASE(OutElastic) EASE_CURVE_CASE(InOutElastic)
+#undef EASE_CURVE_CASE
+	default: break;
+	}
+}
 } // namespace Engine
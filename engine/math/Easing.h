@@ -1,6 +1,8 @@
 #pragma once
 #include "Vector2.h"
 #include "Vector3.h"
+#include <cstdint>
+#include <span>
 
 /// <summary>
 /// イージング
@@ -404,4 +406,41 @@ T EaseInOutElastic(const T& start, const T& end, float x, float totalX);
 ///// <param name="start"></param>
 ///// <param name="end"></param>
 // template<typename T> T EaseTimeControl(float& t, const float& totalTime, const T& start, const T& end);
+//*******************************************************************************************************************************************************************
+// Curve**************************************************************************************************************************************************************
+//*******************************************************************************************************************************************************************
+
+/// <summary>
+/// イージングの種類（TweenScheduler でまとめて求めるときに使う）
+/// </summary>
+enum class EaseType : uint8_t {
+	Linear,
+	InSine, OutSine, InOutSine,
+	InBack, OutBack, InOutBack,
+	InQuint, OutQuint, InOutQuint,
+	InCirc, OutCirc, InOutCirc,
+	InExpo, OutExpo, InOutExpo,
+	InCubic, OutCubic, InOutCubic,
+	InQuad, OutQuad, InOutQuad,
+	InQuart, OutQuart, InOutQuart,
+	InBounce, OutBounce, InOutBounce,
+	InElastic, OutElastic, InOutElastic,
+	Count
+};
+
+/// <summary>
+/// 補間の割合を求める（EaseXxx(0.0f, 1.0f, t, 1.0f) と同じ値）
+/// </summary>
+/// <param name="type">イージングの種類</param>
+/// <param name="t">進行度（0～1）</param>
+/// <returns></returns>
+float EaseCurve(EaseType type, float t);
+
+/// <summary>
+/// 補間の割合をまとめて求める（種類ごとの分岐はループの外で1回だけ行う）
+/// </summary>
+/// <param name="type">イージングの種類</param>
+/// <param name="t">進行度（0～1）</param>
+/// <param name="result">t と同じ数の出力先</param>
+void EaseCurves(EaseType type, std::span<const float> t, std::span<float> result);
 } // namespace Engine
@@ -0,0 +1,612 @@
+#include "MathBenchmark.h"
+#ifdef _DEBUG
+#include "Benchmark.h"
+#include "myMath.h"
+#include "TweenScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "imgui.h"
+#include "EditorUI.h"
+
+namespace Engine {
+namespace {
+using Benchmark::Clock;
+using Benchmark::ElapsedMs;
+
+// RunChecks での誤差の許容値
+constexpr float kCheckInverseTolerance = 1.0e-3f;    // 逆行列（要素の最大値で割ったもの）
+constexpr float kCheckTweenTolerance = 1.0e-4f;      // まとめて求めたトゥイーンと旧方式
+constexpr float kCheckBakedCurveTolerance = 1.0e-2f; // 焼き込んだ表と式
+
+// 旧 MakeAffineMatrix（オイラー角）と同じ処理
+Matrix4x4 LegacyAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	Matrix4x4 rotateMatrix = (MakeRotateXMatrix(rotate.x) * MakeRotateYMatrix(rotate.y)) * MakeRotateZMatrix(rotate.z);
+	return (MakeScaleMatrix(scale) * rotateMatrix) * MakeTranslateMatrix(translate);
+}
+
+// 旧 MakeAffineMatrix（クォータニオン）と同じ処理
+Matrix4x4 LegacyAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+	return MakeScaleMatrix(scale) * QuaternionToMatrix4x4(rotate) * MakeTranslateMatrix(translate);
+}
+
+// 全要素が値として一致するか（0.0f と -0.0f は同じとみなす）
+bool IsIdentical(const std::vector<Matrix4x4>& a, const std::vector<Matrix4x4>& b) {
+	for (size_t index = 0; index < a.size(); ++index) {
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				if (a[index].m[row][column] != b[index].m[row][column]) { return false; }
+			}
+		}
+	}
+	return true;
+}
+
+// double で求めた逆行列（ピボット選択付きの掃き出し法）
+Matrix4x4 InverseReference(const Matrix4x4& m) {
+	double augmented[4][8];
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			augmented[row][column] = m.m[row][column];
+			augmented[row][column + 4] = row == column ? 1.0 : 0.0;
+		}
+	}
+	for (int column = 0; column < 4; ++column) {
+		int pivot = column;
+		for (int row = column + 1; row < 4; ++row) {
+			if (std::fabs(augmented[row][column]) > std::fabs(augmented[pivot][column])) { pivot = row; }
+		}
+		std::swap(augmented[column], augmented[pivot]);
+		const double divisor = augmented[column][column];
+		for (double& value : augmented[column]) { value /= divisor; }
+		for (int row = 0; row < 4; ++row) {
+			if (row == column) { continue; }
+			const double factor = augmented[row][column];
+			for (int index = 0; index < 8; ++index) {
+				augmented[row][index] -= factor * augmented[column][index];
+			}
+		}
+	}
+	Matrix4x4 result;
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			result.m[row][column] = static_cast<float>(augmented[row][column + 4]);
+		}
+	}
+	return result;
+}
+
+// reference との最大誤差（reference の要素の最大値で割ったもの）
+float MaxRelativeError(const Matrix4x4& value, const Matrix4x4& reference) {
+	float magnitude = 0.0f;
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			magnitude = std::max(magnitude, std::fabs(reference.m[row][column]));
+		}
+	}
+	float error = 0.0f;
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			error = std::max(error, std::fabs(value.m[row][column] - reference.m[row][column]) / magnitude);
+		}
+	}
+	return error;
+}
+
+void Consume(const std::vector<Matrix4x4>& matrices) {
+	float sum = 0.0f;
+	for (const Matrix4x4& matrix : matrices) {
+		sum += matrix.m[0][0] + matrix.m[3][2];
+	}
+	Benchmark::Consume(sum);
+}
+
+// 旧方式のトゥイーン（オブジェクトごとにタイマーを持ち、毎フレーム EaseXxx を呼ぶ）
+struct LegacyTween {
+	Vector3 start;
+	Vector3 end;
+	Vector3 value;
+	float timer = 0.0f;
+	float duration = 1.0f;
+	EaseType type = EaseType::Linear;
+};
+
+Vector3 LegacyEase(EaseType type, const Vector3& start, const Vector3& end, float x, float totalX) {
+	switch (type) {
+	case EaseType::InSine: return EaseInSine(start, end, x, totalX);
+	case EaseType::OutSine: return EaseOutSine(start, end, x, totalX);
+	case EaseType::InOutSine: return EaseInOutSine(start, end, x, totalX);
+	case EaseType::InBack: return EaseInBack(start, end, x, totalX);
+	case EaseType::OutBack: return EaseOutBack(start, end, x, totalX);
+	case EaseType::InOutBack: return EaseInOutBack(start, end, x, totalX);
+	case EaseType::InQuint: return EaseInQuint(start, end, x, totalX);
+	case EaseType::OutQuint: return EaseOutQuint(start, end, x, totalX);
+	case EaseType::InOutQuint: return EaseInOutQuint(start, end, x, totalX);
+	case EaseType::InCirc: return EaseInCirc(start, end, x, totalX);
+	case EaseType::OutCirc: return EaseOutCirc(start, end, x, totalX);
+	case EaseType::InOutCirc: return EaseInOutCirc(start, end, x, totalX);
+	case EaseType::InExpo: return EaseInExpo(start, end, x, totalX);
+	case EaseType::OutExpo: return EaseOutExpo(start, end, x, totalX);
+	case EaseType::InOutExpo: return EaseInOutExpo(start, end, x, totalX);
+	case EaseType::InCubic: return EaseInCubic(start, end, x, totalX);
+	case EaseType::OutCubic: return EaseOutCubic(start, end, x, totalX);
+	case EaseType::InOutCubic: return EaseInOutCubic(start, end, x, totalX);
+	case EaseType::InQuad: return EaseInQuad(start, end, x, totalX);
+	case EaseType::OutQuad: return EaseOutQuad(start, end, x, totalX);
+	case EaseType::InOutQuad: return EaseInOutQuad(start, end, x, totalX);
+	case EaseType::InQuart: return EaseInQuart(start, end, x, totalX);
+	case EaseType::OutQuart: return EaseOutQuart(start, end, x, totalX);
+	case EaseType::InBounce: return EaseInBounce(start, end, x, totalX);
+	case EaseType::OutBounce: return EaseOutBounce(start, end, x, totalX);
+	case EaseType::InOutBounce: return EaseInOutBounce(start, end, x, totalX);
+	case EaseType::InElastic: return EaseInElastic(start, end, x, totalX);
+	case EaseType::OutElastic: return EaseOutElastic(start, end, x, totalX);
+	case EaseType::InOutElastic: return EaseInOutElastic(start, end, x, totalX);
+	// Linear と InOutQuart はテンプレートがないので式から求める
+	default: return LerpE(start, end, EaseCurve(type, x / totalX));
+	}
+}
+
+// a と b の最大誤差（開始値・終了値の大きさで割ったもの）
+float MaxRelativeError(const Vector3& a, const Vector3& b, float magnitude) {
+	const float error = std::max({ std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z) });
+	return error / magnitude;
+}
+
+void Consume(const std::vector<Vector3>& values) {
+	float sum = 0.0f;
+	for (const Vector3& value : values) {
+		sum += value.x + value.z;
+	}
+	Benchmark::Consume(sum);
+}
+
+template<class Function>
+double Measure(uint32_t iterations, std::vector<Matrix4x4>& results, Function function) {
+	return Benchmark::MeasureMs(iterations, [&]() {
+		function(results);
+		Consume(results);
+		});
+}
+} // namespace
+
+MathBenchmark::AffineResult MathBenchmark::RunAffine(uint32_t count, uint32_t iterations, uint32_t seed) {
+	AffineResult result;
+	result.count = count;
+	result.iterations = iterations = std::max(iterations, 1u);
+
+	// 回転は -2π ~ 2π、拡大は負の値も含める
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> angle(-6.3f, 6.3f);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::vector<Vector3> scales(count), rotates(count), sinRotates(count), cosRotates(count), translates(count);
+	std::vector<Quaternion> quaternions(count);
+	for (uint32_t index = 0; index < count; ++index) {
+		scales[index] = { unit(engine) * 4.0f, unit(engine) * 4.0f, unit(engine) * 4.0f };
+		rotates[index] = { angle(engine), angle(engine), angle(engine) };
+		sinRotates[index] = { std::sinf(rotates[index].x), std::sinf(rotates[index].y), std::sinf(rotates[index].z) };
+		cosRotates[index] = { std::cosf(rotates[index].x), std::cosf(rotates[index].y), std::cosf(rotates[index].z) };
+		translates[index] = { position(engine), position(engine), position(engine) };
+		quaternions[index] = Quaternion(unit(engine), unit(engine), unit(engine), unit(engine)).Normalize();
+	}
+	// 回転なし・拡大なしの行列も混ぜる
+	if (count > 0) {
+		rotates[0] = {};
+		sinRotates[0] = {};
+		cosRotates[0] = { 1.0f, 1.0f, 1.0f };
+		scales[0] = { 1.0f, 1.0f, 1.0f };
+		quaternions[0] = Quaternion::IdentityQuaternion();
+	}
+
+	std::vector<Matrix4x4> legacy(count), closedForm(count);
+
+	// オイラー角
+	result.legacyEulerMs = Measure(iterations, legacy, [&](std::vector<Matrix4x4>& results) {
+		for (uint32_t index = 0; index < count; ++index) {
+			results[index] = LegacyAffineMatrix(scales[index], rotates[index], translates[index]);
+		}
+		});
+	result.eulerMs = Measure(iterations, closedForm, [&](std::vector<Matrix4x4>& results) {
+		for (uint32_t index = 0; index < count; ++index) {
+			results[index] = MakeAffineMatrix(scales[index], rotates[index], translates[index]);
+		}
+		});
+	bool isEulerIdentical = IsIdentical(legacy, closedForm);
+	result.sinCosMs = Measure(iterations, closedForm, [&](std::vector<Matrix4x4>& results) {
+		for (uint32_t index = 0; index < count; ++index) {
+			results[index] = MakeAffineMatrixFromSinCos(scales[index], sinRotates[index], cosRotates[index], translates[index]);
+		}
+		});
+	result.isEulerIdentical = isEulerIdentical && IsIdentical(legacy, closedForm);
+	result.batchEulerMs = Measure(iterations, closedForm, [&](std::vector<Matrix4x4>& results) {
+		MakeAffineMatrices(scales, rotates, translates, results);
+		});
+	result.isBatchEulerIdentical = IsIdentical(legacy, closedForm);
+
+	// クォータニオン
+	result.legacyQuaternionMs = Measure(iterations, legacy, [&](std::vector<Matrix4x4>& results) {
+		for (uint32_t index = 0; index < count; ++index) {
+			results[index] = LegacyAffineMatrix(scales[index], quaternions[index], translates[index]);
+		}
+		});
+	result.quaternionMs = Measure(iterations, closedForm, [&](std::vector<Matrix4x4>& results) {
+		for (uint32_t index = 0; index < count; ++index) {
+			results[index] = MakeAffineMatrix(scales[index], quaternions[index], translates[index]);
+		}
+		});
+	result.isQuaternionIdentical = IsIdentical(legacy, closedForm);
+	result.batchQuaternionMs = Measure(iterations, closedForm, [&](std::vector<Matrix4x4>& results) {
+		MakeAffineMatrices(scales, quaternions, translates, results);
+		});
+	result.isBatchQuaternionIdentical = IsIdentical(legacy, closedForm);
+
+	return result;
+}
+
+MathBenchmark::SimdResult MathBenchmark::RunSimd(uint32_t count, uint32_t iterations, uint32_t seed) {
+	SimdResult result;
+	result.count = count;
+	result.iterations = iterations = std::max(iterations, 1u);
+#if defined(ENGINE_MATH_AVX2)
+	result.backend = "AVX2";
+#elif defined(ENGINE_MATH_SSE)
+	result.backend = "SSE";
+#else
+	result.backend = "Scalar";
+#endif
+
+	// 半分はアフィン変換、半分は透視投影を掛けたもの
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::vector<Matrix4x4> matrices(count), others(count);
+	std::vector<Vector3> vectors(count);
+	const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	for (uint32_t index = 0; index < count; ++index) {
+		matrices[index] = MakeAffineMatrix({ scale(engine), scale(engine), scale(engine) }, { angle(engine), angle(engine), angle(engine) },
+			{ position(engine), position(engine), position(engine) });
+		others[index] = MakeAffineMatrix({ scale(engine), scale(engine), scale(engine) }, { angle(engine), angle(engine), angle(engine) },
+			{ position(engine), position(engine), position(engine) });
+		if (index % 2 == 1) {
+			matrices[index] = MultiplyScalar(matrices[index], projection);
+		}
+		vectors[index] = { position(engine), position(engine), position(engine) };
+	}
+
+	std::vector<Matrix4x4> scalar(count), simd(count);
+	auto forEach = [&](auto function) {
+		return [&, function](std::vector<Matrix4x4>& results) {
+			for (uint32_t index = 0; index < count; ++index) {
+				results[index] = function(index);
+			}
+			};
+		};
+
+	// 積
+	result.multiplyScalarMs = Measure(iterations, scalar, forEach([&](uint32_t index) { return MultiplyScalar(matrices[index], others[index]); }));
+	result.multiplyMs = Measure(iterations, simd, forEach([&](uint32_t index) { return matrices[index] * others[index]; }));
+	result.isMultiplyIdentical = IsIdentical(scalar, simd);
+
+	// 転置
+	result.transposeScalarMs = Measure(iterations, scalar, forEach([&](uint32_t index) { return TransposeScalar(matrices[index]); }));
+	result.transposeMs = Measure(iterations, simd, forEach([&](uint32_t index) { return Transpose(matrices[index]); }));
+	result.isTransposeIdentical = IsIdentical(scalar, simd);
+
+	// 逆行列（計算の順番が違うので、どちらも double で求めた値との誤差で比べる）
+	result.inverseScalarMs = Measure(iterations, scalar, forEach([&](uint32_t index) { return InverseScalar(matrices[index]); }));
+	result.inverseMs = Measure(iterations, simd, forEach([&](uint32_t index) { return Inverse(matrices[index]); }));
+	for (uint32_t index = 0; index < count; ++index) {
+		const Matrix4x4 reference = InverseReference(matrices[index]);
+		result.maxScalarInverseError = std::max(result.maxScalarInverseError, MaxRelativeError(scalar[index], reference));
+		result.maxInverseError = std::max(result.maxInverseError, MaxRelativeError(simd[index], reference));
+	}
+
+	// 座標変換（行列は1つにして、ベクトルをまとめて変換する）
+	std::vector<Vector3> scalarPoints(count), scalarNormals(count), points(count), normals(count);
+	const Matrix4x4 matrix = count > 1 ? matrices[1] : MakeIdentity4x4();
+	Clock::time_point start = Clock::now();
+	for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+		for (uint32_t index = 0; index < count; ++index) {
+			scalarPoints[index] = TransformationScalar(vectors[index], matrix);
+			scalarNormals[index] = TransformNormalScalar(vectors[index], matrix);
+		}
+		Benchmark::Consume(scalarPoints[iteration % std::max(count, 1u)].x);
+	}
+	result.transformScalarMs = ElapsedMs(start) / iterations;
+	start = Clock::now();
+	for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+		Transformation(vectors, matrix, points);
+		TransformNormal(vectors, matrix, normals);
+		Benchmark::Consume(points[iteration % std::max(count, 1u)].x);
+	}
+	result.transformMs = ElapsedMs(start) / iterations;
+	bool isTransformIdentical = true;
+	for (uint32_t index = 0; index < count; ++index) {
+		const Vector3 point = Transformation(vectors[index], matrix);
+		const Vector3 normal = TransformNormal(vectors[index], matrix);
+		for (const Vector3& value : { points[index], point }) {
+			isTransformIdentical = isTransformIdentical &&
+				value.x == scalarPoints[index].x && value.y == scalarPoints[index].y && value.z == scalarPoints[index].z;
+		}
+		for (const Vector3& value : { normals[index], normal }) {
+			isTransformIdentical = isTransformIdentical &&
+				value.x == scalarNormals[index].x && value.y == scalarNormals[index].y && value.z == scalarNormals[index].z;
+		}
+	}
+	result.isTransformIdentical = isTransformIdentical;
+
+	return result;
+}
+
+MathBenchmark::InverseResult MathBenchmark::RunInverse(uint32_t count, uint32_t iterations, uint32_t seed) {
+	InverseResult result;
+	result.count = count;
+	result.iterations = iterations = std::max(iterations, 1u);
+
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::vector<Matrix4x4> affines(count), rigids(count);
+	for (uint32_t index = 0; index < count; ++index) {
+		const Vector3 rotate = { angle(engine), angle(engine), angle(engine) };
+		const Vector3 translate = { position(engine), position(engine), position(engine) };
+		affines[index] = MakeAffineMatrix({ scale(engine), scale(engine), scale(engine) }, rotate, translate);
+		rigids[index] = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, rotate, translate);
+	}
+
+	std::vector<Matrix4x4> results(count);
+	auto measure = [&](const std::vector<Matrix4x4>& sources, auto function) {
+		return Measure(iterations, results, [&](std::vector<Matrix4x4>& outputs) {
+			for (uint32_t index = 0; index < count; ++index) {
+				outputs[index] = function(sources[index]);
+			}
+			});
+		};
+	auto maxError = [&](const std::vector<Matrix4x4>& sources, bool isTranspose) {
+		float error = 0.0f;
+		for (uint32_t index = 0; index < count; ++index) {
+			const Matrix4x4 reference = InverseReference(sources[index]);
+			error = std::max(error, MaxRelativeError(results[index], isTranspose ? TransposeScalar(reference) : reference));
+		}
+		return error;
+		};
+
+	result.inverseMs = measure(affines, [](const Matrix4x4& m) { return Inverse(m); });
+	result.maxInverseError = maxError(affines, false);
+	result.inverseAffineMs = measure(affines, [](const Matrix4x4& m) { return InverseAffine(m); });
+	result.maxInverseAffineError = maxError(affines, false);
+	result.inverseRigidMs = measure(rigids, [](const Matrix4x4& m) { return InverseRigid(m); });
+	result.maxInverseRigidError = maxError(rigids, false);
+	result.inverseTransposeMs = measure(affines, [](const Matrix4x4& m) { return Transpose(Inverse(m)); });
+	result.inverseTransposeAffineMs = measure(affines, [](const Matrix4x4& m) { return InverseTransposeAffine(m); });
+	result.maxInverseTransposeAffineError = maxError(affines, true);
+
+	return result;
+}
+
+MathBenchmark::TweenResult MathBenchmark::RunTween(uint32_t count, uint32_t frameCount, uint32_t seed) {
+	TweenResult result;
+	result.count = count;
+	result.frameCount = frameCount = std::max(frameCount, 1u);
+
+	constexpr float kDeltaTime = TweenScheduler::kFixedDeltaTime;
+	constexpr float kMagnitude = 10.0f;
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<uint32_t> typeIndex(0, static_cast<uint32_t>(EaseType::Count) - 1);
+	std::uniform_real_distribution<float> position(-kMagnitude, kMagnitude);
+	std::uniform_real_distribution<float> duration(0.25f * frameCount * kDeltaTime, frameCount * kDeltaTime);
+
+	// 旧方式のオブジェクトはばらばらに確保され、更新の順番もばらばら
+	std::vector<std::unique_ptr<LegacyTween>> legacyTweens(count);
+	for (auto& tween : legacyTweens) {
+		tween = std::make_unique<LegacyTween>();
+		tween->type = static_cast<EaseType>(typeIndex(engine));
+		tween->start = { position(engine), position(engine), position(engine) };
+		tween->end = { position(engine), position(engine), position(engine) };
+		tween->value = tween->start;
+		tween->duration = duration(engine);
+	}
+	std::vector<LegacyTween*> order(count);
+	for (uint32_t index = 0; index < count; ++index) {
+		order[index] = legacyTweens[index].get();
+	}
+	std::shuffle(order.begin(), order.end(), engine);
+	const std::vector<std::unique_ptr<LegacyTween>> initialTweens = [&] {
+		std::vector<std::unique_ptr<LegacyTween>> copies(count);
+		for (uint32_t index = 0; index < count; ++index) {
+			copies[index] = std::make_unique<LegacyTween>(*legacyTweens[index]);
+		}
+		return copies;
+		}();
+
+	auto stepLegacy = [&]() {
+		for (LegacyTween* tween : order) {
+			if (tween->timer >= tween->duration) { continue; }
+			tween->timer = std::min(tween->timer + kDeltaTime, tween->duration);
+			tween->value = LegacyEase(tween->type, tween->start, tween->end, tween->timer, tween->duration);
+		}
+		};
+	auto resetLegacy = [&]() {
+		for (uint32_t index = 0; index < count; ++index) {
+			*legacyTweens[index] = *initialTweens[index];
+		}
+		};
+	uint32_t callbackCount = 0;
+	auto startScheduler = [&](TweenScheduler& scheduler, std::vector<Vector3>& targets, bool isBakedOnly, bool isBaked) {
+		targets.assign(count, Vector3{});
+		for (uint32_t index = 0; index < count; ++index) {
+			const LegacyTween& tween = *initialTweens[index];
+			// 焼き込みの比較では Elastic / Bounce の6種類に割り当て直す
+			EaseType type = tween.type;
+			if (isBakedOnly) {
+				type = static_cast<EaseType>(static_cast<uint32_t>(EaseType::InBounce) + static_cast<uint32_t>(type) % 6);
+			}
+			const TweenScheduler::Handle handle = scheduler.Start<Vector3>(&targets[index], tween.start, tween.end, tween.duration, type, 0.0f, isBaked);
+			scheduler.SetOnComplete(handle, [&callbackCount]() { ++callbackCount; });
+		}
+		};
+
+	// 旧方式
+	{
+		const Clock::time_point start = Clock::now();
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			stepLegacy();
+		}
+		result.legacyMs = ElapsedMs(start) / frameCount;
+	}
+
+	// まとめて求める（旧方式と同時に進めて誤差も見る）
+	{
+		TweenScheduler scheduler;
+		std::vector<Vector3> targets;
+		startScheduler(scheduler, targets, false, false);
+		const Clock::time_point start = Clock::now();
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			scheduler.Update(kDeltaTime);
+			Consume(targets);
+		}
+		result.schedulerMs = ElapsedMs(start) / frameCount;
+		result.callbackCount = callbackCount;
+		result.isAllCompleted = scheduler.GetActiveCount() == 0 && callbackCount == count;
+
+		resetLegacy();
+		startScheduler(scheduler, targets, false, false);
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			stepLegacy();
+			scheduler.Update(kDeltaTime);
+			for (uint32_t index = 0; index < count; ++index) {
+				result.maxError = std::max(result.maxError, MaxRelativeError(targets[index], legacyTweens[index]->value, kMagnitude));
+			}
+		}
+	}
+
+	// Elastic / Bounce を式から求める場合と焼き込んだ表から求める場合
+	{
+		TweenScheduler exactScheduler, bakedScheduler;
+		std::vector<Vector3> exactTargets, bakedTargets;
+		auto measure = [&](TweenScheduler& scheduler, std::vector<Vector3>& targets, bool isBaked) {
+			startScheduler(scheduler, targets, true, isBaked);
+			const Clock::time_point start = Clock::now();
+			for (uint32_t frame = 0; frame < frameCount; ++frame) {
+				scheduler.Update(kDeltaTime);
+				Consume(targets);
+			}
+			return ElapsedMs(start) / frameCount;
+			};
+		result.exactCurveMs = measure(exactScheduler, exactTargets, false);
+		result.bakedCurveMs = measure(bakedScheduler, bakedTargets, true);
+
+		startScheduler(exactScheduler, exactTargets, true, false);
+		startScheduler(bakedScheduler, bakedTargets, true, true);
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			exactScheduler.Update(kDeltaTime);
+			bakedScheduler.Update(kDeltaTime);
+			for (uint32_t index = 0; index < count; ++index) {
+				result.maxBakedError = std::max(result.maxBakedError, MaxRelativeError(bakedTargets[index], exactTargets[index], kMagnitude));
+			}
+		}
+	}
+
+	return result;
+}
+
+void MathBenchmark::RunChecks(const Benchmark::Check& check) {
+	const AffineResult affine = RunAffine(256, 1);
+	check("Math: affine (euler) matches legacy", affine.isEulerIdentical);
+	check("Math: batched affine (euler) matches legacy", affine.isBatchEulerIdentical);
+	check("Math: affine (quaternion) matches legacy", affine.isQuaternionIdentical);
+	check("Math: batched affine (quaternion) matches legacy", affine.isBatchQuaternionIdentical);
+
+	const SimdResult simd = RunSimd(256, 1);
+	check(std::format("Math: {} multiply matches scalar", simd.backend), simd.isMultiplyIdentical);
+	check(std::format("Math: {} transpose matches scalar", simd.backend), simd.isTransposeIdentical);
+	check(std::format("Math: {} transform matches scalar", simd.backend), simd.isTransformIdentical);
+	check(std::format("Math: {} inverse error {:.2e}", simd.backend, simd.maxInverseError), simd.maxInverseError <= kCheckInverseTolerance);
+
+	const InverseResult inverse = RunInverse(256, 1);
+	check(std::format("Math: InverseAffine error {:.2e}", inverse.maxInverseAffineError), inverse.maxInverseAffineError <= kCheckInverseTolerance);
+	check(std::format("Math: InverseRigid error {:.2e}", inverse.maxInverseRigidError), inverse.maxInverseRigidError <= kCheckInverseTolerance);
+	check(std::format("Math: InverseTransposeAffine error {:.2e}", inverse.maxInverseTransposeAffineError),
+		inverse.maxInverseTransposeAffineError <= kCheckInverseTolerance);
+
+	const TweenResult tween = RunTween(256, 60);
+	check(std::format("Tween: scheduler error {:.2e}", tween.maxError), tween.maxError <= kCheckTweenTolerance);
+	check(std::format("Tween: baked curve error {:.2e}", tween.maxBakedError), tween.maxBakedError <= kCheckBakedCurveTolerance);
+	check("Tween: all completed with one callback each", tween.isAllCompleted);
+}
+
+void MathBenchmark::DrawPanel() {
+	if (!EditorUI::GetInstance()->PanelVisible("数学計測", "デバッグ")) { return; }
+	ImGui::Begin("数学計測");
+
+	// 10000個の行列を100回求める
+	static std::optional<AffineResult> affineResult;
+	if (ImGui::Button("Run Affine Benchmark")) {
+		affineResult = RunAffine(10000, 100);
+	}
+	if (affineResult) {
+		ImGui::Text("Euler        Legacy: %.3f ms  Closed: %.3f ms  SinCos: %.3f ms  Identical: %s",
+			affineResult->legacyEulerMs, affineResult->eulerMs, affineResult->sinCosMs, affineResult->isEulerIdentical ? "Yes" : "No");
+		ImGui::Text("Euler Batch  %.3f ms  Identical: %s", affineResult->batchEulerMs, affineResult->isBatchEulerIdentical ? "Yes" : "No");
+		ImGui::Text("Quat         Legacy: %.3f ms  Closed: %.3f ms  Identical: %s",
+			affineResult->legacyQuaternionMs, affineResult->quaternionMs, affineResult->isQuaternionIdentical ? "Yes" : "No");
+		ImGui::Text("Quat Batch   %.3f ms  Identical: %s", affineResult->batchQuaternionMs, affineResult->isBatchQuaternionIdentical ? "Yes" : "No");
+	}
+
+	// SIMD 実装とスカラー実装の比較
+	static std::optional<SimdResult> simdResult;
+	if (ImGui::Button("Run Simd Benchmark")) {
+		simdResult = RunSimd(10000, 100);
+	}
+	if (simdResult) {
+		ImGui::Text("Backend: %s", simdResult->backend);
+		ImGui::Text("Multiply   Scalar: %.3f ms  Simd: %.3f ms  Identical: %s",
+			simdResult->multiplyScalarMs, simdResult->multiplyMs, simdResult->isMultiplyIdentical ? "Yes" : "No");
+		ImGui::Text("Transpose  Scalar: %.3f ms  Simd: %.3f ms  Identical: %s",
+			simdResult->transposeScalarMs, simdResult->transposeMs, simdResult->isTransposeIdentical ? "Yes" : "No");
+		ImGui::Text("Inverse    Scalar: %.3f ms / %.2e  Simd: %.3f ms / %.2e",
+			simdResult->inverseScalarMs, simdResult->maxScalarInverseError, simdResult->inverseMs, simdResult->maxInverseError);
+		ImGui::Text("Transform  Scalar: %.3f ms  Batch: %.3f ms  Identical: %s",
+			simdResult->transformScalarMs, simdResult->transformMs, simdResult->isTransformIdentical ? "Yes" : "No");
+	}
+
+	// アフィン変換行列の逆行列と一般の逆行列の比較
+	static std::optional<InverseResult> inverseResult;
+	if (ImGui::Button("Run Inverse Benchmark")) {
+		inverseResult = RunInverse(1000, 1000);
+	}
+	if (inverseResult) {
+		ImGui::Text("Inverse           %.3f ms  Error: %.2e", inverseResult->inverseMs, inverseResult->maxInverseError);
+		ImGui::Text("InverseAffine     %.3f ms  Error: %.2e", inverseResult->inverseAffineMs, inverseResult->maxInverseAffineError);
+		ImGui::Text("InverseRigid      %.3f ms  Error: %.2e", inverseResult->inverseRigidMs, inverseResult->maxInverseRigidError);
+		ImGui::Text("Transpose(Inverse) %.3f ms  InverseTransposeAffine %.3f ms  Error: %.2e",
+			inverseResult->inverseTransposeMs, inverseResult->inverseTransposeAffineMs, inverseResult->maxInverseTransposeAffineError);
+	}
+
+	// オブジェクトごとの更新とまとめての更新の比較
+	static std::optional<TweenResult> tweenResult;
+	if (ImGui::Button("Run Tween Benchmark")) {
+		tweenResult = RunTween(10000, 120);
+	}
+	if (tweenResult) {
+		ImGui::Text("Tween    Legacy: %.3f ms  Scheduler: %.3f ms  Error: %.2e",
+			tweenResult->legacyMs, tweenResult->schedulerMs, tweenResult->maxError);
+		ImGui::Text("Elastic/Bounce  Exact: %.3f ms  Baked: %.3f ms  Error: %.2e",
+			tweenResult->exactCurveMs, tweenResult->bakedCurveMs, tweenResult->maxBakedError);
+		ImGui::Text("Callbacks: %u / %u  AllCompleted: %s",
+			tweenResult->callbackCount, tweenResult->count, tweenResult->isAllCompleted ? "Yes" : "No");
+	}
+
+	ImGui::End();
+}
+} // namespace Engine
+#endif // _DEBUG
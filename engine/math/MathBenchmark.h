@@ -0,0 +1,130 @@
+#pragma once
+#include "Benchmark.h"
+#include <cstdint>
+
+namespace Engine {
+/// <summary>
+/// 数学関数の計測（デバッグビルドのみ。描画・GPUに依存せず単体で実行できる）
+/// </summary>
+class MathBenchmark {
+public:
+	/// <summary>
+	/// アフィン変換行列の計測結果
+	/// </summary>
+	struct AffineResult {
+		uint32_t count = 0;              // 1回あたりに求める行列の数
+		uint32_t iterations = 0;
+		double legacyEulerMs = 0.0;      // 旧実装（拡大・回転X/Y/Z・平行移動の行列を作って掛ける）の1回あたりの時間
+		double eulerMs = 0.0;            // MakeAffineMatrix（オイラー角）
+		double sinCosMs = 0.0;           // MakeAffineMatrixFromSinCos（sin / cos を先に求めてある）
+		double batchEulerMs = 0.0;       // MakeAffineMatrices（オイラー角。sin / cos を配列全体で先に求める）
+		double legacyQuaternionMs = 0.0; // 旧実装（拡大 * クォータニオンの回転行列 * 平行移動）
+		double quaternionMs = 0.0;       // MakeAffineMatrix（クォータニオン）
+		double batchQuaternionMs = 0.0;  // MakeAffineMatrices（クォータニオン）
+		bool isEulerIdentical = false;           // MakeAffineMatrix・MakeAffineMatrixFromSinCos（オイラー角）が旧実装と全要素で一致したか
+		bool isBatchEulerIdentical = false;      // MakeAffineMatrices（オイラー角）が旧実装と全要素で一致したか
+		bool isQuaternionIdentical = false;      // MakeAffineMatrix（クォータニオン）が旧実装と全要素で一致したか
+		bool isBatchQuaternionIdentical = false; // MakeAffineMatrices（クォータニオン）が旧実装と全要素で一致したか
+	};
+
+	/// <summary>
+	/// ランダムな拡大・回転・平行移動から count 個の行列を求めることを iterations 回繰り返す
+	/// </summary>
+	/// <param name="count">行列の数</param>
+	/// <param name="iterations">繰り返す回数</param>
+	/// <param name="seed">乱数シード</param>
+	static AffineResult RunAffine(uint32_t count, uint32_t iterations, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 行列演算の計測結果（SIMD 実装とスカラー実装の比較）
+	/// </summary>
+	struct SimdResult {
+		uint32_t count = 0;
+		uint32_t iterations = 0;
+		const char* backend = "";       // コンパイル時に選ばれた実装
+		double multiplyScalarMs = 0.0;  // 1回あたりの時間
+		double multiplyMs = 0.0;
+		double inverseScalarMs = 0.0;
+		double inverseMs = 0.0;
+		double transposeScalarMs = 0.0;
+		double transposeMs = 0.0;
+		double transformScalarMs = 0.0; // Transformation + TransformNormal を1つずつ
+		double transformMs = 0.0;       // Transformation + TransformNormal を span でまとめて
+		float maxScalarInverseError = 0.0f; // 逆行列の要素の最大誤差（double で求めた値との差を要素の最大値で割ったもの）
+		float maxInverseError = 0.0f;
+		bool isMultiplyIdentical = false;  // 積がスカラー実装と全要素で一致したか
+		bool isTransposeIdentical = false;
+		bool isTransformIdentical = false; // 1つずつ・まとめての座標変換がスカラー実装と全要素で一致したか
+	};
+
+	/// <summary>
+	/// ランダムなアフィン変換・透視投影を含む行列で積・逆行列・転置・座標変換をスカラー実装と比べる
+	/// </summary>
+	/// <param name="count">行列・ベクトルの数</param>
+	/// <param name="iterations">繰り返す回数</param>
+	/// <param name="seed">乱数シード</param>
+	static SimdResult RunSimd(uint32_t count, uint32_t iterations, uint32_t seed = 0u);
+
+	/// <summary>
+	/// アフィン変換行列の逆行列の計測結果
+	/// </summary>
+	struct InverseResult {
+		uint32_t count = 0;
+		uint32_t iterations = 0;
+		double inverseMs = 0.0;                 // Inverse の1回あたりの時間
+		double inverseAffineMs = 0.0;           // InverseAffine
+		double inverseRigidMs = 0.0;            // InverseRigid（回転と平行移動だけの行列）
+		double inverseTransposeMs = 0.0;        // Transpose(Inverse(m))
+		double inverseTransposeAffineMs = 0.0;  // InverseTransposeAffine
+		float maxInverseError = 0.0f;           // double で求めた逆行列との最大誤差（要素の最大値で割ったもの）
+		float maxInverseAffineError = 0.0f;
+		float maxInverseRigidError = 0.0f;
+		float maxInverseTransposeAffineError = 0.0f;
+	};
+
+	/// <summary>
+	/// ランダムなアフィン変換行列（拡大あり）と回転・平行移動だけの行列の逆行列を、一般の Inverse と比べる
+	/// </summary>
+	/// <param name="count">行列の数</param>
+	/// <param name="iterations">繰り返す回数</param>
+	/// <param name="seed">乱数シード</param>
+	static InverseResult RunInverse(uint32_t count, uint32_t iterations, uint32_t seed = 0u);
+
+	/// <summary>
+	/// トゥイーンの計測結果
+	/// </summary>
+	struct TweenResult {
+		uint32_t count = 0;
+		uint32_t frameCount = 0;
+		double legacyMs = 0.0;        // 旧方式（オブジェクトごとにタイマーを進めて EaseXxx を呼ぶ）の1フレームあたりの時間
+		double schedulerMs = 0.0;     // TweenScheduler でまとめて求める
+		double exactCurveMs = 0.0;    // Elastic / Bounce だけを式から求める
+		double bakedCurveMs = 0.0;    // Elastic / Bounce だけを焼き込んだ表から求める
+		float maxError = 0.0f;        // 旧方式との最大誤差（開始値・終了値の大きさで割ったもの）
+		float maxBakedError = 0.0f;   // 焼き込んだ表と式の最大誤差（同上）
+		uint32_t callbackCount = 0;   // 届いた完了コールバックの数
+		bool isAllCompleted = false;  // 全トゥイーンが完了し、コールバックがちょうど1回ずつ届いたか
+	};
+
+	/// <summary>
+	/// 種類と長さの違う Vector3 のトゥイーンを count 個、全て完了するまで進める
+	/// </summary>
+	/// <param name="count">トゥイーンの数</param>
+	/// <param name="frameCount">進めるフレーム数（長さはこの 1/4 ～ 1 倍）</param>
+	/// <param name="seed">乱数シード</param>
+	static TweenResult RunTween(uint32_t count, uint32_t frameCount, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 結果の一致・性質の確認を小さい規模で実行する（SelfCheck から呼ぶ）
+	/// </summary>
+	/// <param name="check">確認1件ごとに呼ぶ関数</param>
+	static void RunChecks(const Benchmark::Check& check);
+
+#ifdef _DEBUG
+	/// <summary>
+	/// 計測パネル
+	/// </summary>
+	static void DrawPanel();
+#endif // _DEBUG
+};
+} // namespace Engine
@@ -0,0 +1,105 @@
+#pragma once
+#include "SimdOps.h"
+
+/// <summary>
+/// 行列演算の実装の切り替え（コンパイル時に決める）
+/// x64 では SSE2 が必ず使えるので SSE の実装を使い、/arch:AVX2（-mavx2）指定時は AVX2 の実装を使う。
+/// 1回が短く実行時の分岐が割に合わないため、SimdOps の GetSupportedLevel は使わない。
+/// ENGINE_MATH_NO_SIMD を定義するとスカラー実装になる
+/// </summary>
+#if !defined(ENGINE_MATH_NO_SIMD) && defined(ENGINE_SIMD_X64)
+#define ENGINE_MATH_SSE
+#if defined(__AVX2__)
+#define ENGINE_MATH_AVX2
+#endif
+#endif
+
+namespace Engine {
+namespace MathKernel {
+
+/// <summary>
+/// 4x4 行列の積（行ベクトル形式、float[16] の行優先）。スカラー実装
+/// </summary>
+inline void MultiplyScalar(const float* a, const float* b, float* result) {
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			float sum = 0;
+			for (int k = 0; k < 4; ++k) {
+				sum += a[i * 4 + k] * b[k * 4 + j];
+			}
+			result[i * 4 + j] = sum;
+		}
+	}
+}
+
+#ifdef ENGINE_MATH_SSE
+/// <summary>
+/// 行 row * 行列 b（各要素はスカラー実装と同じく k = 0 から順に足す）
+/// </summary>
+inline __m128 RowMultiply(__m128 row, __m128 b0, __m128 b1, __m128 b2, __m128 b3) {
+	__m128 sum = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+	sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+	sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+	return _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+}
+
+/// <summary>
+/// 4x4 行列の積。SSE 実装（スカラー実装と値が一致する）
+/// </summary>
+inline void MultiplySse(const float* a, const float* b, float* result) {
+	const __m128 b0 = _mm_loadu_ps(b);
+	const __m128 b1 = _mm_loadu_ps(b + 4);
+	const __m128 b2 = _mm_loadu_ps(b + 8);
+	const __m128 b3 = _mm_loadu_ps(b + 12);
+	const __m128 r0 = RowMultiply(_mm_loadu_ps(a), b0, b1, b2, b3);
+	const __m128 r1 = RowMultiply(_mm_loadu_ps(a + 4), b0, b1, b2, b3);
+	const __m128 r2 = RowMultiply(_mm_loadu_ps(a + 8), b0, b1, b2, b3);
+	const __m128 r3 = RowMultiply(_mm_loadu_ps(a + 12), b0, b1, b2, b3);
+	_mm_storeu_ps(result, r0);
+	_mm_storeu_ps(result + 4, r1);
+	_mm_storeu_ps(result + 8, r2);
+	_mm_storeu_ps(result + 12, r3);
+}
+#endif // ENGINE_MATH_SSE
+
+#ifdef ENGINE_MATH_AVX2
+/// <summary>
+/// 2行分（128bit ずつ）* 行列 b（b の各行は上下の 128bit に同じ値を入れておく）
+/// </summary>
+inline __m256 RowPairMultiply(__m256 rows, __m256 b0, __m256 b1, __m256 b2, __m256 b3) {
+	__m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+	sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+	sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+	return _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+}
+
+/// <summary>
+/// 4x4 行列の積。AVX2 実装（2行ずつ求める。スカラー実装と値が一致する）
+/// </summary>
+inline void MultiplyAvx2(const float* a, const float* b, float* result) {
+	const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b));
+	const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+	const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+	const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+	const __m256 r01 = RowPairMultiply(_mm256_loadu_ps(a), b0, b1, b2, b3);
+	const __m256 r23 = RowPairMultiply(_mm256_loadu_ps(a + 8), b0, b1, b2, b3);
+	_mm256_storeu_ps(result, r01);
+	_mm256_storeu_ps(result + 8, r23);
+}
+#endif // ENGINE_MATH_AVX2
+
+/// <summary>
+/// 4x4 行列の積（コンパイル時に選んだ実装）
+/// </summary>
+inline void Multiply(const float* a, const float* b, float* result) {
+#if defined(ENGINE_MATH_AVX2)
+	MultiplyAvx2(a, b, result);
+#elif defined(ENGINE_MATH_SSE)
+	MultiplySse(a, b, result);
+#else
+	MultiplyScalar(a, b, result);
+#endif
+}
+
+} // namespace MathKernel
+} // namespace Engine
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstring>
 #include"Vector3.h"
+#include "MathKernel.h"
 
 /// <summary>
 /// Matrix4x4
@@ -32,14 +33,7 @@ public:
 
 	Matrix4x4 operator*(const Matrix4x4& mat) const {
 		Matrix4x4 result;
-		for (int i = 0; i < 4; ++i) {
-			for (int j = 0; j < 4; ++j) {
-				result.m[i][j] = 0;
-				for (int k = 0; k < 4; ++k) {
-					result.m[i][j] += m[i][k] * mat.m[k][j];
-				}
-			}
-		}
+		MathKernel::Multiply(&m[0][0], &mat.m[0][0], &result.m[0][0]);
 		return result;
 	}
 
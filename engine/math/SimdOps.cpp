@@ -0,0 +1,41 @@
+#include "SimdOps.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+
+namespace Engine {
+namespace Simd {
+Level GetSupportedLevel() {
+	static const Level level = [] {
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		const int maxId = info[0];
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		// OSがYMMレジスタの退避に対応しているかも確認する
+		if (maxId >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+			__cpuidex(info, 7, 0);
+			if (info[1] & (1 << 5)) {
+				return Level::kAVX2;
+			}
+		}
+#else
+		if (__builtin_cpu_supports("avx2")) {
+			return Level::kAVX2;
+		}
+#endif // _MSC_VER
+#endif // ENGINE_SIMD_ENABLE_AVX2
+#ifdef ENGINE_SIMD_X64
+		// x64はSSE2が必須
+		return Level::kSSE;
+#else
+		return Level::kScalar;
+#endif // ENGINE_SIMD_X64
+		}();
+	return level;
+}
+} // namespace Simd
+} // namespace Engine
@@ -0,0 +1,134 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+/// <summary>
+/// SIMD 命令の共通定義。
+/// ENGINE_SIMD_X64 は x64（SSE2 が必ず使える）のとき、ENGINE_SIMD_ENABLE_AVX2 は AVX2 の関数をコンパイルできるときに定義する。
+/// MSVC は AVX 命令を /arch 指定なしで関数単位に使える。他のコンパイラは -mavx2 指定時のみ有効にする。
+/// 行列演算（MathKernel）はコンパイル時に、一括処理（狭域判定・パーティクル）は GetSupportedLevel で実行時に実装を選ぶ
+/// </summary>
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define ENGINE_SIMD_X64
+#include <immintrin.h>
+#if defined(_MSC_VER) || defined(__AVX2__)
+#define ENGINE_SIMD_ENABLE_AVX2
+#endif
+#endif
+
+namespace Engine {
+namespace Simd {
+
+/// <summary>
+/// 使用する命令セット
+/// </summary>
+enum class Level : int32_t {
+	kScalar, // 1件ずつ
+	kSSE,    // 4件ずつ
+	kAVX2,   // 8件ずつ
+};
+
+/// <summary>
+/// 実行中のCPUで使える最上位の命令セット（初回のみ判定）
+/// </summary>
+Level GetSupportedLevel();
+
+///-------------------------------------------///
+/// 演算の差し替え（スカラー / SSE / AVX2 で同じ計算順序になるようにする）
+/// 比較結果（M）は Select・And・Or・ToBits にだけ渡す
+///-------------------------------------------///
+struct ScalarOps {
+	using V = float;
+	using M = bool;
+	static constexpr uint32_t kWidth = 1;
+	static V Load(const float* p) { return *p; }
+	static void Store(float* p, V a) { *p = a; }
+	static V Set1(float x) { return x; }
+	static V Add(V a, V b) { return a + b; }
+	static V Sub(V a, V b) { return a - b; }
+	static V Mul(V a, V b) { return a * b; }
+	static V Div(V a, V b) { return a / b; }
+	static V Min(V a, V b) { return a < b ? a : b; }
+	static V Max(V a, V b) { return a > b ? a : b; }
+	static V Abs(V a) { return std::fabs(a); }
+	static V Neg(V a) { return -a; }
+	static V Floor(V a) { return std::floor(a); }
+	static M Equal(V a, V b) { return a == b; }
+	static M LessEq(V a, V b) { return a <= b; }
+	static M Greater(V a, V b) { return a > b; }
+	static M GreaterEq(V a, V b) { return a >= b; }
+	static M And(M a, M b) { return a && b; }
+	static M Or(M a, M b) { return a || b; }
+	static M Not(M a) { return !a; }
+	static M False() { return false; }
+	static V Select(M m, V a, V b) { return m ? a : b; }
+	static uint32_t ToBits(M m) { return m ? 1u : 0u; }
+};
+
+#ifdef ENGINE_SIMD_X64
+/// <summary>
+/// SSE2 の範囲だけで書ける演算（Floor は SSE4.1 なので無い）
+/// </summary>
+struct SseOps {
+	using V = __m128;
+	using M = __m128;
+	static constexpr uint32_t kWidth = 4;
+	static V Load(const float* p) { return _mm_loadu_ps(p); }
+	static void Store(float* p, V a) { _mm_storeu_ps(p, a); }
+	static V Set1(float x) { return _mm_set1_ps(x); }
+	static V Add(V a, V b) { return _mm_add_ps(a, b); }
+	static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+	static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+	static V Div(V a, V b) { return _mm_div_ps(a, b); }
+	static V Min(V a, V b) { return _mm_min_ps(a, b); }
+	static V Max(V a, V b) { return _mm_max_ps(a, b); }
+	static V Abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	static V Neg(V a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+	static M Equal(V a, V b) { return _mm_cmpeq_ps(a, b); }
+	static M LessEq(V a, V b) { return _mm_cmple_ps(a, b); }
+	static M Greater(V a, V b) { return _mm_cmpgt_ps(a, b); }
+	static M GreaterEq(V a, V b) { return _mm_cmpge_ps(a, b); }
+	static M And(M a, M b) { return _mm_and_ps(a, b); }
+	static M Or(M a, M b) { return _mm_or_ps(a, b); }
+	static M Not(M a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+	static M False() { return _mm_setzero_ps(); }
+	static V Select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+	static uint32_t ToBits(M m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+};
+#endif // ENGINE_SIMD_X64
+
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+/// <summary>
+/// AVX2 の演算（GetSupportedLevel が kAVX2 のときだけ呼ぶ）
+/// </summary>
+struct Avx2Ops {
+	using V = __m256;
+	using M = __m256;
+	static constexpr uint32_t kWidth = 8;
+	static V Load(const float* p) { return _mm256_loadu_ps(p); }
+	static void Store(float* p, V a) { _mm256_storeu_ps(p, a); }
+	static V Set1(float x) { return _mm256_set1_ps(x); }
+	static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+	static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+	static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+	static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+	static V Min(V a, V b) { return _mm256_min_ps(a, b); }
+	static V Max(V a, V b) { return _mm256_max_ps(a, b); }
+	static V Abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	static V Neg(V a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+	static V Floor(V a) { return _mm256_floor_ps(a); }
+	static M Equal(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	static M LessEq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	static M Greater(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static M GreaterEq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	static M And(M a, M b) { return _mm256_and_ps(a, b); }
+	static M Or(M a, M b) { return _mm256_or_ps(a, b); }
+	static M Not(M a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+	static M False() { return _mm256_setzero_ps(); }
+	static V Select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+	static uint32_t ToBits(M m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+};
+#endif // ENGINE_SIMD_ENABLE_AVX2
+
+} // namespace Simd
+} // namespace Engine
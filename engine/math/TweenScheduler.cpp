@@ -0,0 +1,283 @@
+#define NOMINMAX
+#include "TweenScheduler.h"
+#include <algorithm>
+
+namespace Engine {
+std::unique_ptr<TweenScheduler> TweenScheduler::instance = nullptr;
+
+TweenScheduler* TweenScheduler::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = std::unique_ptr<TweenScheduler>(new TweenScheduler());
+	}
+	return instance.get();
+}
+
+void TweenScheduler::Finalize()
+{
+	// 終了後に呼ばれた Cancel は何もしない
+	instance.reset();
+}
+
+void TweenScheduler::Update(float deltaTime)
+{
+	completedCount_ = 0;
+	activeCount_ = 0;
+	for (uint32_t bucketIndex = 0; bucketIndex < buckets_.size(); ++bucketIndex) {
+		UpdateBucket(bucketIndex, deltaTime);
+		activeCount_ += static_cast<uint32_t>(buckets_[bucketIndex].slots.size());
+	}
+
+	// 全トゥイーンの値を書き終えてからまとめて呼ぶ（コールバックの中で Start / Cancel してもよいように取り出しておく）
+	std::vector<std::function<void()>> callbacks;
+	callbacks.swap(completedCallbacks_);
+	for (auto& callback : callbacks) {
+		callback();
+	}
+	if (completedCallbacks_.empty()) {
+		callbacks.clear();
+		completedCallbacks_.swap(callbacks);
+	}
+}
+
+TweenScheduler::Handle TweenScheduler::StartValues(float* target, const float* start, const float* end, uint32_t componentCount, float duration, EaseType type, float delay, bool isBaked)
+{
+	uint32_t slotIndex = 0;
+	if (!freeSlots_.empty()) {
+		slotIndex = freeSlots_.back();
+		freeSlots_.pop_back();
+	} else {
+		slotIndex = static_cast<uint32_t>(slots_.size());
+		slots_.emplace_back();
+	}
+
+	const uint32_t bucketIndex = static_cast<uint32_t>(type) + (isBaked && IsBakeable(type) ? kCurveCount : 0);
+	if (bucketIndex >= kCurveCount) {
+		GetBakedCurve(type);
+	}
+	Bucket& bucket = buckets_[bucketIndex];
+
+	Slot& slot = slots_[slotIndex];
+	++slot.generation;
+	slot.bucket = bucketIndex;
+	slot.position = static_cast<uint32_t>(bucket.slots.size());
+	slot.isActive = true;
+
+	Values startValues{};
+	Values endValues{};
+	std::copy(start, start + componentCount, startValues.begin());
+	std::copy(end, end + componentCount, endValues.begin());
+
+	// 長さ0のときは開始時刻に達した時点で終了値にする
+	duration = std::max(duration, 0.0f);
+	delay = std::max(delay, 0.0f);
+	bucket.slots.push_back(slotIndex);
+	bucket.elapsed.push_back(0.0f);
+	bucket.delays.push_back(delay);
+	bucket.endTimes.push_back(delay + duration);
+	bucket.invDurations.push_back(duration > 0.0f ? 1.0f / duration : 0.0f);
+	bucket.progress.push_back(0.0f);
+	bucket.targets.push_back(target);
+	bucket.componentCounts.push_back(componentCount);
+	bucket.starts.push_back(startValues);
+	bucket.ends.push_back(endValues);
+	bucket.values.push_back(startValues);
+	bucket.onCompletes.emplace_back();
+
+	// 最初の Update までの間も開始値が入っているようにする
+	if (target) {
+		std::memcpy(target, startValues.data(), sizeof(float) * componentCount);
+	}
+
+	return (static_cast<Handle>(slot.generation) << 32) | slotIndex;
+}
+
+void TweenScheduler::SetOnComplete(Handle handle, std::function<void()> onComplete)
+{
+	if (const Slot* slot = FindSlot(handle)) {
+		buckets_[slot->bucket].onCompletes[slot->position] = std::move(onComplete);
+	}
+}
+
+void TweenScheduler::Cancel(Handle handle)
+{
+	if (!instance) {
+		return;
+	}
+	if (const Slot* slot = instance->FindSlot(handle)) {
+		instance->Remove(slot->bucket, slot->position);
+	}
+}
+
+bool TweenScheduler::IsActive(Handle handle) const
+{
+	return FindSlot(handle) != nullptr;
+}
+
+float TweenScheduler::GetProgress(Handle handle) const
+{
+	const Slot* slot = FindSlot(handle);
+	if (!slot) {
+		return 1.0f;
+	}
+	const Bucket& bucket = buckets_[slot->bucket];
+	const float t = (bucket.elapsed[slot->position] - bucket.delays[slot->position]) * bucket.invDurations[slot->position];
+	return std::clamp(t, 0.0f, 1.0f);
+}
+
+bool TweenScheduler::IsBakeable(EaseType type)
+{
+	switch (type) {
+	case EaseType::InBounce:
+	case EaseType::OutBounce:
+	case EaseType::InOutBounce:
+	case EaseType::InElastic:
+	case EaseType::OutElastic:
+	case EaseType::InOutElastic:
+		return true;
+	default:
+		return false;
+	}
+}
+
+const TweenScheduler::BakedCurve& TweenScheduler::GetBakedCurve(EaseType type)
+{
+	auto& bakedCurve = bakedCurves_[static_cast<size_t>(type)];
+	if (!bakedCurve) {
+		bakedCurve = std::make_unique<BakedCurve>();
+		for (uint32_t index = 0; index <= BakedCurve::kSegmentCount; ++index) {
+			const float t = static_cast<float>(index) / static_cast<float>(BakedCurve::kSegmentCount);
+			bakedCurve->samples[index] = EaseCurve(type, t);
+		}
+	}
+	return *bakedCurve;
+}
+
+void TweenScheduler::UpdateBucket(uint32_t bucketIndex, float deltaTime)
+{
+	Bucket& bucket = buckets_[bucketIndex];
+	const uint32_t count = static_cast<uint32_t>(bucket.slots.size());
+	if (count == 0) {
+		return;
+	}
+
+	// 時間を進めて進行度を求める（分岐のない1つのループにしてまとめて計算させる）
+	float* elapsed = bucket.elapsed.data();
+	const float* delays = bucket.delays.data();
+	const float* endTimes = bucket.endTimes.data();
+	const float* invDurations = bucket.invDurations.data();
+	float* progress = bucket.progress.data();
+	for (uint32_t position = 0; position < count; ++position) {
+		const float time = elapsed[position] + deltaTime;
+		elapsed[position] = time;
+		float t = (time - delays[position]) * invDurations[position];
+		t = t < 0.0f ? 0.0f : t;
+		t = t > 1.0f ? 1.0f : t;
+		progress[position] = time >= endTimes[position] ? 1.0f : t;
+	}
+
+	// 進行度を補間の割合にする（種類ごとの分岐はここで1回だけ）
+	if (bucketIndex < kCurveCount) {
+		EaseCurves(static_cast<EaseType>(bucketIndex), std::span<const float>(progress, count), std::span<float>(progress, count));
+	} else {
+		const float* samples = GetBakedCurve(static_cast<EaseType>(bucketIndex - kCurveCount)).samples.data();
+		constexpr float kSegmentCount = static_cast<float>(BakedCurve::kSegmentCount);
+		for (uint32_t position = 0; position < count; ++position) {
+			const float x = progress[position] * kSegmentCount;
+			const uint32_t index = std::min(static_cast<uint32_t>(x), BakedCurve::kSegmentCount - 1);
+			const float fraction = x - static_cast<float>(index);
+			progress[position] = (1.0f - fraction) * samples[index] + samples[index + 1] * fraction;
+		}
+	}
+
+	// 値を求めて書き込む（LerpE と同じ式。成分数によらず4つ求める）
+	const Values* starts = bucket.starts.data();
+	const Values* ends = bucket.ends.data();
+	Values* values = bucket.values.data();
+	for (uint32_t position = 0; position < count; ++position) {
+		const float easeT = progress[position];
+		for (uint32_t component = 0; component < 4; ++component) {
+			values[position][component] = (1.0f - easeT) * starts[position][component] + ends[position][component] * easeT;
+		}
+	}
+	for (uint32_t position = 0; position < count; ++position) {
+		if (float* target = bucket.targets[position]) {
+			std::memcpy(target, values[position].data(), sizeof(float) * bucket.componentCounts[position]);
+		}
+	}
+
+	// 完了したものを後ろから取り除き、コールバックを預かる
+	completedPositions_.clear();
+	for (uint32_t position = 0; position < count; ++position) {
+		if (elapsed[position] >= endTimes[position]) {
+			completedPositions_.push_back(position);
+		}
+	}
+	for (auto it = completedPositions_.rbegin(); it != completedPositions_.rend(); ++it) {
+		if (bucket.onCompletes[*it]) {
+			completedCallbacks_.push_back(std::move(bucket.onCompletes[*it]));
+		}
+		Remove(bucketIndex, *it);
+	}
+	completedCount_ += static_cast<uint32_t>(completedPositions_.size());
+}
+
+void TweenScheduler::Remove(uint32_t bucketIndex, uint32_t position)
+{
+	Bucket& bucket = buckets_[bucketIndex];
+	Slot& slot = slots_[bucket.slots[position]];
+	slot.isActive = false;
+	freeSlots_.push_back(bucket.slots[position]);
+
+	const uint32_t last = static_cast<uint32_t>(bucket.slots.size()) - 1;
+	if (position != last) {
+		bucket.slots[position] = bucket.slots[last];
+		bucket.elapsed[position] = bucket.elapsed[last];
+		bucket.delays[position] = bucket.delays[last];
+		bucket.endTimes[position] = bucket.endTimes[last];
+		bucket.invDurations[position] = bucket.invDurations[last];
+		bucket.progress[position] = bucket.progress[last];
+		bucket.targets[position] = bucket.targets[last];
+		bucket.componentCounts[position] = bucket.componentCounts[last];
+		bucket.starts[position] = bucket.starts[last];
+		bucket.ends[position] = bucket.ends[last];
+		bucket.values[position] = bucket.values[last];
+		bucket.onCompletes[position] = std::move(bucket.onCompletes[last]);
+		slots_[bucket.slots[position]].position = position;
+	}
+	bucket.slots.pop_back();
+	bucket.elapsed.pop_back();
+	bucket.delays.pop_back();
+	bucket.endTimes.pop_back();
+	bucket.invDurations.pop_back();
+	bucket.progress.pop_back();
+	bucket.targets.pop_back();
+	bucket.componentCounts.pop_back();
+	bucket.starts.pop_back();
+	bucket.ends.pop_back();
+	bucket.values.pop_back();
+	bucket.onCompletes.pop_back();
+}
+
+const TweenScheduler::Slot* TweenScheduler::FindSlot(Handle handle) const
+{
+	const uint32_t slotIndex = static_cast<uint32_t>(handle & 0xFFFFFFFFu);
+	const uint32_t generation = static_cast<uint32_t>(handle >> 32);
+	if (handle == kInvalidHandle || slotIndex >= slots_.size()) {
+		return nullptr;
+	}
+	const Slot& slot = slots_[slotIndex];
+	if (!slot.isActive || slot.generation != generation) {
+		return nullptr;
+	}
+	return &slot;
+}
+
+const TweenScheduler::Values* TweenScheduler::FindValues(Handle handle) const
+{
+	if (const Slot* slot = FindSlot(handle)) {
+		return &buckets_[slot->bucket].values[slot->position];
+	}
+	return nullptr;
+}
+} // namespace Engine
@@ -0,0 +1,204 @@
+#pragma once
+#include "Easing.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// トゥイーンの一括更新クラス。
+/// 動いているトゥイーンをイージングの種類ごとに連続した配列（SoA）で持ち、毎フレーム種類ごとにまとめて求める。
+/// 重い Elastic / Bounce は焼き込んだ表からも求められる。完了時のコールバックは全体の更新の後にまとめて呼ぶ
+/// </summary>
+namespace Engine {
+class TweenScheduler
+{
+#pragma region シングルトンインスタンス
+private:
+	static std::unique_ptr<TweenScheduler> instance;
+
+	TweenScheduler() = default;
+	TweenScheduler(TweenScheduler&) = delete;
+	TweenScheduler& operator=(TweenScheduler&) = delete;
+
+	// 計測用に単体のインスタンスを作る
+	friend class MathBenchmark;
+
+public:
+	~TweenScheduler() = default;
+	// シングルトンインスタンスの取得
+	static TweenScheduler* GetInstance();
+	// 終了
+	void Finalize();
+#pragma endregion シングルトンインスタンス
+
+public:
+
+	using Handle = uint64_t;
+	static constexpr Handle kInvalidHandle = 0;
+
+	/// <summary>
+	/// 全トゥイーンを進め、値を書き込み、完了したもののコールバックを呼ぶ（シーンの更新の前に1回呼ぶ）
+	/// </summary>
+	/// <param name="deltaTime">進める時間（秒。フレームレートによらないよう実際の経過時間を渡す）</param>
+	void Update(float deltaTime);
+
+	/// <summary>
+	/// トゥイーンの開始
+	/// </summary>
+	/// <typeparam name="T">float / Vector2 / Vector3</typeparam>
+	/// <param name="target">毎フレーム値を書き込む先（nullptr なら GetValue で受け取る。完了か Cancel まで有効であること）。
+	/// 持ち主の更新を止めても進み続けるので、止めたいときは Cancel する</param>
+	/// <param name="start">開始値</param>
+	/// <param name="end">終了値</param>
+	/// <param name="duration">補間にかける時間（秒）</param>
+	/// <param name="type">イージングの種類</param>
+	/// <param name="delay">開始までの時間（秒。その間は開始値を書き込む）</param>
+	/// <param name="isBaked">焼き込んだ表から求めるか（Elastic / Bounce のみ）</param>
+	/// <returns>ハンドル</returns>
+	template<typename T>
+	Handle Start(std::type_identity_t<T>* target, const T& start, const T& end, float duration, EaseType type, float delay = 0.0f, bool isBaked = false) {
+		static_assert(sizeof(T) % sizeof(float) == 0 && sizeof(T) <= sizeof(Values), "Error: float を4つまで並べた型のみ使えます。");
+		return StartValues(reinterpret_cast<float*>(target), reinterpret_cast<const float*>(&start), reinterpret_cast<const float*>(&end),
+			sizeof(T) / sizeof(float), duration, type, delay, isBaked);
+	}
+
+	/// <summary>
+	/// 完了時のコールバックの設定（完了したフレームの Update の最後にまとめて呼ばれる）
+	/// </summary>
+	void SetOnComplete(Handle handle, std::function<void()> onComplete);
+
+	/// <summary>
+	/// トゥイーンの中止（コールバックは呼ばない。終了後・完了後に呼んでも何もしない）
+	/// </summary>
+	static void Cancel(Handle handle);
+
+	/// <summary>
+	/// 動いているか（完了・中止したものは false）
+	/// </summary>
+	bool IsActive(Handle handle) const;
+
+	/// <summary>
+	/// 経過時間の割合（イージング前の 0～1。開始前の待ち時間の間は0、動いていないときは1）
+	/// </summary>
+	float GetProgress(Handle handle) const;
+
+	/// <summary>
+	/// 現在の値（動いていないときは T{}）
+	/// </summary>
+	template<typename T>
+	T GetValue(Handle handle) const {
+		T value{};
+		if (const Values* values = FindValues(handle)) {
+			std::memcpy(&value, values->data(), sizeof(T));
+		}
+		return value;
+	}
+
+	/// 各ステータス取得関数
+	/// <returns></returns>
+	uint32_t GetActiveCount() const { return activeCount_; }
+	uint32_t GetCompletedCount() const { return completedCount_; }
+
+	// 60fps の1フレームの時間（フレーム数で決めた長さを秒に直すときに使う）
+	static constexpr float kFixedDeltaTime = 1.0f / 60.0f;
+
+private:
+
+	using Values = std::array<float, 4>;
+
+	/// <summary>
+	/// 同じイージングで求めるトゥイーンの配列
+	/// </summary>
+	struct Bucket {
+		std::vector<uint32_t> slots;        // 位置 → スロット番号
+		std::vector<float> elapsed;
+		std::vector<float> delays;
+		std::vector<float> endTimes;        // delay + duration（これ以上で完了）
+		std::vector<float> invDurations;
+		std::vector<float> progress;        // 計算用（進行度 → 補間の割合）
+		std::vector<float*> targets;
+		std::vector<uint32_t> componentCounts;
+		std::vector<Values> starts;
+		std::vector<Values> ends;
+		std::vector<Values> values;
+		std::vector<std::function<void()>> onCompletes;
+	};
+
+	/// <summary>
+	/// 焼き込んだ表（[0, 1] を等間隔に区切った値を線形補間する）
+	/// </summary>
+	struct BakedCurve {
+		static constexpr uint32_t kSegmentCount = 1024;
+		std::array<float, kSegmentCount + 1> samples;
+	};
+
+	/// <summary>
+	/// スロット（ハンドルから位置を引く。世代が合わないハンドルは無効）
+	/// </summary>
+	struct Slot {
+		uint32_t generation = 0;
+		uint32_t bucket = 0;
+		uint32_t position = 0;
+		bool isActive = false;
+	};
+
+	static constexpr uint32_t kCurveCount = static_cast<uint32_t>(EaseType::Count);
+
+	/// <summary>
+	/// トゥイーンの開始（型を float の並びに直したもの）
+	/// </summary>
+	Handle StartValues(float* target, const float* start, const float* end, uint32_t componentCount, float duration, EaseType type, float delay, bool isBaked);
+
+	/// <summary>
+	/// 焼き込んだ表から求められる種類か
+	/// </summary>
+	static bool IsBakeable(EaseType type);
+
+	/// <summary>
+	/// 焼き込んだ表の取得（最初に使うときに作る）
+	/// </summary>
+	const BakedCurve& GetBakedCurve(EaseType type);
+
+	/// <summary>
+	/// 同じ種類のトゥイーンをまとめて進める
+	/// </summary>
+	void UpdateBucket(uint32_t bucketIndex, float deltaTime);
+
+	/// <summary>
+	/// 配列からの削除（末尾の要素を空いた位置へ移す）
+	/// </summary>
+	void Remove(uint32_t bucketIndex, uint32_t position);
+
+	/// <summary>
+	/// ハンドルからスロットを引く（無効なら nullptr）
+	/// </summary>
+	const Slot* FindSlot(Handle handle) const;
+
+	/// <summary>
+	/// ハンドルから現在の値を引く（無効なら nullptr）
+	/// </summary>
+	const Values* FindValues(Handle handle) const;
+
+private:
+
+	// 0 ～ kCurveCount - 1 がそのまま、kCurveCount ～ が焼き込んだ表を使うもの
+	std::array<Bucket, kCurveCount * 2> buckets_;
+	std::array<std::unique_ptr<BakedCurve>, kCurveCount> bakedCurves_;
+
+	std::vector<Slot> slots_;
+	std::vector<uint32_t> freeSlots_;
+
+	// 完了したトゥイーンのコールバック（全体の更新の後にまとめて呼ぶ）
+	std::vector<std::function<void()>> completedCallbacks_;
+	std::vector<uint32_t> completedPositions_;
+
+	// 前回の Update の統計
+	uint32_t activeCount_ = 0;
+	uint32_t completedCount_ = 0;
+};
+} // namespace Engine
@@ -1,8 +1,124 @@
 #include"myMath.h"
+#include <array>
 #include <numbers>
 #include"ViewProjection.h"
 
 namespace Engine {
+namespace {
+#ifdef ENGINE_MATH_SSE
+///-------------------------------------------///
+/// SSE 実装の補助（スカラー実装と同じ順番で掛けて足す）
+///-------------------------------------------///
+struct Rows {
+	__m128 r[4];
+};
+
+Rows LoadRows(const Matrix4x4& m) {
+	return { { _mm_loadu_ps(m.m[0]), _mm_loadu_ps(m.m[1]), _mm_loadu_ps(m.m[2]), _mm_loadu_ps(m.m[3]) } };
+}
+
+template<int X, int Y, int Z, int W>
+__m128 Swizzle(__m128 v) {
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+// (x, y, z, 1) * m
+__m128 TransformRow(const Vector3& v, const Rows& rows) {
+	__m128 row = _mm_mul_ps(_mm_set1_ps(v.x), rows.r[0]);
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(v.y), rows.r[1]));
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(v.z), rows.r[2]));
+	return _mm_add_ps(row, rows.r[3]);
+}
+
+// (x, y, z, 0) * m
+__m128 TransformNormalRow(const Vector3& v, const Rows& rows) {
+	__m128 row = _mm_mul_ps(_mm_set1_ps(v.x), rows.r[0]);
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(v.y), rows.r[1]));
+	return _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(v.z), rows.r[2]));
+}
+
+__m128 DivideByW(__m128 row) {
+	return _mm_div_ps(row, Swizzle<3, 3, 3, 3>(row));
+}
+
+Vector3 StoreVector3(__m128 row) {
+	alignas(16) float values[4];
+	_mm_store_ps(values, row);
+	return { values[0], values[1], values[2] };
+}
+
+// 3要素の外積（w は 0 になる）
+__m128 Cross(__m128 a, __m128 b) {
+	return _mm_sub_ps(_mm_mul_ps(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)), _mm_mul_ps(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+}
+
+// 3x3 の逆行列の行 a0, a1, a2 と平行移動 t から、アフィン変換行列の逆行列の4行を作る
+Rows AffineInverseRows(__m128 a0, __m128 a1, __m128 a2, __m128 t) {
+	__m128 translate = _mm_mul_ps(Swizzle<0, 0, 0, 0>(t), a0);
+	translate = _mm_add_ps(translate, _mm_mul_ps(Swizzle<1, 1, 1, 1>(t), a1));
+	translate = _mm_add_ps(translate, _mm_mul_ps(Swizzle<2, 2, 2, 2>(t), a2));
+	// w は 0 なので、符号を反転してから 1 を足す
+	translate = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translate);
+	return { { a0, a1, a2, translate } };
+}
+
+// 4列目を 0 にした左上3x3の行（アフィン変換行列なら元から 0）
+Rows LoadAffineRows(const Matrix4x4& m) {
+	const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	Rows rows = LoadRows(m);
+	for (int i = 0; i < 3; ++i) {
+		rows.r[i] = _mm_and_ps(rows.r[i], mask);
+	}
+	return rows;
+}
+
+// アフィン変換行列の逆行列（c0 = r1 x r2, c1 = r2 x r0, c2 = r0 x r1 を |A| で割ったものが逆行列の列になる）
+Rows InverseAffineRows(const Matrix4x4& m) {
+	const Rows rows = LoadAffineRows(m);
+	__m128 c0 = Cross(rows.r[1], rows.r[2]);
+	__m128 c1 = Cross(rows.r[2], rows.r[0]);
+	__m128 c2 = Cross(rows.r[0], rows.r[1]);
+	__m128 det = _mm_mul_ps(rows.r[0], c0);
+	det = _mm_add_ps(det, Swizzle<2, 3, 0, 1>(det));
+	det = _mm_add_ps(det, Swizzle<1, 0, 3, 2>(det));
+	assert(_mm_cvtss_f32(det) != 0.0f);
+	const __m128 inverseDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+	c0 = _mm_mul_ps(c0, inverseDet);
+	c1 = _mm_mul_ps(c1, inverseDet);
+	c2 = _mm_mul_ps(c2, inverseDet);
+	__m128 zero = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, zero);
+	return AffineInverseRows(c0, c1, c2, rows.r[3]);
+}
+
+Matrix4x4 StoreRows(const Rows& rows) {
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		_mm_storeu_ps(result.m[i], rows.r[i]);
+	}
+	return result;
+}
+
+// 2x2 行列（行優先の4要素）の積 A * B
+__m128 Mat2Mul(__m128 a, __m128 b) {
+	return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+
+// 余因子行列との積 A# * B
+__m128 Mat2AdjMul(__m128 a, __m128 b) {
+	return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+}
+
+// 余因子行列との積 A * B#
+__m128 Mat2MulAdj(__m128 a, __m128 b) {
+	return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+#endif // ENGINE_MATH_SSE
+
+// MakeAffineMatrices で回転の sin / cos・クォータニオンの積を先にまとめて求める要素数（スタックに置ける大きさ）
+constexpr size_t kAffineBatchSize = 64;
+} // namespace
+
 float Lerp(float _start, float _end, float _t)
 {
 	return (1.0f - _t) * _start + _end * _t;
@@ -31,6 +147,225 @@ Matrix4x4 MakeTranslateMatrix(const Vector3& translate) { return { 1, 0, 0, 0, 0
 Matrix4x4 MakeScaleMatrix(const Vector3& scale) { return { scale.x, 0, 0, 0, 0, scale.y, 0, 0, 0, 0, scale.z, 0, 0, 0, 0, 1 }; }
 
 Vector3 Transformation(const Vector3& vector, const Matrix4x4& matrix) {
+#ifdef ENGINE_MATH_SSE
+	const __m128 row = TransformRow(vector, LoadRows(matrix));
+	assert(_mm_cvtss_f32(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3))) != 0.0f);
+	return StoreVector3(DivideByW(row));
+#else
+	return TransformationScalar(vector, matrix);
+#endif // ENGINE_MATH_SSE
+}
+
+// Vector4をMatrix4x4で変換する関数
+Vector4 Transformation(const Vector4& vector, const Matrix4x4& matrix) {
+#ifdef ENGINE_MATH_SSE
+	const Rows rows = LoadRows(matrix);
+	__m128 row = _mm_mul_ps(_mm_set1_ps(vector.x), rows.r[0]);
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(vector.y), rows.r[1]));
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(vector.z), rows.r[2]));
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(vector.w), rows.r[3]));
+
+	// wが0でないことを確認
+	assert(_mm_cvtss_f32(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3))) != 0.0f);
+
+	// 正規化（正規化後のwは1.0f）
+	const Vector3 result = StoreVector3(DivideByW(row));
+	return { result.x, result.y, result.z, 1.0f };
+#else
+	return TransformationScalar(vector, matrix);
+#endif // ENGINE_MATH_SSE
+}
+
+Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) {
+#ifdef ENGINE_MATH_SSE
+	return StoreVector3(TransformNormalRow(v, LoadRows(m)));
+#else
+	return TransformNormalScalar(v, m);
+#endif // ENGINE_MATH_SSE
+}
+
+void Transformation(std::span<const Vector3> vectors, const Matrix4x4& matrix, std::span<Vector3> results) {
+	assert(vectors.size() == results.size());
+#ifdef ENGINE_MATH_SSE
+	const Rows rows = LoadRows(matrix);
+	size_t index = 0;
+#ifdef ENGINE_MATH_AVX2
+	// 2つずつ（上下の 128bit にそれぞれ1つ）
+	const __m256 r0 = _mm256_set_m128(rows.r[0], rows.r[0]);
+	const __m256 r1 = _mm256_set_m128(rows.r[1], rows.r[1]);
+	const __m256 r2 = _mm256_set_m128(rows.r[2], rows.r[2]);
+	const __m256 r3 = _mm256_set_m128(rows.r[3], rows.r[3]);
+	for (; index + 2 <= vectors.size(); index += 2) {
+		const Vector3& a = vectors[index];
+		const Vector3& b = vectors[index + 1];
+		__m256 row = _mm256_mul_ps(_mm256_set_m128(_mm_set1_ps(b.x), _mm_set1_ps(a.x)), r0);
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_set_m128(_mm_set1_ps(b.y), _mm_set1_ps(a.y)), r1));
+		row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_set_m128(_mm_set1_ps(b.z), _mm_set1_ps(a.z)), r2));
+		row = _mm256_add_ps(row, r3);
+		const __m256 w = _mm256_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3));
+		assert(_mm256_movemask_ps(_mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ)) == 0);
+		row = _mm256_div_ps(row, w);
+		results[index] = StoreVector3(_mm256_castps256_ps128(row));
+		results[index + 1] = StoreVector3(_mm256_extractf128_ps(row, 1));
+	}
+#endif // ENGINE_MATH_AVX2
+	for (; index < vectors.size(); ++index) {
+		const __m128 row = TransformRow(vectors[index], rows);
+		assert(_mm_cvtss_f32(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3))) != 0.0f);
+		results[index] = StoreVector3(DivideByW(row));
+	}
+#else
+	for (size_t index = 0; index < vectors.size(); ++index) {
+		results[index] = TransformationScalar(vectors[index], matrix);
+	}
+#endif // ENGINE_MATH_SSE
+}
+
+void TransformNormal(std::span<const Vector3> normals, const Matrix4x4& matrix, std::span<Vector3> results) {
+	assert(normals.size() == results.size());
+#ifdef ENGINE_MATH_SSE
+	const Rows rows = LoadRows(matrix);
+	for (size_t index = 0; index < normals.size(); ++index) {
+		results[index] = StoreVector3(TransformNormalRow(normals[index], rows));
+	}
+#else
+	for (size_t index = 0; index < normals.size(); ++index) {
+		results[index] = TransformNormalScalar(normals[index], matrix);
+	}
+#endif // ENGINE_MATH_SSE
+}
+
+Matrix4x4 Inverse(const Matrix4x4& m) {
+#ifdef ENGINE_MATH_SSE
+	// 2x2 のブロック A B / C D に分けて求める（行列式の逆数は1回だけ求める）
+	const Rows rows = LoadRows(m);
+	const __m128 a = _mm_movelh_ps(rows.r[0], rows.r[1]);
+	const __m128 b = _mm_movehl_ps(rows.r[1], rows.r[0]);
+	const __m128 c = _mm_movelh_ps(rows.r[2], rows.r[3]);
+	const __m128 d = _mm_movehl_ps(rows.r[3], rows.r[2]);
+
+	// (|A|, |B|, |C|, |D|)
+	const __m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(rows.r[0], rows.r[2], _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(rows.r[1], rows.r[3], _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(rows.r[0], rows.r[2], _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(rows.r[1], rows.r[3], _MM_SHUFFLE(2, 0, 2, 0))));
+	const __m128 detA = Swizzle<0, 0, 0, 0>(detSub);
+	const __m128 detB = Swizzle<1, 1, 1, 1>(detSub);
+	const __m128 detC = Swizzle<2, 2, 2, 2>(detSub);
+	const __m128 detD = Swizzle<3, 3, 3, 3>(detSub);
+
+	// 逆行列 = 1/|M| * (X Y / Z W) の各ブロックの余因子
+	const __m128 adjDC = Mat2AdjMul(d, c);
+	const __m128 adjAB = Mat2AdjMul(a, b);
+	__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, adjDC));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, adjAB));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, adjAB));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, adjDC));
+
+	// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+	__m128 trace = _mm_mul_ps(adjAB, Swizzle<0, 2, 1, 3>(adjDC));
+	trace = _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+	trace = _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+	const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+	assert(_mm_cvtss_f32(det) != 0.0f);
+
+	// 余因子の符号を逆数に含めておく
+	const __m128 inverseDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+	x = _mm_mul_ps(x, inverseDet);
+	y = _mm_mul_ps(y, inverseDet);
+	z = _mm_mul_ps(z, inverseDet);
+	w = _mm_mul_ps(w, inverseDet);
+
+	Matrix4x4 result;
+	_mm_storeu_ps(result.m[0], _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(result.m[1], _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_storeu_ps(result.m[2], _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(result.m[3], _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+	return result;
+#else
+	return InverseScalar(m);
+#endif // ENGINE_MATH_SSE
+}
+
+Matrix4x4 Transpose(const Matrix4x4& m) {
+#ifdef ENGINE_MATH_SSE
+	Rows rows = LoadRows(m);
+	_MM_TRANSPOSE4_PS(rows.r[0], rows.r[1], rows.r[2], rows.r[3]);
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		_mm_storeu_ps(result.m[i], rows.r[i]);
+	}
+	return result;
+#else
+	return TransposeScalar(m);
+#endif // ENGINE_MATH_SSE
+}
+
+bool IsAffine(const Matrix4x4& m) {
+	return m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f && m.m[3][3] == 1.0f;
+}
+
+Matrix4x4 InverseAffine(const Matrix4x4& m) {
+	assert(IsAffine(m));
+#ifdef ENGINE_MATH_SSE
+	return StoreRows(InverseAffineRows(m));
+#else
+	// 左上3x3の各行 r0, r1, r2 から c0 = r1 x r2, c1 = r2 x r0, c2 = r0 x r1 を求めると、逆行列の列は c / |A| になる
+	const Vector3 r0 = { m.m[0][0], m.m[0][1], m.m[0][2] };
+	const Vector3 r1 = { m.m[1][0], m.m[1][1], m.m[1][2] };
+	const Vector3 r2 = { m.m[2][0], m.m[2][1], m.m[2][2] };
+	const float inverseDet = 1.0f / r0.Dot(r1.Cross(r2));
+	const Vector3 c0 = r1.Cross(r2) * inverseDet;
+	const Vector3 c1 = r2.Cross(r0) * inverseDet;
+	const Vector3 c2 = r0.Cross(r1) * inverseDet;
+
+	// 平行移動は -t * A^-1
+	const Vector3 t = { m.m[3][0], m.m[3][1], m.m[3][2] };
+	return {
+		c0.x, c1.x, c2.x, 0.0f,
+		c0.y, c1.y, c2.y, 0.0f,
+		c0.z, c1.z, c2.z, 0.0f,
+		-t.Dot(c0), -t.Dot(c1), -t.Dot(c2), 1.0f };
+#endif // ENGINE_MATH_SSE
+}
+
+Matrix4x4 InverseRigid(const Matrix4x4& m) {
+	assert(IsAffine(m));
+#ifdef ENGINE_MATH_SSE
+	Rows rows = LoadAffineRows(m);
+	__m128 zero = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(rows.r[0], rows.r[1], rows.r[2], zero);
+	return StoreRows(AffineInverseRows(rows.r[0], rows.r[1], rows.r[2], rows.r[3]));
+#else
+	const Vector3 r0 = { m.m[0][0], m.m[0][1], m.m[0][2] };
+	const Vector3 r1 = { m.m[1][0], m.m[1][1], m.m[1][2] };
+	const Vector3 r2 = { m.m[2][0], m.m[2][1], m.m[2][2] };
+	const Vector3 t = { m.m[3][0], m.m[3][1], m.m[3][2] };
+	return {
+		r0.x, r1.x, r2.x, 0.0f,
+		r0.y, r1.y, r2.y, 0.0f,
+		r0.z, r1.z, r2.z, 0.0f,
+		-t.Dot(r0), -t.Dot(r1), -t.Dot(r2), 1.0f };
+#endif // ENGINE_MATH_SSE
+}
+
+Matrix4x4 InverseTransposeAffine(const Matrix4x4& m) {
+#ifdef ENGINE_MATH_SSE
+	assert(IsAffine(m));
+	Rows rows = InverseAffineRows(m);
+	_MM_TRANSPOSE4_PS(rows.r[0], rows.r[1], rows.r[2], rows.r[3]);
+	return StoreRows(rows);
+#else
+	return TransposeScalar(InverseAffine(m));
+#endif // ENGINE_MATH_SSE
+}
+
+Matrix4x4 MultiplyScalar(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result;
+	MathKernel::MultiplyScalar(&m1.m[0][0], &m2.m[0][0], &result.m[0][0]);
+	return result;
+}
+
+Vector3 TransformationScalar(const Vector3& vector, const Matrix4x4& matrix) {
 	Vector3 result;
 	result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
 	result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
@@ -43,8 +378,7 @@ Vector3 Transformation(const Vector3& vector, const Matrix4x4& matrix) {
 	return result;
 }
 
-// Vector4をMatrix4x4で変換する関数
-Vector4 Transformation(const Vector4& vector, const Matrix4x4& matrix) {
+Vector4 TransformationScalar(const Vector4& vector, const Matrix4x4& matrix) {
 	Vector4 result;
 	result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + vector.w * matrix.m[3][0];
 	result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + vector.w * matrix.m[3][1];
@@ -64,7 +398,7 @@ Vector4 Transformation(const Vector4& vector, const Matrix4x4& matrix) {
 }
 
 
-Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) {
+Vector3 TransformNormalScalar(const Vector3& v, const Matrix4x4& m) {
 	Vector3 result{
 		v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
 		v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
@@ -74,7 +408,7 @@ Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) {
 	return result;
 }
 
-Matrix4x4 Inverse(const Matrix4x4& m) {
+Matrix4x4 InverseScalar(const Matrix4x4& m) {
 	float A =
 		m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1] -
 		m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2] - m.m[0][1] * m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[1][0] * m.m[2][3] * m.m[3][1] -
@@ -151,7 +485,7 @@ Matrix4x4 Inverse(const Matrix4x4& m) {
 	};
 }
 
-Matrix4x4 Transpose(const Matrix4x4& m) {
+Matrix4x4 TransposeScalar(const Matrix4x4& m) {
 	return { m.m[0][0], m.m[1][0], m.m[2][0], m.m[3][0], m.m[0][1], m.m[1][1], m.m[2][1], m.m[3][1], m.m[0][2], m.m[1][2], m.m[2][2], m.m[3][2], m.m[0][3], m.m[1][3], m.m[2][3], m.m[3][3] };
 }
 
@@ -195,14 +529,48 @@ Matrix4x4 MakeRotateXYZMatrix(const Quaternion& quat)
 }
 
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
-	Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-	Matrix4x4 rotateXMatrix = MakeRotateXMatrix(rotate.x);
-	Matrix4x4 rotateYMatrix = MakeRotateYMatrix(rotate.y);
-	Matrix4x4 rotateZMatrix = MakeRotateZMatrix(rotate.z);
-	Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
-	Matrix4x4 rotateMatrix = (rotateXMatrix * rotateYMatrix) * rotateZMatrix;
+	const Vector3 sinRotate = { std::sinf(rotate.x), std::sinf(rotate.y), std::sinf(rotate.z) };
+	const Vector3 cosRotate = { std::cosf(rotate.x), std::cosf(rotate.y), std::cosf(rotate.z) };
+	return MakeAffineMatrixFromSinCos(scale, sinRotate, cosRotate, translate);
+}
+
+Matrix4x4 MakeAffineMatrixFromSinCos(const Vector3& scale, const Vector3& sinRotate, const Vector3& cosRotate, const Vector3& translate) {
+	// Rx * Ry * Rz を展開したもの。掛け算・足し算の順番は行列の掛け算と同じにして、結果が一致するようにしている
+	const float sx = sinRotate.x, sy = sinRotate.y, sz = sinRotate.z;
+	const float cx = cosRotate.x, cy = cosRotate.y, cz = cosRotate.z;
+	const float sxsy = sx * sy;
+	const float cxsy = cx * sy;
+	return {
+		scale.x * (cy * cz), scale.x * (cy * sz), scale.x * -sy, 0.0f,
+		scale.y * (sxsy * cz - cx * sz), scale.y * (sxsy * sz + cx * cz), scale.y * (sx * cy), 0.0f,
+		scale.z * (cxsy * cz + sx * sz), scale.z * (cxsy * sz - sx * cz), scale.z * (cx * cy), 0.0f,
+		translate.x, translate.y, translate.z, 1.0f };
+}
 
-	return { (scaleMatrix * rotateMatrix) * translateMatrix };
+void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Vector3> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results) {
+	assert(scales.size() == results.size() && rotates.size() == results.size() && translates.size() == results.size());
+	std::array<float, kAffineBatchSize * 3> angles;
+	std::array<float, kAffineBatchSize * 3> sines;
+	std::array<float, kAffineBatchSize * 3> cosines;
+	for (size_t begin = 0; begin < results.size(); begin += kAffineBatchSize) {
+		const size_t count = results.size() - begin < kAffineBatchSize ? results.size() - begin : kAffineBatchSize;
+		for (size_t index = 0; index < count; ++index) {
+			const Vector3& rotate = rotates[begin + index];
+			angles[index * 3 + 0] = rotate.x;
+			angles[index * 3 + 1] = rotate.y;
+			angles[index * 3 + 2] = rotate.z;
+		}
+		// 角度を1列に並べて sin / cos を1回のループで求める（分岐のない単純なループなのでベクトル化しやすい）
+		for (size_t index = 0; index < count * 3; ++index) {
+			sines[index] = std::sinf(angles[index]);
+			cosines[index] = std::cosf(angles[index]);
+		}
+		for (size_t index = 0; index < count; ++index) {
+			const size_t offset = index * 3;
+			results[begin + index] = MakeAffineMatrixFromSinCos(scales[begin + index], { sines[offset], sines[offset + 1], sines[offset + 2] },
+				{ cosines[offset], cosines[offset + 1], cosines[offset + 2] }, translates[begin + index]);
+		}
+	}
 }
 
 float cotf(float theta) { return 1.0f / std::tanf(theta); }
@@ -232,8 +600,63 @@ Vector3 QuaternionToAxis(const Quaternion& q)
 }
 
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
-	Matrix4x4 result = MakeScaleMatrix(scale) * QuaternionToMatrix4x4(rotate) * MakeTranslateMatrix(translate);
-	return result;
+	// QuaternionToMatrix4x4 の各行に拡大率を掛け、4行目に平行移動を置いたもの
+	const float xx = rotate.x * rotate.x;
+	const float yy = rotate.y * rotate.y;
+	const float zz = rotate.z * rotate.z;
+	const float xy = rotate.x * rotate.y;
+	const float xz = rotate.x * rotate.z;
+	const float yz = rotate.y * rotate.z;
+	const float wx = rotate.w * rotate.x;
+	const float wy = rotate.w * rotate.y;
+	const float wz = rotate.w * rotate.z;
+	return {
+		scale.x * (1.0f - 2.0f * (yy + zz)), scale.x * (2.0f * (xy + wz)), scale.x * (2.0f * (xz - wy)), 0.0f,
+		scale.y * (2.0f * (xy - wz)), scale.y * (1.0f - 2.0f * (xx + zz)), scale.y * (2.0f * (yz + wx)), 0.0f,
+		scale.z * (2.0f * (xz + wy)), scale.z * (2.0f * (yz - wx)), scale.z * (1.0f - 2.0f * (xx + yy)), 0.0f,
+		translate.x, translate.y, translate.z, 1.0f };
+}
+
+void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Quaternion> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results) {
+	assert(scales.size() == results.size() && rotates.size() == results.size() && translates.size() == results.size());
+	// 回転行列の9要素を成分ごとの配列に求めてから、拡大率を掛けて書き込む（計算の順番は MakeAffineMatrix と同じ）
+	struct RotationBlock {
+		std::array<float, kAffineBatchSize> m00, m01, m02, m10, m11, m12, m20, m21, m22;
+	};
+	RotationBlock block;
+	for (size_t begin = 0; begin < results.size(); begin += kAffineBatchSize) {
+		const size_t count = results.size() - begin < kAffineBatchSize ? results.size() - begin : kAffineBatchSize;
+		for (size_t index = 0; index < count; ++index) {
+			const Quaternion& rotate = rotates[begin + index];
+			const float xx = rotate.x * rotate.x;
+			const float yy = rotate.y * rotate.y;
+			const float zz = rotate.z * rotate.z;
+			const float xy = rotate.x * rotate.y;
+			const float xz = rotate.x * rotate.z;
+			const float yz = rotate.y * rotate.z;
+			const float wx = rotate.w * rotate.x;
+			const float wy = rotate.w * rotate.y;
+			const float wz = rotate.w * rotate.z;
+			block.m00[index] = 1.0f - 2.0f * (yy + zz);
+			block.m01[index] = 2.0f * (xy + wz);
+			block.m02[index] = 2.0f * (xz - wy);
+			block.m10[index] = 2.0f * (xy - wz);
+			block.m11[index] = 1.0f - 2.0f * (xx + zz);
+			block.m12[index] = 2.0f * (yz + wx);
+			block.m20[index] = 2.0f * (xz + wy);
+			block.m21[index] = 2.0f * (yz - wx);
+			block.m22[index] = 1.0f - 2.0f * (xx + yy);
+		}
+		for (size_t index = 0; index < count; ++index) {
+			const Vector3& scale = scales[begin + index];
+			const Vector3& translate = translates[begin + index];
+			results[begin + index] = {
+				scale.x * block.m00[index], scale.x * block.m01[index], scale.x * block.m02[index], 0.0f,
+				scale.y * block.m10[index], scale.y * block.m11[index], scale.y * block.m12[index], 0.0f,
+				scale.z * block.m20[index], scale.z * block.m21[index], scale.z * block.m22[index], 0.0f,
+				translate.x, translate.y, translate.z, 1.0f };
+		}
+	}
 }
 Matrix4x4 QuaternionToMatrix4x4(const Quaternion& q) {
 	Matrix4x4 mat;
@@ -5,6 +5,7 @@
 #include "cmath"
 #include <Vector3.h>
 #include <Quaternion.h>
+#include <span>
 
 
 namespace Engine {
@@ -33,12 +34,36 @@ Vector4 Transformation(const Vector4& vector, const Matrix4x4& matrix);
 
 Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m);
 
+// 座標変換をまとめて行う（vectors と results の要素数は同じにする）
+void Transformation(std::span<const Vector3> vectors, const Matrix4x4& matrix, std::span<Vector3> results);
+void TransformNormal(std::span<const Vector3> normals, const Matrix4x4& matrix, std::span<Vector3> results);
+
 // 逆行列
 Matrix4x4 Inverse(const Matrix4x4& m);
 
 // 転置行列
 Matrix4x4 Transpose(const Matrix4x4& m);
 
+// アフィン変換行列か（4列目が (0, 0, 0, 1)）
+bool IsAffine(const Matrix4x4& m);
+
+// アフィン変換行列の逆行列（左上3x3の逆行列と平行移動だけを求める）
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+// 回転と平行移動だけの行列の逆行列（左上3x3は転置するだけ）
+Matrix4x4 InverseRigid(const Matrix4x4& m);
+
+// アフィン変換行列の逆行列の転置行列（法線の変換用。Transpose(Inverse(m)) と同じ）
+Matrix4x4 InverseTransposeAffine(const Matrix4x4& m);
+
+// スカラー実装（SIMD 実装との比較用。ENGINE_MATH_NO_SIMD のときは上の関数もこれを使う）
+Vector3 TransformationScalar(const Vector3& vector, const Matrix4x4& matrix);
+Vector4 TransformationScalar(const Vector4& vector, const Matrix4x4& matrix);
+Vector3 TransformNormalScalar(const Vector3& v, const Matrix4x4& m);
+Matrix4x4 InverseScalar(const Matrix4x4& m);
+Matrix4x4 TransposeScalar(const Matrix4x4& m);
+Matrix4x4 MultiplyScalar(const Matrix4x4& m1, const Matrix4x4& m2);
+
 // 単位行列の作成
 Matrix4x4 MakeIdentity4x4();
 
@@ -53,8 +78,15 @@ Matrix4x4 MakeRotateXYZMatrix(const Vector3& radian);
 
 Matrix4x4 MakeRotateXYZMatrix(const Quaternion& quat);
 
+// アフィン変換行列（S * Rx * Ry * Rz * T を行列の掛け算をせずに直接求める）
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
 
+// アフィン変換行列（回転の sin / cos を先に求めてあるとき）
+Matrix4x4 MakeAffineMatrixFromSinCos(const Vector3& scale, const Vector3& sinRotate, const Vector3& cosRotate, const Vector3& translate);
+
+// アフィン変換行列をまとめて求める（各配列の要素数は同じにする。回転の sin / cos を先にまとめて求める）
+void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Vector3> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results);
+
 // tanθの逆数
 float cotf(float theta);
 
@@ -70,8 +102,12 @@ Matrix4x4 MakeViewPortMatrix(float left, float top, float width, float height, f
 // クォータニオンから回転軸(Vector3)を計算する関数
 Vector3 QuaternionToAxis(const Quaternion& q);
 
+// アフィン変換行列（S * R(q) * T を行列の掛け算をせずに直接求める）
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
 
+// アフィン変換行列をまとめて求める（各配列の要素数は同じにする。回転行列の要素を先にまとめて求める）
+void MakeAffineMatrices(std::span<const Vector3> scales, std::span<const Quaternion> rotates, std::span<const Vector3> translates, std::span<Matrix4x4> results);
+
 Matrix4x4 QuaternionToMatrix4x4(const Quaternion& q);
 
 float LerpShortAngle(float a, float b, float t);
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <random>
 
 /// <summary>
@@ -17,4 +18,44 @@ private:
     // 乱数生成器（メルセンヌ・ツイスタ）
     static std::mt19937& GetEngine();
 };
+
+/// <summary>
+/// 軽量な乱数生成器（PCG32）。状態は16バイトで、分布オブジェクトを作らずに範囲の値を出せる。
+/// 同じシード・系列なら同じ並びを返す
+/// </summary>
+class Pcg32 {
+public:
+    explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = 0xda3e39cb94b95bdbULL) { Seed(seed, stream); }
+
+    // シードと系列を設定する
+    void Seed(uint64_t seed, uint64_t stream = 0xda3e39cb94b95bdbULL) {
+        state_ = 0;
+        increment_ = (stream << 1) | 1;
+        Next();
+        state_ += seed;
+        Next();
+    }
+
+    // 系列を返す（Seed(seed, GetStream()) で系列を変えずにシードだけ設定し直せる）
+    uint64_t GetStream() const { return increment_ >> 1; }
+
+    // 32bit の乱数を返す
+    uint32_t Next() {
+        const uint64_t old = state_;
+        state_ = old * 6364136223846793005ULL + increment_;
+        const uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // [0, 1) の値を返す（上位24bitを使う）
+    float NextFloat() { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+
+    // [min, max) の値を返す
+    float Range(float min, float max) { return min + (max - min) * NextFloat(); }
+
+private:
+    uint64_t state_ = 0;
+    uint64_t increment_ = 1;
+};
 } // namespace Engine
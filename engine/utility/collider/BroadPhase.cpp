@@ -0,0 +1,214 @@
+#define NOMINMAX
+#include "BroadPhase.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Engine {
+///-------------------------------------------///
+/// 総当たり
+///-------------------------------------------///
+void BruteForceBroadPhase::ComputePairs(const std::vector<AABB>& bounds, std::vector<BroadPhasePair>& outPairs) {
+	outPairs.clear();
+	const uint32_t count = static_cast<uint32_t>(bounds.size());
+	for (uint32_t a = 0; a < count; ++a) {
+		for (uint32_t b = a + 1; b < count; ++b) {
+			outPairs.push_back({ a, b });
+		}
+	}
+}
+
+void BruteForceBroadPhase::Rebuild(const std::vector<AABB>&) {
+	// 保持している並びがないので何もしない
+}
+
+void BruteForceBroadPhase::QueryAABB(const std::vector<AABB>& bounds, const AABB& query, std::vector<uint32_t>& outIndices) const {
+	outIndices.clear();
+	const uint32_t count = static_cast<uint32_t>(bounds.size());
+	for (uint32_t i = 0; i < count; ++i) {
+		if (OverlapsAABB(bounds[i], query)) {
+			outIndices.push_back(i);
+		}
+	}
+}
+
+///-------------------------------------------///
+/// スイープ&プルーン
+///-------------------------------------------///
+void SweepAndPruneBroadPhase::ComputePairs(const std::vector<AABB>& bounds, std::vector<BroadPhasePair>& outPairs) {
+	outPairs.clear();
+	const uint32_t count = static_cast<uint32_t>(bounds.size());
+	Rebuild(bounds);
+
+	// X区間が重なる範囲だけを走査し、Y・Zで絞り込む
+	for (uint32_t i = 0; i < count; ++i) {
+		const uint32_t a = order_[i];
+		const AABB& boundsA = bounds[a];
+		for (uint32_t j = i + 1; j < count; ++j) {
+			const uint32_t b = order_[j];
+			const AABB& boundsB = bounds[b];
+			if (boundsB.min.x > boundsA.max.x) {
+				break;
+			}
+			if (boundsA.min.y <= boundsB.max.y && boundsA.max.y >= boundsB.min.y &&
+				boundsA.min.z <= boundsB.max.z && boundsA.max.z >= boundsB.min.z) {
+				outPairs.push_back({ a, b });
+			}
+		}
+	}
+}
+
+void SweepAndPruneBroadPhase::Rebuild(const std::vector<AABB>& bounds) {
+	const uint32_t count = static_cast<uint32_t>(bounds.size());
+	if (order_.size() != count) {
+		// 要素数が変わったら並べ直す
+		order_.resize(count);
+		std::iota(order_.begin(), order_.end(), 0u);
+		std::sort(order_.begin(), order_.end(), [&](uint32_t lhs, uint32_t rhs) {
+			return bounds[lhs].min.x < bounds[rhs].min.x;
+			});
+	}
+	else {
+		// 前フレームの並びはほぼ整列済みなので挿入ソートで十分
+		for (uint32_t i = 1; i < count; ++i) {
+			const uint32_t key = order_[i];
+			const float keyX = bounds[key].min.x;
+			uint32_t j = i;
+			while (j > 0 && bounds[order_[j - 1]].min.x > keyX) {
+				order_[j] = order_[j - 1];
+				--j;
+			}
+			order_[j] = key;
+		}
+	}
+}
+
+void SweepAndPruneBroadPhase::QueryAABB(const std::vector<AABB>& bounds, const AABB& query, std::vector<uint32_t>& outIndices) const {
+	outIndices.clear();
+	if (order_.size() != bounds.size()) {
+		return;
+	}
+	// min.x 昇順なので、問い合わせ範囲の右端を越えたら打ち切る
+	for (uint32_t index : order_) {
+		const AABB& target = bounds[index];
+		if (target.min.x > query.max.x) {
+			break;
+		}
+		if (OverlapsAABB(target, query)) {
+			outIndices.push_back(index);
+		}
+	}
+}
+
+///-------------------------------------------///
+/// 一様グリッド
+///-------------------------------------------///
+void UniformGridBroadPhase::SetWorldBounds(const Vector3& center, float halfExtent, uint32_t cellsPerSide) {
+	cellsPerSide_ = std::max(cellsPerSide, 1u);
+	halfExtent = std::max(halfExtent, 1.0f);
+	cellSize_ = (halfExtent * 2.0f) / static_cast<float>(cellsPerSide_);
+	invCellSize_ = 1.0f / cellSize_;
+	origin_ = { center.x - halfExtent, center.y, center.z - halfExtent };
+}
+
+uint32_t UniformGridBroadPhase::CellCoord(float value, float origin) const {
+	const float cell = std::floor((value - origin) * invCellSize_);
+	if (!(cell > 0.0f)) {
+		return 0u;
+	}
+	return std::min(static_cast<uint32_t>(cell), cellsPerSide_ - 1);
+}
+
+void UniformGridBroadPhase::ComputePairs(const std::vector<AABB>& bounds, std::vector<BroadPhasePair>& outPairs) {
+	outPairs.clear();
+	Rebuild(bounds);
+
+	// セル内のペアを判定
+	for (uint32_t z = 0; z < cellsPerSide_; ++z) {
+		for (uint32_t x = 0; x < cellsPerSide_; ++x) {
+			const uint32_t cell = z * cellsPerSide_ + x;
+			const uint32_t begin = cellStart_[cell];
+			const uint32_t end = cellStart_[cell + 1];
+			for (uint32_t i = begin; i < end; ++i) {
+				const uint32_t a = entries_[i];
+				const CellRange& rangeA = ranges_[a];
+				for (uint32_t j = i + 1; j < end; ++j) {
+					const uint32_t b = entries_[j];
+					const CellRange& rangeB = ranges_[b];
+					// 複数セルで重複して出さないよう、共有セルのうち最小のセルでだけ出力する
+					if (x != std::max(rangeA.x0, rangeB.x0) || z != std::max(rangeA.z0, rangeB.z0)) {
+						continue;
+					}
+					if (OverlapsAABB(bounds[a], bounds[b])) {
+						outPairs.push_back({ a, b });
+					}
+				}
+			}
+		}
+	}
+}
+
+void UniformGridBroadPhase::Rebuild(const std::vector<AABB>& bounds) {
+	const uint32_t count = static_cast<uint32_t>(bounds.size());
+	const uint32_t cellCount = cellsPerSide_ * cellsPerSide_;
+
+	// 各境界が覆うセル範囲を求め、セルごとの個数を数える
+	ranges_.resize(count);
+	cellStart_.assign(cellCount + 1, 0u);
+	for (uint32_t i = 0; i < count; ++i) {
+		CellRange& range = ranges_[i];
+		range.x0 = CellCoord(bounds[i].min.x, origin_.x);
+		range.x1 = CellCoord(bounds[i].max.x, origin_.x);
+		range.z0 = CellCoord(bounds[i].min.z, origin_.z);
+		range.z1 = CellCoord(bounds[i].max.z, origin_.z);
+		for (uint32_t z = range.z0; z <= range.z1; ++z) {
+			for (uint32_t x = range.x0; x <= range.x1; ++x) {
+				++cellStart_[z * cellsPerSide_ + x + 1];
+			}
+		}
+	}
+
+	// 累積和で各セルの開始位置を決めて詰める
+	for (uint32_t c = 0; c < cellCount; ++c) {
+		cellStart_[c + 1] += cellStart_[c];
+	}
+	entries_.resize(cellStart_[cellCount]);
+	cellCursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+	for (uint32_t i = 0; i < count; ++i) {
+		const CellRange& range = ranges_[i];
+		for (uint32_t z = range.z0; z <= range.z1; ++z) {
+			for (uint32_t x = range.x0; x <= range.x1; ++x) {
+				entries_[cellCursor_[z * cellsPerSide_ + x]++] = i;
+			}
+		}
+	}
+}
+
+void UniformGridBroadPhase::QueryAABB(const std::vector<AABB>& bounds, const AABB& query, std::vector<uint32_t>& outIndices) const {
+	outIndices.clear();
+	if (ranges_.size() != bounds.size() || cellStart_.size() != cellsPerSide_ * cellsPerSide_ + 1) {
+		return;
+	}
+
+	const uint32_t x0 = CellCoord(query.min.x, origin_.x);
+	const uint32_t x1 = CellCoord(query.max.x, origin_.x);
+	const uint32_t z0 = CellCoord(query.min.z, origin_.z);
+	const uint32_t z1 = CellCoord(query.max.z, origin_.z);
+	for (uint32_t z = z0; z <= z1; ++z) {
+		for (uint32_t x = x0; x <= x1; ++x) {
+			const uint32_t cell = z * cellsPerSide_ + x;
+			for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+				const uint32_t index = entries_[i];
+				const CellRange& range = ranges_[index];
+				// ペア列挙と同じく、共有セルのうち最小のセルでだけ出力する
+				if (x != std::max(range.x0, x0) || z != std::max(range.z0, z0)) {
+					continue;
+				}
+				if (OverlapsAABB(bounds[index], query)) {
+					outIndices.push_back(index);
+				}
+			}
+		}
+	}
+}
+} // namespace Engine
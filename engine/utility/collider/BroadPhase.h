@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "CollisionShapes.h"
+
+namespace Engine {
+/// <summary>
+/// ブロードフェーズが出力する候補ペア（境界配列のインデックス）
+/// </summary>
+struct BroadPhasePair {
+	uint32_t a;
+	uint32_t b;
+};
+
+/// <summary>
+/// ブロードフェーズの種類（GlobalVariablesの "broadPhase" に対応）
+/// </summary>
+enum class BroadPhaseType : int32_t {
+	kBruteForce,    // 総当たり
+	kSweepAndPrune, // X軸のスイープ&プルーン
+	kUniformGrid,   // XZ平面の一様グリッド
+	kCount,
+};
+
+/// <summary>
+/// AABB同士が重なっているか（接触も重なりとみなす）
+/// </summary>
+inline bool OverlapsAABB(const AABB& a, const AABB& b) {
+	return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+		a.min.y <= b.max.y && a.max.y >= b.min.y &&
+		a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+/// <summary>
+/// ブロードフェーズの抽象基底クラス。
+/// コライダー全体を包むAABBの配列から、重なる可能性のあるペアだけを列挙する。
+/// </summary>
+class IBroadPhase {
+public:
+	virtual ~IBroadPhase() = default;
+
+	/// <summary>種別名(ImGui表示用)</summary>
+	virtual const char* GetTypeName() const = 0;
+
+	/// <summary>
+	/// 候補ペアの列挙
+	/// </summary>
+	/// <param name="bounds">判定対象の境界AABB</param>
+	/// <param name="outPairs">候補ペアの出力先（先頭でクリアされる）</param>
+	virtual void ComputePairs(const std::vector<AABB>& bounds, std::vector<BroadPhasePair>& outPairs) = 0;
+
+	/// <summary>
+	/// 問い合わせ用の並び・セルだけを作り直す（境界の位置だけが変わったとき。ペアは列挙しない）
+	/// </summary>
+	/// <param name="bounds">判定対象の境界AABB</param>
+	virtual void Rebuild(const std::vector<AABB>& bounds) = 0;
+
+	/// <summary>
+	/// 指定したAABBと重なる境界の列挙（直前の ComputePairs・Rebuild と同じ bounds を渡すこと）
+	/// </summary>
+	/// <param name="bounds">判定対象の境界AABB</param>
+	/// <param name="query">問い合わせる範囲</param>
+	/// <param name="outIndices">重なった境界のインデックスの出力先（先頭でクリアされる）</param>
+	virtual void QueryAABB(const std::vector<AABB>& bounds, const AABB& query, std::vector<uint32_t>& outIndices) const = 0;
+};
+
+/// <summary>総当たり（比較用。AABBの重なりも見ずに全ペアを返す）</summary>
+class BruteForceBroadPhase : public IBroadPhase {
+public:
+	const char* GetTypeName() const override { return "BruteForce"; }
+	void ComputePairs(const std::vector<AABB>& bounds, std::vector<BroadPhasePair>& outPairs) override;
+	void Rebuild(const std::vector<AABB>& bounds) override;
+	void QueryAABB(const std::vector<AABB>& bounds, const AABB& query, std::vector<uint32_t>& outIndices) const override;
+};
+
+/// <summary>
+/// X軸のスイープ&プルーン。
+/// 前フレームの並び順を保持し、挿入ソートでほぼO(n)に並べ替える。
+/// </summary>
+class SweepAndPruneBroadPhase : public IBroadPhase {
+public:
+	const char* GetTypeName() const override { return "SweepAndPrune"; }
+	void ComputePairs(const std::vector<AABB>& bounds, std::vector<BroadPhasePair>& outPairs) override;
+	void Rebuild(const std::vector<AABB>& bounds) override;
+	void QueryAABB(const std::vector<AABB>& bounds, const AABB& query, std::vector<uint32_t>& outIndices) const override;
+
+private:
+	std::vector<uint32_t> order_; // min.x 昇順のインデックス
+};
+
+/// <summary>
+/// XZ平面の一様グリッド。
+/// ステージ中心・半径から範囲を決め、範囲外の境界は端のセルに寄せる。
+/// </summary>
+class UniformGridBroadPhase : public IBroadPhase {
+public:
+	const char* GetTypeName() const override { return "UniformGrid"; }
+	void ComputePairs(const std::vector<AABB>& bounds, std::vector<BroadPhasePair>& outPairs) override;
+	void Rebuild(const std::vector<AABB>& bounds) override;
+	void QueryAABB(const std::vector<AABB>& bounds, const AABB& query, std::vector<uint32_t>& outIndices) const override;
+
+	/// <summary>
+	/// グリッド範囲の設定
+	/// </summary>
+	/// <param name="center">中心座標</param>
+	/// <param name="halfExtent">中心から端までの距離</param>
+	/// <param name="cellsPerSide">1辺あたりのセル数</param>
+	void SetWorldBounds(const Vector3& center, float halfExtent, uint32_t cellsPerSide);
+
+private:
+	// セル範囲（両端を含む）
+	struct CellRange {
+		uint32_t x0, z0, x1, z1;
+	};
+
+	uint32_t CellCoord(float value, float origin) const;
+
+	Vector3 origin_ = { -40.0f, 0.0f, -40.0f }; // グリッドの最小点
+	float cellSize_ = 5.0f;
+	float invCellSize_ = 1.0f / 5.0f;
+	uint32_t cellsPerSide_ = 16;
+
+	std::vector<CellRange> ranges_;    // 境界ごとのセル範囲
+	std::vector<uint32_t> cellStart_;  // セルごとの開始位置（セル数+1）
+	std::vector<uint32_t> cellCursor_; // 書き込み位置
+	std::vector<uint32_t> entries_;    // セルに登録された境界インデックス
+};
+} // namespace Engine
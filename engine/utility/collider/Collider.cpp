@@ -1,3 +1,4 @@
+#define NOMINMAX
 #include "Collider.h"
 #include"CollisionManager.h"
 #include <line/DrawLine3D.h>
@@ -53,6 +54,16 @@ Collider::Collider() {
 	variables_->AddItem(groupName, "OBB center", OBBOffset.center);
 	variables_->AddItem(groupName, "OBB size", OBBOffset.size);
 	variables_->AddItem(groupName, "OBB Size Scale", adjustableOBBSize_);
+
+	// 毎フレーム読む項目は参照を取っておく
+	sphereTranslationItem_ = variables_->GetHandle<Vector3>(groupName, "Sphere Translation");
+	sphereRadiusItem_ = variables_->GetHandle<float>(groupName, "Sphere Radius");
+	aabbMinItem_ = variables_->GetHandle<Vector3>(groupName, "AABB Min");
+	aabbMaxItem_ = variables_->GetHandle<Vector3>(groupName, "AABB Max");
+	aabbScaleItem_ = variables_->GetHandle<Vector3>(groupName, "AABB Scale");
+	obbCenterItem_ = variables_->GetHandle<Vector3>(groupName, "OBB center");
+	obbSizeItem_ = variables_->GetHandle<Vector3>(groupName, "OBB size");
+	obbSizeScaleItem_ = variables_->GetHandle<Vector3>(groupName, "OBB Size Scale");
 }
 
 Collider::~Collider()
@@ -67,6 +78,10 @@ void Collider::Initialize() {
 void Collider::UpdateWorldTransform() {
 	ApplyVariables();
 
+	// 更新前の形状を前フレームの値として残す
+	previousCenter_ = Cubewt_.translation_;
+	previousAabb_ = aabb;
+
 	// 球用のワールドトランスフォームを更新
 	float actualRadius = radius_ * adjustableRadius_;
 	Cubewt_.translation_ = GetCenterPosition() + SphereOffset;
@@ -100,6 +115,50 @@ void Collider::UpdateWorldTransform() {
 	OBBwt_.rotation_ = GetCenterRotation();
 	OBBwt_.scale_ = obb.size;
 	OBBwt_.UpdateMatrix();
+
+	// 初回は前フレームが無いので現フレームと同じにする（生成位置からの移動とみなさない）
+	if (!hasPreviousTransform_) {
+		previousCenter_ = Cubewt_.translation_;
+		previousAabb_ = aabb;
+		hasPreviousTransform_ = true;
+	}
+}
+
+AABB Collider::GetBroadPhaseBounds() const {
+	// 球
+	const Vector3& center = Cubewt_.translation_;
+	AABB bounds;
+	bounds.min = center - Vector3(radius_, radius_, radius_);
+	bounds.max = center + Vector3(radius_, radius_, radius_);
+
+	// 境界を広げる
+	auto expand = [&bounds](const Vector3& point) {
+		bounds.min = { std::min(bounds.min.x, point.x), std::min(bounds.min.y, point.y), std::min(bounds.min.z, point.z) };
+		bounds.max = { std::max(bounds.max.x, point.x), std::max(bounds.max.y, point.y), std::max(bounds.max.z, point.z) };
+		};
+
+	// AABB（オフセットで反転していても包めるよう両端を入れる）
+	expand(aabb.min);
+	expand(aabb.max);
+
+	// OBB（各軸の寄与の絶対値を足したものがワールド軸方向の半径）
+	Vector3 extent = {
+		std::abs(obb.orientations[0].x) * obb.size.x + std::abs(obb.orientations[1].x) * obb.size.y + std::abs(obb.orientations[2].x) * obb.size.z,
+		std::abs(obb.orientations[0].y) * obb.size.x + std::abs(obb.orientations[1].y) * obb.size.y + std::abs(obb.orientations[2].y) * obb.size.z,
+		std::abs(obb.orientations[0].z) * obb.size.x + std::abs(obb.orientations[1].z) * obb.size.y + std::abs(obb.orientations[2].z) * obb.size.z,
+	};
+	expand(obb.center - extent);
+	expand(obb.center + extent);
+
+	// 連続判定するものは前フレームの位置からの移動範囲も含める
+	if (isContinuousEnabled_) {
+		expand(previousCenter_ - Vector3(radius_, radius_, radius_));
+		expand(previousCenter_ + Vector3(radius_, radius_, radius_));
+		expand(previousAabb_.min);
+		expand(previousAabb_.max);
+	}
+
+	return bounds;
 }
 
 void Collider::DrawSphere(const ViewProjection& viewProjection) {
@@ -206,14 +265,14 @@ void Collider::DrawOBB(const ViewProjection& viewProjection) {
 
 void Collider::ApplyVariables()
 {
-	SphereOffset = variables_->GetVector3Value(groupName, "Sphere Translation");
-	adjustableRadius_ = variables_->GetFloatValue(groupName, "Sphere Radius");
-	AABBOffset.min = variables_->GetVector3Value(groupName, "AABB Min");
-	AABBOffset.max = variables_->GetVector3Value(groupName, "AABB Max");
-	adjustableAABBScale_ = variables_->GetVector3Value(groupName, "AABB Scale");
-	OBBOffset.center = variables_->GetVector3Value(groupName, "OBB center");
-	OBBOffset.size = variables_->GetVector3Value(groupName, "OBB size");
-	adjustableOBBSize_ = variables_->GetVector3Value(groupName, "OBB Size Scale");
+	SphereOffset = sphereTranslationItem_.Get();
+	adjustableRadius_ = sphereRadiusItem_.Get();
+	AABBOffset.min = aabbMinItem_.Get();
+	AABBOffset.max = aabbMaxItem_.Get();
+	adjustableAABBScale_ = aabbScaleItem_.Get();
+	OBBOffset.center = obbCenterItem_.Get();
+	OBBOffset.size = obbSizeItem_.Get();
+	adjustableOBBSize_ = obbSizeScaleItem_.Get();
 }
 
 void Collider::MakeOBBOrientations(OBB& obb, const Vector3& rotate) {
@@ -4,29 +4,15 @@
 #include"Object3d.h"
 #include"ViewProjection.h"
 #include"GlobalVariables.h"
+#include"CollisionShapes.h"
 
-/// <summary>
-/// AABB
-/// </summary>
 namespace Engine {
-struct AABB {
-	Vector3 min; //!< 最小点
-	Vector3 max; //!< 最大点
-};
-
-/// <summary>
-/// OBB
-/// </summary>
-struct OBB {
-	Vector3 center;          //!< 中心点
-	Vector3 orientations[3]; //!< 座標軸。正規化・直行必須
-	Vector3 size;            //!< 座標軸方向の長さの半分。中心から面までの距離
-};
-
 /// <summary>
 /// 当たり判定クラス
 /// </summary>
 class Collider {
+	friend class CollisionManager;
+
 public:
 
 	Collider();
@@ -88,21 +74,34 @@ public:
 	float GetRadius() { return radius_; }
 	//識別IDを取得
 	uint32_t GetTypeID() const { return typeID_; }
+	// 衝突レイヤーのビットを取得（識別IDをそのままレイヤー番号として使う）
+	uint32_t GetLayerBit() const { return 1u << typeID_; }
 	// 中心座標を取得
 	virtual Vector3 GetCenterPosition() const = 0;
 	virtual Vector3 GetCenterRotation() const = 0;
 	Vector3 GetCenter() { return Cubewt_.translation_; }
 	AABB GetAABB() { return aabb; }
 	OBB GetOBB() { return obb; }
+	// 球・AABB・OBBをすべて包むAABB（ブロードフェーズ用）
+	AABB GetBroadPhaseBounds() const;
 	bool IsCollisionEnabled() const { return isCollisionEnabled_; }
+	// 前フレームからの移動も判定するか（速く動いてすり抜けやすいもの用）
+	bool IsContinuousEnabled() const { return isContinuousEnabled_; }
+	// 前フレームの球の中心
+	const Vector3& GetPreviousCenter() const { return previousCenter_; }
+	// 前フレームのAABB
+	const AABB& GetPreviousAABB() const { return previousAabb_; }
+	// 衝突コールバック中の衝突時刻（0:前フレームの位置 〜 1:現フレームの位置）
+	float GetTimeOfImpact() const { return timeOfImpact_; }
 
 	/// <summary>
 	/// setter
 	/// </summary>
 	/// <param name="radius"></param>
 	void SetRadius(float radius) { radius_ = radius; }
-	void SetTypeID(uint32_t typeID) { typeID_ = typeID; }
+	void SetTypeID(uint32_t typeID) { assert(typeID < 32u); typeID_ = typeID; }
 	void SetCollisionEnabled(bool enabled) { isCollisionEnabled_ = enabled; }
+	void SetContinuousEnabled(bool enabled) { isContinuousEnabled_ = enabled; }
 	void SetAABBScale(const Vector3& scale) { scale_ = scale; }
 	void SetHitColor() { color_ = { 1.0f,0.0f,0.0f,1.0f }; }
 	void SetDefaultColor() { color_ = { 1.0f,1.0f,1.0f,1.0f }; }
@@ -114,6 +113,9 @@ private:
 
 private:
 
+	// CollisionManagerが割り当てるハンドル（スロット番号＋世代。0は未登録）
+	uint32_t handle_ = 0u;
+
 	// 衝突半径
 	float radius_ = 1.0f;
 	//識別ID
@@ -130,6 +132,16 @@ private:
 
 	GlobalVariables* variables_;
 	std::string groupName;
+
+	// 調整項目への参照（毎フレームの文字列検索を避ける）
+	GlobalVariables::ItemHandle<Vector3> sphereTranslationItem_;
+	GlobalVariables::ItemHandle<float> sphereRadiusItem_;
+	GlobalVariables::ItemHandle<Vector3> aabbMinItem_;
+	GlobalVariables::ItemHandle<Vector3> aabbMaxItem_;
+	GlobalVariables::ItemHandle<Vector3> aabbScaleItem_;
+	GlobalVariables::ItemHandle<Vector3> obbCenterItem_;
+	GlobalVariables::ItemHandle<Vector3> obbSizeItem_;
+	GlobalVariables::ItemHandle<Vector3> obbSizeScaleItem_;
 	AABB aabb;
 	OBB obb;
 	Vector3 aabbCenter;
@@ -148,5 +160,13 @@ private:
 	Vector3 adjustableOBBSize_ = { 1.0f, 1.0f, 1.0f };
 
 	bool isCollisionEnabled_ = true;  // デフォルトではコリジョンを有効化
+	bool isContinuousEnabled_ = false;
+
+	// 前フレームの形状（連続判定用）
+	Vector3 previousCenter_;
+	AABB previousAabb_;
+	bool hasPreviousTransform_ = false;
+	// CollisionManagerがコールバック直前に設定する
+	float timeOfImpact_ = 1.0f;
 };
 } // namespace Engine
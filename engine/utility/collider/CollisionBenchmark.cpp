@@ -0,0 +1,474 @@
+#include "CollisionBenchmark.h"
+#ifdef _DEBUG
+#include "BroadPhase.h"
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <random>
+#include <vector>
+
+namespace Engine {
+namespace {
+using Benchmark::Clock;
+using Benchmark::ElapsedMs;
+
+constexpr float kCheckStageRadius = 50.0f; // RunChecks で並べる範囲
+
+///-------------------------------------------///
+/// 旧実装（CollisionManager::IsCollision / CheckCollisionBetween をそのまま移したもの）。
+/// 狭域判定を置き換えたときの基準として残す
+///-------------------------------------------///
+void LegacyProjectOBB(const OBB& obb, const Vector3& axis, float& min, float& max) {
+	float centerProjection = obb.center.Dot(axis);
+	float radius = std::abs(obb.orientations[0].Dot(axis)) * obb.size.x +
+		std::abs(obb.orientations[1].Dot(axis)) * obb.size.y +
+		std::abs(obb.orientations[2].Dot(axis)) * obb.size.z;
+
+	min = centerProjection - radius;
+	max = centerProjection + radius;
+}
+
+bool LegacyTestAxis(const Vector3& axis, const OBB& obb1, const OBB& obb2) {
+	float min1, max1, min2, max2;
+	LegacyProjectOBB(obb1, axis, min1, max1);
+	LegacyProjectOBB(obb2, axis, min2, max2);
+
+	float sumSpan = (max1 - min1) + (max2 - min2);
+	float longSpan = std::max(max1, max2) - std::min(min1, min2);
+
+	return sumSpan >= longSpan;
+}
+
+bool LegacyIsCollision(const AABB& aabb1, const AABB& aabb2) {
+	if ((aabb1.min.x <= aabb2.max.x && aabb1.max.x >= aabb2.min.x) &&
+		(aabb1.min.y <= aabb2.max.y && aabb1.max.y >= aabb2.min.y) &&
+		(aabb1.min.z <= aabb2.max.z && aabb1.max.z >= aabb2.min.z)) {
+		return true;
+	}
+	return false;
+}
+
+bool LegacyIsCollision(const OBB& obb1, const OBB& obb2) {
+	Vector3 axes[15] = {
+		obb1.orientations[0],
+		obb1.orientations[1],
+		obb1.orientations[2],
+		obb2.orientations[0],
+		obb2.orientations[1],
+		obb2.orientations[2],
+		obb1.orientations[0].Cross(obb2.orientations[0]),
+		obb1.orientations[0].Cross(obb2.orientations[1]),
+		obb1.orientations[0].Cross(obb2.orientations[2]),
+		obb1.orientations[1].Cross(obb2.orientations[0]),
+		obb1.orientations[1].Cross(obb2.orientations[1]),
+		obb1.orientations[1].Cross(obb2.orientations[2]),
+		obb1.orientations[2].Cross(obb2.orientations[0]),
+		obb1.orientations[2].Cross(obb2.orientations[1]),
+		obb1.orientations[2].Cross(obb2.orientations[2]),
+	};
+
+	for (const Vector3& axis : axes) {
+		if (axis.Length() > 0.0001f && !LegacyTestAxis(axis.Normalize(), obb1, obb2)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// <summary>
+/// 比較用の形状（旧実装はコライダーから、新しい判定はスナップショットから読む）
+/// </summary>
+struct LegacyShape {
+	Vector3 center;
+	float radius = 0.0f;
+	AABB aabb;
+	OBB obb;
+};
+
+// 旧 CheckCollisionBetween（有効・無効の確認を除き、形状を直接受け取る）
+bool LegacyCheckCollisionBetween(const NarrowPhase::Shapes& shapes, const LegacyShape& colliderA, const LegacyShape& colliderB) {
+	// 球の衝突チェック
+	if (shapes.sphere) {
+		float distance = (colliderA.center - colliderB.center).Length();
+		if (distance <= colliderA.radius + colliderB.radius) {
+			return true;
+		}
+	}
+
+	// AABBの衝突チェック
+	if (shapes.aabb) {
+		if (LegacyIsCollision(colliderA.aabb, colliderB.aabb)) {
+			return true;
+		}
+	}
+
+	// OBB同士の衝突チェック
+	if (shapes.obb) {
+		if (LegacyIsCollision(colliderA.obb, colliderB.obb)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// 形状を scale 倍に広げる（差が接する程度のものかを確かめる）
+LegacyShape Inflate(const LegacyShape& shape, float scale) {
+	LegacyShape inflated = shape;
+	inflated.radius *= scale;
+	const Vector3 center = (shape.aabb.min + shape.aabb.max) * 0.5f;
+	inflated.aabb.min = center + (shape.aabb.min - center) * scale;
+	inflated.aabb.max = center + (shape.aabb.max - center) * scale;
+	inflated.obb.size = shape.obb.size * scale;
+	return inflated;
+}
+} // namespace
+
+CollisionBenchmark::BroadPhaseResult CollisionBenchmark::RunBroadPhase(uint32_t colliderCount, float stageRadius, uint32_t seed) {
+	BroadPhaseResult result;
+	result.colliderCount = colliderCount;
+
+	// ステージ上に弾程度の大きさの境界をばらまく
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> posXZ(-stageRadius, stageRadius);
+	std::uniform_real_distribution<float> posY(0.0f, 4.0f);
+	std::uniform_real_distribution<float> halfSize(0.25f, 1.5f);
+
+	std::vector<AABB> bounds(colliderCount);
+	for (AABB& aabb : bounds) {
+		Vector3 center = { posXZ(engine), posY(engine), posXZ(engine) };
+		float size = halfSize(engine);
+		aabb.min = center - Vector3(size, size, size);
+		aabb.max = center + Vector3(size, size, size);
+	}
+
+	std::vector<BroadPhasePair> pairs;
+	pairs.reserve(colliderCount * 8);
+
+	// 総当たり（旧実装と同じ二重ループ）
+	{
+		Clock::time_point start = Clock::now();
+		uint32_t hits = 0;
+		for (uint32_t a = 0; a < colliderCount; ++a) {
+			for (uint32_t b = a + 1; b < colliderCount; ++b) {
+				if (OverlapsAABB(bounds[a], bounds[b])) {
+					++hits;
+				}
+			}
+		}
+		result.bruteForceMs = ElapsedMs(start);
+		result.bruteForceHits = hits;
+	}
+
+	// スイープ&プルーン
+	{
+		SweepAndPruneBroadPhase broadPhase;
+		Clock::time_point start = Clock::now();
+		broadPhase.ComputePairs(bounds, pairs);
+		result.sweepAndPruneMs = ElapsedMs(start);
+		result.sweepAndPruneHits = static_cast<uint32_t>(pairs.size());
+	}
+
+	// 一様グリッド
+	{
+		UniformGridBroadPhase broadPhase;
+		broadPhase.SetWorldBounds({ 0.0f, 0.0f, 0.0f }, stageRadius, 16);
+		Clock::time_point start = Clock::now();
+		broadPhase.ComputePairs(bounds, pairs);
+		result.uniformGridMs = ElapsedMs(start);
+		result.uniformGridHits = static_cast<uint32_t>(pairs.size());
+	}
+
+	return result;
+}
+
+CollisionBenchmark::NarrowPhaseResult CollisionBenchmark::RunNarrowPhase(uint32_t colliderCount, uint32_t seed) {
+	NarrowPhaseResult result;
+	result.testCount = colliderCount * colliderCount;
+	result.supportedLevel = NarrowPhase::GetSupportedLevel();
+
+	// 狭い範囲に回転したOBBを詰め、一定数が当たるようにする
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> position(-6.0f, 6.0f);
+	std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+	std::uniform_real_distribution<float> halfSize(0.25f, 2.0f);
+
+	ColliderSnapshot snapshot;
+	std::vector<LegacyShape> legacyShapes(colliderCount);
+	for (uint32_t i = 0; i < colliderCount; ++i) {
+		OBB obb;
+		obb.center = { position(engine), position(engine), position(engine) };
+		// Y→X の順に回転させた正規直交基底（4つに1つは回転なしにして、平行な辺どうしの外積が0になる組も混ぜる）
+		const bool isAxisAligned = i % 4 == 0;
+		const float yaw = isAxisAligned ? 0.0f : angle(engine);
+		const float pitch = isAxisAligned ? 0.0f : angle(engine);
+		const float cy = std::cos(yaw), sy = std::sin(yaw);
+		const float cp = std::cos(pitch), sp = std::sin(pitch);
+		obb.orientations[0] = { cy, 0.0f, -sy };
+		obb.orientations[1] = { sy * sp, cp, cy * sp };
+		obb.orientations[2] = { sy * cp, -sp, cy * cp };
+		obb.size = { halfSize(engine), halfSize(engine), halfSize(engine) };
+
+		// 旧実装との比較用に球・AABBも持たせる（計測はOBBのみ）
+		LegacyShape& shape = legacyShapes[i];
+		shape.center = obb.center;
+		shape.radius = std::max({ obb.size.x, obb.size.y, obb.size.z });
+		shape.aabb = { obb.center - obb.size, obb.center + obb.size };
+		shape.obb = obb;
+		snapshot.Push(shape.center, shape.radius, shape.aabb, shape.obb);
+	}
+
+	std::vector<uint32_t> others(colliderCount);
+	for (uint32_t i = 0; i < colliderCount; ++i) {
+		others[i] = i;
+	}
+
+	// OBBのみを判定する
+	NarrowPhase::Shapes shapes;
+	shapes.sphere = false;
+	shapes.aabb = false;
+
+	std::vector<uint8_t> hits[3];
+	for (int32_t level = 0; level <= static_cast<int32_t>(result.supportedLevel); ++level) {
+		std::vector<uint8_t>& levelHits = hits[level];
+		levelHits.resize(static_cast<size_t>(colliderCount) * colliderCount);
+		Clock::time_point start = Clock::now();
+		for (uint32_t a = 0; a < colliderCount; ++a) {
+			NarrowPhase::TestOneVsMany(snapshot, a, others.data(), colliderCount, shapes,
+				static_cast<NarrowPhase::SimdLevel>(level), levelHits.data() + static_cast<size_t>(a) * colliderCount);
+		}
+		result.ms[level] = ElapsedMs(start);
+		for (uint8_t hit : levelHits) {
+			result.hits[level] += hit;
+		}
+	}
+
+	// スカラー版との一致確認
+	for (int32_t level = 1; level <= static_cast<int32_t>(result.supportedLevel); ++level) {
+		for (size_t i = 0; i < hits[0].size(); ++i) {
+			if (hits[level][i] != hits[0][i]) {
+				++result.mismatchCount;
+			}
+		}
+	}
+
+	// 旧 IsCollision(OBB)（置き換える前の時間）
+	{
+		Clock::time_point start = Clock::now();
+		for (uint32_t a = 0; a < colliderCount; ++a) {
+			for (uint32_t b = 0; b < colliderCount; ++b) {
+				result.legacyHits += LegacyIsCollision(legacyShapes[a].obb, legacyShapes[b].obb) ? 1u : 0u;
+			}
+		}
+		result.legacyMs = ElapsedMs(start);
+	}
+
+	// 旧実装との比較（OBBのみと、球・AABB・OBBの全部）
+	constexpr float kInflateScale = 1.001f;
+	NarrowPhase::Shapes allShapes;
+	std::vector<uint8_t> scalarHits(colliderCount);
+	for (const NarrowPhase::Shapes& compared : { shapes, allShapes }) {
+		for (uint32_t a = 0; a < colliderCount; ++a) {
+			NarrowPhase::TestOneVsMany(snapshot, a, others.data(), colliderCount, compared, NarrowPhase::SimdLevel::kScalar, scalarHits.data());
+			for (uint32_t b = 0; b < colliderCount; ++b) {
+				const bool isLegacyHit = LegacyCheckCollisionBetween(compared, legacyShapes[a], legacyShapes[b]);
+				if (isLegacyHit && !scalarHits[b]) {
+					++result.legacyMissCount;
+				}
+				else if (!isLegacyHit && scalarHits[b]) {
+					++result.legacyExtraCount;
+					if (!LegacyCheckCollisionBetween(compared, Inflate(legacyShapes[a], kInflateScale), Inflate(legacyShapes[b], kInflateScale))) {
+						++result.legacyUnexplainedCount;
+					}
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+CollisionBenchmark::ParallelScalingResult CollisionBenchmark::RunParallelScaling(uint32_t colliderCount, float stageRadius, uint32_t seed) {
+	// 同じ計測を繰り返して最短時間を取る回数
+	constexpr uint32_t kRepeatCount = 5;
+
+	ParallelScalingResult result;
+	result.colliderCount = colliderCount;
+
+	// 球・AABB・OBBを持つコライダーをステージ上にばらまく
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> posXZ(-stageRadius, stageRadius);
+	std::uniform_real_distribution<float> posY(0.0f, 4.0f);
+	std::uniform_real_distribution<float> halfSize(0.25f, 1.5f);
+	std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+
+	ColliderSnapshot snapshot;
+	std::vector<AABB> bounds(colliderCount);
+	for (uint32_t i = 0; i < colliderCount; ++i) {
+		const Vector3 center = { posXZ(engine), posY(engine), posXZ(engine) };
+		const float size = halfSize(engine);
+		AABB aabb = { center - Vector3(size, size, size), center + Vector3(size, size, size) };
+
+		OBB obb;
+		obb.center = center;
+		const float yaw = angle(engine);
+		const float cy = std::cos(yaw), sy = std::sin(yaw);
+		obb.orientations[0] = { cy, 0.0f, -sy };
+		obb.orientations[1] = { 0.0f, 1.0f, 0.0f };
+		obb.orientations[2] = { sy, 0.0f, cy };
+		obb.size = { size, size * 0.5f, size };
+
+		snapshot.Push(center, size, aabb, obb);
+		// 回転しても size の箱に収まるよう √3 倍で包む
+		const float boundSize = size * 1.7320508f;
+		bounds[i] = { center - Vector3(boundSize, boundSize, boundSize), center + Vector3(boundSize, boundSize, boundSize) };
+	}
+
+	std::vector<BroadPhasePair> pairs;
+	UniformGridBroadPhase broadPhase;
+	broadPhase.SetWorldBounds({ 0.0f, 0.0f, 0.0f }, stageRadius, 16);
+	broadPhase.ComputePairs(bounds, pairs);
+	result.candidateCount = static_cast<uint32_t>(pairs.size());
+
+	NarrowPhase::Workspace workspace;
+	NarrowPhase::GroupPairs(pairs, colliderCount, workspace);
+
+	const NarrowPhase::Shapes shapes;
+	const NarrowPhase::SimdLevel level = NarrowPhase::GetSupportedLevel();
+	const uint32_t maxThreads = JobSystem::GetInstance()->GetMaxThreadCount();
+
+	std::vector<NarrowPhase::Hit> reference;
+	std::vector<NarrowPhase::Hit> hits;
+	for (uint32_t step = 0; step < ParallelScalingResult::kStepCount; ++step) {
+		const uint32_t threads = result.requestedThreads[step];
+		result.usedThreads[step] = std::min(threads, maxThreads);
+
+		double bestMs = 0.0;
+		for (uint32_t repeat = 0; repeat < kRepeatCount; ++repeat) {
+			Clock::time_point start = Clock::now();
+			NarrowPhase::TestGroupsParallel(snapshot, shapes, level, threads, {}, workspace, hits);
+			const double ms = ElapsedMs(start);
+			bestMs = (repeat == 0) ? ms : std::min(bestMs, ms);
+		}
+		result.ms[step] = bestMs;
+
+		if (step == 0) {
+			reference = hits;
+			result.hitCount = static_cast<uint32_t>(hits.size());
+		}
+		else if (hits != reference) {
+			result.isDeterministic = false;
+		}
+	}
+
+	return result;
+}
+
+std::vector<CollisionBenchmark::SweptScenarioResult> CollisionBenchmark::RunSweptScenarios() {
+	// 衝突時刻の許容誤差
+	constexpr float kTimeTolerance = 1.0e-4f;
+
+	std::vector<SweptScenarioResult> results;
+	auto finish = [&](SweptScenarioResult& result) {
+		result.passed = (result.sweptHit == result.expectedHit) &&
+			(!result.expectedHit || std::abs(result.timeOfImpact - result.expectedTimeOfImpact) <= kTimeTolerance);
+		results.push_back(result);
+		};
+
+	// 球（半径0.5）が1フレームで静止した球を通り抜ける
+	{
+		SweptScenarioResult result;
+		result.name = "Sphere through sphere";
+		Vector3 start = { -10.0f, 0.0f, 0.0f };
+		Vector3 end = { 10.0f, 0.0f, 0.0f };
+		Vector3 target = { 0.0f, 0.0f, 0.0f };
+		result.discreteHit = (end - target).Length() <= 1.0f;
+		result.sweptHit = NarrowPhase::SweepSphere(start, end, 0.5f, target, target, 0.5f, result.timeOfImpact);
+		result.expectedHit = true;
+		result.expectedTimeOfImpact = 9.0f / 20.0f;
+		finish(result);
+	}
+
+	// 向かい合って動く球がすれ違う
+	{
+		SweptScenarioResult result;
+		result.name = "Sphere vs sphere (both moving)";
+		Vector3 startA = { -10.0f, 0.0f, 0.0f };
+		Vector3 endA = { 10.0f, 0.0f, 0.0f };
+		Vector3 startB = { 10.0f, 0.0f, 0.0f };
+		Vector3 endB = { -10.0f, 0.0f, 0.0f };
+		result.discreteHit = (endA - endB).Length() <= 1.0f;
+		result.sweptHit = NarrowPhase::SweepSphere(startA, endA, 0.5f, startB, endB, 0.5f, result.timeOfImpact);
+		result.expectedHit = true;
+		result.expectedTimeOfImpact = 19.0f / 40.0f;
+		finish(result);
+	}
+
+	// 横を通り過ぎる球（当たらない）
+	{
+		SweptScenarioResult result;
+		result.name = "Sphere passing by";
+		Vector3 start = { -10.0f, 3.0f, 0.0f };
+		Vector3 end = { 10.0f, 3.0f, 0.0f };
+		Vector3 target = { 0.0f, 0.0f, 0.0f };
+		result.discreteHit = (end - target).Length() <= 1.0f;
+		result.sweptHit = NarrowPhase::SweepSphere(start, end, 0.5f, target, target, 0.5f, result.timeOfImpact);
+		result.expectedHit = false;
+		finish(result);
+	}
+
+	// 箱（半サイズ0.25）が厚さ0.1の壁を通り抜ける
+	{
+		SweptScenarioResult result;
+		result.name = "Box through thin wall";
+		AABB box = { { -5.25f, -0.25f, -0.25f }, { -4.75f, 0.25f, 0.25f } };
+		AABB wall = { { -0.05f, -2.0f, -2.0f }, { 0.05f, 2.0f, 2.0f } };
+		Vector3 move = { 10.0f, 0.0f, 0.0f };
+		AABB end = { box.min + move, box.max + move };
+		result.discreteHit = OverlapsAABB(end, wall);
+		result.sweptHit = NarrowPhase::SweepAABB(box, move, wall, { 0.0f, 0.0f, 0.0f }, result.timeOfImpact);
+		result.expectedHit = true;
+		result.expectedTimeOfImpact = 4.7f / 10.0f;
+		finish(result);
+	}
+
+	// 箱が壁の上を飛び越える（当たらない）
+	{
+		SweptScenarioResult result;
+		result.name = "Box over wall";
+		AABB box = { { -5.25f, 2.5f, -0.25f }, { -4.75f, 3.0f, 0.25f } };
+		AABB wall = { { -0.05f, -2.0f, -2.0f }, { 0.05f, 2.0f, 2.0f } };
+		Vector3 move = { 10.0f, 0.0f, 0.0f };
+		AABB end = { box.min + move, box.max + move };
+		result.discreteHit = OverlapsAABB(end, wall);
+		result.sweptHit = NarrowPhase::SweepAABB(box, move, wall, { 0.0f, 0.0f, 0.0f }, result.timeOfImpact);
+		result.expectedHit = false;
+		finish(result);
+	}
+
+	return results;
+}
+
+void CollisionBenchmark::RunChecks(const Benchmark::Check& check) {
+	const BroadPhaseResult broadPhase = RunBroadPhase(500, kCheckStageRadius);
+	check("Collision: sweep and prune matches brute force", broadPhase.sweepAndPruneHits == broadPhase.bruteForceHits);
+	check("Collision: uniform grid matches brute force", broadPhase.uniformGridHits == broadPhase.bruteForceHits);
+
+	const NarrowPhaseResult narrowPhase = RunNarrowPhase(64);
+	check("Collision: SIMD narrow phase matches scalar", narrowPhase.mismatchCount == 0);
+	check("Collision: narrow phase hits everything the legacy IsCollision hits", narrowPhase.legacyMissCount == 0);
+	check(std::format("Collision: {} extra hits over legacy are touching contacts", narrowPhase.legacyExtraCount),
+		narrowPhase.legacyUnexplainedCount == 0);
+
+	for (const SweptScenarioResult& swept : RunSweptScenarios()) {
+		check(std::format("Collision: swept {}", swept.name), swept.passed);
+	}
+
+	const ParallelScalingResult scaling = RunParallelScaling(500, kCheckStageRadius);
+	check("Collision: parallel narrow phase is deterministic", scaling.isDeterministic);
+}
+} // namespace Engine
+#endif // _DEBUG
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Benchmark.h"
+#include "NarrowPhase.h"
+
+namespace Engine {
+/// <summary>
+/// 当たり判定の計測（デバッグビルドのみ。描画・GPUに依存せず単体で実行できる）
+/// </summary>
+class CollisionBenchmark {
+public:
+	/// <summary>
+	/// ブロードフェーズ計測結果
+	/// </summary>
+	struct BroadPhaseResult {
+		uint32_t colliderCount = 0;
+		double bruteForceMs = 0.0;     // 全ペアにAABB判定をかけた時間
+		double sweepAndPruneMs = 0.0;
+		double uniformGridMs = 0.0;
+		uint32_t bruteForceHits = 0;   // 重なったペア数（3方式で一致するはず）
+		uint32_t sweepAndPruneHits = 0;
+		uint32_t uniformGridHits = 0;
+	};
+
+	/// <summary>
+	/// ブロードフェーズを総当たりと比較する
+	/// </summary>
+	/// <param name="colliderCount">コライダー数</param>
+	/// <param name="stageRadius">配置範囲（ステージ半径）</param>
+	/// <param name="seed">乱数シード</param>
+	static BroadPhaseResult RunBroadPhase(uint32_t colliderCount, float stageRadius, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 狭域判定計測結果（OBB同士）
+	/// </summary>
+	struct NarrowPhaseResult {
+		uint32_t testCount = 0;
+		double ms[3] = {};               // SimdLevel ごとの時間（未対応の命令セットは0）
+		uint32_t hits[3] = {};           // SimdLevel ごとの衝突数
+		uint32_t mismatchCount = 0;      // スカラー版と結果が食い違った数（0であるべき）
+		NarrowPhase::SimdLevel supportedLevel = NarrowPhase::SimdLevel::kScalar;
+
+		// 旧実装（CollisionManager::IsCollision / CheckCollisionBetween）との比較
+		double legacyMs = 0.0;           // 旧 IsCollision(OBB) の時間
+		uint32_t legacyHits = 0;         // 旧 IsCollision(OBB) の衝突数
+		uint32_t legacyMissCount = 0;    // 旧実装だけが当たった数（0であるべき）
+		uint32_t legacyExtraCount = 0;   // スカラー版だけが当たった数（ほぼ平行な軸の扱いの差。接する程度のものだけ）
+		uint32_t legacyUnexplainedCount = 0; // そのうち旧実装の形状を少し大きくしても当たらなかった数（0であるべき）
+	};
+
+	/// <summary>
+	/// OBB同士の判定をスカラー・SSE・AVX2・旧実装で比較する（結果の一致も確認する）。
+	/// 旧実装は外積の軸を正規化し、長さ 1e-4 以下の軸（ほぼ平行な辺どうし）を飛ばしていた。
+	/// 今の分離軸判定は正規化せず、回転行列の絶対値に kEpsilon を足して判定を甘くする側に倒すので、
+	/// 旧実装で当たるものは必ず当たり、接する程度のものだけが余分に当たる
+	/// </summary>
+	/// <param name="colliderCount">コライダー数（各コライダーが全員と判定する）</param>
+	/// <param name="seed">乱数シード</param>
+	static NarrowPhaseResult RunNarrowPhase(uint32_t colliderCount, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 並列判定のスレッド数ごとの計測結果
+	/// </summary>
+	struct ParallelScalingResult {
+		static constexpr uint32_t kStepCount = 4;
+		uint32_t colliderCount = 0;
+		uint32_t candidateCount = 0;        // 候補ペア数
+		uint32_t hitCount = 0;              // 当たったペア数
+		uint32_t requestedThreads[kStepCount] = { 1, 2, 4, 8 };
+		uint32_t usedThreads[kStepCount] = {}; // JobSystem のスレッド数で頭打ちになる
+		double ms[kStepCount] = {};
+		bool isDeterministic = true;        // 全スレッド数で結果の並びが1スレッドと一致したか
+	};
+
+	/// <summary>
+	/// 狭域判定を1・2・4・8スレッドで実行し、時間と結果の一致を調べる
+	/// </summary>
+	/// <param name="colliderCount">コライダー数</param>
+	/// <param name="stageRadius">配置範囲（ステージ半径）</param>
+	/// <param name="seed">乱数シード</param>
+	static ParallelScalingResult RunParallelScaling(uint32_t colliderCount, float stageRadius, uint32_t seed = 0u);
+
+	/// <summary>
+	/// 連続判定の検証結果（決められた軌道で動かしたときの判定）
+	/// </summary>
+	struct SweptScenarioResult {
+		const char* name = "";
+		bool discreteHit = false;   // 現フレームの位置だけで判定した結果
+		bool sweptHit = false;      // 移動を含めて判定した結果
+		bool expectedHit = false;
+		float timeOfImpact = 1.0f;
+		float expectedTimeOfImpact = 1.0f;
+		bool passed = false;        // 期待通りか
+	};
+
+	/// <summary>
+	/// すり抜けが起きる軌道で、連続判定が当たりと衝突時刻を正しく返すか確認する
+	/// </summary>
+	static std::vector<SweptScenarioResult> RunSweptScenarios();
+
+	/// <summary>
+	/// 結果の一致・性質の確認を小さい規模で実行する（SelfCheck から呼ぶ）
+	/// </summary>
+	/// <param name="check">確認1件ごとに呼ぶ関数</param>
+	static void RunChecks(const Benchmark::Check& check);
+};
+} // namespace Engine
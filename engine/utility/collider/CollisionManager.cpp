@@ -3,44 +3,106 @@
 #include "GlobalVariables.h"
 #include "Object3dCommon.h"
 #include "myMath.h"
+#include <algorithm>
+
+#ifdef _DEBUG
+#include "CollisionBenchmark.h"
+#include "imgui.h"
+#include "EditorUI.h"
+#endif // _DEBUG
 
 // 静的メンバの定義
 namespace Engine {
-std::list<Collider*>                          CollisionManager::colliders_;
-std::set<CollisionManager::ColliderPair>      CollisionManager::previousCollidingPairs_;
-std::set<CollisionManager::ColliderPair>      CollisionManager::currentCollidingPairs_;
+CollisionManager*                             CollisionManager::instance_ = nullptr;
+std::vector<Collider*>                        CollisionManager::colliders_;
+std::vector<CollisionManager::ColliderSlot>   CollisionManager::slots_;
+std::vector<uint32_t>                         CollisionManager::freeSlots_;
+ContactTable                                  CollisionManager::contactTables_[2];
+uint32_t                                      CollisionManager::currentTableIndex_ = 0;
+Vector3                                       CollisionManager::worldCenter_ = { 0.0f, 0.0f, 0.0f };
+float                                         CollisionManager::worldRadius_ = 40.0f;
+bool                                          CollisionManager::isWorldBoundsDirty_ = true;
+std::array<uint32_t, CollisionManager::kMaxLayers>    CollisionManager::layerMasks_ = [] {
+	// 初期状態は全レイヤーが当たる
+	std::array<uint32_t, CollisionManager::kMaxLayers> masks;
+	masks.fill(~0u);
+	return masks;
+	}();
+std::array<std::string, CollisionManager::kMaxLayers> CollisionManager::layerNames_;
+bool                                          CollisionManager::isLayerVariablesDirty_ = false;
+
+namespace {
+// AABBを回転なしのOBBとして扱う
+OBB ToOBB(const AABB& aabb) {
+	OBB obb;
+	obb.center = (aabb.min + aabb.max) * 0.5f;
+	obb.orientations[0] = { 1.0f, 0.0f, 0.0f };
+	obb.orientations[1] = { 0.0f, 1.0f, 0.0f };
+	obb.orientations[2] = { 0.0f, 0.0f, 1.0f };
+	obb.size = (aabb.max - aabb.min) * 0.5f;
+	return obb;
+}
+} // namespace
+
+CollisionManager::~CollisionManager() {
+	if (instance_ == this) {
+		instance_ = nullptr;
+	}
+}
 
 void CollisionManager::Reset() {
+	for (Collider* collider : colliders_) {
+		collider->handle_ = 0u;
+	}
 	colliders_.clear();
-	previousCollidingPairs_.clear();
-	currentCollidingPairs_.clear();
+	slots_.clear();
+	freeSlots_.clear();
+	contactTables_[0].Clear();
+	contactTables_[1].Clear();
 }
 
 void CollisionManager::RemoveCollider(Collider* collider) {
-	// colliders_ から除去
-	auto it = std::find(colliders_.begin(), colliders_.end(), collider);
-	if (it != colliders_.end()) {
-		colliders_.erase(it);
-	}
-
-	// 破棄されるコライダーを含むペアを両方のセットから除去
-	// → ダングリングポインタによるアクセス違反を防ぐ
-	auto removePairsContaining = [&](std::set<ColliderPair>& pairs) {
-		for (auto it = pairs.begin(); it != pairs.end(); ) {
-			if (it->first == collider || it->second == collider) {
-				it = pairs.erase(it);
-			}
-			else {
-				++it;
-			}
-		}
-		};
+	if (ResolveHandle(collider->handle_) != collider) {
+		return;
+	}
 
-	removePairsContaining(previousCollidingPairs_);
-	removePairsContaining(currentCollidingPairs_);
+	// 末尾と入れ替えて colliders_ から除去
+	const uint32_t index = collider->handle_ & kHandleIndexMask;
+	ColliderSlot& slot = slots_[index];
+	Collider* last = colliders_.back();
+	colliders_[slot.denseIndex] = last;
+	slots_[last->handle_ & kHandleIndexMask].denseIndex = slot.denseIndex;
+	colliders_.pop_back();
+
+	// 世代を進めてハンドルを無効化する
+	// → 衝突ペアに残った古いハンドルは解決に失敗するので、ダングリングポインタに触れない
+	slot.collider = nullptr;
+	slot.generation = (slot.generation % kHandleGenerationMask) + 1;
+	freeSlots_.push_back(index);
+	collider->handle_ = 0u;
+}
+
+bool CollisionManager::ResolvePair(const ContactTable::Contact& contact, Collider*& colliderA, Collider*& colliderB) {
+	colliderA = ResolveHandle(contact.handleA);
+	colliderB = ResolveHandle(contact.handleB);
+	return colliderA && colliderB;
+}
+
+Collider* CollisionManager::ResolveHandle(uint32_t handle) {
+	const uint32_t index = handle & kHandleIndexMask;
+	if (handle == 0u || index >= slots_.size()) {
+		return nullptr;
+	}
+	const ColliderSlot& slot = slots_[index];
+	if (slot.generation != (handle >> kHandleIndexBits)) {
+		return nullptr;
+	}
+	return slot.collider;
 }
 
 void CollisionManager::Initialize() {
+	instance_ = this;
+
 	const char* groupName = "Collider";
 	GlobalVariables::GetInstance()->CreateGroup(groupName);
 
@@ -49,6 +111,17 @@ void CollisionManager::Initialize() {
 	globalVariables->AddItem(groupName, "sphereCollision", sphereCollision);
 	globalVariables->AddItem(groupName, "aabbCollision", aabbCollision);
 	globalVariables->AddItem(groupName, "obbCollision", obbCollision);
+	globalVariables->AddItem(groupName, "sweptCollision", sweptCollision);
+	globalVariables->AddItem(groupName, "broadPhase", broadPhaseType_);
+	globalVariables->SetIntRange(groupName, "broadPhase", 0, static_cast<int32_t>(BroadPhaseType::kCount) - 1);
+	globalVariables->AddItem(groupName, "gridCellsPerSide", gridCellsPerSide_);
+	globalVariables->SetIntRange(groupName, "gridCellsPerSide", 1, 64);
+	globalVariables->AddItem(groupName, "narrowPhase", narrowPhaseLevel_);
+	globalVariables->SetIntRange(groupName, "narrowPhase", 0, static_cast<int32_t>(NarrowPhase::SimdLevel::kAVX2));
+	globalVariables->AddItem(groupName, "narrowPhaseThreads", narrowPhaseThreads_);
+	globalVariables->SetIntRange(groupName, "narrowPhaseThreads", 0, 16);
+
+	UpdateBroadPhase();
 }
 
 void CollisionManager::UpdateWorldTransform() {
@@ -56,6 +129,8 @@ void CollisionManager::UpdateWorldTransform() {
 	for (Collider* collider : colliders_) {
 		collider->UpdateWorldTransform();
 	}
+	// 判定で使った境界はこの更新の前のもの。次の問い合わせで形状に合わせて作り直す
+	isQueryBoundsStale_ = true;
 }
 
 void CollisionManager::Draw(const ViewProjection& viewProjection) {
@@ -82,163 +157,728 @@ void CollisionManager::Update()
 {
 	CheckAllCollisions();
 	UpdateWorldTransform();
+#ifdef _DEBUG
+	DrawBenchmark();
+#endif // _DEBUG
 }
 
-bool CollisionManager::CheckCollisionBetween(Collider* colliderA, Collider* colliderB) {
-	// コリジョンが無効化されている場合はスキップ
-	if (!colliderA->IsCollisionEnabled() || !colliderB->IsCollisionEnabled()) {
-		return false;
-	}
+void CollisionManager::CheckAllCollisions() {
+	// 2枚のテーブルを入れ替えて使う（コピーは発生しない）
+	ContactTable& currentContacts = contactTables_[currentTableIndex_];
+	ContactTable& previousContacts = contactTables_[currentTableIndex_ ^ 1u];
 
-	// 球の衝突チェック
-	if (sphereCollision) {
-		Vector3 posA = colliderA->GetCenter();
-		Vector3 posB = colliderB->GetCenter();
-		float distance = (posA - posB).Length();
-		if (distance <= colliderA->GetRadius() + colliderB->GetRadius()) {
-			return true;
-		}
+	// 現フレームの衝突ペアをクリア
+	currentContacts.Clear();
+
+	// 有効なコライダーを集めてブロードフェーズで候補ペアを絞り込む
+	GatherColliders();
+
+	// 当たらないレイヤーの組み合わせはビット演算1回で除外し、判定元ごとにまとめる
+	std::erase_if(candidatePairs_, [this](const BroadPhasePair& candidate) {
+		return (collisionMasks_[candidate.a] & layerBits_[candidate.b]) == 0;
+		});
+	NarrowPhase::GroupPairs(candidatePairs_, static_cast<uint32_t>(activeColliders_.size()), narrowPhaseWorkspace_);
+
+	// 判定フェーズ：並列に判定してスレッドごとのバッファに集め、(a, b) 順に並べる
+	// （コールバックはまだ呼ばないので、コライダーの状態は読むだけ）
+	NarrowPhase::Shapes shapes;
+	shapes.sphere = sphereCollision;
+	shapes.aabb = aabbCollision;
+	shapes.obb = obbCollision;
+	const NarrowPhase::SimdLevel level = static_cast<NarrowPhase::SimdLevel>(
+		std::clamp(narrowPhaseLevel_, 0, static_cast<int32_t>(NarrowPhase::SimdLevel::kAVX2)));
+	NarrowPhase::ExtraTest sweepTest;
+	if (sweptCollision) {
+		// 現フレームで離れていても、連続判定するものは移動中に当たっていないか調べる
+		sweepTest = [this](uint32_t a, uint32_t b, float& outTime) {
+			return (continuous_[a] | continuous_[b]) && SweepBetween(activeColliders_[a], activeColliders_[b], outTime);
+			};
 	}
+	NarrowPhase::TestGroupsParallel(snapshot_, shapes, level, static_cast<uint32_t>(std::max(narrowPhaseThreads_, 0)),
+		sweepTest, narrowPhaseWorkspace_, hits_);
 
-	// AABBの衝突チェック
-	if (aabbCollision) {
-		if (IsCollision(colliderA->GetAABB(), colliderB->GetAABB())) {
-			return true;
-		}
+	// 並べた順にハンドルの組で登録する（スレッド数によらずコールバックの順序が同じになる）
+	for (const NarrowPhase::Hit& hit : hits_) {
+		ContactTable::Contact& contact = currentContacts.Insert(activeColliders_[hit.a]->handle_, activeColliders_[hit.b]->handle_);
+		contact.timeOfImpact = hit.timeOfImpact;
 	}
 
-	// OBB同士の衝突チェック
-	if (obbCollision) {
-		if (IsCollision(colliderA->GetOBB(), colliderB->GetOBB())) {
-			return true;
+	// 前後フレームのテーブルを突き合わせてコールバックを呼ぶ
+	// （コールバック中にコライダーが破棄されてもハンドルの解決に失敗するだけで安全）
+	const uint32_t currentCount = currentContacts.GetSize();
+	for (uint32_t i = 0; i < currentCount; ++i) {
+		const ContactTable::Contact& contact = currentContacts.GetContact(i);
+		ContactTable::Contact* previous = previousContacts.Find(contact.key);
+		if (previous) {
+			previous->isMatched = true;
 		}
-	}
-
-	return false;
-}
 
-void CollisionManager::CheckAllCollisions() {
-	// 現フレームの衝突ペアをクリア
-	currentCollidingPairs_.clear();
-
-	// 全ペアの衝突判定（純粋な判定のみ、コールバックはまだ呼ばない）
-	auto itrA = colliders_.begin();
-	for (; itrA != colliders_.end(); ++itrA) {
-		Collider* colliderA = *itrA;
-
-		auto itrB = std::next(itrA);
-		for (; itrB != colliders_.end(); ++itrB) {
-			Collider* colliderB = *itrB;
-
-			if (CheckCollisionBetween(colliderA, colliderB)) {
-				// ポインタの大小でペアを正規化（順序を統一し重複を防ぐ）
-				ColliderPair pair = (colliderA < colliderB)
-					? ColliderPair(colliderA, colliderB)
-					: ColliderPair(colliderB, colliderA);
-				currentCollidingPairs_.insert(pair);
-			}
+		Collider* colliderA = nullptr;
+		Collider* colliderB = nullptr;
+		if (!ResolvePair(contact, colliderA, colliderB)) {
+			continue;
 		}
-	}
+		colliderA->timeOfImpact_ = contact.timeOfImpact;
+		colliderB->timeOfImpact_ = contact.timeOfImpact;
 
-	// 現フレームで衝突しているペアのコールバックを呼ぶ
-	for (const auto& pair : currentCollidingPairs_) {
-		if (previousCollidingPairs_.find(pair) == previousCollidingPairs_.end()) {
+		if (!previous) {
 			// 前フレームになかった → 衝突開始
-			pair.first->OnCollisionEnter(pair.second);
-			pair.second->OnCollisionEnter(pair.first);
+			colliderA->OnCollisionEnter(colliderB);
+			if (!ResolvePair(contact, colliderA, colliderB)) { continue; }
+			colliderB->OnCollisionEnter(colliderA);
 		}
 		else {
 			// 前フレームでも衝突していた → 衝突継続
-			pair.first->OnCollision(pair.second);
-			pair.second->OnCollision(pair.first);
+			colliderA->OnCollision(colliderB);
+			if (!ResolvePair(contact, colliderA, colliderB)) { continue; }
+			colliderB->OnCollision(colliderA);
 		}
-		pair.first->SetHitColor();
-		pair.second->SetHitColor();
+		if (!ResolvePair(contact, colliderA, colliderB)) { continue; }
+		colliderA->SetHitColor();
+		colliderB->SetHitColor();
 	}
 
 	// 前フレームで衝突していたが、現フレームにないペア → 衝突終了
-	for (const auto& pair : previousCollidingPairs_) {
-		if (currentCollidingPairs_.find(pair) == currentCollidingPairs_.end()) {
-			pair.first->OnCollisionOut(pair.second);
-			pair.second->OnCollisionOut(pair.first);
-			pair.first->SetDefaultColor();
-			pair.second->SetDefaultColor();
+	const uint32_t previousCount = previousContacts.GetSize();
+	for (uint32_t i = 0; i < previousCount; ++i) {
+		const ContactTable::Contact& contact = previousContacts.GetContact(i);
+		if (contact.isMatched) {
+			continue;
+		}
+		Collider* colliderA = nullptr;
+		Collider* colliderB = nullptr;
+		if (!ResolvePair(contact, colliderA, colliderB)) {
+			continue;
+		}
+		colliderA->OnCollisionOut(colliderB);
+		if (!ResolvePair(contact, colliderA, colliderB)) { continue; }
+		colliderB->OnCollisionOut(colliderA);
+		if (!ResolvePair(contact, colliderA, colliderB)) { continue; }
+		colliderA->SetDefaultColor();
+		colliderB->SetDefaultColor();
+	}
+
+	// 今フレームのテーブルを次フレームの「前フレーム」にする
+	currentTableIndex_ ^= 1u;
+}
+
+void CollisionManager::GatherColliders()
+{
+	// 有効なコライダーと、その全形状を包む境界を集める
+	activeColliders_.clear();
+	activeHandles_.clear();
+	layerBits_.clear();
+	collisionMasks_.clear();
+	continuous_.clear();
+	bounds_.clear();
+	queryOnlyHandles_.clear();
+	queryOnlyBounds_.clear();
+	snapshot_.Clear();
+	for (Collider* collider : colliders_) {
+		if (!collider->IsCollisionEnabled()) {
+			continue;
 		}
+		// どのレイヤーとも当たらないコライダーはブロードフェーズに入れず、問い合わせ用にだけ残す
+		uint32_t collisionMask = layerMasks_[collider->GetTypeID()];
+		if (collisionMask == 0) {
+			queryOnlyHandles_.push_back(collider->handle_);
+			queryOnlyBounds_.push_back(collider->GetBroadPhaseBounds());
+			continue;
+		}
+		activeColliders_.push_back(collider);
+		activeHandles_.push_back(collider->handle_);
+		layerBits_.push_back(collider->GetLayerBit());
+		collisionMasks_.push_back(collisionMask);
+		continuous_.push_back(collider->IsContinuousEnabled() ? 1u : 0u);
+		bounds_.push_back(collider->GetBroadPhaseBounds());
+		snapshot_.Push(collider->GetCenter(), collider->GetRadius(), collider->GetAABB(), collider->GetOBB());
 	}
 
-	// 前フレームの状態を現フレームで更新
-	previousCollidingPairs_ = currentCollidingPairs_;
+	// ブロードフェーズで候補ペアを絞り込む
+	UpdateBroadPhase();
+	broadPhase_->ComputePairs(bounds_, candidatePairs_);
+	isQueryBoundsStale_ = false;
 }
 
 void CollisionManager::AddCollider(Collider* collider)
 {
+	// 空きスロットがあれば再利用する
+	uint32_t index;
+	if (!freeSlots_.empty()) {
+		index = freeSlots_.back();
+		freeSlots_.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(slots_.size());
+		assert(index <= kHandleIndexMask);
+		slots_.emplace_back();
+	}
+
+	ColliderSlot& slot = slots_[index];
+	slot.collider = collider;
+	slot.denseIndex = static_cast<uint32_t>(colliders_.size());
 	colliders_.push_back(collider);
+	collider->handle_ = (slot.generation << kHandleIndexBits) | index;
 }
 
-void CollisionManager::ApplyGlobalVariables() {
+void CollisionManager::SetWorldBounds(const Vector3& center, float radius)
+{
+	worldCenter_ = center;
+	worldRadius_ = radius;
+	isWorldBoundsDirty_ = true;
+}
+
+void CollisionManager::RegisterLayer(uint32_t layer, const std::string& name)
+{
+	assert(layer < kMaxLayers);
+	layerNames_[layer] = name;
+	isLayerVariablesDirty_ = true;
+}
+
+void CollisionManager::SetLayerCollision(uint32_t layerA, uint32_t layerB, bool enabled)
+{
+	assert(layerA < kMaxLayers && layerB < kMaxLayers);
+	if (enabled) {
+		layerMasks_[layerA] |= (1u << layerB);
+		layerMasks_[layerB] |= (1u << layerA);
+	}
+	else {
+		layerMasks_[layerA] &= ~(1u << layerB);
+		layerMasks_[layerB] &= ~(1u << layerA);
+	}
+}
+
+bool CollisionManager::IsLayerCollisionEnabled(uint32_t layerA, uint32_t layerB)
+{
+	assert(layerA < kMaxLayers && layerB < kMaxLayers);
+	return (layerMasks_[layerA] & (1u << layerB)) != 0;
+}
+
+void CollisionManager::ApplyLayerVariables()
+{
 	GlobalVariables* globalVariables = GlobalVariables::GetInstance();
-	const char* groupName = "Collider";
-	visible = globalVariables->GetBoolValue(groupName, "visible");
-	sphereCollision = globalVariables->GetBoolValue(groupName, "sphereCollision");
-	aabbCollision = globalVariables->GetBoolValue(groupName, "aabbCollision");
-	obbCollision = globalVariables->GetBoolValue(groupName, "obbCollision");
+	const char* groupName = "CollisionLayer";
+
+	// 登録済みレイヤーの組み合わせを調整項目に追加（現在の設定を初期値にする）
+	if (isLayerVariablesDirty_) {
+		globalVariables->CreateGroup(groupName);
+		layerPairItems_.clear();
+		for (uint32_t a = 0; a < kMaxLayers; ++a) {
+			if (layerNames_[a].empty()) {
+				continue;
+			}
+			for (uint32_t b = a; b < kMaxLayers; ++b) {
+				if (layerNames_[b].empty()) {
+					continue;
+				}
+				LayerPairItem item{ a, b, layerNames_[a] + " x " + layerNames_[b] };
+				globalVariables->AddItem(groupName, item.key, IsLayerCollisionEnabled(a, b));
+				layerPairItems_.push_back(std::move(item));
+			}
+		}
+		isLayerVariablesDirty_ = false;
+	}
+
+	for (const LayerPairItem& item : layerPairItems_) {
+		SetLayerCollision(item.layerA, item.layerB, globalVariables->GetBoolValue(groupName, item.key));
+	}
 }
 
-bool CollisionManager::IsCollision(const AABB& aabb1, const AABB& aabb2) {
-	if ((aabb1.min.x <= aabb2.max.x && aabb1.max.x >= aabb2.min.x) &&
-		(aabb1.min.y <= aabb2.max.y && aabb1.max.y >= aabb2.min.y) &&
-		(aabb1.min.z <= aabb2.max.z && aabb1.max.z >= aabb2.min.z)) {
-		return true;
-	}
-	return false;
-}
-
-bool CollisionManager::IsCollision(const OBB& obb1, const OBB& obb2) {
-	Vector3 axes[15] = {
-		obb1.orientations[0],
-		obb1.orientations[1],
-		obb1.orientations[2],
-		obb2.orientations[0],
-		obb2.orientations[1],
-		obb2.orientations[2],
-		obb1.orientations[0].Cross(obb2.orientations[0]),
-		obb1.orientations[0].Cross(obb2.orientations[1]),
-		obb1.orientations[0].Cross(obb2.orientations[2]),
-		obb1.orientations[1].Cross(obb2.orientations[0]),
-		obb1.orientations[1].Cross(obb2.orientations[1]),
-		obb1.orientations[1].Cross(obb2.orientations[2]),
-		obb1.orientations[2].Cross(obb2.orientations[0]),
-		obb1.orientations[2].Cross(obb2.orientations[1]),
-		obb1.orientations[2].Cross(obb2.orientations[2]),
+bool CollisionManager::Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, RaycastHit& outHit, uint32_t layerMask)
+{
+	const float length = direction.Length();
+	if (!instance_ || length <= NarrowPhase::kEpsilon || maxDistance < 0.0f) {
+		return false;
+	}
+	const Vector3 unitDirection = direction / length;
+	const Vector3 end = origin + unitDirection * maxDistance;
+
+	// レイ全体を包むAABBで候補を絞る
+	AABB query;
+	query.min = { std::min(origin.x, end.x), std::min(origin.y, end.y), std::min(origin.z, end.z) };
+	query.max = { std::max(origin.x, end.x), std::max(origin.y, end.y), std::max(origin.z, end.z) };
+	CollisionManager& self = *instance_;
+	if (!self.CollectQueryCandidates(query)) {
+		return false;
+	}
+
+	NarrowPhase::Shapes shapes;
+	shapes.sphere = self.sphereCollision;
+	shapes.aabb = self.aabbCollision;
+	shapes.obb = self.obbCollision;
+
+	bool isHit = false;
+	float nearest = maxDistance;
+	for (uint32_t index : self.queryCandidates_) {
+		Collider* collider = self.GetQueryCandidate(index, layerMask);
+		if (!collider) {
+			continue;
+		}
+		float distance = 0.0f;
+		if (RaycastShapes(shapes, origin, unitDirection, nearest, collider->Cubewt_.translation_, collider->radius_,
+			collider->aabb, collider->obb, distance)) {
+			isHit = true;
+			nearest = distance;
+			outHit.collider = collider;
+		}
+	}
+
+	if (isHit) {
+		outHit.distance = nearest;
+		outHit.point = origin + unitDirection * nearest;
+	}
+	return isHit;
+}
+
+uint32_t CollisionManager::SphereOverlap(const Vector3& center, float radius, Collider** outColliders, uint32_t capacity, uint32_t layerMask)
+{
+	if (!instance_) {
+		return 0;
+	}
+	AABB query;
+	query.min = center - Vector3(radius, radius, radius);
+	query.max = center + Vector3(radius, radius, radius);
+	CollisionManager& self = *instance_;
+	if (!self.CollectQueryCandidates(query)) {
+		return 0;
+	}
+
+	uint32_t count = 0;
+	for (uint32_t index : self.queryCandidates_) {
+		if (count >= capacity) {
+			break;
+		}
+		Collider* collider = self.GetQueryCandidate(index, layerMask);
+		if (!collider) {
+			continue;
+		}
+		bool isHit = false;
+		if (self.sphereCollision) {
+			const Vector3 offset = collider->Cubewt_.translation_ - center;
+			const float radiusSum = collider->radius_ + radius;
+			isHit = offset.Dot(offset) <= radiusSum * radiusSum;
+		}
+		if (!isHit && self.aabbCollision) {
+			isHit = NarrowPhase::SphereAABB(center, radius, collider->aabb);
+		}
+		if (!isHit && self.obbCollision) {
+			isHit = NarrowPhase::SphereOBB(center, radius, collider->obb);
+		}
+		if (isHit) {
+			outColliders[count++] = collider;
+		}
+	}
+	return count;
+}
+
+uint32_t CollisionManager::BoxOverlap(const OBB& box, Collider** outColliders, uint32_t capacity, uint32_t layerMask)
+{
+	if (!instance_) {
+		return 0;
+	}
+	// 箱を包むAABB
+	const Vector3 extent = {
+		std::abs(box.orientations[0].x) * box.size.x + std::abs(box.orientations[1].x) * box.size.y + std::abs(box.orientations[2].x) * box.size.z,
+		std::abs(box.orientations[0].y) * box.size.x + std::abs(box.orientations[1].y) * box.size.y + std::abs(box.orientations[2].y) * box.size.z,
+		std::abs(box.orientations[0].z) * box.size.x + std::abs(box.orientations[1].z) * box.size.y + std::abs(box.orientations[2].z) * box.size.z,
 	};
+	AABB query;
+	query.min = box.center - extent;
+	query.max = box.center + extent;
+	CollisionManager& self = *instance_;
+	if (!self.CollectQueryCandidates(query)) {
+		return 0;
+	}
 
-	for (const Vector3& axis : axes) {
-		if (axis.Length() > 0.0001f && !testAxis(axis.Normalize(), obb1, obb2)) {
-			return false;
+	uint32_t count = 0;
+	for (uint32_t index : self.queryCandidates_) {
+		if (count >= capacity) {
+			break;
+		}
+		Collider* collider = self.GetQueryCandidate(index, layerMask);
+		if (!collider) {
+			continue;
+		}
+		bool isHit = false;
+		if (self.sphereCollision) {
+			isHit = NarrowPhase::SphereOBB(collider->Cubewt_.translation_, collider->radius_, box);
+		}
+		if (!isHit && self.aabbCollision) {
+			isHit = NarrowPhase::TestOBB(box, ToOBB(collider->aabb));
+		}
+		if (!isHit && self.obbCollision) {
+			isHit = NarrowPhase::TestOBB(box, collider->obb);
+		}
+		if (isHit) {
+			outColliders[count++] = collider;
 		}
 	}
+	return count;
+}
 
+bool CollisionManager::CollectQueryCandidates(const AABB& query)
+{
+	if (!broadPhase_ || bounds_.size() != activeHandles_.size()) {
+		queryCandidates_.clear();
+		return false;
+	}
+	if (isQueryBoundsStale_) {
+		RefreshQueryBounds();
+	}
+	CollectQueryCandidates(*broadPhase_, bounds_, queryOnlyBounds_, query, queryCandidates_);
 	return true;
 }
 
-void CollisionManager::projectOBB(const OBB& obb, const Vector3& axis, float& min, float& max) {
-	float centerProjection = obb.center.Dot(axis);
-	float radius = std::abs(obb.orientations[0].Dot(axis)) * obb.size.x +
-		std::abs(obb.orientations[1].Dot(axis)) * obb.size.y +
-		std::abs(obb.orientations[2].Dot(axis)) * obb.size.z;
+void CollisionManager::CollectQueryCandidates(const IBroadPhase& broadPhase, const std::vector<AABB>& bounds,
+	const std::vector<AABB>& queryOnlyBounds, const AABB& query, std::vector<uint32_t>& outCandidates)
+{
+	broadPhase.QueryAABB(bounds, query, outCandidates);
+
+	// ブロードフェーズに入れていないもの（地面など）は数が少ないので総当たりで足す
+	const uint32_t offset = static_cast<uint32_t>(bounds.size());
+	for (uint32_t i = 0; i < queryOnlyBounds.size(); ++i) {
+		if (OverlapsAABB(queryOnlyBounds[i], query)) {
+			outCandidates.push_back(offset + i);
+		}
+	}
+}
+
+void CollisionManager::RefreshQueryBounds()
+{
+	// 集めた時点から破棄されたものは境界をそのまま残す（GetQueryCandidate で除かれる）
+	for (uint32_t i = 0; i < activeHandles_.size(); ++i) {
+		if (const Collider* collider = ResolveHandle(activeHandles_[i])) {
+			bounds_[i] = collider->GetBroadPhaseBounds();
+		}
+	}
+	for (uint32_t i = 0; i < queryOnlyHandles_.size(); ++i) {
+		if (const Collider* collider = ResolveHandle(queryOnlyHandles_[i])) {
+			queryOnlyBounds_[i] = collider->GetBroadPhaseBounds();
+		}
+	}
+	broadPhase_->Rebuild(bounds_);
+	isQueryBoundsStale_ = false;
+}
+
+bool CollisionManager::RaycastShapes(const NarrowPhase::Shapes& shapes, const Vector3& origin, const Vector3& unitDirection, float maxDistance,
+	const Vector3& center, float radius, const AABB& aabb, const OBB& obb, float& outDistance)
+{
+	// 当たるたびに最大距離を縮め、有効な形状のうち最も近い当たりを残す
+	bool isHit = false;
+	float nearest = maxDistance;
+	float distance = 0.0f;
+	if (shapes.sphere && NarrowPhase::RaySphere(origin, unitDirection, nearest, center, radius, distance)) {
+		isHit = true;
+		nearest = distance;
+	}
+	if (shapes.aabb && NarrowPhase::RayAABB(origin, unitDirection, nearest, aabb, distance)) {
+		isHit = true;
+		nearest = distance;
+	}
+	if (shapes.obb && NarrowPhase::RayOBB(origin, unitDirection, nearest, obb, distance)) {
+		isHit = true;
+		nearest = distance;
+	}
+	if (isHit) {
+		outDistance = nearest;
+	}
+	return isHit;
+}
+
+Collider* CollisionManager::GetQueryCandidate(uint32_t index, uint32_t layerMask) const
+{
+	const uint32_t activeCount = static_cast<uint32_t>(activeHandles_.size());
+	const uint32_t handle = index < activeCount ? activeHandles_[index] : queryOnlyHandles_[index - activeCount];
+	Collider* collider = ResolveHandle(handle);
+	if (!collider || !collider->IsCollisionEnabled() || (collider->GetLayerBit() & layerMask) == 0) {
+		return nullptr;
+	}
+	return collider;
+}
+
+bool CollisionManager::SweepBetween(const Collider* colliderA, const Collider* colliderB, float& outTime) const
+{
+	bool isHit = false;
+	outTime = 1.0f;
+
+	// 球（前フレームと現フレームの中心を結ぶ線分上を動いたとみなす）
+	float time = 1.0f;
+	if (sphereCollision &&
+		NarrowPhase::SweepSphere(colliderA->GetPreviousCenter(), colliderA->Cubewt_.translation_, colliderA->radius_,
+			colliderB->GetPreviousCenter(), colliderB->Cubewt_.translation_, colliderB->radius_, time)) {
+		isHit = true;
+		outTime = std::min(outTime, time);
+	}
+
+	// AABB（前フレームのAABBを中心の移動量だけ動かす）
+	if (aabbCollision) {
+		const AABB& startA = colliderA->GetPreviousAABB();
+		const AABB& startB = colliderB->GetPreviousAABB();
+		const Vector3 moveA = (colliderA->aabb.min + colliderA->aabb.max - startA.min - startA.max) * 0.5f;
+		const Vector3 moveB = (colliderB->aabb.min + colliderB->aabb.max - startB.min - startB.max) * 0.5f;
+		if (NarrowPhase::SweepAABB(startA, moveA, startB, moveB, time)) {
+			isHit = true;
+			outTime = std::min(outTime, time);
+		}
+	}
+
+	return isHit;
+}
+
+void CollisionManager::UpdateBroadPhase()
+{
+	BroadPhaseType type = static_cast<BroadPhaseType>(broadPhaseType_);
+	if (broadPhaseType_ < 0 || type >= BroadPhaseType::kCount) {
+		type = BroadPhaseType::kUniformGrid;
+	}
+
+	// 種類が変わったら作り直す
+	if (!broadPhase_ || type != currentBroadPhaseType_) {
+		switch (type) {
+		case BroadPhaseType::kBruteForce:
+			broadPhase_ = std::make_unique<BruteForceBroadPhase>();
+			break;
+		case BroadPhaseType::kSweepAndPrune:
+			broadPhase_ = std::make_unique<SweepAndPruneBroadPhase>();
+			break;
+		default:
+			broadPhase_ = std::make_unique<UniformGridBroadPhase>();
+			break;
+		}
+		currentBroadPhaseType_ = type;
+		isWorldBoundsDirty_ = true;
+	}
+
+	// グリッドの範囲・分割数の反映
+	if (type == BroadPhaseType::kUniformGrid &&
+		(isWorldBoundsDirty_ || gridCellsPerSide_ != currentGridCellsPerSide_)) {
+		auto* grid = static_cast<UniformGridBroadPhase*>(broadPhase_.get());
+		grid->SetWorldBounds(worldCenter_, worldRadius_ * kGridMargin, static_cast<uint32_t>(std::max(gridCellsPerSide_, 1)));
+		currentGridCellsPerSide_ = gridCellsPerSide_;
+		isWorldBoundsDirty_ = false;
+	}
+}
+
+#ifdef _DEBUG
+void CollisionManager::DrawBenchmark()
+{
+	if (!EditorUI::GetInstance()->PanelVisible("コリジョン計測", "デバッグ")) { return; }
+	ImGui::Begin("コリジョン計測");
+
+	ImGui::Text("Colliders: %d  Candidates: %d", static_cast<int>(activeColliders_.size()), static_cast<int>(candidatePairs_.size()));
+	ImGui::Text("BroadPhase: %s", broadPhase_ ? broadPhase_->GetTypeName() : "-");
+	ImGui::Separator();
+
+	// 100〜10000個で総当たりと比較する
+	static std::vector<CollisionBenchmark::BroadPhaseResult> results;
+	if (ImGui::Button("Run BroadPhase Benchmark")) {
+		results.clear();
+		for (uint32_t count : { 100u, 500u, 1000u, 5000u, 10000u }) {
+			results.push_back(CollisionBenchmark::RunBroadPhase(count, worldRadius_));
+		}
+	}
+
+	if (!results.empty() && ImGui::BeginTable("BroadPhaseResults", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Count");
+		ImGui::TableSetupColumn("Brute(ms)");
+		ImGui::TableSetupColumn("SAP(ms)");
+		ImGui::TableSetupColumn("Grid(ms)");
+		ImGui::TableHeadersRow();
+		for (const CollisionBenchmark::BroadPhaseResult& result : results) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0); ImGui::Text("%u", result.colliderCount);
+			ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f (%u)", result.bruteForceMs, result.bruteForceHits);
+			ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f (%u)", result.sweepAndPruneMs, result.sweepAndPruneHits);
+			ImGui::TableSetColumnIndex(3); ImGui::Text("%.3f (%u)", result.uniformGridMs, result.uniformGridHits);
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::Separator();
+
+	// OBB同士の判定をSIMDとスカラーで比較する
+	static std::vector<CollisionBenchmark::NarrowPhaseResult> narrowResults;
+	if (ImGui::Button("Run NarrowPhase Benchmark")) {
+		narrowResults.clear();
+		for (uint32_t count : { 100u, 500u, 1000u }) {
+			narrowResults.push_back(CollisionBenchmark::RunNarrowPhase(count));
+		}
+	}
+
+	if (!narrowResults.empty() && ImGui::BeginTable("NarrowPhaseResults", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Tests");
+		ImGui::TableSetupColumn("Legacy(ms)");
+		ImGui::TableSetupColumn("Scalar(ms)");
+		ImGui::TableSetupColumn("SSE(ms)");
+		ImGui::TableSetupColumn("AVX2(ms)");
+		ImGui::TableSetupColumn("Mismatch");
+		ImGui::TableSetupColumn("Legacy miss/extra(?)");
+		ImGui::TableHeadersRow();
+		for (const CollisionBenchmark::NarrowPhaseResult& result : narrowResults) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0); ImGui::Text("%u", result.testCount);
+			ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f (%u)", result.legacyMs, result.legacyHits);
+			for (int32_t level = 0; level < 3; ++level) {
+				ImGui::TableSetColumnIndex(level + 2);
+				if (level <= static_cast<int32_t>(result.supportedLevel)) {
+					ImGui::Text("%.3f (%u)", result.ms[level], result.hits[level]);
+				}
+				else {
+					ImGui::TextUnformatted("-");
+				}
+			}
+			ImGui::TableSetColumnIndex(5); ImGui::Text("%u", result.mismatchCount);
+			ImGui::TableSetColumnIndex(6);
+			ImGui::Text("%u / %u (%u)", result.legacyMissCount, result.legacyExtraCount, result.legacyUnexplainedCount);
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::Separator();
+
+	// 並列判定のスケーリング（1・2・4・8スレッド）
+	static std::vector<CollisionBenchmark::ParallelScalingResult> scalingResults;
+	if (ImGui::Button("Run Parallel Scaling Benchmark")) {
+		scalingResults.clear();
+		for (uint32_t count : { 1000u, 5000u, 10000u }) {
+			scalingResults.push_back(CollisionBenchmark::RunParallelScaling(count, worldRadius_));
+		}
+	}
+
+	if (!scalingResults.empty() &&
+		ImGui::BeginTable("ParallelScalingResults", 2 + CollisionBenchmark::ParallelScalingResult::kStepCount, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Count");
+		for (uint32_t step = 0; step < CollisionBenchmark::ParallelScalingResult::kStepCount; ++step) {
+			static const char* kHeaders[] = { "1T(ms)", "2T(ms)", "4T(ms)", "8T(ms)" };
+			ImGui::TableSetupColumn(kHeaders[step]);
+		}
+		ImGui::TableSetupColumn("Same order");
+		ImGui::TableHeadersRow();
+		for (const CollisionBenchmark::ParallelScalingResult& result : scalingResults) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0); ImGui::Text("%u (%u hits)", result.colliderCount, result.hitCount);
+			for (uint32_t step = 0; step < CollisionBenchmark::ParallelScalingResult::kStepCount; ++step) {
+				ImGui::TableSetColumnIndex(static_cast<int>(step) + 1);
+				ImGui::Text("%.3f [%u]", result.ms[step], result.usedThreads[step]);
+			}
+			ImGui::TableSetColumnIndex(1 + CollisionBenchmark::ParallelScalingResult::kStepCount);
+			ImGui::TextUnformatted(result.isDeterministic ? "OK" : "NG");
+		}
+		ImGui::EndTable();
+	}
 
-	min = centerProjection - radius;
-	max = centerProjection + radius;
+	ImGui::Separator();
+
+	// 連続判定の検証（すり抜ける軌道）
+	static std::vector<CollisionBenchmark::SweptScenarioResult> sweptResults;
+	if (ImGui::Button("Run Swept Scenarios")) {
+		sweptResults = CollisionBenchmark::RunSweptScenarios();
+	}
+	for (const CollisionBenchmark::SweptScenarioResult& result : sweptResults) {
+		ImGui::Text("[%s] %s  discrete:%d swept:%d toi:%.4f (expected %.4f)", result.passed ? "OK" : "NG", result.name,
+			result.discreteHit, result.sweptHit, result.timeOfImpact, result.expectedHit ? result.expectedTimeOfImpact : 1.0f);
+	}
+
+	// 問い合わせの検証（問い合わせ専用の境界・形状が動いた後の境界）
+	static std::vector<QueryCheckResult> queryResults;
+	if (ImGui::Button("Run Query Checks")) {
+		queryResults = RunQueryChecks();
+	}
+	for (const QueryCheckResult& result : queryResults) {
+		ImGui::Text("[%s] %s (%s)  distance:%.3f hits:%u", result.passed ? "OK" : "NG", result.name, result.broadPhase, result.distance, result.hitCount);
+	}
+
+	ImGui::End();
 }
 
-bool CollisionManager::testAxis(const Vector3& axis, const OBB& obb1, const OBB& obb2) {
-	float min1, max1, min2, max2;
-	projectOBB(obb1, axis, min1, max1);
-	projectOBB(obb2, axis, min2, max2);
+std::vector<CollisionManager::QueryCheckResult> CollisionManager::RunQueryChecks() const
+{
+	// ステージから離れた位置に 2x2x2 の箱（球・AABB・OBB とも中心から1）を置く
+	const Vector3 kProbePosition = { 0.0f, -1000.0f, 0.0f };
+	const Vector3 kHalf = { 1.0f, 1.0f, 1.0f };
+	auto makeBounds = [&](const Vector3& center) {
+		AABB bounds;
+		bounds.min = center - kHalf;
+		bounds.max = center + kHalf;
+		return bounds;
+		};
+	OBB probeBox;
+	probeBox.center = kProbePosition;
+	probeBox.orientations[0] = { 1.0f, 0.0f, 0.0f };
+	probeBox.orientations[1] = { 0.0f, 1.0f, 0.0f };
+	probeBox.orientations[2] = { 0.0f, 0.0f, 1.0f };
+	probeBox.size = kHalf;
+
+	UniformGridBroadPhase grid;
+	grid.SetWorldBounds(worldCenter_, worldRadius_ * kGridMargin, static_cast<uint32_t>(std::max(gridCellsPerSide_, 1)));
+	BruteForceBroadPhase bruteForce;
+	SweepAndPruneBroadPhase sweepAndPrune;
+	IBroadPhase* broadPhases[] = { &bruteForce, &sweepAndPrune, &grid };
+
+	std::vector<QueryCheckResult> results;
+	std::vector<BroadPhasePair> pairs;
+	std::vector<uint32_t> candidates;
+	for (IBroadPhase* broadPhase : broadPhases) {
+		// 判定用に3つ（X方向に並べる）、どのレイヤーとも当たらない問い合わせ専用に1つ
+		std::vector<AABB> bounds = {
+			makeBounds(kProbePosition + Vector3(20.0f, 0.0f, 0.0f)),
+			makeBounds(kProbePosition + Vector3(40.0f, 0.0f, 0.0f)),
+			makeBounds(kProbePosition + Vector3(60.0f, 0.0f, 0.0f)),
+		};
+		const std::vector<AABB> queryOnlyBounds = { makeBounds(kProbePosition) };
+		broadPhase->ComputePairs(bounds, pairs);
+
+		// 真下へのレイは問い合わせ専用の箱の上面（始点から9）で当たる
+		const Vector3 rayOrigin = kProbePosition + Vector3(0.0f, 10.0f, 0.0f);
+		const Vector3 rayDirection = { 0.0f, -1.0f, 0.0f };
+		AABB rayQuery;
+		rayQuery.min = rayOrigin + rayDirection * 20.0f;
+		rayQuery.max = rayOrigin;
+		CollectQueryCandidates(*broadPhase, bounds, queryOnlyBounds, rayQuery, candidates);
+		QueryCheckResult& ray = results.emplace_back();
+		ray.name = "Ray down onto query-only box";
+		ray.broadPhase = broadPhase->GetTypeName();
+		ray.hitCount = static_cast<uint32_t>(candidates.size());
+		const bool isCandidate = candidates.size() == 1 && candidates[0] == bounds.size();
+		float distance = 0.0f;
+		if (isCandidate && RaycastShapes(NarrowPhase::Shapes{}, rayOrigin, rayDirection, 20.0f,
+			kProbePosition, 1.0f, queryOnlyBounds[0], probeBox, distance)) {
+			ray.distance = distance;
+			ray.passed = std::abs(distance - 9.0f) <= 1.0e-3f;
+		}
+
+		// 判定の後に形状が動いた分を Rebuild で反映すると、移動先でだけ見つかる
+		// （X順の並びが入れ替わるので、並びやセルを作り直さなければ見落とす）
+		const Vector3 movedPosition = kProbePosition + Vector3(-20.0f, 0.0f, 0.0f);
+		bounds[2] = makeBounds(movedPosition);
+		broadPhase->Rebuild(bounds);
+		QueryCheckResult& moved = results.emplace_back();
+		moved.name = "Query follows rebuilt bounds";
+		moved.broadPhase = broadPhase->GetTypeName();
+		CollectQueryCandidates(*broadPhase, bounds, queryOnlyBounds, makeBounds(movedPosition), candidates);
+		moved.hitCount = static_cast<uint32_t>(candidates.size());
+		const bool isFoundAtNew = candidates.size() == 1 && candidates[0] == 2;
+		CollectQueryCandidates(*broadPhase, bounds, queryOnlyBounds, makeBounds(kProbePosition + Vector3(60.0f, 0.0f, 0.0f)), candidates);
+		moved.passed = isFoundAtNew && candidates.empty();
+	}
+	return results;
+}
+#endif // _DEBUG
 
-	float sumSpan = (max1 - min1) + (max2 - min2);
-	float longSpan = std::max(max1, max2) - std::min(min1, min2);
+void CollisionManager::ApplyGlobalVariables() {
+	GlobalVariables* globalVariables = GlobalVariables::GetInstance();
+	const char* groupName = "Collider";
+	visible = globalVariables->GetBoolValue(groupName, "visible");
+	sphereCollision = globalVariables->GetBoolValue(groupName, "sphereCollision");
+	aabbCollision = globalVariables->GetBoolValue(groupName, "aabbCollision");
+	obbCollision = globalVariables->GetBoolValue(groupName, "obbCollision");
+	sweptCollision = globalVariables->GetBoolValue(groupName, "sweptCollision");
+	broadPhaseType_ = globalVariables->GetIntValue(groupName, "broadPhase");
+	gridCellsPerSide_ = globalVariables->GetIntValue(groupName, "gridCellsPerSide");
+	narrowPhaseLevel_ = globalVariables->GetIntValue(groupName, "narrowPhase");
+	narrowPhaseThreads_ = globalVariables->GetIntValue(groupName, "narrowPhaseThreads");
 
-	return sumSpan >= longSpan;
+	ApplyLayerVariables();
 }
+
 } // namespace Engine
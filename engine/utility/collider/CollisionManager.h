@@ -1,8 +1,13 @@
 #pragma once
 #include "Collider.h"
+#include "BroadPhase.h"
+#include "ContactTable.h"
+#include "NarrowPhase.h"
 #include "SceneManager.h"
-#include "list"
-#include "set"
+#include "array"
+#include "memory"
+#include "string"
+#include "vector"
 #include "Object3d.h"
 
 /// <summary>
@@ -10,31 +15,117 @@
 /// </summary>
 namespace Engine {
 class CollisionManager {
+public:
+	// レイヤー数（識別IDの上限）
+	static constexpr uint32_t kMaxLayers = 32;
+
+	/// <summary>
+	/// レイキャストの結果
+	/// </summary>
+	struct RaycastHit {
+		Collider* collider = nullptr;
+		float distance = 0.0f; // 始点からの距離
+		Vector3 point;         // 当たった位置
+	};
+
 private:
-	// コライダー
-	static std::list<Collider*> colliders_;
+	// 問い合わせ（Raycast等）に使うインスタンス
+	static CollisionManager* instance_;
+
+	// コライダー（登録順ではなく、削除時は末尾と入れ替えて詰める）
+	static std::vector<Collider*> colliders_;
 
-	// ペアごとの衝突状態管理
-	using ColliderPair = std::pair<Collider*, Collider*>;
-	static std::set<ColliderPair> previousCollidingPairs_; // 前フレームの衝突ペア
-	static std::set<ColliderPair> currentCollidingPairs_;  // 現フレームの衝突ペア
+	// ハンドルの参照先。削除されたスロットは世代を進めて古いハンドルを無効にする
+	struct ColliderSlot {
+		Collider* collider = nullptr;
+		uint32_t generation = 1;
+		uint32_t denseIndex = 0; // colliders_ 内の位置
+	};
+	static std::vector<ColliderSlot> slots_;
+	static std::vector<uint32_t> freeSlots_;
+
+	// ハンドルのビット割り当て（下位がスロット番号、上位が世代）
+	static constexpr uint32_t kHandleIndexBits = 20;
+	static constexpr uint32_t kHandleIndexMask = (1u << kHandleIndexBits) - 1;
+	static constexpr uint32_t kHandleGenerationMask = (1u << (32 - kHandleIndexBits)) - 1;
+
+	// ペアごとの衝突状態管理（2枚を毎フレーム入れ替えて使う）
+	static ContactTable contactTables_[2];
+	static uint32_t currentTableIndex_;
+
+	// レイヤーごとの「当たる相手」ビットマスク（layerMasks_[i] の jビット目 = iとjが当たる）
+	static std::array<uint32_t, kMaxLayers> layerMasks_;
+	static std::array<std::string, kMaxLayers> layerNames_;
+	static bool isLayerVariablesDirty_;
+
+	// 調整項目に出しているレイヤーの組み合わせ
+	struct LayerPairItem {
+		uint32_t layerA;
+		uint32_t layerB;
+		std::string key;
+	};
+	std::vector<LayerPairItem> layerPairItems_;
+
+	// ブロードフェーズの範囲（ステージ中心・半径）
+	static Vector3 worldCenter_;
+	static float worldRadius_;
+	static bool isWorldBoundsDirty_;
 
 	bool visible = true;
 	bool sphereCollision = true;
 	bool aabbCollision = true;
 	bool obbCollision = true;
+	bool sweptCollision = true; // 連続判定を有効にしたコライダーのすり抜け防止
+
+	// ブロードフェーズ
+	int32_t broadPhaseType_ = static_cast<int32_t>(BroadPhaseType::kUniformGrid);
+	int32_t gridCellsPerSide_ = 16;
+	std::unique_ptr<IBroadPhase> broadPhase_;
+	BroadPhaseType currentBroadPhaseType_ = BroadPhaseType::kCount;
+	int32_t currentGridCellsPerSide_ = 0;
+
+	// 毎フレーム使い回す作業領域
+	std::vector<Collider*> activeColliders_;
+	std::vector<uint32_t> activeHandles_;  // 問い合わせ用（判定後に破棄されたものを除くため）
+	std::vector<uint32_t> layerBits_;      // 自分のレイヤービット
+	std::vector<uint32_t> collisionMasks_; // 当たる相手のレイヤーマスク
+	std::vector<uint8_t> continuous_;      // 連続判定するか
+	std::vector<AABB> bounds_;
+	std::vector<BroadPhasePair> candidatePairs_;
+	ColliderSnapshot snapshot_;            // 狭域判定用の形状（SoA）
+	NarrowPhase::Workspace narrowPhaseWorkspace_;
+	std::vector<NarrowPhase::Hit> hits_;   // 当たったペア（a, b 順）
+	std::vector<uint32_t> queryCandidates_; // 問い合わせの候補（queryOnly の分は bounds_ の要素数だけずらした番号）
+	std::vector<uint32_t> queryOnlyHandles_; // どのレイヤーとも当たらないが問い合わせには含めるコライダー
+	std::vector<AABB> queryOnlyBounds_;
+	bool isQueryBoundsStale_ = false; // 判定の後に形状を更新したので、問い合わせ用の境界が古い
+
+	// 狭域判定の命令セット（CPUが対応していなければ下位に落とす）
+	int32_t narrowPhaseLevel_ = static_cast<int32_t>(NarrowPhase::SimdLevel::kAVX2);
+	// 狭域判定に使うスレッド数（0なら JobSystem の全スレッド）
+	int32_t narrowPhaseThreads_ = 0;
+
+	// グリッドの範囲をステージ半径よりどれだけ広げるか
+	static constexpr float kGridMargin = 1.25f;
 
 public:
+	~CollisionManager();
+
 	/// <summary>
 	/// リセット
 	/// </summary>
 	static void Reset();
 
 	/// <summary>
-	/// コライダーの削除（破棄時にペアセットも掃除）
+	/// コライダーの削除（ハンドルを無効化するので、衝突ペアの掃除は不要）
 	/// </summary>
 	static void RemoveCollider(Collider* collider);
 
+	/// <summary>
+	/// ハンドルからコライダーを取得（削除済みならnullptr）
+	/// </summary>
+	static Collider* ResolveHandle(uint32_t handle);
+
 	/// <summary>
 	/// 初期化
 	/// </summary>
@@ -63,19 +154,112 @@ public:
 	/// </summary>
 	static void AddCollider(Collider* collider);
 
+	/// <summary>
+	/// ブロードフェーズの範囲設定（StageManagerの中心・半径を渡す）
+	/// </summary>
+	/// <param name="center">ステージ中心</param>
+	/// <param name="radius">ステージ半径</param>
+	static void SetWorldBounds(const Vector3& center, float radius);
+
+	/// <summary>
+	/// レイヤー名の登録（GlobalVariablesの "CollisionLayer" に組み合わせが並ぶ）
+	/// </summary>
+	/// <param name="layer">レイヤー番号（コライダーの識別ID）</param>
+	/// <param name="name">表示名</param>
+	static void RegisterLayer(uint32_t layer, const std::string& name);
+
+	/// <summary>
+	/// 2つのレイヤーが当たるかの設定（対称に反映される）
+	/// </summary>
+	static void SetLayerCollision(uint32_t layerA, uint32_t layerB, bool enabled);
+
+	/// <summary>
+	/// 2つのレイヤーが当たるか
+	/// </summary>
+	static bool IsLayerCollisionEnabled(uint32_t layerA, uint32_t layerB);
+
+	/// <summary>
+	/// レイキャスト（最も近い当たりを返す）。
+	/// 問い合わせは直前の当たり判定で作ったブロードフェーズを使い、メモリ確保はしない
+	/// </summary>
+	/// <param name="origin">始点</param>
+	/// <param name="direction">向き（正規化しなくてよい）</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="outHit">結果</param>
+	/// <param name="layerMask">対象レイヤーのビットマスク</param>
+	/// <returns>当たったか</returns>
+	static bool Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, RaycastHit& outHit, uint32_t layerMask = ~0u);
+
+	/// <summary>
+	/// 球と重なるコライダーの取得
+	/// </summary>
+	/// <param name="center">中心</param>
+	/// <param name="radius">半径</param>
+	/// <param name="outColliders">結果の書き込み先</param>
+	/// <param name="capacity">書き込み先の要素数（超えた分は捨てる）</param>
+	/// <param name="layerMask">対象レイヤーのビットマスク</param>
+	/// <returns>書き込んだ数</returns>
+	static uint32_t SphereOverlap(const Vector3& center, float radius, Collider** outColliders, uint32_t capacity, uint32_t layerMask = ~0u);
+
+	/// <summary>
+	/// 箱と重なるコライダーの取得
+	/// </summary>
+	/// <param name="box">箱（回転なしなら orientations を単位軸にする）</param>
+	/// <param name="outColliders">結果の書き込み先</param>
+	/// <param name="capacity">書き込み先の要素数（超えた分は捨てる）</param>
+	/// <param name="layerMask">対象レイヤーのビットマスク</param>
+	/// <returns>書き込んだ数</returns>
+	static uint32_t BoxOverlap(const OBB& box, Collider** outColliders, uint32_t capacity, uint32_t layerMask = ~0u);
+
 private:
+	// 衝突ペアの両方のコライダーを取得（どちらかが削除済みならfalse）
+	static bool ResolvePair(const ContactTable::Contact& contact, Collider*& colliderA, Collider*& colliderB);
+
 	// 調整項目の適用
 	void ApplyGlobalVariables();
 
-	// 2つのコライダー間の純粋な衝突判定
-	bool CheckCollisionBetween(Collider* colliderA, Collider* colliderB);
+	// 当たり判定マトリクスの調整項目の適用
+	void ApplyLayerVariables();
+
+	// 有効なコライダーを判定用・問い合わせ用の配列に集め、ブロードフェーズを更新する
+	void GatherColliders();
 
-	bool IsCollision(const AABB& aabb1, const AABB& aabb2);
-	bool IsCollision(const OBB& obb1, const OBB& obb2);
+	// 問い合わせ範囲と重なる候補を queryCandidates_ に集める（使えなければfalse）
+	bool CollectQueryCandidates(const AABB& query);
+	// 判定用の境界と問い合わせ専用の境界から候補を集める（queryOnly の分は bounds の要素数だけずらした番号）
+	static void CollectQueryCandidates(const IBroadPhase& broadPhase, const std::vector<AABB>& bounds,
+		const std::vector<AABB>& queryOnlyBounds, const AABB& query, std::vector<uint32_t>& outCandidates);
+	// 問い合わせ用の境界を現在の形状から作り直す（判定の後に UpdateWorldTransform で形状が動いた分）
+	void RefreshQueryBounds();
+	// 有効な形状のうち最も近いレイの当たり
+	static bool RaycastShapes(const NarrowPhase::Shapes& shapes, const Vector3& origin, const Vector3& unitDirection, float maxDistance,
+		const Vector3& center, float radius, const AABB& aabb, const OBB& obb, float& outDistance);
+	// 候補のコライダーを取得（破棄・無効化済み、対象外のレイヤーならnullptr）
+	Collider* GetQueryCandidate(uint32_t index, uint32_t layerMask) const;
+
+	// 前フレームからの移動を含めた判定（当たれば衝突時刻を返す）
+	bool SweepBetween(const Collider* colliderA, const Collider* colliderB, float& outTime) const;
+
+	// 設定に合わせてブロードフェーズを作り直す
+	void UpdateBroadPhase();
+
+#ifdef _DEBUG
+	// ブロードフェーズ計測パネル
+	void DrawBenchmark();
+
+	/// <summary>
+	/// 問い合わせの検証結果
+	/// </summary>
+	struct QueryCheckResult {
+		const char* name = "";
+		const char* broadPhase = "";
+		bool passed = false;
+		float distance = 0.0f; // レイの当たった距離（当たらなければ0）
+		uint32_t hitCount = 0; // 重なったコライダー数
+	};
 
-	// 軸に対するOBBの投影範囲を計算する関数
-	void projectOBB(const OBB& obb, const Vector3& axis, float& min, float& max);
-	// 軸に投影するための関数
-	bool testAxis(const Vector3& axis, const OBB& obb1, const OBB& obb2);
+	// マネージャーの外で、形状と境界だけを使って問い合わせの手順を確かめる（ブロードフェーズの種類ごと）
+	std::vector<QueryCheckResult> RunQueryChecks() const;
+#endif // _DEBUG
 };
 } // namespace Engine
@@ -0,0 +1,21 @@
+#pragma once
+#include"Vector3.h"
+
+namespace Engine {
+/// <summary>
+/// AABB
+/// </summary>
+struct AABB {
+	Vector3 min; //!< 最小点
+	Vector3 max; //!< 最大点
+};
+
+/// <summary>
+/// OBB
+/// </summary>
+struct OBB {
+	Vector3 center;          //!< 中心点
+	Vector3 orientations[3]; //!< 座標軸。正規化・直行必須
+	Vector3 size;            //!< 座標軸方向の長さの半分。中心から面までの距離
+};
+} // namespace Engine
@@ -0,0 +1,93 @@
+#include "ContactTable.h"
+#include <cassert>
+#include <utility>
+
+namespace Engine {
+uint64_t ContactTable::MakeKey(uint32_t handleA, uint32_t handleB) {
+	if (handleA > handleB) {
+		std::swap(handleA, handleB);
+	}
+	return (static_cast<uint64_t>(handleA) << 32) | handleB;
+}
+
+void ContactTable::Clear() {
+	for (uint32_t slot : used_) {
+		slots_[slot].key = 0;
+	}
+	used_.clear();
+}
+
+ContactTable::Contact& ContactTable::Insert(uint32_t handleA, uint32_t handleB) {
+	assert(handleA != 0 && handleB != 0);
+
+	// 負荷率が1/2を超えないように広げる
+	if ((used_.size() + 1) * 2 > slots_.size()) {
+		Grow();
+	}
+
+	const uint64_t key = MakeKey(handleA, handleB);
+	const uint32_t mask = static_cast<uint32_t>(slots_.size()) - 1;
+	uint32_t slot = HashSlot(key);
+	while (slots_[slot].key != 0) {
+		if (slots_[slot].key == key) {
+			return slots_[slot];
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	Contact& contact = slots_[slot];
+	contact.key = key;
+	contact.handleA = static_cast<uint32_t>(key >> 32);
+	contact.handleB = static_cast<uint32_t>(key);
+	contact.isMatched = false;
+	contact.timeOfImpact = 1.0f;
+	used_.push_back(slot);
+	return contact;
+}
+
+ContactTable::Contact* ContactTable::Find(uint64_t key) {
+	if (used_.empty()) {
+		return nullptr;
+	}
+	const uint32_t mask = static_cast<uint32_t>(slots_.size()) - 1;
+	uint32_t slot = HashSlot(key);
+	while (slots_[slot].key != 0) {
+		if (slots_[slot].key == key) {
+			return &slots_[slot];
+		}
+		slot = (slot + 1) & mask;
+	}
+	return nullptr;
+}
+
+uint32_t ContactTable::HashSlot(uint64_t key) const {
+	// splitmix64 の最終ミックス
+	key ^= key >> 30;
+	key *= 0xbf58476d1ce4e5b9ull;
+	key ^= key >> 27;
+	key *= 0x94d049bb133111ebull;
+	key ^= key >> 31;
+	return static_cast<uint32_t>(key) & (static_cast<uint32_t>(slots_.size()) - 1);
+}
+
+void ContactTable::Grow() {
+	std::vector<Contact> oldSlots = std::move(slots_);
+	std::vector<uint32_t> oldUsed = std::move(used_);
+
+	slots_.assign(oldSlots.empty() ? kInitialCapacity : oldSlots.size() * 2, Contact{});
+	used_.clear();
+	used_.reserve(slots_.size() / 2);
+
+	// 追加順を保ったまま入れ直す
+	const uint32_t mask = static_cast<uint32_t>(slots_.size()) - 1;
+	for (uint32_t oldSlot : oldUsed) {
+		const Contact& contact = oldSlots[oldSlot];
+		uint32_t slot = HashSlot(contact.key);
+		while (slots_[slot].key != 0) {
+			slot = (slot + 1) & mask;
+		}
+		slots_[slot] = contact;
+		used_.push_back(slot);
+	}
+}
+} // namespace Engine
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+/// <summary>
+/// 衝突ペアのハッシュテーブル（オープンアドレス法・線形探索）。
+/// キーは2つのコライダーハンドルの組で、確保済みの領域は使い回すため
+/// 毎フレームのクリア・挿入でメモリ確保が発生しない。
+/// </summary>
+class ContactTable {
+public:
+	/// <summary>
+	/// 衝突ペア
+	/// </summary>
+	struct Contact {
+		uint64_t key = 0;        // 0 は空きスロット
+		uint32_t handleA = 0;    // 小さい方のハンドル
+		uint32_t handleB = 0;    // 大きい方のハンドル
+		bool isMatched = false;  // 次フレームのテーブルで同じペアが見つかったか
+		float timeOfImpact = 1.0f; // 衝突時刻（0:前フレーム 〜 1:現フレーム）
+	};
+
+	/// <summary>
+	/// ハンドルの組からキーを作る（順序は正規化される）
+	/// </summary>
+	static uint64_t MakeKey(uint32_t handleA, uint32_t handleB);
+
+	/// <summary>
+	/// 全ペアの削除（使用中のスロットだけを消すのでペア数に比例）
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// ペアの追加（既にあれば既存のものを返す）
+	/// </summary>
+	Contact& Insert(uint32_t handleA, uint32_t handleB);
+
+	/// <summary>
+	/// ペアの検索（無ければnullptr）
+	/// </summary>
+	Contact* Find(uint64_t key);
+
+	/// <summary>
+	/// 登録済みペア数
+	/// </summary>
+	uint32_t GetSize() const { return static_cast<uint32_t>(used_.size()); }
+
+	/// <summary>
+	/// 追加順で index 番目のペア
+	/// </summary>
+	Contact& GetContact(uint32_t index) { return slots_[used_[index]]; }
+
+private:
+	// キーから最初に調べるスロット
+	uint32_t HashSlot(uint64_t key) const;
+	// 容量を倍にして入れ直す
+	void Grow();
+
+	static constexpr uint32_t kInitialCapacity = 64;
+
+	std::vector<Contact> slots_;  // 容量は常に2のべき乗
+	std::vector<uint32_t> used_;  // 使用中スロット番号（追加順）
+};
+} // namespace Engine
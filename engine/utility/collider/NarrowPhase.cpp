@@ -0,0 +1,487 @@
+#define NOMINMAX
+#include "NarrowPhase.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+namespace {
+using Simd::ScalarOps;
+using Simd::SseOps;
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+using Simd::Avx2Ops;
+#endif // ENGINE_SIMD_ENABLE_AVX2
+
+using Field = ColliderSnapshot::Field;
+
+///-------------------------------------------///
+/// OBB同士の分離軸判定（軸は正規化せず、Aの座標系で15軸を調べる）
+///-------------------------------------------///
+template<class Ops, class SelfFn, class LaneFn>
+typename Ops::M TestObbLanes(SelfFn self, LaneFn lane) {
+	using V = typename Ops::V;
+	using M = typename Ops::M;
+
+	V aAxis[3][3];
+	V bAxis[3][3];
+	V ea[3];
+	V eb[3];
+	for (uint32_t i = 0; i < 3; ++i) {
+		for (uint32_t k = 0; k < 3; ++k) {
+			aAxis[i][k] = self(Field::kObbAxis0X + i * 3 + k);
+			bAxis[i][k] = lane(Field::kObbAxis0X + i * 3 + k);
+		}
+		ea[i] = self(Field::kObbSizeX + i);
+		eb[i] = lane(Field::kObbSizeX + i);
+	}
+
+	auto dot = [](const V* x, const V* y) {
+		return Ops::Add(Ops::Add(Ops::Mul(x[0], y[0]), Ops::Mul(x[1], y[1])), Ops::Mul(x[2], y[2]));
+		};
+
+	// 中心間のベクトルをAの軸で表す
+	V d[3] = {
+		Ops::Sub(lane(Field::kObbCenterX), self(Field::kObbCenterX)),
+		Ops::Sub(lane(Field::kObbCenterY), self(Field::kObbCenterY)),
+		Ops::Sub(lane(Field::kObbCenterZ), self(Field::kObbCenterZ)),
+	};
+	V t[3] = { dot(d, aAxis[0]), dot(d, aAxis[1]), dot(d, aAxis[2]) };
+
+	// Bの軸をAの座標系で表した回転行列
+	const V epsilon = Ops::Set1(NarrowPhase::kEpsilon);
+	V r[3][3];
+	V absR[3][3];
+	for (uint32_t i = 0; i < 3; ++i) {
+		for (uint32_t j = 0; j < 3; ++j) {
+			r[i][j] = dot(aAxis[i], bAxis[j]);
+			absR[i][j] = Ops::Add(Ops::Abs(r[i][j]), epsilon);
+		}
+	}
+
+	M separated = Ops::False();
+
+	// Aの軸
+	for (uint32_t i = 0; i < 3; ++i) {
+		V rb = Ops::Add(Ops::Add(Ops::Mul(eb[0], absR[i][0]), Ops::Mul(eb[1], absR[i][1])), Ops::Mul(eb[2], absR[i][2]));
+		separated = Ops::Or(separated, Ops::Greater(Ops::Abs(t[i]), Ops::Add(ea[i], rb)));
+	}
+
+	// Bの軸
+	for (uint32_t j = 0; j < 3; ++j) {
+		V ra = Ops::Add(Ops::Add(Ops::Mul(ea[0], absR[0][j]), Ops::Mul(ea[1], absR[1][j])), Ops::Mul(ea[2], absR[2][j]));
+		V tt = Ops::Add(Ops::Add(Ops::Mul(t[0], r[0][j]), Ops::Mul(t[1], r[1][j])), Ops::Mul(t[2], r[2][j]));
+		separated = Ops::Or(separated, Ops::Greater(Ops::Abs(tt), Ops::Add(ra, eb[j])));
+	}
+
+	// 外積の9軸
+	for (uint32_t i = 0; i < 3; ++i) {
+		const uint32_t i1 = (i + 1) % 3;
+		const uint32_t i2 = (i + 2) % 3;
+		for (uint32_t j = 0; j < 3; ++j) {
+			const uint32_t j1 = (j + 1) % 3;
+			const uint32_t j2 = (j + 2) % 3;
+			V ra = Ops::Add(Ops::Mul(ea[i1], absR[i2][j]), Ops::Mul(ea[i2], absR[i1][j]));
+			V rb = Ops::Add(Ops::Mul(eb[j1], absR[i][j2]), Ops::Mul(eb[j2], absR[i][j1]));
+			V tt = Ops::Sub(Ops::Mul(t[i2], r[i1][j]), Ops::Mul(t[i1], r[i2][j]));
+			separated = Ops::Or(separated, Ops::Greater(Ops::Abs(tt), Ops::Add(ra, rb)));
+		}
+	}
+
+	return Ops::Not(separated);
+}
+
+///-------------------------------------------///
+/// 1対 kWidth 件の判定。戻り値は当たったレーンのビット
+///-------------------------------------------///
+template<class Ops>
+uint32_t TestLanes(const float* selfFields, const float* laneFields, const NarrowPhase::Shapes& shapes) {
+	using V = typename Ops::V;
+	using M = typename Ops::M;
+
+	auto self = [selfFields](uint32_t field) { return Ops::Set1(selfFields[field]); };
+	auto lane = [laneFields](uint32_t field) { return Ops::Load(laneFields + field * Ops::kWidth); };
+
+	M hit = Ops::False();
+
+	// 球
+	if (shapes.sphere) {
+		V dx = Ops::Sub(lane(Field::kSphereX), self(Field::kSphereX));
+		V dy = Ops::Sub(lane(Field::kSphereY), self(Field::kSphereY));
+		V dz = Ops::Sub(lane(Field::kSphereZ), self(Field::kSphereZ));
+		V distanceSq = Ops::Add(Ops::Add(Ops::Mul(dx, dx), Ops::Mul(dy, dy)), Ops::Mul(dz, dz));
+		V radius = Ops::Add(self(Field::kRadius), lane(Field::kRadius));
+		hit = Ops::Or(hit, Ops::LessEq(distanceSq, Ops::Mul(radius, radius)));
+	}
+
+	// AABB
+	if (shapes.aabb) {
+		M overlap = Ops::And(
+			Ops::And(Ops::LessEq(self(Field::kAabbMinX), lane(Field::kAabbMaxX)), Ops::LessEq(lane(Field::kAabbMinX), self(Field::kAabbMaxX))),
+			Ops::And(Ops::LessEq(self(Field::kAabbMinY), lane(Field::kAabbMaxY)), Ops::LessEq(lane(Field::kAabbMinY), self(Field::kAabbMaxY))));
+		overlap = Ops::And(overlap,
+			Ops::And(Ops::LessEq(self(Field::kAabbMinZ), lane(Field::kAabbMaxZ)), Ops::LessEq(lane(Field::kAabbMinZ), self(Field::kAabbMaxZ))));
+		hit = Ops::Or(hit, overlap);
+	}
+
+	// OBB
+	if (shapes.obb) {
+		hit = Ops::Or(hit, TestObbLanes<Ops>(self, lane));
+	}
+
+	return Ops::ToBits(hit);
+}
+
+///-------------------------------------------///
+/// 相手を kWidth 件ずつ集めて判定する
+///-------------------------------------------///
+template<class Ops>
+void RunBatches(const ColliderSnapshot& snapshot, const float* selfFields, const uint32_t* others, uint32_t count,
+	const NarrowPhase::Shapes& shapes, uint8_t* outHits) {
+	constexpr uint32_t kWidth = Ops::kWidth;
+	alignas(32) float laneFields[Field::kFieldCount * kWidth];
+
+	for (uint32_t begin = 0; begin < count; begin += kWidth) {
+		const uint32_t laneCount = std::min(kWidth, count - begin);
+
+		// SoAから相手の値を集める（余ったレーンは0で埋め、結果は捨てる）
+		for (uint32_t field = 0; field < Field::kFieldCount; ++field) {
+			const float* source = snapshot.GetField(static_cast<Field>(field));
+			float* destination = laneFields + field * kWidth;
+			for (uint32_t l = 0; l < laneCount; ++l) {
+				destination[l] = source[others[begin + l]];
+			}
+			for (uint32_t l = laneCount; l < kWidth; ++l) {
+				destination[l] = 0.0f;
+			}
+		}
+
+		const uint32_t bits = TestLanes<Ops>(selfFields, laneFields, shapes);
+		for (uint32_t l = 0; l < laneCount; ++l) {
+			outHits[begin + l] = static_cast<uint8_t>((bits >> l) & 1u);
+		}
+	}
+}
+
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+void RunBatchesAvx2(const ColliderSnapshot& snapshot, const float* selfFields, const uint32_t* others, uint32_t count,
+	const NarrowPhase::Shapes& shapes, uint8_t* outHits) {
+	RunBatches<Avx2Ops>(snapshot, selfFields, others, count, shapes, outHits);
+	// SSE命令との切り替えペナルティを避ける
+	_mm256_zeroupper();
+}
+#endif // ENGINE_SIMD_ENABLE_AVX2
+
+// OBBをフィールド配列に書き込む
+void WriteObbFields(float* fields, const OBB& obb) {
+	fields[Field::kObbCenterX] = obb.center.x;
+	fields[Field::kObbCenterY] = obb.center.y;
+	fields[Field::kObbCenterZ] = obb.center.z;
+	for (uint32_t i = 0; i < 3; ++i) {
+		fields[Field::kObbAxis0X + i * 3 + 0] = obb.orientations[i].x;
+		fields[Field::kObbAxis0X + i * 3 + 1] = obb.orientations[i].y;
+		fields[Field::kObbAxis0X + i * 3 + 2] = obb.orientations[i].z;
+	}
+	fields[Field::kObbSizeX] = obb.size.x;
+	fields[Field::kObbSizeY] = obb.size.y;
+	fields[Field::kObbSizeZ] = obb.size.z;
+}
+
+// レイと箱（軸ごとの区間を交差させる）
+bool RaySlab(const float origin[3], const float direction[3], const float boxMin[3], const float boxMax[3],
+	float maxDistance, float& outDistance) {
+	float nearDistance = 0.0f;
+	float farDistance = maxDistance;
+	for (uint32_t axis = 0; axis < 3; ++axis) {
+		if (std::abs(direction[axis]) < NarrowPhase::kEpsilon) {
+			// 軸と平行なので、始点が区間外なら当たらない
+			if (origin[axis] < boxMin[axis] || origin[axis] > boxMax[axis]) {
+				return false;
+			}
+			continue;
+		}
+		const float inverse = 1.0f / direction[axis];
+		float t0 = (boxMin[axis] - origin[axis]) * inverse;
+		float t1 = (boxMax[axis] - origin[axis]) * inverse;
+		if (t0 > t1) {
+			std::swap(t0, t1);
+		}
+		nearDistance = std::max(nearDistance, t0);
+		farDistance = std::min(farDistance, t1);
+		if (nearDistance > farDistance) {
+			return false;
+		}
+	}
+	outDistance = nearDistance;
+	return true;
+}
+} // namespace
+
+///-------------------------------------------///
+/// ColliderSnapshot
+///-------------------------------------------///
+void ColliderSnapshot::Clear() {
+	for (std::vector<float>& field : fields_) {
+		field.clear();
+	}
+	size_ = 0;
+}
+
+void ColliderSnapshot::Push(const Vector3& sphereCenter, float radius, const AABB& aabb, const OBB& obb) {
+	float values[kFieldCount] = {
+		sphereCenter.x, sphereCenter.y, sphereCenter.z, radius,
+		aabb.min.x, aabb.min.y, aabb.min.z, aabb.max.x, aabb.max.y, aabb.max.z,
+	};
+	WriteObbFields(values, obb);
+	for (uint32_t field = 0; field < kFieldCount; ++field) {
+		fields_[field].push_back(values[field]);
+	}
+	++size_;
+}
+
+///-------------------------------------------///
+/// NarrowPhase
+///-------------------------------------------///
+void NarrowPhase::TestOneVsMany(const ColliderSnapshot& snapshot, uint32_t a, const uint32_t* others, uint32_t count,
+	const Shapes& shapes, SimdLevel level, uint8_t* outHits) {
+	// 判定元の値（全レーンに配る）
+	float selfFields[ColliderSnapshot::kFieldCount];
+	for (uint32_t field = 0; field < ColliderSnapshot::kFieldCount; ++field) {
+		selfFields[field] = snapshot.GetField(static_cast<Field>(field))[a];
+	}
+
+	level = std::min(level, GetSupportedLevel());
+	switch (level) {
+#ifdef ENGINE_SIMD_ENABLE_AVX2
+	case SimdLevel::kAVX2:
+		RunBatchesAvx2(snapshot, selfFields, others, count, shapes, outHits);
+		break;
+#endif // ENGINE_SIMD_ENABLE_AVX2
+	case SimdLevel::kSSE:
+		RunBatches<SseOps>(snapshot, selfFields, others, count, shapes, outHits);
+		break;
+	default:
+		RunBatches<ScalarOps>(snapshot, selfFields, others, count, shapes, outHits);
+		break;
+	}
+}
+
+void NarrowPhase::GroupPairs(const std::vector<BroadPhasePair>& pairs, uint32_t count, Workspace& workspace) {
+	// 判定元ごとの個数を数えて累積和で開始位置を決める
+	std::vector<uint32_t>& groupStart = workspace.groupStart;
+	groupStart.assign(count + 1, 0u);
+	for (const BroadPhasePair& pair : pairs) {
+		++groupStart[pair.a + 1];
+	}
+	for (uint32_t i = 0; i < count; ++i) {
+		groupStart[i + 1] += groupStart[i];
+	}
+
+	// 開始位置を書き込み位置として進め、後で1つずらして戻す
+	workspace.others.resize(groupStart[count]);
+	for (const BroadPhasePair& pair : pairs) {
+		workspace.others[groupStart[pair.a]++] = pair.b;
+	}
+	for (uint32_t i = count; i > 0; --i) {
+		groupStart[i] = groupStart[i - 1];
+	}
+	groupStart[0] = 0;
+}
+
+void NarrowPhase::TestGroupsParallel(const ColliderSnapshot& snapshot, const Shapes& shapes, SimdLevel level, uint32_t maxThreads,
+	const ExtraTest& extraTest, Workspace& workspace, std::vector<Hit>& outHits) {
+	// 1ジョブで受け持つ判定元の数
+	constexpr uint32_t kGroupsPerJob = 16;
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	const uint32_t groupCount = workspace.groupStart.empty() ? 0u : static_cast<uint32_t>(workspace.groupStart.size()) - 1;
+	workspace.hits.resize(workspace.others.size());
+	workspace.threadHits.resize(jobSystem->GetMaxThreadCount());
+	for (std::vector<Hit>& threadHits : workspace.threadHits) {
+		threadHits.clear();
+	}
+
+	// 判定フェーズ（スレッドごとのバッファに書くだけで、共有状態には触れない）
+	const bool useShapes = shapes.sphere || shapes.aabb || shapes.obb;
+	jobSystem->ParallelFor(groupCount, kGroupsPerJob, [&](uint32_t beginGroup, uint32_t endGroup, uint32_t threadIndex) {
+		std::vector<Hit>& threadHits = workspace.threadHits[threadIndex];
+		for (uint32_t a = beginGroup; a < endGroup; ++a) {
+			const uint32_t begin = workspace.groupStart[a];
+			const uint32_t count = workspace.groupStart[a + 1] - begin;
+			if (count == 0) {
+				continue;
+			}
+			const uint32_t* others = workspace.others.data() + begin;
+			uint8_t* hits = workspace.hits.data() + begin;
+			if (useShapes) {
+				TestOneVsMany(snapshot, a, others, count, shapes, level, hits);
+			}
+			else {
+				std::fill(hits, hits + count, uint8_t(0));
+			}
+			for (uint32_t i = 0; i < count; ++i) {
+				float timeOfImpact = 1.0f;
+				if (!hits[i] && (!extraTest || !extraTest(a, others[i], timeOfImpact))) {
+					continue;
+				}
+				threadHits.push_back({ std::min(a, others[i]), std::max(a, others[i]), timeOfImpact });
+			}
+		}
+		}, maxThreads);
+
+	// 結合して並べ替える（スレッドの分担によらず同じ順序になる）
+	outHits.clear();
+	for (const std::vector<Hit>& threadHits : workspace.threadHits) {
+		outHits.insert(outHits.end(), threadHits.begin(), threadHits.end());
+	}
+	std::sort(outHits.begin(), outHits.end(), [](const Hit& lhs, const Hit& rhs) {
+		return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b;
+		});
+}
+
+bool NarrowPhase::TestOBB(const OBB& obbA, const OBB& obbB) {
+	float fieldsA[ColliderSnapshot::kFieldCount] = {};
+	float fieldsB[ColliderSnapshot::kFieldCount] = {};
+	WriteObbFields(fieldsA, obbA);
+	WriteObbFields(fieldsB, obbB);
+	return TestObbLanes<ScalarOps>(
+		[&](uint32_t field) { return fieldsA[field]; },
+		[&](uint32_t field) { return fieldsB[field]; });
+}
+
+bool NarrowPhase::SweepSphere(const Vector3& startA, const Vector3& endA, float radiusA,
+	const Vector3& startB, const Vector3& endB, float radiusB, float& outTime) {
+	// Aを止めて、Bが相対速度で動くとみなす
+	const Vector3 offset = startB - startA;
+	const Vector3 move = (endB - startB) - (endA - startA);
+	const float radius = radiusA + radiusB;
+
+	// |offset + move * t|^2 = radius^2 を解く
+	const float c = offset.Dot(offset) - radius * radius;
+	if (c <= 0.0f) {
+		// 開始時点で重なっている
+		outTime = 0.0f;
+		return true;
+	}
+	const float a = move.Dot(move);
+	if (a <= kEpsilon) {
+		return false;
+	}
+	const float b = offset.Dot(move);
+	if (b >= 0.0f) {
+		// 離れていく方向
+		return false;
+	}
+	const float discriminant = b * b - a * c;
+	if (discriminant < 0.0f) {
+		return false;
+	}
+	const float time = (-b - std::sqrt(discriminant)) / a;
+	if (time > 1.0f) {
+		return false;
+	}
+	outTime = time;
+	return true;
+}
+
+bool NarrowPhase::SweepAABB(const AABB& startA, const Vector3& moveA, const AABB& startB, const Vector3& moveB, float& outTime) {
+	// Aを止めて、Bが相対速度で動くとみなす（軸ごとに重なっている時間帯を求めて交差させる）
+	const float minA[3] = { startA.min.x, startA.min.y, startA.min.z };
+	const float maxA[3] = { startA.max.x, startA.max.y, startA.max.z };
+	const float minB[3] = { startB.min.x, startB.min.y, startB.min.z };
+	const float maxB[3] = { startB.max.x, startB.max.y, startB.max.z };
+	const Vector3 relative = moveB - moveA;
+	const float velocity[3] = { relative.x, relative.y, relative.z };
+
+	float timeFirst = 0.0f;
+	float timeLast = 1.0f;
+	for (uint32_t axis = 0; axis < 3; ++axis) {
+		if (velocity[axis] < 0.0f) {
+			if (maxB[axis] < minA[axis]) { return false; }
+			if (maxA[axis] < minB[axis]) { timeFirst = std::max((maxA[axis] - minB[axis]) / velocity[axis], timeFirst); }
+			if (maxB[axis] > minA[axis]) { timeLast = std::min((minA[axis] - maxB[axis]) / velocity[axis], timeLast); }
+		}
+		else if (velocity[axis] > 0.0f) {
+			if (minB[axis] > maxA[axis]) { return false; }
+			if (maxB[axis] < minA[axis]) { timeFirst = std::max((minA[axis] - maxB[axis]) / velocity[axis], timeFirst); }
+			if (maxA[axis] > minB[axis]) { timeLast = std::min((maxA[axis] - minB[axis]) / velocity[axis], timeLast); }
+		}
+		else if (maxB[axis] < minA[axis] || minB[axis] > maxA[axis]) {
+			// この軸は動かず、離れたまま
+			return false;
+		}
+		if (timeFirst > timeLast) {
+			return false;
+		}
+	}
+	outTime = timeFirst;
+	return true;
+}
+
+bool NarrowPhase::RaySphere(const Vector3& origin, const Vector3& direction, float maxDistance,
+	const Vector3& center, float radius, float& outDistance) {
+	const Vector3 offset = origin - center;
+	const float c = offset.Dot(offset) - radius * radius;
+	if (c <= 0.0f) {
+		outDistance = 0.0f;
+		return true;
+	}
+	const float b = offset.Dot(direction);
+	if (b >= 0.0f) {
+		return false;
+	}
+	const float discriminant = b * b - c;
+	if (discriminant < 0.0f) {
+		return false;
+	}
+	const float distance = -b - std::sqrt(discriminant);
+	if (distance > maxDistance) {
+		return false;
+	}
+	outDistance = distance;
+	return true;
+}
+
+bool NarrowPhase::RayAABB(const Vector3& origin, const Vector3& direction, float maxDistance, const AABB& aabb, float& outDistance) {
+	const float rayOrigin[3] = { origin.x, origin.y, origin.z };
+	const float rayDirection[3] = { direction.x, direction.y, direction.z };
+	const float boxMin[3] = { aabb.min.x, aabb.min.y, aabb.min.z };
+	const float boxMax[3] = { aabb.max.x, aabb.max.y, aabb.max.z };
+	return RaySlab(rayOrigin, rayDirection, boxMin, boxMax, maxDistance, outDistance);
+}
+
+bool NarrowPhase::RayOBB(const Vector3& origin, const Vector3& direction, float maxDistance, const OBB& obb, float& outDistance) {
+	// OBBのローカル座標系に移して箱として判定する
+	const Vector3 offset = origin - obb.center;
+	const float rayOrigin[3] = { offset.Dot(obb.orientations[0]), offset.Dot(obb.orientations[1]), offset.Dot(obb.orientations[2]) };
+	const float rayDirection[3] = { direction.Dot(obb.orientations[0]), direction.Dot(obb.orientations[1]), direction.Dot(obb.orientations[2]) };
+	const float boxMin[3] = { -obb.size.x, -obb.size.y, -obb.size.z };
+	const float boxMax[3] = { obb.size.x, obb.size.y, obb.size.z };
+	return RaySlab(rayOrigin, rayDirection, boxMin, boxMax, maxDistance, outDistance);
+}
+
+bool NarrowPhase::SphereAABB(const Vector3& center, float radius, const AABB& aabb) {
+	// AABB上の最近接点との距離
+	const Vector3 closest = {
+		std::clamp(center.x, aabb.min.x, aabb.max.x),
+		std::clamp(center.y, aabb.min.y, aabb.max.y),
+		std::clamp(center.z, aabb.min.z, aabb.max.z),
+	};
+	const Vector3 offset = center - closest;
+	return offset.Dot(offset) <= radius * radius;
+}
+
+bool NarrowPhase::SphereOBB(const Vector3& center, float radius, const OBB& obb) {
+	// OBBのローカル座標系で最近接点を求める
+	const Vector3 offset = center - obb.center;
+	const float local[3] = { offset.Dot(obb.orientations[0]), offset.Dot(obb.orientations[1]), offset.Dot(obb.orientations[2]) };
+	const float size[3] = { obb.size.x, obb.size.y, obb.size.z };
+	float distanceSq = 0.0f;
+	for (uint32_t axis = 0; axis < 3; ++axis) {
+		const float excess = std::abs(local[axis]) - size[axis];
+		if (excess > 0.0f) {
+			distanceSq += excess * excess;
+		}
+	}
+	return distanceSq <= radius * radius;
+}
+} // namespace Engine
@@ -0,0 +1,198 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "BroadPhase.h"
+#include "CollisionShapes.h"
+#include "SimdOps.h"
+
+namespace Engine {
+/// <summary>
+/// 判定用のコライダー形状をSoA(フィールドごとの配列)で保持するスナップショット
+/// </summary>
+class ColliderSnapshot {
+public:
+	// フィールド
+	enum Field : uint32_t {
+		kSphereX, kSphereY, kSphereZ, kRadius,
+		kAabbMinX, kAabbMinY, kAabbMinZ, kAabbMaxX, kAabbMaxY, kAabbMaxZ,
+		kObbCenterX, kObbCenterY, kObbCenterZ,
+		kObbAxis0X, kObbAxis0Y, kObbAxis0Z,
+		kObbAxis1X, kObbAxis1Y, kObbAxis1Z,
+		kObbAxis2X, kObbAxis2Y, kObbAxis2Z,
+		kObbSizeX, kObbSizeY, kObbSizeZ,
+		kFieldCount,
+	};
+
+	/// <summary>全要素の削除（確保済みの領域は残す）</summary>
+	void Clear();
+
+	/// <summary>
+	/// 要素の追加
+	/// </summary>
+	/// <param name="sphereCenter">球の中心</param>
+	/// <param name="radius">球の半径</param>
+	/// <param name="aabb">AABB</param>
+	/// <param name="obb">OBB</param>
+	void Push(const Vector3& sphereCenter, float radius, const AABB& aabb, const OBB& obb);
+
+	uint32_t GetSize() const { return size_; }
+	const float* GetField(Field field) const { return fields_[field].data(); }
+
+private:
+	std::array<std::vector<float>, kFieldCount> fields_;
+	uint32_t size_ = 0;
+};
+
+/// <summary>
+/// 狭域判定（球・AABB・OBB）。1つのコライダーと複数の相手をSIMDでまとめて判定する
+/// </summary>
+class NarrowPhase {
+public:
+	/// <summary>
+	/// 使用する命令セット
+	/// </summary>
+	using SimdLevel = Simd::Level;
+
+	/// <summary>
+	/// 判定に使う形状
+	/// </summary>
+	struct Shapes {
+		bool sphere = true;
+		bool aabb = true;
+		bool obb = true;
+	};
+
+	/// <summary>
+	/// 当たったペア（a < b）
+	/// </summary>
+	struct Hit {
+		uint32_t a;
+		uint32_t b;
+		float timeOfImpact; // 衝突時刻（0:前フレーム 〜 1:現フレーム）
+
+		bool operator==(const Hit& other) const = default;
+	};
+
+	/// <summary>
+	/// 通常の判定で外れたペアに追加でかける判定（連続判定用）。当たれば衝突時刻を返す
+	/// </summary>
+	using ExtraTest = std::function<bool(uint32_t a, uint32_t b, float& outTime)>;
+
+	/// <summary>
+	/// 作業領域（毎フレーム使い回す）
+	/// </summary>
+	struct Workspace {
+		std::vector<uint32_t> groupStart;            // 判定元ごとの相手リストの開始位置
+		std::vector<uint32_t> others;                // 判定元ごとにまとめた相手
+		std::vector<uint8_t> hits;
+		std::vector<std::vector<Hit>> threadHits;    // スレッドごとの出力
+	};
+
+	/// <summary>
+	/// 実行中のCPUで使える最上位の命令セット（初回のみ判定）
+	/// </summary>
+	static SimdLevel GetSupportedLevel() { return Simd::GetSupportedLevel(); }
+
+	/// <summary>
+	/// 候補ペアを判定元ごとにまとめる
+	/// </summary>
+	/// <param name="pairs">候補ペア</param>
+	/// <param name="count">要素数</param>
+	/// <param name="workspace">まとめた結果の書き込み先</param>
+	static void GroupPairs(const std::vector<BroadPhasePair>& pairs, uint32_t count, Workspace& workspace);
+
+	/// <summary>
+	/// まとめた候補ペアを並列に判定し、スレッド数によらず同じ順序（a, b の昇順）で返す
+	/// </summary>
+	/// <param name="snapshot">形状のスナップショット</param>
+	/// <param name="shapes">判定に使う形状</param>
+	/// <param name="level">命令セット</param>
+	/// <param name="maxThreads">使うスレッド数の上限（0なら全部）</param>
+	/// <param name="extraTest">外れたペアへの追加判定（空なら呼ばない）</param>
+	/// <param name="workspace">GroupPairs でまとめた作業領域</param>
+	/// <param name="outHits">当たったペアの出力先</param>
+	static void TestGroupsParallel(const ColliderSnapshot& snapshot, const Shapes& shapes, SimdLevel level, uint32_t maxThreads,
+		const ExtraTest& extraTest, Workspace& workspace, std::vector<Hit>& outHits);
+
+	/// <summary>
+	/// 1対多の判定
+	/// </summary>
+	/// <param name="snapshot">形状のスナップショット</param>
+	/// <param name="a">判定元のインデックス</param>
+	/// <param name="others">相手のインデックス配列</param>
+	/// <param name="count">相手の数</param>
+	/// <param name="shapes">判定に使う形状（いずれかが当たれば衝突）</param>
+	/// <param name="level">命令セット（CPUが対応していなければ下位に落とす）</param>
+	/// <param name="outHits">相手ごとの結果(1:衝突)</param>
+	static void TestOneVsMany(const ColliderSnapshot& snapshot, uint32_t a, const uint32_t* others, uint32_t count,
+		const Shapes& shapes, SimdLevel level, uint8_t* outHits);
+
+	/// <summary>
+	/// OBB同士の判定（分離軸判定。スカラー版と同じ計算）
+	/// </summary>
+	static bool TestOBB(const OBB& obbA, const OBB& obbB);
+
+	/// <summary>
+	/// 移動する球同士の判定（フレーム間を直線移動とみなす）
+	/// </summary>
+	/// <param name="startA">Aの前フレームの中心</param>
+	/// <param name="endA">Aの現フレームの中心</param>
+	/// <param name="radiusA">Aの半径</param>
+	/// <param name="startB">Bの前フレームの中心</param>
+	/// <param name="endB">Bの現フレームの中心</param>
+	/// <param name="radiusB">Bの半径</param>
+	/// <param name="outTime">最初に接触する時刻（0:前フレーム 〜 1:現フレーム）</param>
+	static bool SweepSphere(const Vector3& startA, const Vector3& endA, float radiusA,
+		const Vector3& startB, const Vector3& endB, float radiusB, float& outTime);
+
+	/// <summary>
+	/// 移動するAABB同士の判定（フレーム間を直線移動とみなす）
+	/// </summary>
+	/// <param name="startA">Aの前フレームのAABB</param>
+	/// <param name="moveA">Aの移動量</param>
+	/// <param name="startB">Bの前フレームのAABB</param>
+	/// <param name="moveB">Bの移動量</param>
+	/// <param name="outTime">最初に接触する時刻（0:前フレーム 〜 1:現フレーム）</param>
+	static bool SweepAABB(const AABB& startA, const Vector3& moveA, const AABB& startB, const Vector3& moveB, float& outTime);
+
+	/// <summary>
+	/// レイと球（始点が内側なら距離0）
+	/// </summary>
+	/// <param name="origin">始点</param>
+	/// <param name="direction">向き（正規化済み）</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="center">球の中心</param>
+	/// <param name="radius">球の半径</param>
+	/// <param name="outDistance">当たった距離</param>
+	static bool RaySphere(const Vector3& origin, const Vector3& direction, float maxDistance,
+		const Vector3& center, float radius, float& outDistance);
+
+	/// <summary>
+	/// レイとAABB（始点が内側なら距離0）
+	/// </summary>
+	static bool RayAABB(const Vector3& origin, const Vector3& direction, float maxDistance, const AABB& aabb, float& outDistance);
+
+	/// <summary>
+	/// レイとOBB（始点が内側なら距離0）
+	/// </summary>
+	static bool RayOBB(const Vector3& origin, const Vector3& direction, float maxDistance, const OBB& obb, float& outDistance);
+
+	/// <summary>
+	/// 球とAABB
+	/// </summary>
+	static bool SphereAABB(const Vector3& center, float radius, const AABB& aabb);
+
+	/// <summary>
+	/// 球とOBB
+	/// </summary>
+	static bool SphereOBB(const Vector3& center, float radius, const OBB& obb);
+
+	/// <summary>
+	/// 判定の精度調整用（平行な軸の外積がゼロになる場合の誤差吸収）
+	/// </summary>
+	static constexpr float kEpsilon = 1.0e-5f;
+};
+} // namespace Engine
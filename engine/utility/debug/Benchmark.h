@@ -0,0 +1,50 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/// <summary>
+/// 計測の共通部分（XxxBenchmark が使う。デバッグビルドのみ）。
+/// このリポジトリにはテストのターゲットがないため、最適化の前後で結果が変わらないことは各 XxxBenchmark の Run 関数が計測と同時に確かめる。
+/// その確認だけを小さい規模で行うのが各 XxxBenchmark の RunChecks で、SelfCheck がそれをまとめて呼ぶ（ウィンドウを作らずに実行できる）
+/// </summary>
+namespace Engine {
+namespace Benchmark {
+using Clock = std::chrono::high_resolution_clock;
+
+/// <summary>
+/// 確認1件の結果を受け取る関数（確認の名前, 通ったか）
+/// </summary>
+using Check = std::function<void(const std::string& name, bool passed)>;
+
+/// <summary>
+/// start からの経過時間（ミリ秒）
+/// </summary>
+inline double ElapsedMs(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// <summary>
+/// function を iterations 回繰り返した1回あたりの時間（ミリ秒）
+/// </summary>
+template<class Function>
+double MeasureMs(uint32_t iterations, Function function) {
+	const Clock::time_point start = Clock::now();
+	for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+		function();
+	}
+	return ElapsedMs(start) / (iterations > 0 ? iterations : 1u);
+}
+
+// 最適化で計算を消されないように結果を書き込む先
+inline volatile float gSink = 0.0f;
+
+/// <summary>
+/// 計算結果を使ったことにする
+/// </summary>
+inline void Consume(float value) {
+	gSink = gSink + value;
+}
+} // namespace Benchmark
+} // namespace Engine
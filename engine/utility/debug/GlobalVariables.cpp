@@ -318,35 +318,33 @@ void GlobalVariables::AddItem(const std::string& groupName, const std::string& k
 }
 
 void GlobalVariables::SetValue(const std::string& groupName, const std::string& key, int32_t value) {
-	Group& group = datas_[groupName];
-	Item newItem{};
-	newItem.value = value;
-	group.items[key] = newItem;
+	StoreValue(groupName, key, value);
 }
 
 void GlobalVariables::SetValue(const std::string& groupName, const std::string& key, float value) {
-	Group& group = datas_[groupName];
-	Item newItem{};
-	newItem.value = value;
-	group.items[key] = newItem;
+	StoreValue(groupName, key, value);
 }
 
 void GlobalVariables::SetValue(const std::string& groupName, const std::string& key, const Vector2& value) {
-	Group& group = datas_[groupName];
-	Item newItem{};
-	newItem.value = value;
-	group.items[key] = newItem;
+	StoreValue(groupName, key, value);
 }
 
 void GlobalVariables::SetValue(const std::string& groupName, const std::string& key, const Vector3& value) {
-	Group& group = datas_[groupName];
-	Item newItem{};
-	newItem.value = value;
-	group.items[key] = newItem;
+	StoreValue(groupName, key, value);
 }
 
 void GlobalVariables::SetValue(const std::string& groupName, const std::string& key, const bool& value) {
+	StoreValue(groupName, key, value);
+}
+
+template<typename T>
+void GlobalVariables::StoreValue(const std::string& groupName, const std::string& key, const T& value) {
 	Group& group = datas_[groupName];
+	auto itItem = group.items.find(key);
+	// 既存の項目の型が変わると、参照が持つポインタの型と合わなくなる
+	if (itItem != group.items.end() && !std::holds_alternative<T>(itItem->second.value)) {
+		++generation_;
+	}
 	Item newItem{};
 	newItem.value = value;
 	group.items[key] = newItem;
@@ -386,6 +384,8 @@ void GlobalVariables::SaveDefaultValues(const std::string& groupName) {
 void GlobalVariables::ResetToDefault(const std::string& groupName) {
 	if (defaultValues_.find(groupName) != defaultValues_.end()) {
 		datas_[groupName] = defaultValues_[groupName];
+		// グループごと入れ替えるのでノードが作り直される可能性がある
+		++generation_;
 	}
 }
 
@@ -394,6 +394,7 @@ void GlobalVariables::ResetToDefault(const std::string& groupName, const std::st
 		const auto& defaultGroup = defaultValues_[groupName];
 		if (defaultGroup.items.find(key) != defaultGroup.items.end()) {
 			datas_[groupName].items[key] = defaultGroup.items.at(key);
+			++generation_;
 		}
 	}
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "externals/nlohmann/json.hpp"
+#include "cassert"
 #include "map"
 #include "string"
 #include "variant"
@@ -15,6 +16,43 @@
 namespace Engine {
 class GlobalVariables {
 public:
+	/// <summary>
+	/// 項目への参照（毎フレームの文字列検索を避けるため、初回だけ検索して値へのポインタを保持する）。
+	/// 値の型の変更やグループのリセットで無効になり、次の Get で自動的に引き直す。
+	/// ImGui での編集はポインタ先がそのまま書き換わるので、引き直さずに反映される
+	/// </summary>
+	template<typename T>
+	class ItemHandle {
+	public:
+		ItemHandle() = default;
+
+		/// <summary>
+		/// 値の取得（項目が無い・型が違う場合は T{}）
+		/// </summary>
+		const T& Get() const {
+			assert(owner_);
+			// 未登録だった項目は後から追加されることがあるので引き直す
+			if (!value_ || generation_ != owner_->generation_) {
+				value_ = owner_->FindValue<T>(groupName_, key_);
+				generation_ = owner_->generation_;
+			}
+			return value_ ? *value_ : kDefaultValue;
+		}
+
+	private:
+		friend class GlobalVariables;
+		ItemHandle(GlobalVariables* owner, const std::string& groupName, const std::string& key)
+			: owner_(owner), groupName_(groupName), key_(key) {}
+
+		inline static const T kDefaultValue{};
+
+		GlobalVariables* owner_ = nullptr;
+		std::string groupName_;
+		std::string key_;
+		mutable const T* value_ = nullptr;
+		mutable uint32_t generation_ = 0; // 0 は未解決
+	};
+
 	/// <summary>
 	/// 毎フレーム処理
 	/// </summary>
@@ -135,6 +173,15 @@ public:
 	Vector3 GetVector3Value(const std::string& groupName, const std::string& key) const;
 	bool GetBoolValue(const std::string& groupName, const std::string& key) const;
 
+	/// <summary>
+	/// 項目への参照の取得（毎フレーム読む項目はこちらを使う）
+	/// </summary>
+	/// <typeparam name="T">int32_t, float, Vector2, Vector3, bool のいずれか</typeparam>
+	template<typename T>
+	ItemHandle<T> GetHandle(const std::string& groupName, const std::string& key) {
+		return ItemHandle<T>(this, groupName, key);
+	}
+
 	bool GroupExists(const std::string& groupName) const;
 
 	// 新機能：値の制限設定
@@ -177,6 +224,9 @@ private:
 	// 全データ
 	std::map<std::string, Group> datas_;
 
+	// 項目への参照を無効にするたびに進める（std::map のノードは挿入では動かないので、型の変更とグループのリセット時のみ）
+	uint32_t generation_ = 1;
+
 	// デフォルト値の保存
 	std::map<std::string, Group> defaultValues_;
 
@@ -190,6 +240,24 @@ private:
 	bool sortAlphabetically_ = false;
 	int  selectedGroupIndex_ = 0; // プルダウンで選択中のグループ
 
+	// 値の書き込み（型が変わった場合は参照を無効にする）
+	template<typename T>
+	void StoreValue(const std::string& groupName, const std::string& key, const T& value);
+
+	// 項目の値へのポインタ（無い・型が違う場合はnullptr）
+	template<typename T>
+	const T* FindValue(const std::string& groupName, const std::string& key) const {
+		auto itGroup = datas_.find(groupName);
+		if (itGroup == datas_.end()) {
+			return nullptr;
+		}
+		auto itItem = itGroup->second.items.find(key);
+		if (itItem == itGroup->second.items.end()) {
+			return nullptr;
+		}
+		return std::get_if<T>(&itItem->second.value);
+	}
+
 	// UI用のヘルパー関数
 	bool PassesFilter(const std::string& itemName) const;
 	std::vector<std::pair<std::string, Item&>> GetSortedItems(Group& group);
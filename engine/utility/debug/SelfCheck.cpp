@@ -0,0 +1,49 @@
+#include "SelfCheck.h"
+#ifdef _DEBUG
+#include "animation/AnimationBenchmark.h"
+#include "Benchmark.h"
+#include "CollisionBenchmark.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include "MathBenchmark.h"
+#include "ParticleBenchmark.h"
+#include <format>
+
+namespace Engine {
+bool SelfCheck::IsRequested(const std::string& commandLine)
+{
+	return commandLine.find("--self-check") != std::string::npos;
+}
+
+bool SelfCheck::RunAll()
+{
+	// 並列の結果の一致も見られるようにワーカーを起こす
+	JobSystem::GetInstance()->Initialize();
+
+	uint32_t failedCount = 0;
+	const Benchmark::Check check = [&failedCount](const std::string& name, bool passed) {
+		Logger::Log(std::format("[{}] {}\n", passed ? "OK" : "NG", name));
+		if (!passed) {
+			++failedCount;
+		}
+		};
+
+	// --- 数学 ---
+	MathBenchmark::RunChecks(check);
+
+	// --- アニメーション ---
+	AnimationBenchmark::RunChecks(check);
+
+	// --- パーティクル ---
+	ParticleBenchmark::RunChecks(check);
+
+	// --- 当たり判定 ---
+	CollisionBenchmark::RunChecks(check);
+
+	JobSystem::GetInstance()->Finalize();
+
+	Logger::Log(std::format("SelfCheck: {} failed\n", failedCount));
+	return failedCount == 0;
+}
+} // namespace Engine
+#endif // _DEBUG
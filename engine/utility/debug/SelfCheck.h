@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// 結果の一致・性質の確認をまとめて実行するクラス（デバッグビルドのみ）。
+/// 各 XxxBenchmark の RunChecks を呼び、時間は見ずに判定だけを見る。
+/// 起動引数に --self-check を付けるとウィンドウを作らずに実行し、結果を終了コードで返す
+/// </summary>
+namespace Engine {
+class SelfCheck
+{
+public:
+
+	/// <summary>
+	/// 起動引数で実行が指定されているか
+	/// </summary>
+	/// <param name="commandLine">起動引数</param>
+	static bool IsRequested(const std::string& commandLine);
+
+	/// <summary>
+	/// 全ての確認を実行し、1件ずつログに出す
+	/// </summary>
+	/// <returns>全て通ったか</returns>
+	static bool RunAll();
+};
+} // namespace Engine
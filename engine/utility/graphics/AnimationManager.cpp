@@ -32,7 +32,7 @@ ModelAnimation* AnimationManager::FindAnimation(const std::string& filePath)
 	return nullptr;
 }
 
-void AnimationManager::LoadAnimation(const std::string& filePath, ModelData modelData)
+void AnimationManager::LoadAnimation(const std::string& filePath, const ModelData& modelData)
 {
 	// 読み込み済みモデルを探索
 	if (animations.contains(filePath)) {
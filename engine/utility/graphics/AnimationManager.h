@@ -47,7 +47,7 @@ public:
 	/// モデルファイルの読み込み
 	/// </summary>
 	/// <param name="filePath"></param>
-	void LoadAnimation(const std::string& filePath, ModelData modelData);
+	void LoadAnimation(const std::string& filePath, const ModelData& modelData);
 public:
 	// モデルデータ
 	std::map<std::string, std::unique_ptr<ModelAnimation>> animations;
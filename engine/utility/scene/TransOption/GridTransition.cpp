@@ -6,12 +6,15 @@
 namespace Engine {
 GridTransition::GridTransition() {}
 
-GridTransition::~GridTransition() {}
+GridTransition::~GridTransition() {
+    // 書き込み先がなくなるので止める
+    CancelGridTweens();
+}
 
 void GridTransition::Initialize() {
     duration_ = 1.0f;
-    counter_ = 0.0f;
-    progress_ = 0.0f;
+    isTweenStarted_ = false;
+    remainingRects_ = 0;
     transitionStart_ = false;
     isEnd_ = false;
     isCloseTransition_ = false;
@@ -22,6 +25,7 @@ void GridTransition::Initialize() {
 }
 
 void GridTransition::InitializeGridRects() {
+    CancelGridTweens();
     gridRects_.clear();
 
     // 各矩形のサイズを計算
@@ -66,7 +70,9 @@ void GridTransition::Update() {
         return;
     }
 
-    ProcessTransition();
+    if (!isTweenStarted_) {
+        StartGridTweens();
+    }
     UpdateGridRects();
 }
 
@@ -77,56 +83,50 @@ void GridTransition::Draw() {
     }
 }
 
-void GridTransition::ProcessTransition() {
-    // 経過時間を更新
-    counter_ += 1.0f / 60.0f;
-    if (counter_ >= duration_) {
-        counter_ = duration_;
-        isEnd_ = true;
+void GridTransition::StartGridTweens() {
+    TweenScheduler* tweenScheduler = TweenScheduler::GetInstance();
+    isTweenStarted_ = true;
+    remainingRects_ = static_cast<uint32_t>(gridRects_.size());
+
+    for (auto &rect : gridRects_) {
+        // 閉じる：遅延後に黒く埋まる（easeOutCubic）
+        // 開く：逆順の遅延後に消える（easeInCubic）
+        // どちらも全体の終了時刻（duration_）にそろって終わる
+        float delay = isCloseTransition_ ? rect.delayTime : 1.0f - rect.delayTime;
+        float startAlpha = isCloseTransition_ ? 0.0f : 1.0f;
+        float endAlpha = isCloseTransition_ ? 1.0f : 0.0f;
+        EaseType type = isCloseTransition_ ? EaseType::OutCubic : EaseType::InCubic;
+
+        rect.tween = tweenScheduler->Start<float>(&rect.currentAlpha, startAlpha, endAlpha,
+            (1.0f - delay) * duration_, type, delay * duration_);
+
+        // 完了はまとめて届くので、最後の1つで終了にする
+        tweenScheduler->SetOnComplete(rect.tween, [this]() {
+            if (--remainingRects_ == 0) {
+                isEnd_ = true;
+            }
+        });
     }
+}
 
-    // 全体の進行度を計算
-    progress_ = counter_ / duration_;
+void GridTransition::CancelGridTweens() {
+    for (auto &rect : gridRects_) {
+        TweenScheduler::Cancel(rect.tween);
+        rect.tween = TweenScheduler::kInvalidHandle;
+    }
 }
 
 void GridTransition::UpdateGridRects() {
+    // スプライトのアルファ値を更新
     for (auto &rect : gridRects_) {
-        // 各矩形の個別進行度を計算（遅延を考慮）
-        float localProgress = 0.0f;
-
-        if (isCloseTransition_) {
-            // 閉じる：画面が黒く埋まる
-            // 遅延後に進行開始
-            if (progress_ >= rect.delayTime) {
-                localProgress = (progress_ - rect.delayTime) / (1.0f - rect.delayTime);
-                localProgress = min(localProgress, 1.0f);
-            }
-
-            // イージング適用（easeOutCubic）
-            float eased = 1.0f - powf(1.0f - localProgress, 3.0f);
-            rect.currentAlpha = eased;
-
-        } else {
-            // 開く：次シーンへ移行（逆順で消える）
-            float reverseDelay = 1.0f - rect.delayTime;
-            if (progress_ >= reverseDelay) {
-                localProgress = (progress_ - reverseDelay) / (1.0f - reverseDelay);
-                localProgress = min(localProgress, 1.0f);
-            }
-
-            // イージング適用（easeInCubic）
-            float eased = powf(localProgress, 3.0f);
-            rect.currentAlpha = 1.0f - eased;
-        }
-
-        // スプライトのアルファ値を更新
         rect.sprite->SetAlpha(rect.currentAlpha);
     }
 }
 
 void GridTransition::Reset() {
-    counter_ = 0.0f;
-    progress_ = 0.0f;
+    CancelGridTweens();
+    isTweenStarted_ = false;
+    remainingRects_ = 0;
     transitionStart_ = false;
     isEnd_ = false;
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "Sprite.h"
+#include "TweenScheduler.h"
 #include "memory"
 #include "vector"
 
@@ -53,9 +54,14 @@ class GridTransition {
     void InitializeGridRects();
 
     /// <summary>
-    /// トランジション処理
+    /// 各矩形のトゥイーンの開始（TweenScheduler がまとめて進める）
     /// </summary>
-    void ProcessTransition();
+    void StartGridTweens();
+
+    /// <summary>
+    /// 各矩形のトゥイーンの中止
+    /// </summary>
+    void CancelGridTweens();
 
     /// <summary>
     /// 各矩形の更新
@@ -70,15 +76,16 @@ class GridTransition {
         Vector2 size;
         int waveIndex;      // 波の順番（チェッカーボードパターン用）
         float delayTime;    // 表示開始の遅延時間
-        float currentAlpha; // 現在のアルファ値
+        float currentAlpha; // 現在のアルファ値（TweenScheduler が書き込む）
+        TweenScheduler::Handle tween = TweenScheduler::kInvalidHandle;
     };
 
     // フェードの持続時間
     float duration_ = 1.0f;
-    // 経過時間カウンター
-    float counter_ = 0.0f;
-    // 現在の進行度 (0.0f ~ 1.0f)
-    float progress_ = 0.0f;
+    // トゥイーンを開始したか
+    bool isTweenStarted_ = false;
+    // まだ完了していない矩形の数（完了時のコールバックで減らす）
+    uint32_t remainingRects_ = 0;
 
     // グリッドの列数と行数
     int gridCols_ = 16;
@@ -0,0 +1,112 @@
+#define NOMINMAX
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace Engine {
+JobSystem* JobSystem::GetInstance() {
+	static JobSystem instance;
+	return &instance;
+}
+
+JobSystem::~JobSystem() {
+	Finalize();
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+	Finalize();
+
+	if (workerCount == 0) {
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	isQuit_ = false;
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+	}
+}
+
+void JobSystem::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isQuit_ = true;
+	}
+	wakeCondition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t chunkSize, const RangeFunction& function, uint32_t maxThreads) {
+	if (count == 0) {
+		return;
+	}
+	chunkSize = std::max(chunkSize, 1u);
+	uint32_t threadCount = GetMaxThreadCount();
+	if (maxThreads != 0) {
+		threadCount = std::min(threadCount, maxThreads);
+	}
+	// 分けるほどの量が無ければその場で実行する
+	threadCount = std::min(threadCount, (count + chunkSize - 1) / chunkSize);
+	if (threadCount <= 1) {
+		function(0, count, 0);
+		return;
+	}
+
+	std::lock_guard<std::mutex> dispatchLock(dispatchMutex_);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		function_ = &function;
+		count_ = count;
+		chunkSize_ = chunkSize;
+		threadCount_ = threadCount;
+		nextBegin_.store(0, std::memory_order_relaxed);
+		pendingWorkers_ = threadCount - 1;
+		++batchId_;
+	}
+	wakeCondition_.notify_all();
+
+	// 呼び出し元も処理する
+	RunChunks(0);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	doneCondition_.wait(lock, [this] { return pendingWorkers_ == 0; });
+	function_ = nullptr;
+}
+
+void JobSystem::WorkerMain(uint32_t threadIndex) {
+	uint64_t seenBatchId = 0;
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		wakeCondition_.wait(lock, [&] { return isQuit_ || batchId_ != seenBatchId; });
+		if (isQuit_) {
+			return;
+		}
+		seenBatchId = batchId_;
+		// スレッド数を絞っているときは参加しない
+		if (threadIndex >= threadCount_) {
+			continue;
+		}
+
+		lock.unlock();
+		RunChunks(threadIndex);
+		lock.lock();
+
+		if (--pendingWorkers_ == 0) {
+			doneCondition_.notify_one();
+		}
+	}
+}
+
+void JobSystem::RunChunks(uint32_t threadIndex) {
+	while (true) {
+		const uint32_t begin = nextBegin_.fetch_add(chunkSize_, std::memory_order_relaxed);
+		if (begin >= count_) {
+			break;
+		}
+		(*function_)(begin, std::min(begin + chunkSize_, count_), threadIndex);
+	}
+}
+} // namespace Engine
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+/// <summary>
+/// ワーカースレッドで範囲処理を分担する簡易ジョブシステム。
+/// 呼び出し元スレッドも処理に参加し、全範囲が終わるまで戻らない。
+/// 初期化前・ワーカー0人の場合は呼び出し元スレッドだけで実行する。
+/// </summary>
+class JobSystem {
+public:
+	/// <summary>
+	/// 範囲処理 [begin, end)。threadIndex は 0(呼び出し元)〜GetMaxThreadCount()-1
+	/// </summary>
+	using RangeFunction = std::function<void(uint32_t begin, uint32_t end, uint32_t threadIndex)>;
+
+	/// <summary>
+	/// インスタンスの取得
+	/// </summary>
+	static JobSystem* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="workerCount">ワーカー数（0ならCPUのスレッド数-1）</param>
+	void Initialize(uint32_t workerCount = 0);
+
+	/// <summary>
+	/// 終了（ワーカーを止めて合流する）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 同時に処理できるスレッド数（呼び出し元を含む）
+	/// </summary>
+	uint32_t GetMaxThreadCount() const { return static_cast<uint32_t>(workers_.size()) + 1; }
+
+	/// <summary>
+	/// 範囲を chunkSize ごとに分けて並列実行する（入れ子の呼び出しは不可）
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="chunkSize">1回に取る要素数</param>
+	/// <param name="function">範囲処理</param>
+	/// <param name="maxThreads">使うスレッド数の上限（0なら全部）</param>
+	void ParallelFor(uint32_t count, uint32_t chunkSize, const RangeFunction& function, uint32_t maxThreads = 0);
+
+private:
+	// ワーカーの処理
+	void WorkerMain(uint32_t threadIndex);
+	// 残りの範囲を取り合って処理する
+	void RunChunks(uint32_t threadIndex);
+
+	std::vector<std::thread> workers_;
+
+	std::mutex dispatchMutex_; // ParallelFor を同時に1つに制限する
+	std::mutex mutex_;
+	std::condition_variable wakeCondition_;
+	std::condition_variable doneCondition_;
+	bool isQuit_ = false;
+	uint64_t batchId_ = 0;         // ParallelFor ごとに進める
+	uint32_t pendingWorkers_ = 0;  // 処理中のワーカー数
+
+	// 実行中の処理
+	const RangeFunction* function_ = nullptr;
+	uint32_t count_ = 0;
+	uint32_t chunkSize_ = 1;
+	uint32_t threadCount_ = 1;
+	std::atomic<uint32_t> nextBegin_ = 0;
+
+	JobSystem() = default;
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+};
+} // namespace Engine
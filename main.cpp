@@ -1,8 +1,16 @@
 #include "MyGame.h"
+#include "SelfCheck.h"
 
 using namespace Engine;
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int)
 {
+#ifdef _DEBUG
+	// ウィンドウを作らずに結果の確認だけを行う（失敗があれば1を返す）
+	if (SelfCheck::IsRequested(lpCmdLine)) {
+		return SelfCheck::RunAll() ? 0 : 1;
+	}
+#endif // _DEBUG
+
 	std::unique_ptr<Framework> game = std::make_unique<MyGame>();
 
 	game->Run();